@@ -147,16 +147,16 @@ int main()
         /* Average Integration Parameters */
         intgrt_t *intgrt = avr_get_integrate(_idAvrLine_);
 
-        /* Change the Integration Routine */
-        integrate_set_routine(intgrt, _idIntgrtDivonne_);
+        /* Change the Integration Routine (deterministic adaptive cubature) */
+        integrate_set_routine(intgrt, _idIntgrtCubature_);
 
-        /* Adjust Divonne Parameters */
-        intgrt_divonne_t *divonne = integrate_get_divonne(intgrt);
+        /* Adjust Cubature Parameters */
+        intgrt_cubature_t *cubature = integrate_get_cubature(intgrt);
 
-        integrate_divonne_set_epsabs(divonne, 0.);
-        integrate_divonne_set_epsrel(divonne, 1.e-4);
+        integrate_cubature_set_abserr(cubature, 0.);
+        integrate_cubature_set_relerr(cubature, 1.e-4);
 
-        integrate_divonne_set_maxeval(divonne, 1000000);
+        integrate_cubature_set_maxeval(cubature, 1000000);
       }
 
 
@@ -185,16 +185,16 @@ int main()
         /* Average PP Gaussian Covariance Matrix Integration Parameters */
         intgrt_t *intgrtGauss = avr_get_integrate(_idAvrCovPPGauss_);
 
-        /* Change the Integration Routine */
-        integrate_set_routine(intgrtGauss, _idIntgrtDivonne_);
+        /* Change the Integration Routine (deterministic adaptive cubature) */
+        integrate_set_routine(intgrtGauss, _idIntgrtCubature_);
 
-        /* Adjust Divonne Parameters */
-        intgrt_divonne_t *divonneGauss = integrate_get_divonne(intgrtGauss);
+        /* Adjust Cubature Parameters */
+        intgrt_cubature_t *cubatureGauss = integrate_get_cubature(intgrtGauss);
 
-        integrate_divonne_set_epsabs(divonneGauss, 0.);
-        integrate_divonne_set_epsrel(divonneGauss, 1.e-3);
+        integrate_cubature_set_abserr(cubatureGauss, 0.);
+        integrate_cubature_set_relerr(cubatureGauss, 1.e-4);
 
-        integrate_divonne_set_maxeval(divonneGauss, 1000000);
+        integrate_cubature_set_maxeval(cubatureGauss, 1000000);
 
 
         /* Average PP Non-Gaussian Covariance Matrix Integration Parameters */
@@ -420,6 +420,22 @@ int main()
 /*  ----------------------------------------------------  */
 
 
+    /**  Tabulate the One-Loop Power Spectrum (requires the redshift sample and the loop integration settings)  **/
+
+    if (false)
+      {
+        /* Grid of the tables (uniform in log(k) and mu^2) */
+        spec_table_pnl_set_k(64, 1.e-3, 0.5);
+        spec_table_pnl_set_mu(9);
+
+        /* Tabulate the bias and RSD basis instead (tables then remain valid if the bias or RSD parameters change) */
+        spec_table_pnl_set_basis(false);
+
+        /* Compute the P22 and P13 tables for every redshift; spec_pnl_p22 and spec_pnl_p13 then read from the tables */
+        spec_table_pnl_setup();
+      }
+
+
     /**  Interpolate the Power Spectrum from File  **/
 
     if (false)
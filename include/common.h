@@ -20,6 +20,7 @@
 #include <gsl/gsl_monte.h>
 #include <gsl/gsl_monte_miser.h>
 #include <gsl/gsl_monte_vegas.h>
+#include <gsl/gsl_qrng.h>
 #include <gsl/gsl_integration.h>
 
 
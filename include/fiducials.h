@@ -118,6 +118,39 @@ typedef struct
 
 
 
+typedef struct
+{
+    /*
+
+        Snapshot of all fiducials at one redshift, which is computed once and then shared read-only by all threads
+        and kern_t structs (see fid_snap_get)
+
+    */
+
+    double z;
+
+    /* Flags with which the snapshot was computed (_fidInclBias_, _fidInclRSD_) */
+    bool inclBias;
+    bool inclRSD;
+
+    /* Whether the bias terms (b1 = 1, b2 = bG2 = bGam3 = 0, c2Ga = a2Ga) and the RSD terms (f = 0) vanish, which
+       selects the variant of the batch kernels (see kernels_set_z) */
+    bool noBias;
+    bool noRSD;
+
+    double growth;
+
+    fid_lcdm_t *lcdm;
+    fid_btst_t *btst;
+    fid_bias_t *bias;
+    fid_rsd_t *rsd;
+    fid_ctr_t *ctr;
+    fid_surv_t *surv;
+
+} fid_snap_t;
+
+
+
 /*  ----------------------------------------------------  */
 /*  ---------------   Module Functions   ---------------  */
 /*  ----------------------------------------------------  */
@@ -431,6 +464,35 @@ extern void *_fidParamsDPk_;
 
 
 
+/*  ----------------------------------------------------  */
+/*  -------------   Linear Power Spectrum   ------------  */
+/*  ----------------------------------------------------  */
+
+
+int fid_pk_eval_n(
+    const double *k,
+    double *out,
+    size_t n);
+
+int fid_dpk_eval_n(
+    const double *k,
+    double *out,
+    size_t n);
+
+
+
+/*  ----------------------------------------------------  */
+/*  --------------   Fiducial Snapshots   --------------  */
+/*  ----------------------------------------------------  */
+
+
+const fid_snap_t *fid_snap_get(
+    double z);
+
+int fid_snap_clear(void);
+
+
+
 /*  ----------------------------------------------------  */
 /*  ------------------   Cosmology   -------------------  */
 /*  ----------------------------------------------------  */
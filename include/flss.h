@@ -77,6 +77,8 @@ extern const char *_idInf_;
 extern const char *_idIntgrtCQUAD_;
 extern const char *_idIntgrtVegas_;
 extern const char *_idIntgrtDivonne_;
+extern const char *_idIntgrtQMC_;
+extern const char *_idIntgrtCubature_;
 
 
 /**  Shape Identifiers  **/
@@ -12,6 +12,135 @@
 
 
 
+/* Number of points that are processed together by the batched integrands (see integrand_spec_pnl_p22_1loop_batch) */
+#define __INTGRND_BATCH_SIZE__ 64
+
+
+/*  ----------------------------------------------------  */
+/*  ----------------   Basis Structure   ---------------  */
+/*  ----------------------------------------------------  */
+
+
+typedef struct
+{
+    /*
+
+        Parameters for the integrands of the bias and RSD basis terms
+
+    */
+
+    /* Kern struct */
+    kern_t *kern;
+
+    /* Indices of the basis terms */
+    size_t index1;
+    size_t index2;
+
+} intgrnd_basis_t;
+
+
+/* Components of the vector valued integrand of the basis terms (see integrand_spec_pnl_basis_1loop_vec): the P22 pairs
+   (i, j) with i <= j, followed by the P13 terms */
+#define __INTGRND_BASIS_P22_SIZE__ (__KERN_Z2_BASIS_SIZE__ * (__KERN_Z2_BASIS_SIZE__ + 1) / 2)
+#define __INTGRND_BASIS_SIZE__ (__INTGRND_BASIS_P22_SIZE__ + __KERN_Z3_BASIS_SIZE__)
+
+
+typedef struct
+{
+    /*
+
+        Parameters for the vector valued integrand of the bias and RSD basis terms
+
+    */
+
+    /* Kern struct */
+    kern_t *kern;
+
+    /* Components to be computed */
+    bool comp[__INTGRND_BASIS_SIZE__];
+
+} intgrnd_basis_vec_t;
+
+
+
+/*  ----------------------------------------------------  */
+/*  -------------   Derivatives Structure   ------------  */
+/*  ----------------------------------------------------  */
+
+
+/* Components of the vector valued integrand of the power spectrum derivatives (see integrand_spec_dpnl_1loop_vec) */
+#define __INTGRND_DPNL_PNL__ 0
+
+#define __INTGRND_DPNL_A2GA__ 1
+#define __INTGRND_DPNL_D2GA__ 2
+
+#define __INTGRND_DPNL_A3GAA__ 3
+#define __INTGRND_DPNL_A3GAB__ 4
+#define __INTGRND_DPNL_D3GAA__ 5
+#define __INTGRND_DPNL_D3GAB__ 6
+
+#define __INTGRND_DPNL_B1__ 7
+#define __INTGRND_DPNL_B2__ 8
+#define __INTGRND_DPNL_C2GA__ 9
+#define __INTGRND_DPNL_BGAM3__ 10
+
+#define __INTGRND_DPNL_F__ 11
+
+#define __INTGRND_DPNL_K__ 12
+
+#define __INTGRND_DPNL_SIZE__ 13
+
+
+typedef struct
+{
+    /*
+
+        Parameters for the vector valued integrand of the power spectrum derivatives
+
+    */
+
+    /* Kern struct */
+    kern_t *kern;
+
+    /* Components to be computed */
+    bool comp[__INTGRND_DPNL_SIZE__];
+
+} intgrnd_dpnl_t;
+
+
+
+/*  ----------------------------------------------------  */
+/*  -------------   Radial P13 Structure   -------------  */
+/*  ----------------------------------------------------  */
+
+
+/* Number of Gauss-Legendre nodes per panel in nu, relative error and maximum depth of the bisection of the panels in nu,
+   and number of nodes in cos(phi) (see integrand_spec_p13_radial_1loop) */
+#define __INTGRND_RADIAL_NU_SIZE__ 8
+#define __INTGRND_RADIAL_NU_RELERR__ 1.e-6
+#define __INTGRND_RADIAL_NU_DEPTH__ 20
+#define __INTGRND_RADIAL_PHI_SIZE__ 4
+
+
+typedef struct
+{
+    /*
+
+        Parameters for the angular average of a P13-type integrand
+
+    */
+
+    /* Integrand in (q, nu, phi) and its parameters */
+    double (*integrand)(double*, size_t, void*);
+    void *params;
+
+    /* Gauss-Legendre nodes of a panel in nu (allocated once by the caller) */
+    const gsl_integration_glfixed_table *table;
+
+} intgrnd_radial_t;
+
+
+
 /*  ----------------------------------------------------  */
 /*  ----------   Non-Linear Power Spectrum   -----------  */
 /*  ----------------------------------------------------  */
@@ -34,12 +163,72 @@ double integrand_spec_pnl_p13_1loop(
     size_t dim,
     void *params);
 
+int integrand_spec_pnl_p22_1loop_batch(
+    double *var,
+    size_t dim,
+    size_t nVec,
+    void *params,
+    double *result);
+
+double integrand_spec_pnl_p22_sym_1loop(
+    double *var,
+    size_t dim,
+    void *params);
+
+int integrand_spec_pnl_p22_sym_1loop_batch(
+    double *var,
+    size_t dim,
+    size_t nVec,
+    void *params,
+    double *result);
+
+int integrand_spec_pnl_p13_1loop_batch(
+    double *var,
+    size_t dim,
+    size_t nVec,
+    void *params,
+    double *result);
+
+/*  ----------------------------------------------------  */
+
+double integrand_spec_pnl_p22_basis_1loop(
+    double *var,
+    size_t dim,
+    void *params);
+
+double integrand_spec_pnl_p13_basis_1loop(
+    double *var,
+    size_t dim,
+    void *params);
+
+int integrand_spec_pnl_basis_1loop_vec(
+    double *var,
+    size_t dim,
+    void *params,
+    double *result);
+
+/*  ----------------------------------------------------  */
+
+double integrand_spec_p13_radial_1loop(
+    double *var,
+    size_t dim,
+    void *params);
+
 
 /*  ----------------------------------------------------  */
 /*  ---   Power Spectrum _1loop(Analytical) Derivatives   ----  */
 /*  ----------------------------------------------------  */
 
 
+int integrand_spec_dpnl_1loop_vec(
+    double *var,
+    size_t dim,
+    void *params,
+    double *result);
+
+/*  ----------------------------------------------------  */
+
+
 double integrand_spec_dpnl_a2ga_1loop(
     double *var,
     size_t dim,
@@ -50,6 +50,25 @@ typedef struct
 } intgrt_vegas_t;
 
 
+typedef struct
+{
+    /*
+
+        Adapted grid of the vegas routine, which subsequent integrals over the same region can start from
+
+    */
+
+    gsl_monte_vegas_state *state; // Vegas state holding the grid (NULL if not yet allocated)
+
+    size_t dim; // Dimension of the region
+    double *lowerBounds; // Lower bounds of the region
+    double *upperBounds; // Upper bounds of the region
+
+    bool adapted; // Has the grid been adapted to an integrand
+
+} intgrt_vegas_grid_t;
+
+
 typedef struct
 {
     /*
@@ -89,6 +108,46 @@ typedef struct
 } intgrt_divonne_t;
 
 
+typedef struct
+{
+    /*
+
+        Parameters for the randomised quasi-Monte Carlo routine (digitally shifted Sobol points)
+
+    */
+
+    size_t points; // Initial number of points per scrambling (rounded up to a power of 2)
+    size_t maxPoints; // Maximum number of points per scrambling
+
+    size_t scramblings; // Number of independent scramblings (the error is estimated from their scatter)
+
+    double relErr; // Desired relative error (points are doubled until reached, no refinement if 0)
+
+    unsigned long seed; // Seed of the scramblings
+
+    int verbose; // Verbose level of output
+
+} intgrt_qmc_t;
+
+
+typedef struct
+{
+    /*
+
+        Parameters for the adaptive cubature routine (Genz-Malik rule, Gauss-Kronrod in one dimension)
+
+    */
+
+    double relErr; // Desired relative error
+    double absErr; // Desired absolute error
+
+    size_t maxEval; // (Approximate) Maximum number of integrand evaluations
+
+    int verbose; // Verbose level of output
+
+} intgrt_cubature_t;
+
+
 typedef struct
 {
     /*
@@ -105,12 +164,23 @@ typedef struct
     intgrt_cquad_t *cquad; // CQUAD struct
     intgrt_vegas_t *vegas; // Vegas struct
     intgrt_divonne_t *divonne; // Divonne struct
+    intgrt_qmc_t *qmc; // QMC struct
+    intgrt_cubature_t *cubature; // Cubature struct
+
+    intgrt_vegas_grid_t *vegasGrid; // Vegas grid to start from (not owned by intgrt, NULL for a fresh grid)
 
     const char *routine;
 
     double (*integrand)(double*, size_t, void*); // Integrand
     void *params; // Parameters of the integrand
 
+    int (*integrandVec)(double*, size_t, void*, double*); // Vector valued integrand
+    size_t nComp; // Number of components of the vector valued integrand
+
+    int (*integrandBatch)(double*, size_t, size_t, void*, double*); // Batched integrand (nVec points per call)
+
+    double *buffer; // Points and values of a block of the Divonne integrand (allocated once per integration)
+
 } intgrt_t;
 
 
@@ -126,6 +196,8 @@ typedef struct
 extern const char *_idIntgrtCQUAD_;
 extern const char *_idIntgrtVegas_;
 extern const char *_idIntgrtDivonne_;
+extern const char *_idIntgrtQMC_;
+extern const char *_idIntgrtCubature_;
 
 
 
@@ -223,6 +295,23 @@ int integrate_vegas_set_verbose(
 
 
 
+/*  ----------------------------------------------------  */
+/*  ----------------   Vegas Grid Struct   -------------  */
+/*  ----------------------------------------------------  */
+
+
+intgrt_vegas_grid_t *integrate_vegas_grid_new(void);
+
+intgrt_vegas_grid_t *integrate_vegas_grid_free(
+    intgrt_vegas_grid_t *grid);
+
+/*  ----------------------------------------------------  */
+
+int integrate_vegas_grid_reset(
+    intgrt_vegas_grid_t *grid);
+
+
+
 /*  ----------------------------------------------------  */
 /*  -----------------   Divonne Struct   ---------------  */
 /*  ----------------------------------------------------  */
@@ -313,6 +402,90 @@ int integrate_divonne_set_verbose(
 
 
 
+/*  ----------------------------------------------------  */
+/*  -------------------   QMC Struct   -----------------  */
+/*  ----------------------------------------------------  */
+
+
+intgrt_qmc_t *integrate_qmc_new(void);
+
+intgrt_qmc_t *integrate_qmc_free(
+    intgrt_qmc_t *qmc);
+
+/*  ----------------------------------------------------  */
+
+intgrt_qmc_t *integrate_qmc_cp(
+    intgrt_qmc_t *qmc);
+
+
+/*  ----------------------------------------------------  */
+/*  ----------------------------------------------------  */
+
+
+int integrate_qmc_set_points(
+    intgrt_qmc_t *qmc,
+    size_t points);
+
+int integrate_qmc_set_maxpoints(
+    intgrt_qmc_t *qmc,
+    size_t maxPoints);
+
+int integrate_qmc_set_scramblings(
+    intgrt_qmc_t *qmc,
+    size_t scramblings);
+
+int integrate_qmc_set_relerr(
+    intgrt_qmc_t *qmc,
+    double relErr);
+
+int integrate_qmc_set_seed(
+    intgrt_qmc_t *qmc,
+    unsigned long seed);
+
+int integrate_qmc_set_verbose(
+    intgrt_qmc_t *qmc,
+    int verbose);
+
+
+
+/*  ----------------------------------------------------  */
+/*  ----------------   Cubature Struct   ---------------  */
+/*  ----------------------------------------------------  */
+
+
+intgrt_cubature_t *integrate_cubature_new(void);
+
+intgrt_cubature_t *integrate_cubature_free(
+    intgrt_cubature_t *cubature);
+
+/*  ----------------------------------------------------  */
+
+intgrt_cubature_t *integrate_cubature_cp(
+    intgrt_cubature_t *cubature);
+
+
+/*  ----------------------------------------------------  */
+/*  ----------------------------------------------------  */
+
+
+int integrate_cubature_set_relerr(
+    intgrt_cubature_t *cubature,
+    double relErr);
+
+int integrate_cubature_set_abserr(
+    intgrt_cubature_t *cubature,
+    double absErr);
+
+int integrate_cubature_set_maxeval(
+    intgrt_cubature_t *cubature,
+    size_t maxEval);
+
+int integrate_cubature_set_verbose(
+    intgrt_cubature_t *cubature,
+    int verbose);
+
+
+
 /*  ----------------------------------------------------  */
 /*  ----------------   Integrate Struct   --------------  */
 /*  ----------------------------------------------------  */
@@ -365,6 +538,18 @@ int integrate_set_divonne(
     intgrt_t *intgrt,
     intgrt_divonne_t *divonne);
 
+int integrate_set_qmc(
+    intgrt_t *intgrt,
+    intgrt_qmc_t *qmc);
+
+int integrate_set_cubature(
+    intgrt_t *intgrt,
+    intgrt_cubature_t *cubature);
+
+int integrate_set_vegas_grid(
+    intgrt_t *intgrt,
+    intgrt_vegas_grid_t *grid);
+
 
 int integrate_set_routine(
     intgrt_t *intgrt,
@@ -375,6 +560,15 @@ int integrate_set_integrand(
     intgrt_t *intgrt,
     double (*integrand)(double*, size_t, void*));
 
+int integrate_set_integrand_vec(
+    intgrt_t *intgrt,
+    int (*integrandVec)(double*, size_t, void*, double*),
+    size_t nComp);
+
+int integrate_set_integrand_batch(
+    intgrt_t *intgrt,
+    int (*integrandBatch)(double*, size_t, size_t, void*, double*));
+
 int integrate_set_params(
     intgrt_t *intgrt,
     void *params);
@@ -393,6 +587,12 @@ intgrt_vegas_t *integrate_get_vegas(
 intgrt_divonne_t *integrate_get_divonne(
     intgrt_t *intgrt);
 
+intgrt_qmc_t *integrate_get_qmc(
+    intgrt_t *intgrt);
+
+intgrt_cubature_t *integrate_get_cubature(
+    intgrt_t *intgrt);
+
 
 
 
@@ -406,6 +606,21 @@ int integrate(
     intgrt_t *intgrt,
     double *result);
 
+int integrate_vec(
+    int integrandVec(double*, size_t, void*, double*),
+    size_t nComp,
+    intgrt_t *intgrt,
+    double *result);
+
+bool integrate_vec_sweep(
+    intgrt_t *intgrt);
+
+int integrate_batch(
+    double integrand(double*, size_t, void*),
+    int integrandBatch(double*, size_t, size_t, void*, double*),
+    intgrt_t *intgrt,
+    double *result);
+
 
 /*  ----------------------------------------------------  */
 /*  ----------------------------------------------------  */
@@ -418,6 +633,14 @@ int integrate_cquad(
 
 /*  ----------------------------------------------------  */
 
+int integrate_cquad_vec(
+    int integrandVec(double*, size_t, void*, double*),
+    size_t nComp,
+    intgrt_t *intgrt,
+    double *result);
+
+/*  ----------------------------------------------------  */
+
 double integrate_cquad_integrand(
     double x,
     void *params);
@@ -438,6 +661,14 @@ int integrate_vegas(
     intgrt_t *intgrt,
     double *result);
 
+/*  ----------------------------------------------------  */
+
+int integrate_vegas_vec(
+    int integrandVec(double*, size_t, void*, double*),
+    size_t nComp,
+    intgrt_t *intgrt,
+    double *result);
+
 
 /*  ----------------------------------------------------  */
 /*  ----------------------------------------------------  */
@@ -450,12 +681,65 @@ int integrate_divonne(
 
 /*  ----------------------------------------------------  */
 
+int integrate_divonne_vec(
+    int integrandVec(double*, size_t, void*, double*),
+    size_t nComp,
+    intgrt_t *intgrt,
+    double *result);
+
+/*  ----------------------------------------------------  */
+
 int integrate_divonne_integrand(
     const int *nDim,
     const cubareal xx[],
     const int *nComp,
     cubareal ff[],
-    void *usrData);
+    void *usrData,
+    const int *nVec);
+
+int integrate_divonne_integrand_vec(
+    const int *nDim,
+    const cubareal xx[],
+    const int *nComp,
+    cubareal ff[],
+    void *usrData,
+    const int *nVec);
+
+
+/*  ----------------------------------------------------  */
+/*  ----------------------------------------------------  */
+
+
+int integrate_qmc(
+    double integrand(double*, size_t, void*),
+    intgrt_t *intgrt,
+    double *result);
+
+/*  ----------------------------------------------------  */
+
+int integrate_qmc_vec(
+    int integrandVec(double*, size_t, void*, double*),
+    size_t nComp,
+    intgrt_t *intgrt,
+    double *result);
+
+
+/*  ----------------------------------------------------  */
+/*  ----------------------------------------------------  */
+
+
+int integrate_cubature(
+    double integrand(double*, size_t, void*),
+    intgrt_t *intgrt,
+    double *result);
+
+/*  ----------------------------------------------------  */
+
+int integrate_cubature_vec(
+    int integrandVec(double*, size_t, void*, double*),
+    size_t nComp,
+    intgrt_t *intgrt,
+    double *result);
 
 
 /*  ----------------------------------------------------  */
@@ -13,6 +13,11 @@
 #include "shape.h"
 
 
+/* Uniform grids (see interpolate_interp_init_uniform) have max(__INTERP_UNIFORM_FACTOR__ * size, __INTERP_UNIFORM_MIN_SIZE__) nodes */
+#define __INTERP_UNIFORM_FACTOR__ 2
+#define __INTERP_UNIFORM_MIN_SIZE__ 256
+
+
 /*  ----------------------------------------------------  */
 /*  -------------------   Structures   -----------------  */
 /*  ----------------------------------------------------  */
@@ -26,7 +31,7 @@ typedef struct
 
     */
 
-    /* Acceleration struct from GSL (not used with SPLINTER) */
+    /* Acceleration struct from GSL (not used with SPLINTER or the uniform grids) */
     void *acc;
 
     /* Interpolation (spline) function */
@@ -77,6 +82,20 @@ interp_t *interpolate_interp_init_gsl(
     dat_t *dat,
     double (*extrapolate)(void*, void*, void*, size_t*, size_t));
 
+
+interp_t *interpolate_interp_init_uniform(
+    dat_t *dat,
+    double (*extrapolate)(void*, void*, void*, size_t*, size_t));
+
+interp_t *interpolate_interp_init_uniform_log(
+    dat_t *dat,
+    double (*extrapolate)(void*, void*, void*, size_t*, size_t));
+
+
+interp_t *interpolate_interp_init_grid(
+    dat_t *dat,
+    double (*extrapolate)(void*, void*, void*, size_t*, size_t));
+
 /*  ----------------------------------------------------  */
 
 double interpolate_interp_eval(
@@ -102,6 +121,37 @@ double interpolate_interp_eval_deriv_gsl(
     interp_t *interp,
     void *params);
 
+
+double interpolate_interp_eval_uniform(
+    void *values,
+    interp_t *interp,
+    void *params);
+
+double interpolate_interp_eval_deriv_uniform(
+    void *values,
+    interp_t *interp,
+    void *params);
+
+int interpolate_interp_eval_uniform_n(
+    double *values,
+    size_t n,
+    interp_t *interp,
+    void *params,
+    double *result);
+
+int interpolate_interp_eval_deriv_uniform_n(
+    double *values,
+    size_t n,
+    interp_t *interp,
+    void *params,
+    double *result);
+
+
+double interpolate_interp_eval_grid(
+    void *values,
+    interp_t *interp,
+    void *params);
+
 /*  ----------------------------------------------------  */
 
 interp_t *interpolate_interp_free(
@@ -115,6 +165,12 @@ interp_t *interpolate_interp_free_splinter(
 interp_t *interpolate_interp_free_gsl(
     interp_t *interp);
 
+interp_t *interpolate_interp_free_uniform(
+    interp_t *interp);
+
+interp_t *interpolate_interp_free_grid(
+    interp_t *interp);
+
 
 
 /*  ----------------------------------------------------  */
@@ -8,6 +8,44 @@
 #include "fiducials.h"
 
 
+/* Number of bias and RSD monomials of the Z2 and Z3 kernels (see kernels_z2_basis and kernels_z3_basis) */
+#define __KERN_Z2_BASIS_SIZE__ 6
+#define __KERN_Z3_BASIS_SIZE__ 11
+
+/* Variants of the batch kernels specialised for the fiducial flags _fidInclBias_ and _fidInclRSD_ (see kernels_set_z) */
+#define __KERN_VARIANT_FULL__ 0
+#define __KERN_VARIANT_REAL__ 1
+#define __KERN_VARIANT_NOBIAS__ 2
+#define __KERN_VARIANT_MATTER__ 3
+
+/* X-macro over the variants: X(variant, inclBias, inclRSD) */
+#define __KERN_VARIANTS__(X) \
+    X(__KERN_VARIANT_FULL__, true, true) \
+    X(__KERN_VARIANT_REAL__, true, false) \
+    X(__KERN_VARIANT_NOBIAS__, false, true) \
+    X(__KERN_VARIANT_MATTER__, false, false)
+
+
+/* Parameters carried by the tangents of kern_dual_t (see kernels_z1_dual, kernels_z2_dual and kernels_z3_dual) */
+#define __KERN_DUAL_A2GA__ 0
+#define __KERN_DUAL_D2GA__ 1
+
+#define __KERN_DUAL_A3GAA__ 2
+#define __KERN_DUAL_A3GAB__ 3
+#define __KERN_DUAL_D3GAA__ 4
+#define __KERN_DUAL_D3GAB__ 5
+
+#define __KERN_DUAL_H__ 6
+
+#define __KERN_DUAL_B1__ 7
+#define __KERN_DUAL_B2__ 8
+#define __KERN_DUAL_C2GA__ 9
+#define __KERN_DUAL_BGAM3__ 10
+
+#define __KERN_DUAL_F__ 11
+
+#define __KERN_DUAL_SIZE__ 12
+
 
 /*  ----------------------------------------------------  */
 /*  ----------------   Kernel Structure   --------------  */
@@ -42,7 +80,7 @@ typedef struct
     /* Linear growth factor */
     double growth;
 
-    /* Fiducials */
+    /* Fiducials (shared with the snapshot from fid_snap_get, except for the bias) */
     fid_lcdm_t *lcdm;
 
     fid_btst_t *btst;
@@ -55,14 +93,41 @@ typedef struct
     fid_surv_t *surv;
 
 
+    /* Variant of the batch kernels (one of __KERN_VARIANT_...__ chosen from the fiducial values) */
+    int variant;
+
+
     /* Internal kern_t structs */
     void *kernWork;
     bool computeWork;
 
+    /* Vertices (bit i for the i'th k, mu) whose variables changed since the working kern_t structs were last updated */
+    unsigned long workDirty;
+
 } kern_t;
 
 
 
+/*  ----------------------------------------------------  */
+/*  ------------------   Dual Numbers   ----------------  */
+/*  ----------------------------------------------------  */
+
+
+typedef struct
+{
+    /*
+
+        Kernel value and its derivatives with respect to the parameters __KERN_DUAL_...__
+
+    */
+
+    double val;
+    double d[__KERN_DUAL_SIZE__];
+
+} kern_dual_t;
+
+
+
 /*  ----------------------------------------------------  */
 /*  ------------------   Kern Struct   -----------------  */
 /*  ----------------------------------------------------  */
@@ -303,6 +368,12 @@ double kernels_dsmooth_sigv(
 double kernels_z1(
     kern_t *kernVar);
 
+int kernels_z1_batch(
+    kern_t *kernVar,
+    size_t nVec,
+    double *mu1,
+    double *z1Kernels);
+
 /*  ----------------------------------------------------  */
 
 double kernels_dz1_mu(
@@ -322,6 +393,24 @@ double kernels_dz1_f(
 double kernels_z2(
     kern_t *kernVar);
 
+int kernels_z2_basis(
+    kern_t *kernVar,
+    double *z2Basis);
+
+int kernels_z2_basis_coeff(
+    kern_t *kernVar,
+    double *z2Coeff);
+
+int kernels_z2_batch(
+    kern_t *kernVar,
+    size_t nVec,
+    double *k1,
+    double *k2,
+    double *nu12,
+    double *mu1,
+    double *mu2,
+    double *z2Kernels);
+
 /*  ----------------------------------------------------  */
 
 double kernels_dz2_k(
@@ -363,6 +452,28 @@ double kernels_dz2_f(
 double kernels_z3(
     kern_t *kernVar);
 
+int kernels_z3_basis(
+    kern_t *kernVar,
+    double *z3Basis);
+
+int kernels_z3_basis_coeff(
+    kern_t *kernVar,
+    double *z3Coeff);
+
+int kernels_z3_batch(
+    kern_t *kernVar,
+    size_t nVec,
+    double *k1,
+    double *k2,
+    double *k3,
+    double *nu12,
+    double *nu13,
+    double *nu23,
+    double *mu1,
+    double *mu2,
+    double *mu3,
+    double *z3Kernels);
+
 /*  ----------------------------------------------------  */
 
 double kernels_dz3_k(
@@ -417,6 +528,25 @@ double kernels_dz3_f(
 
 
 
+/*  ----------------------------------------------------  */
+/*  -----------------   Dual Kernels   -----------------  */
+/*  ----------------------------------------------------  */
+
+
+int kernels_z1_dual(
+    kern_t *kernVar,
+    kern_dual_t *z1Dual);
+
+int kernels_z2_dual(
+    kern_t *kernVar,
+    kern_dual_t *z2Dual);
+
+int kernels_z3_dual(
+    kern_t *kernVar,
+    kern_dual_t *z3Dual);
+
+
+
 /*  ----------------------------------------------------  */
 /*  ----------------------------------------------------  */
 /*  ----------------------------------------------------  */
@@ -33,10 +33,22 @@ void dgetri_(int *N, double *A, int *LDA, int *IPIV, double *WORK, int *LWORK, i
 
 void dsytrf_(char *UPLO, int *N, double *A, int *LDA, int *IPIV, double *WORK, int *LWORK, int *INFO);
 void dsytri_(char *UPLO, int *N, double *A, int *LDA, int *IPIV, double *WORK, int *LWORK, int *INFO);
+void dsytrs_(char *UPLO, int *N, int *NRHS, double *A, int *LDA, int *IPIV, double *B, int *LDB, int *INFO);
+
+void dpotrf_(char *UPLO, int *N, double *A, int *LDA, int *INFO);
+void dpotrs_(char *UPLO, int *N, int *NRHS, double *A, int *LDA, double *B, int *LDB, int *INFO);
 
 void dsyev_(char *JOBZ, char *UPLO, int *N, double *A, int *LDA, double *W, double *WORK, int *LWORK, int *INFO);
 
 
+/*  ----------------------------------------------------  */
+/*  ------------------  BLAS Routines  -----------------  */
+/*  ----------------------------------------------------  */
+
+
+void dgemm_(char *TRANSA, char *TRANSB, int *M, int *N, int *K, double *ALPHA, double *A, int *LDA, double *B, int *LDB, double *BETA, double *C, int *LDC);
+
+
 
 
 /*  ----------------------------------------------------  */
@@ -213,6 +225,33 @@ typedef struct
 
 
 
+typedef struct
+{
+    /*
+
+        Factorisation of a covariance matrix C = S R S, where S = diag(sqrt(C_ii)) and R is the correlation matrix
+
+        R is stored as its Cholesky factor (R = U^T U), or as a pivoted UDU^T factorisation (ipiv != NULL) if R is
+        not numerically positive definite. For a diagonal C the factor is NULL (R = 1).
+
+    */
+
+    /* Dimension of C */
+    size_t dim;
+
+    /* Inverse standard deviations 1 / sqrt(C_ii) */
+    double *scale;
+
+    /* Factor of R (column-major, upper triangle) */
+    double *factor;
+
+    /* Pivots of the UDU^T factorisation */
+    int *ipiv;
+
+} mat_fact_t;
+
+
+
 
 /*  ----------------------------------------------------  */
 /*  ---------    Get the Matrix Type Struct   ----------  */
@@ -795,6 +834,21 @@ mat_t *mat_inv_cov(
     mat_reduce_t *reduce);
 
 
+/*  ----------------------------------------------------  */
+/*  ----------------------------------------------------  */
+
+
+mat_fact_t *mat_fact_cov(
+    mat_t *mat);
+
+mat_fact_t *mat_fact_free(
+    mat_fact_t *fact);
+
+mat_t *mat_fact_solve_ip(
+    mat_fact_t *fact,
+    mat_t *mat);
+
+
 
 /*  ----------------------------------------------------  */
 /*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
@@ -29,6 +29,26 @@ typedef struct
 
 
 
+/*  ----------------------------------------------------  */
+/*  -----------  Compensated Sum Structure  ------------  */
+/*  ----------------------------------------------------  */
+
+
+typedef struct
+{
+    /*
+
+        Running sum with its (Neumaier) compensation, initialise with {0., 0.}
+
+    */
+
+    double sum;
+    double comp;
+
+} misc_csum_t;
+
+
+
 /*  ----------------------------------------------------  */
 /*  ---------------   Extern Functions   ---------------  */
 /*  ----------------------------------------------------  */
@@ -242,6 +262,23 @@ size_t misc_multinom(
 
 
 
+/*  ----------------------------------------------------  */
+/*  -------------   Compensated Summation   ------------  */
+/*  ----------------------------------------------------  */
+
+int misc_csum_add(
+    misc_csum_t *csum,
+    double value);
+
+int misc_csum_merge(
+    misc_csum_t *csum1,
+    misc_csum_t *csum2);
+
+double misc_csum_get(
+    misc_csum_t *csum);
+
+
+
 /*  ----------------------------------------------------  */
 /*  ---------------------   Time   ---------------------  */
 /*  ----------------------------------------------------  */
@@ -119,6 +119,9 @@ typedef struct
 
     double binVolume;
 
+    /* Tree-level bispectrum kernels and their derivatives at the last configuration (see spec_dbtr_a2ga, ...) */
+    void *btrDual;
+
 } spec_arg_t;
 
 
@@ -267,6 +270,14 @@ int spec_info_set_loop_order(
     const char *id,
     size_t loopOrder);
 
+int spec_info_set_loop_sym_p22(
+    const char *id,
+    bool loopSymP22);
+
+int spec_info_set_loop_radial(
+    const char *id,
+    bool loopRadial);
+
 /*  ----------------------------------------------------  */
 
 size_t spec_info_get_order(
@@ -281,6 +292,16 @@ intgrt_t *spec_info_get_loop_integrate(
     size_t loopOrder);
 
 
+bool spec_info_get_loop_sym_p22(
+    const char *id);
+
+bool spec_info_get_loop_radial(
+    const char *id);
+
+intgrt_t *spec_info_get_loop_radial_integrate(
+    const char *id);
+
+
 size_t spec_info_get_kern_order(
     const char *id);
 
@@ -315,6 +336,30 @@ int spec_in_dpnl_setup(void);
 
 
 
+/*  ----------------------------------------------------  */
+/*  --------------   Tabulated Spectra   ---------------  */
+/*  ----------------------------------------------------  */
+
+
+int spec_table_pnl_set_k(
+    size_t size,
+    double kMin,
+    double kMax);
+
+int spec_table_pnl_set_mu(
+    size_t size);
+
+int spec_table_pnl_set_basis(
+    bool basis);
+
+/*  ----------------------------------------------------  */
+
+int spec_table_pnl_setup(void);
+
+int spec_table_pnl_free(void);
+
+
+
 /*  ----------------------------------------------------  */
 /*  ---------------   Spectra Structs   ----------------  */
 /*  ----------------------------------------------------  */
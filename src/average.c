@@ -31,6 +31,8 @@ static const size_t _avrLineVolIntgrtDim = 2;
 static const char *_avrLineVolIntgrtRoutine = "vegas";
 static const intgrt_vegas_t _avrLineVolIntgrtVegas = {1000, 100, 1., 10, 0.5, 0., 0};
 static const intgrt_divonne_t _avrLineVolIntgrtDivonne = {1, 1, 1.e-3, 1.e-12, 0, 0, 50000, 47, 1, 1, 5, 0., 10., 0.25, 0};
+static const intgrt_qmc_t _avrLineVolIntgrtQMC = {1024, 65536, 8, 1.e-3, 0, 0};
+static const intgrt_cubature_t _avrLineVolIntgrtCubature = {1.e-4, 0., 100000, 0};
 
 /* Triangle */
 static int (*_avrTriVolFunc)(spec_arg_t*, double*) = NULL;
@@ -43,6 +45,8 @@ static const size_t _avrTriVolIntgrtDim = 5;
 static const char *_avrTriVolIntgrtRoutine = "vegas";
 static const intgrt_vegas_t _avrTriVolIntgrtVegas = {10000, 1000, 1., 10, 0.5, 0., 0};
 static const intgrt_divonne_t _avrTriVolIntgrtDivonne = {1, 1, 1.e-3, 1.e-12, 0, 0, 50000, 47, 1, 1, 5, 0., 10., 0.25, 0};
+static const intgrt_qmc_t _avrTriVolIntgrtQMC = {1024, 65536, 8, 1.e-3, 0, 0};
+static const intgrt_cubature_t _avrTriVolIntgrtCubature = {1.e-4, 0., 100000, 0};
 
 
 /**  Shape Average  **/
@@ -53,9 +57,11 @@ static const size_t _avrLineOrder = 2;
 static intgrt_t *_avrLineIntgrt = NULL;
 
 static const size_t _avrLineIntgrtDim = 2;
-static const char *_avrLineIntgrtRoutine = "vegas";
+static const char *_avrLineIntgrtRoutine = "cubature";
 static const intgrt_vegas_t _avrLineIntgrtVegas = {1000, 100, 1., 10, 0.5, 0., 0};
 static const intgrt_divonne_t _avrLineIntgrtDivonne = {1, 1, 1.e-3, 1.e-12, 0, 0, 50000, 47, 1, 1, 5, 0., 10., 0.25, 0};
+static const intgrt_qmc_t _avrLineIntgrtQMC = {1024, 65536, 8, 1.e-3, 0, 0};
+static const intgrt_cubature_t _avrLineIntgrtCubature = {1.e-4, 0., 100000, 0};
 
 /* Triangle */
 static const size_t _avrTriOrder = 3;
@@ -66,6 +72,8 @@ static const size_t _avrTriIntgrtDim = 5;
 static const char *_avrTriIntgrtRoutine = "vegas";
 static const intgrt_vegas_t _avrTriIntgrtVegas = {10000, 1000, 1., 10, 0.5, 0., 0};
 static const intgrt_divonne_t _avrTriIntgrtDivonne = {1, 1, 1.e-3, 1.e-12, 0, 0, 50000, 47, 1, 1, 5, 0., 10., 0.25, 0};
+static const intgrt_qmc_t _avrTriIntgrtQMC = {1024, 65536, 8, 1.e-3, 0, 0};
+static const intgrt_cubature_t _avrTriIntgrtCubature = {1.e-4, 0., 100000, 0};
 
 
 /**  PP Covarianece Matrix Average  **/
@@ -74,9 +82,11 @@ static const intgrt_divonne_t _avrTriIntgrtDivonne = {1, 1, 1.e-3, 1.e-12, 0, 0,
 static intgrt_t *_avrCovPPGaussIntgrt = NULL;
 
 static const size_t _avrCovPPGaussIntgrtDim = 2;
-static const char *_avrCovPPGaussIntgrtRoutine = "vegas";
+static const char *_avrCovPPGaussIntgrtRoutine = "cubature";
 static const intgrt_vegas_t _avrCovPPGaussIntgrtVegas = {1000, 100, 1., 10, 0.5, 0., 0};
 static const intgrt_divonne_t _avrCovPPGaussIntgrtDivonne = {1, 1, 1.e-3, 1.e-12, 0, 0, 50000, 47, 1, 1, 5, 0., 10., 0.25, 0};
+static const intgrt_qmc_t _avrCovPPGaussIntgrtQMC = {1024, 65536, 8, 1.e-3, 0, 0};
+static const intgrt_cubature_t _avrCovPPGaussIntgrtCubature = {1.e-4, 0., 100000, 0};
 
 
 /* Non-Gaussian (Infinitesimal limit) */
@@ -94,6 +104,8 @@ static const size_t _avrCovPPNGaussIntgrtDim = 5;
 static const char *_avrCovPPNGaussIntgrtRoutine = "vegas";
 static const intgrt_vegas_t _avrCovPPNGaussIntgrtVegas = {1000, 100, 1., 10, 0.5, 0., 0};
 static const intgrt_divonne_t _avrCovPPNGaussIntgrtDivonne = {1, 1, 1.e-3, 1.e-12, 0, 0, 50000, 47, 1, 1, 5, 0., 10., 0.25, 0};
+static const intgrt_qmc_t _avrCovPPNGaussIntgrtQMC = {1024, 65536, 8, 1.e-3, 0, 0};
+static const intgrt_cubature_t _avrCovPPNGaussIntgrtCubature = {1.e-4, 0., 100000, 0};
 
 
 /**  BB Covarianece Matrix Average  **/
@@ -102,9 +114,11 @@ static const intgrt_divonne_t _avrCovPPNGaussIntgrtDivonne = {1, 1, 1.e-3, 1.e-1
 static intgrt_t *_avrCovBBGaussIntgrt = NULL;
 
 static const size_t _avrCovBBGaussIntgrtDim = 5;
-static const char *_avrCovBBGaussIntgrtRoutine = "vegas";
+static const char *_avrCovBBGaussIntgrtRoutine = "cubature";
 static const intgrt_vegas_t _avrCovBBGaussIntgrtVegas = {100000, 10000, 1., 10, 0.5, 0., 0};
 static const intgrt_divonne_t _avrCovBBGaussIntgrtDivonne = {1, 1, 1.e-3, 1.e-12, 0, 0, 50000, 47, 1, 1, 5, 0., 10., 0.25, 0};
+static const intgrt_qmc_t _avrCovBBGaussIntgrtQMC = {1024, 65536, 8, 1.e-3, 0, 0};
+static const intgrt_cubature_t _avrCovBBGaussIntgrtCubature = {1.e-4, 0., 100000, 0};
 
 /* Non-Gaussian */
 static intgrt_t *_avrCovBBNGaussIntgrt = NULL;
@@ -113,6 +127,8 @@ static const size_t _avrCovBBNGaussIntgrtDim = 8;
 static const char *_avrCovBBNGaussIntgrtRoutine = "vegas";
 static const intgrt_vegas_t _avrCovBBNGaussIntgrtVegas = {100000, 10000, 1., 10, 0.5, 0., 1};
 static const intgrt_divonne_t _avrCovBBNGaussIntgrtDivonne = {1, 1, 1.e-3, 1.e-12, 0, 0, 50000, 47, 1, 1, 5, 0., 10., 0.25, 0};
+static const intgrt_qmc_t _avrCovBBNGaussIntgrtQMC = {1024, 65536, 8, 1.e-3, 0, 0};
+static const intgrt_cubature_t _avrCovBBNGaussIntgrtCubature = {1.e-4, 0., 100000, 0};
 
 
 /**  PB Covarianece Matrix Average  **/
@@ -126,6 +142,8 @@ static const size_t _avrCovPBNGaussIntgrtDim = 5;
 static const char *_avrCovPBNGaussIntgrtRoutine = "vegas";
 static const intgrt_vegas_t _avrCovPBNGaussIntgrtVegas = {10000, 1000, 1., 10, 0.5, 0., 1};
 static const intgrt_divonne_t _avrCovPBNGaussIntgrtDivonne = {1, 1, 1.e-3, 1.e-12, 0, 0, 50000, 47, 1, 1, 5, 0., 10., 0.25, 0};
+static const intgrt_qmc_t _avrCovPBNGaussIntgrtQMC = {1024, 65536, 8, 1.e-3, 0, 0};
+static const intgrt_cubature_t _avrCovPBNGaussIntgrtCubature = {1.e-4, 0., 100000, 0};
 
 
 
@@ -285,6 +303,8 @@ int avr_ini(void)
 
     integrate_set_vegas(_avrLineVolIntgrt, (intgrt_vegas_t*) &_avrLineVolIntgrtVegas);
     integrate_set_divonne(_avrLineVolIntgrt, (intgrt_divonne_t*) &_avrLineVolIntgrtDivonne);
+    integrate_set_qmc(_avrLineVolIntgrt, (intgrt_qmc_t*) &_avrLineVolIntgrtQMC);
+    integrate_set_cubature(_avrLineVolIntgrt, (intgrt_cubature_t*) &_avrLineVolIntgrtCubature);
 
     /* Triangle */
     avr_set_shape_vol_func(_idAvrTriVol_, _idAvrTriVolFuncNum_);
@@ -297,6 +317,8 @@ int avr_ini(void)
 
     integrate_set_vegas(_avrTriVolIntgrt, (intgrt_vegas_t*) &_avrTriVolIntgrtVegas);
     integrate_set_divonne(_avrTriVolIntgrt, (intgrt_divonne_t*) &_avrTriVolIntgrtDivonne);
+    integrate_set_qmc(_avrTriVolIntgrt, (intgrt_qmc_t*) &_avrTriVolIntgrtQMC);
+    integrate_set_cubature(_avrTriVolIntgrt, (intgrt_cubature_t*) &_avrTriVolIntgrtCubature);
 
 
     /**  Shape Average  **/
@@ -310,6 +332,8 @@ int avr_ini(void)
 
     integrate_set_vegas(_avrLineIntgrt, (intgrt_vegas_t*) &_avrLineIntgrtVegas);
     integrate_set_divonne(_avrLineIntgrt, (intgrt_divonne_t*) &_avrLineIntgrtDivonne);
+    integrate_set_qmc(_avrLineIntgrt, (intgrt_qmc_t*) &_avrLineIntgrtQMC);
+    integrate_set_cubature(_avrLineIntgrt, (intgrt_cubature_t*) &_avrLineIntgrtCubature);
 
     /* Triangle */
     _avrTriIntgrt = integrate_new();
@@ -320,6 +344,8 @@ int avr_ini(void)
 
     integrate_set_vegas(_avrTriIntgrt, (intgrt_vegas_t*) &_avrTriIntgrtVegas);
     integrate_set_divonne(_avrTriIntgrt, (intgrt_divonne_t*) &_avrTriIntgrtDivonne);
+    integrate_set_qmc(_avrTriIntgrt, (intgrt_qmc_t*) &_avrTriIntgrtQMC);
+    integrate_set_cubature(_avrTriIntgrt, (intgrt_cubature_t*) &_avrTriIntgrtCubature);
 
 
     /**  PP Covariance Matrix Average  **/
@@ -333,6 +359,8 @@ int avr_ini(void)
 
     integrate_set_vegas(_avrCovPPGaussIntgrt, (intgrt_vegas_t*) &_avrCovPPGaussIntgrtVegas);
     integrate_set_divonne(_avrCovPPGaussIntgrt, (intgrt_divonne_t*) &_avrCovPPGaussIntgrtDivonne);
+    integrate_set_qmc(_avrCovPPGaussIntgrt, (intgrt_qmc_t*) &_avrCovPPGaussIntgrtQMC);
+    integrate_set_cubature(_avrCovPPGaussIntgrt, (intgrt_cubature_t*) &_avrCovPPGaussIntgrtCubature);
 
     /* Non-Gaussian (Infinitesimal limit) */
     _avrCovPPNGaussInfIntgrt = integrate_new();
@@ -353,6 +381,8 @@ int avr_ini(void)
 
     integrate_set_vegas(_avrCovPPNGaussIntgrt, (intgrt_vegas_t*) &_avrCovPPNGaussIntgrtVegas);
     integrate_set_divonne(_avrCovPPNGaussIntgrt, (intgrt_divonne_t*) &_avrCovPPNGaussIntgrtDivonne);
+    integrate_set_qmc(_avrCovPPNGaussIntgrt, (intgrt_qmc_t*) &_avrCovPPNGaussIntgrtQMC);
+    integrate_set_cubature(_avrCovPPNGaussIntgrt, (intgrt_cubature_t*) &_avrCovPPNGaussIntgrtCubature);
 
 
     /**  BB Covariance Matrix Average  **/
@@ -366,6 +396,8 @@ int avr_ini(void)
 
     integrate_set_vegas(_avrCovBBGaussIntgrt, (intgrt_vegas_t*) &_avrCovBBGaussIntgrtVegas);
     integrate_set_divonne(_avrCovBBGaussIntgrt, (intgrt_divonne_t*) &_avrCovBBGaussIntgrtDivonne);
+    integrate_set_qmc(_avrCovBBGaussIntgrt, (intgrt_qmc_t*) &_avrCovBBGaussIntgrtQMC);
+    integrate_set_cubature(_avrCovBBGaussIntgrt, (intgrt_cubature_t*) &_avrCovBBGaussIntgrtCubature);
 
     /* Non-Gaussian */
     _avrCovBBNGaussIntgrt = integrate_new();
@@ -376,6 +408,8 @@ int avr_ini(void)
 
     integrate_set_vegas(_avrCovBBNGaussIntgrt, (intgrt_vegas_t*) &_avrCovBBNGaussIntgrtVegas);
     integrate_set_divonne(_avrCovBBNGaussIntgrt, (intgrt_divonne_t*) &_avrCovBBNGaussIntgrtDivonne);
+    integrate_set_qmc(_avrCovBBNGaussIntgrt, (intgrt_qmc_t*) &_avrCovBBNGaussIntgrtQMC);
+    integrate_set_cubature(_avrCovBBNGaussIntgrt, (intgrt_cubature_t*) &_avrCovBBNGaussIntgrtCubature);
 
 
     /**  PB Covariance Matrix Average  **/
@@ -391,6 +425,8 @@ int avr_ini(void)
 
     integrate_set_vegas(_avrCovPBNGaussIntgrt, (intgrt_vegas_t*) &_avrCovPBNGaussIntgrtVegas);
     integrate_set_divonne(_avrCovPBNGaussIntgrt, (intgrt_divonne_t*) &_avrCovPBNGaussIntgrtDivonne);
+    integrate_set_qmc(_avrCovPBNGaussIntgrt, (intgrt_qmc_t*) &_avrCovPBNGaussIntgrtQMC);
+    integrate_set_cubature(_avrCovPBNGaussIntgrt, (intgrt_cubature_t*) &_avrCovPBNGaussIntgrtCubature);
 
 
     return 0;
@@ -183,6 +183,30 @@ static char *_fidLabelDPk = "dPk";
 static _fid_interp_single_t _fidInterpDPk;
 
 
+/* Growth */
+
+/* Number of redshifts at which the growth function is tabulated */
+#ifndef __FID_GROWTH_SIZE__
+#define __FID_GROWTH_SIZE__ 512
+#endif
+
+/* Number of Gauss-Legendre nodes for the integral in fid_growth_fct */
+#ifndef __FID_GROWTH_GL_SIZE__
+#define __FID_GROWTH_GL_SIZE__ 32
+#endif
+
+/* Interpolated growth function, set up on first use (see _setup_growth) */
+static interp_t *_fidInterpGrowth = NULL;
+static bool _fidGrowthSetup = false;
+
+
+/* Snapshots */
+
+/* Fiducial snapshots at the redshifts seen so far (see fid_snap_get) */
+static fid_snap_t **_fidSnap = NULL;
+static size_t _fidSnapSize = 0;
+
+
 
 /*  ------------------------------------------------------------------------------------------------------  */
 /*  -----------------------------------   Initialise Local Variables   -----------------------------------  */
@@ -375,25 +399,27 @@ static int _ini_interp(void)
       {
         _fidInterp -> fidInterpSingle[i] -> interp = NULL;
 
+        /* Power spectrum on a uniform grid in log(k) */
         if (!strcmp(_fidInterp -> labels[i], "Pk"))
           {
-            _fidInterp -> fidInterpSingle[i] -> interpInit = interpolate_interp_init_gsl;
-            _fidInterp -> fidInterpSingle[i] -> interpEval = interpolate_interp_eval_gsl;
-            _fidInterp -> fidInterpSingle[i] -> interpFree = interpolate_interp_free_gsl;
+            _fidInterp -> fidInterpSingle[i] -> interpInit = interpolate_interp_init_uniform_log;
+            _fidInterp -> fidInterpSingle[i] -> interpEval = interpolate_interp_eval_uniform;
+            _fidInterp -> fidInterpSingle[i] -> interpFree = interpolate_interp_free_uniform;
           }
 
         else if (!strcmp(_fidInterp -> labels[i], "dPk"))
           {
-            _fidInterp -> fidInterpSingle[i] -> interpInit = interpolate_interp_init_gsl;
-            _fidInterp -> fidInterpSingle[i] -> interpEval = interpolate_interp_eval_deriv_gsl;
-            _fidInterp -> fidInterpSingle[i] -> interpFree = interpolate_interp_free_gsl;
+            _fidInterp -> fidInterpSingle[i] -> interpInit = interpolate_interp_init_uniform_log;
+            _fidInterp -> fidInterpSingle[i] -> interpEval = interpolate_interp_eval_deriv_uniform;
+            _fidInterp -> fidInterpSingle[i] -> interpFree = interpolate_interp_free_uniform;
           }
 
+        /* Redshift dependent fiducials on a uniform grid in z */
         else
           {
-            _fidInterp -> fidInterpSingle[i] -> interpInit = interpolate_interp_init_splinter;
-            _fidInterp -> fidInterpSingle[i] -> interpEval = interpolate_interp_eval_splinter;
-            _fidInterp -> fidInterpSingle[i] -> interpFree = interpolate_interp_free_splinter;
+            _fidInterp -> fidInterpSingle[i] -> interpInit = interpolate_interp_init_uniform;
+            _fidInterp -> fidInterpSingle[i] -> interpEval = interpolate_interp_eval_uniform;
+            _fidInterp -> fidInterpSingle[i] -> interpFree = interpolate_interp_free_uniform;
           }
       }
 
@@ -477,6 +503,7 @@ static double _fid_surv_sn(void *var, void *params);
 /* Growth */
 
 static double _fid_growth(void *var, void *params);
+static double _fid_growth_extrapolate(void *var, void *interp, void *params, size_t *indices, size_t size);
 
 
 /* Linear Power Spectrum */
@@ -651,6 +678,7 @@ static int _ini_func(void)
 /*  ####################################   Function Declarations   #######################################  */
 
 static int _setup_interp(void);
+static int _setup_growth(void);
 
 /*  ######################################################################################################  */
 /*  ------------------------------------------------------------------------------------------------------  */
@@ -668,6 +696,9 @@ int fiducials_setup(void)
     /* Interpolate the fiducials */
     _setup_interp();
 
+    /* Snapshots and growth table of the previous fiducials */
+    fid_snap_clear();
+
     return 0;
 }
 
@@ -739,6 +770,58 @@ static int _setup_interp(void)
 }
 
 
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static int _setup_growth(void)
+{
+    /*
+
+        Tabulate the growth function D(z) (see fid_growth_fct) at __FID_GROWTH_SIZE__ redshifts spanning the redshift
+        range of the LCDM fiducials and interpolate it, so that _fid_growth only evaluates a spline. Redshifts outside of
+        this range fall back to fid_growth_fct.
+
+        The table is computed from _fidLCDM_ by _fid_growth on first use and freed by fid_snap_clear, i.e. it follows
+        the same life cycle as the snapshots.
+
+    */
+
+    _fidInterpGrowth = interpolate_interp_free_uniform(_fidInterpGrowth);
+
+    /* Fiducials not set up */
+    if (_fidInterpOmegaM0.interp == NULL || _fidInterpGrowthIndex.interp == NULL)
+        return 0;
+
+    /* Redshift range of the LCDM fiducials */
+    double zMin = fmax(_fidInterpOmegaM0.interp -> xBounds[0][0], _fidInterpGrowthIndex.interp -> xBounds[0][0]);
+    double zMax = fmin(_fidInterpOmegaM0.interp -> xBounds[0][1], _fidInterpGrowthIndex.interp -> xBounds[0][1]);
+
+    if (zMax <= zMin)
+        return 0;
+
+    /* Growth function at the redshifts */
+    dat_t *data = dat_new(1, 1, __FID_GROWTH_SIZE__);
+
+    for (size_t i = 0; i < __FID_GROWTH_SIZE__; i++)
+      {
+        double z = zMin + (zMax - zMin) * (double) i / (double) (__FID_GROWTH_SIZE__ - 1);
+
+        fid_lcdm_t *lcdm = _fidLCDM_(&z, _fidParamsLCDM_);
+
+        dat_set_xvalue(data, 0, i, z);
+        dat_set_yvalue(data, 0, i, fid_growth_fct(z, lcdm));
+
+        lcdm = fid_lcdm_free(lcdm);
+      }
+
+    _fidInterpGrowth = interpolate_interp_init_uniform(data, _fid_growth_extrapolate);
+
+    data = dat_free(data);
+
+    return 0;
+}
+
+
 
 /*  ------------------------------------------------------------------------------------------------------  */
 /*  --------------------------------------   Set Local Variables   ---------------------------------------  */
@@ -808,6 +891,9 @@ int fiducials_free(void)
     /* Free interpolation structs */
     _free_interp();
 
+    /* Free the snapshots and the tabulated growth function */
+    fid_snap_clear();
+
     return 0;
 }
 
@@ -1830,11 +1916,54 @@ static double _fid_growth(void *var, void *params)
 {
     /*
 
-        Calculate the growth fiducial via exp(-int f(z) / (1 + z)).
+        Calculate the growth fiducial from the table (set up on the first call, see _setup_growth), or via
+        exp(-int f(z) / (1 + z)) if there is none.
+
+    */
+
+    (void) params;
+
+    interp_t *interpGrowth = NULL;
+
+    #pragma omp critical (_fid_growth_)
+      {
+        if (!_fidGrowthSetup)
+          {
+            _setup_growth();
+            _fidGrowthSetup = true;
+          }
+
+        interpGrowth = _fidInterpGrowth;
+      }
+
+    /* Tabulated growth function (extrapolated with _fid_growth_extrapolate) */
+    if (interpGrowth != NULL)
+        return interpolate_interp_eval_uniform(var, interpGrowth, NULL);
+
+    /* Need LCDM */
+    fid_lcdm_t *lcdm = _fidLCDM_(var, _fidParamsLCDM_);
+
+    double growth = fid_growth_fct(*((double*) var), lcdm);
+
+    /* Free memory */
+    lcdm = fid_lcdm_free(lcdm);
+
+    return growth;
+}
+
+
+static double _fid_growth_extrapolate(void *var, void *interp, void *params, size_t *indices, size_t size)
+{
+    /*
+
+        Growth fiducial outside of the tabulated redshift range (computed directly)
 
     */
 
+    (void) interp;
     (void) params;
+    (void) indices;
+    (void) size;
 
     /* Need LCDM */
     fid_lcdm_t *lcdm = _fidLCDM_(var, _fidParamsLCDM_);
@@ -1878,6 +2007,43 @@ static double _fid_dpk(void *var, void *params)
 }
 
 
+int fid_pk_eval_n(const double *k, double *out, size_t n)
+{
+    /*
+
+        Evaluate the linear power spectrum fiducial at the n wavenumbers k. The default fiducial is evaluated in one pass
+        over its uniform grid (see interpolate_interp_eval_uniform_n), while a user-defined _fidPk_ is called pointwise.
+
+    */
+
+    if (_fidPk_ == _fid_pk && _fidInterpPk.interpEval == interpolate_interp_eval_uniform)
+        return interpolate_interp_eval_uniform_n((double*) k, n, _fidInterpPk.interp, _fidParamsPk_, out);
+
+    for (size_t i = 0; i < n; i++)
+        out[i] = _fidPk_((double*) &k[i], _fidParamsPk_);
+
+    return 0;
+}
+
+
+int fid_dpk_eval_n(const double *k, double *out, size_t n)
+{
+    /*
+
+        Evaluate the derivative of the linear power spectrum fiducial at the n wavenumbers k (see fid_pk_eval_n).
+
+    */
+
+    if (_fidDPk_ == _fid_dpk && _fidInterpDPk.interpEval == interpolate_interp_eval_deriv_uniform)
+        return interpolate_interp_eval_deriv_uniform_n((double*) k, n, _fidInterpDPk.interp, _fidParamsDPk_, out);
+
+    for (size_t i = 0; i < n; i++)
+        out[i] = _fidDPk_((double*) &k[i], _fidParamsDPk_);
+
+    return 0;
+}
+
+
 /*  ------------------------------------------------------------------------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
@@ -1960,6 +2126,113 @@ static double _fid_dpk_extrapolate(void *var, void *interp, void *params, size_t
 
 
 
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%     FIDUCIAL SNAPSHOTS     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+
+const fid_snap_t *fid_snap_get(double z)
+{
+    /*
+
+        Get the snapshot of the fiducials at redshift z. It is computed from the fiducial functions (_fidLCDM_, ...,
+        _fidGrowth_) the first time z is requested with the current flags _fidInclBias_ and _fidInclRSD_, and is then
+        shared by all callers, so it must not be modified. Toggling the flags yields a new snapshot (the old one stays
+        valid for the kern_t structs that still point to it).
+
+        The snapshots are only cleared by fid_snap_clear (also called by fiducials_setup and fiducials_free), which
+        must be called if any of the fiducial functions are changed afterwards.
+
+    */
+
+    fid_snap_t *snap = NULL;
+
+    #pragma omp critical (_fid_snap_)
+      {
+        /* Snapshot already exists */
+        for (size_t i = 0; i < _fidSnapSize; i++)
+          {
+            if (fabs(_fidSnap[i] -> z - z) < __ABSTOL__ && _fidSnap[i] -> inclBias == _fidInclBias_ && _fidSnap[i] -> inclRSD == _fidInclRSD_)
+              {
+                snap = _fidSnap[i];
+                break;
+              }
+          }
+
+        /* New snapshot */
+        if (snap == NULL)
+          {
+            snap = malloc(sizeof(fid_snap_t));
+
+            snap -> z = z;
+
+            snap -> inclBias = _fidInclBias_;
+            snap -> inclRSD = _fidInclRSD_;
+
+            snap -> growth = _fidGrowth_(&z, _fidParamsGrowth_);
+
+            snap -> lcdm = _fidLCDM_(&z, _fidParamsLCDM_);
+            snap -> btst = _fidBTST_(&z, _fidParamsBTST_);
+            snap -> bias = _fidBias_(&z, _fidParamsBias_);
+            snap -> rsd = _fidRSD_(&z, _fidParamsRSD_);
+            snap -> ctr = _fidCtr_(&z, _fidParamsCtr_);
+            snap -> surv = _fidSurv_(&z, _fidParamsSurv_);
+
+            /* Vanishing bias and RSD terms (from the values, which may be set independently of the flags) */
+            snap -> noBias = snap -> bias -> b1 == 1. && snap -> bias -> b2 == 0. && snap -> bias -> bG2 == 0. && snap -> bias -> bGam3 == 0. &&
+                             snap -> bias -> c2Ga == snap -> btst -> a2Ga;
+            snap -> noRSD = snap -> rsd -> f == 0.;
+
+            _fidSnap = realloc(_fidSnap, sizeof(fid_snap_t*) * (_fidSnapSize + 1));
+            _fidSnap[_fidSnapSize++] = snap;
+          }
+      }
+
+    return snap;
+}
+
+
+int fid_snap_clear(void)
+{
+    /*
+
+        Free all fiducial snapshots (no kern_t struct may still point to them) and the tabulated growth function, which
+        is recomputed on its next use
+
+    */
+
+    #pragma omp critical (_fid_growth_)
+      {
+        _fidInterpGrowth = interpolate_interp_free_uniform(_fidInterpGrowth);
+        _fidGrowthSetup = false;
+      }
+
+    for (size_t i = 0; i < _fidSnapSize; i++)
+      {
+        _fidSnap[i] -> lcdm = fid_lcdm_free(_fidSnap[i] -> lcdm);
+        _fidSnap[i] -> btst = fid_btst_free(_fidSnap[i] -> btst);
+        _fidSnap[i] -> bias = fid_bias_free(_fidSnap[i] -> bias);
+        _fidSnap[i] -> rsd = fid_rsd_free(_fidSnap[i] -> rsd);
+        _fidSnap[i] -> ctr = fid_ctr_free(_fidSnap[i] -> ctr);
+        _fidSnap[i] -> surv = fid_surv_free(_fidSnap[i] -> surv);
+
+        free(_fidSnap[i]);
+      }
+
+    free(_fidSnap);
+
+    _fidSnap = NULL;
+    _fidSnapSize = 0;
+
+    return 0;
+}
+
+
+
+
 /*  ------------------------------------------------------------------------------------------------------  */
 /*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
 /*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%     COSMOLOGY     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
@@ -2014,7 +2287,7 @@ double fid_growth_rate(double z, fid_lcdm_t *lcdm)
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-static double _fid_growth_fct_integrand(double *var, size_t dim, void *params)
+static double _fid_growth_fct_integrand(double z, void *params)
 {
     /*
 
@@ -2026,12 +2299,6 @@ static double _fid_growth_fct_integrand(double *var, size_t dim, void *params)
 
     */
 
-    /* Not used */
-    (void) (dim);
-
-    /* Redshift is integration variable */
-    double z = var[0];
-
     /* LCDM parameters */
     fid_lcdm_t *lcdm = (fid_lcdm_t*) params;
 
@@ -2047,33 +2314,21 @@ double fid_growth_fct(double z, fid_lcdm_t *lcdm)
 
             D1(z) = exp(- integral(f(z') / (1 + z'), z', 0, z)).
 
-    */
+        The integrand is smooth, so __FID_GROWTH_GL_SIZE__ Gauss-Legendre nodes give it to machine precision.
 
-    intgrt_vegas_t *vegas = integrate_vegas_new();
-
-    integrate_vegas_set_wucalls(vegas, 100);
-    integrate_vegas_set_mcalls(vegas, 1000);
-    integrate_vegas_set_chisqerr(vegas, 0.5);
-    integrate_vegas_set_mloop(vegas, 10);
-    integrate_vegas_set_verbose(vegas, 0);
-
-    intgrt_t *intgrt = integrate_new();
-
-    double lowerBound = 0.;
-    double upperBound = z;
+    */
 
-    integrate_set_bounds(intgrt, 1, &upperBound, &lowerBound);
-    integrate_set_params(intgrt, lcdm);
-    integrate_set_vegas(intgrt, vegas);
+    gsl_function integrand;
+    integrand.function = &_fid_growth_fct_integrand;
+    integrand.params = lcdm;
 
-    double growthResult[3];
+    gsl_integration_glfixed_table *table = gsl_integration_glfixed_table_alloc(__FID_GROWTH_GL_SIZE__);
 
-    integrate_vegas(_fid_growth_fct_integrand, intgrt, growthResult);
+    double growthResult = gsl_integration_glfixed(&integrand, 0., z, table);
 
-    intgrt = integrate_free(intgrt);
-    vegas = integrate_vegas_free(vegas);
+    gsl_integration_glfixed_table_free(table);
 
-    return exp(-growthResult[0]);
+    return exp(-growthResult);
 }
 
 
@@ -1588,54 +1588,75 @@ static mat_t *_fish_setup_mat(fish_mat_t *fishMat)
 
 
 /*  ------------------------------------------------------------------------------------------------------  */
-/*  ------------------------------------   Fisher Matrix Function   --------------------------------------  */
+/*  -------------------------------------   Derivative Matrices   ----------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-mats_t *fish_mat_poly(fish_mat_t *fishMat)
+typedef struct
 {
     /*
 
-        Calculate the fisher matrix
+        Block of derivatives of the i'th spectrum w.r.t. the f'th parameter (r'th derivative value of the n'th
+        partial parameter) at the t'th redshift, one task per shape starting at the flat task index offset
 
     */
 
+    size_t n;
+    size_t r;
+    size_t f;
+    size_t t;
+    size_t i;
 
-    /* Exit if nothing should be calculated */
+    size_t offset;
+    size_t size;
 
-    /* fishMat itself is NULL */
-    if (fishMat == NULL)
-      {
-        return NULL;
-      }
+} _fish_deriv_block_t;
 
-    /* Outsize is 0 */
-    if (fishMat -> out -> size == 0)
-      {
-        return NULL;
-      }
 
-    /* fishMat is faulty */
-    if (!_fish_mat_test(fishMat))
+static size_t _fish_deriv_block_find(_fish_deriv_block_t *blocks, size_t blocksSize, size_t task)
+{
+    /*
+
+        Find the block containing the flat task index task (blocks are ordered by offset)
+
+    */
+
+    size_t lo = 0;
+    size_t hi = blocksSize;
+
+    while (hi - lo > 1)
       {
-        return NULL;
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (blocks[mid].offset <= task)
+            lo = mid;
+
+        else
+            hi = mid;
       }
 
+    return lo;
+}
 
-    // TODO: Clean this mess up...
 
-    /* Get parameters from fishMat */
+/*  ------------------------------------------------------------------------------------------------------  */
 
-    /* Info on spectrum */
-    _fish_info_t *info = _fish_info_get_struct(fishMat -> id);
 
-    /* Kern order */
-    size_t kernOrder = fish_info_get_kern_order(info -> id);
+static int _fish_mat_deriv(_fish_info_t *info, size_t kernOrder, size_t fishDim, dat_t **datDeriv, print_t *print)
+{
+    /*
 
-    /* Get the output matrix struct */
-    mats_t *mats = mats_new(1);
-    mat_t *mat = _fish_setup_mat(fishMat);
-    mats_set_mat(mats, 0, mat);
+        Calculate the (shape averaged) derivatives of all spectra w.r.t. all parameters of the Fisher matrix, where
+        datDeriv[i] holds the derivative of the i'th spectrum w.r.t. the f'th parameter at the s'th shape and t'th
+        redshift as yvalue (f, t * size + s).
+
+        Every contributing (parameter, redshift, spectrum, shape) derivative is a single task of a flat task space,
+        which is distributed with dynamic scheduling, such that each derivative is calculated exactly once.
+
+        Derivatives of partial parameters that do not contribute (redshift or scale not in the sample) are not
+        calculated and must be initialised to zero.
+
+    */
 
     /* Variables */
     sample_raw_t *sampleRawZ = flss_get_sample_redshift();
@@ -1644,382 +1665,676 @@ mats_t *fish_mat_poly(fish_mat_t *fishMat)
     sample_arg_t *sampleArgK = ((sample_raw_t*) flss_get_sample_shape(info -> specLabels[0]) -> sampleRawLength) -> sampleArg;
     sample_arg_t *sampleArgMu = ((sample_raw_t*) flss_get_sample_shape(info -> specLabels[0]) -> sampleRawOrientation) -> sampleArg;
 
-    /* Shared variables */
-    __float128 valFish;
 
-    /* Covariance matrix */
-    size_t covDimT[2] = {sampleArgZ -> size, sampleArgZ -> size};
-    mat_t *covInv = mat_new("d", covDimT, _true_);
+    /* Enumerate the contributing blocks of derivatives */
 
-    mat_reduce_t red = {1.e-14}; // TODO: Improve this...
+    _fish_deriv_block_t *blocks = malloc(sizeof(_fish_deriv_block_t) * fishDim * sampleArgZ -> size * info -> specSize);
 
-    for (size_t locT[2] = {0, 0}; locT[0] < sampleArgZ -> size; locT[1] = ++locT[0])
+    size_t blocksSize = 0;
+    size_t tasksSize = 0;
+
+    spec_deriv_t *derivBlock = spec_deriv_new();
+
+    for (size_t n = 0, f = 0; n < info -> partsSize; n++)
       {
-        /* Put the single covariance matrices into blocks at each redshift */
-        size_t covDimTBlock[2] = {info -> specSize, info -> specSize};
-        mat_t *covBlock = mat_new("s", covDimTBlock, _true_);
+        /* Skip if the element does not exist */
+        if (!*(info -> partsExist[n]))
+            continue;
 
-        for (size_t loc[2] = {0, 0}, index = 0; loc[0] < info -> specSize; loc[0] = (loc[1] < info -> specSize - 1) ? loc[0] : loc[0] + 1, loc[1] = (loc[1] < info -> specSize - 1) ? loc[1] + 1 : loc[0], index++)
+        for (size_t r = 0; r < info -> partsDerivVals[n] -> size; r++, f++)
           {
-            cov_mat_t *covMat = cov_mat_new(info -> covLabels[index]);
-            cov_out_add_label(cov_mat_get_out(covMat), cov_in_get_label(info -> covLabels[index]));
+            /* Set the derivative variables */
+            for (size_t i = 0; i < info -> partsDerivVals[n] -> xDim; i++)
+              {
+                spec_deriv_set_var(derivBlock, dat_get_label(info -> partsDerivVals[n], i, 'x'), dat_get_value(info -> partsDerivVals[n], i, r, 'x'));
+              }
 
-            /* Get the block */
-            mat_t *covBlockSub = mat_get_block(_covPolyMat_(info -> covLabels[index])(covMat, NULL), locT);
+            for (size_t t = 0; t < sampleArgZ -> size; t++)
+              {
+                /* Skip partial multiplicities with unequal redshifts */
+                if (info -> partsMult[n][0] == -1 && derivBlock -> z != sampleRawZ -> array[t])
+                    continue;
 
-            /* Set the block */
-            mat_fset_block(covBlock, loc, covBlockSub);
+                for (size_t i = 0; i < info -> specSize; i++)
+                  {
+                    /* Variables */
+                    sample_shape_t *sampleShape = flss_get_sample_shape(info -> specLabels[i]);
 
-            /* Free memory */
-            covMat = cov_mat_free(covMat);
+                    sample_raw_t *sampleRawKi = sampleShape -> sampleRawLength;
+                    sample_arg_t *sampleArgKi = sampleRawKi -> sampleArg;
+
+                    /* Skip if deriv -> k is not included in the sample */
+                    if (info -> partsMult[n][1] == 1 && !misc_bsearch(sampleRawKi -> array, sampleArgKi -> size, derivBlock -> k, __ABSTOL__, NULL))
+                        continue;
+
+                    /* Skip empty samples */
+                    if (sampleShape -> size == 0)
+                        continue;
+
+                    _fish_deriv_block_t block = {n, r, f, t, i, tasksSize, sampleShape -> size};
+                    blocks[blocksSize++] = block;
+
+                    tasksSize += sampleShape -> size;
+                  }
+              }
           }
+      }
 
-        /* Reduce the matrix */
-        covBlock = mat_reduce(covBlock, &red);
+    derivBlock = spec_deriv_free(derivBlock);
 
-        /* Get the inverse of the covariance matrix */
-        mat_t *covBlockInv = mat_inv_cov(mat_inv_lapack, covBlock, NULL);
 
-        /* Set the block */
-        mat_fset_block(covInv, locT, covBlockInv);
+    /* Parallel threading */
+
+    #pragma omp parallel
+
+      { // Start pragma parallel
+
+        /* Declare and define variables */
+
+        /* Spec args struct */
+        spec_arg_t *specArg = spec_arg_new(NULL);
+
+        spec_arg_set_dz(specArg, sampleArgZ -> step);
+        spec_arg_set_dk(specArg, sampleArgK -> step);
+        spec_arg_set_dmu(specArg, sampleArgMu -> step);
+
+        /* Kern struct */
+        kern_t *kern = kernels_new_order(info -> specOrders[info -> specSize - 1], kernOrder);
+
+        spec_arg_set_kern(specArg, kern);
+
+        /* Deriv struct */
+        spec_deriv_t *deriv = spec_deriv_new();
+
+        spec_arg_set_deriv(specArg, deriv);
+
+        /* Block the structs of this thread are set up for */
+        size_t bSet = blocksSize;
+
+
+        /* Calculate the derivatives */
+
+        #pragma omp for schedule(dynamic)
+
+        for (size_t task = 0; task < tasksSize; task++)
+
+          { // Start task for
+
+            /* Block and shape of the task */
+            size_t b = _fish_deriv_block_find(blocks, blocksSize, task);
+            _fish_deriv_block_t *block = &blocks[b];
+
+            size_t s = task - block -> offset;
+
+            /* Set the derivative variables and the redshift, if the block has changed */
+            if (b != bSet)
+              {
+                spec_deriv_set_log(deriv, *(info -> partsDerivLog[block -> n]));
+
+                for (size_t i = 0; i < info -> partsDerivVals[block -> n] -> xDim; i++)
+                  {
+                    spec_deriv_set_var(deriv, dat_get_label(info -> partsDerivVals[block -> n], i, 'x'), dat_get_value(info -> partsDerivVals[block -> n], i, block -> r, 'x'));
+                  }
+
+                kernels_set_z(kern, sampleRawZ -> array[block -> t]);
+
+                bSet = b;
+              }
+
+            /* Variables */
+            sample_shape_t *sampleShape = flss_get_sample_shape(info -> specLabels[block -> i]);
+
+            /* Spectral derivative function */
+            double (*dSpecFunc)(void*, void*) = _specPoly_(info -> specLabels[block -> i], info -> partsLabels[block -> n]);
+
+            /* Average flag */
+            bool avrFlag = flss_get_avr_shape_flag(info -> specLabels[block -> i]);
+
+            /* Average function */
+            int (*avrFunc)(double (*)(void*, void*), spec_arg_t *, double*) = (avrFlag) ? avr_shape_get_func(info -> specOrders[block -> i]) : avr_shape_inf;
+
+            /* Shape of the spectrum */
+            shape_t *shape = sampleShape -> arrayShape[s];
+
+            /* Set variables for the shape */
+            for (size_t j = 0; j < shape -> dim; j++)
+              {
+                kernels_qset_k(kern, j, shape -> length[j]);
+                kernels_qset_mu(kern, j, shape -> orientation[j]);
+
+                for (size_t l = j + 1; l < shape -> dim; l++)
+                    kernels_qset_nu(kern, j, l, shape -> angle[shape_get_vertex_angle_index(shape -> dim, j, l)]);
+              }
+
+            /* Spectra derivative */
+            dat_set_yvalue(datDeriv[block -> i], block -> f, block -> t * sampleShape -> size + s, avr_shape_direct(avrFunc, dSpecFunc, specArg));
+
+            /* Update the progress (with the last task of a block) */
+            if (s == block -> size - 1)
+              {
+                #pragma omp critical
+                  {
+                    print_update_progress(print, (double) block -> size / (double) tasksSize);
+                    print_fish(print);
+                  }
+              }
+
+          } // End task for
+
 
         /* Free memory */
-        covBlock = mat_free(covBlock);
-      }
 
-    /* Sizes */
-    size_t sizes[5] = {sampleArgZ -> size, sampleArgK -> size, sampleArgMu -> size, mat -> dim[0], mat -> dim[0] * (mat -> dim[1] + 1) / 2};
+        specArg = spec_arg_free(specArg);
 
-    /* Print struct */
-    print_t *print = print_new();
 
-    print_set_id(print, fishMat -> id);
-    print_set_flags(print, fishMat -> flags);
+      } // End pragma parallel
 
-    print_set_sizes(print, sizes);
+    /* Free memory */
+    free(blocks);
 
-    /* Store derivatives */
-    dat_t **datDeriv = malloc(sizeof(dat_t*) * info -> specSize);
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static mat_t *_fish_mat_deriv_block(_fish_info_t *info, dat_t **datDeriv, size_t t, size_t fishDim)
+{
+    /*
+
+        Derivative matrix D at the t'th redshift with one row per element of the covariance matrix (i.e. spectra
+        stacked in order, shapes without parity invariance repeated) and one column per parameter of the Fisher matrix
+
+    */
+
+    /* Dimensions */
+    size_t dim[2] = {0, fishDim};
 
     for (size_t i = 0; i < info -> specSize; i++)
+        dim[0] += flss_get_sample_shape(info -> specLabels[i]) -> sizeFull;
+
+    mat_t *matDerivT = mat_new("f", dim, false);
+    double *matrix = matDerivT -> matrix;
+
+    for (size_t i = 0, offset = 0; i < info -> specSize; i++)
       {
         sample_shape_t *sampleShape = flss_get_sample_shape(info -> specLabels[i]);
 
-        datDeriv[i] = dat_new(0, mat -> dim[0], sampleArgZ -> size * sampleShape -> size);
-
-        for (size_t n = 0; n < datDeriv[i] -> size; n++)
+        for (size_t s = 0; s < sampleShape -> size; s++)
           {
-            for (size_t m = 0; m < datDeriv[i] -> yDim; m++)
-                dat_set_yvalue(datDeriv[i], m, n, NAN);
+            for (size_t p = 0; p < 1 + (size_t) (!sampleShape -> arrayShape[s] -> parity); p++)
+              {
+                /* (Spatial) Row in the covariance matrix */
+                size_t row = offset + ((s < sampleShape -> sizeParity) ? s : sampleShape -> sizeParity + 2 * (s - sampleShape -> sizeParity) + p);
+
+                for (size_t f = 0; f < fishDim; f++)
+                    matrix[row * fishDim + f] = dat_get_yvalue(datDeriv[i], f, t * sampleShape -> size + s);
+              }
           }
+
+        offset += sampleShape -> sizeFull;
       }
 
+    return matDerivT;
+}
 
-    /* Parallel threading */
 
-    #pragma omp parallel shared(valFish)
 
-      { // Start pragma parallel
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  --------------------------------------   Fisher Contraction   ----------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
 
-        /* Declare and define variables */
 
-        /* Spec args struct */
-        spec_arg_t *specArg1 = spec_arg_new(NULL);
-        spec_arg_t *specArg2 = spec_arg_new(NULL);
+static int _fish_mat_contract(mat_fact_t *covFactT, mat_t *matDerivT, double *valFishT)
+{
+    /*
 
-        spec_arg_set_dz(specArg1, sampleArgZ -> step);
-        spec_arg_set_dz(specArg2, sampleArgZ -> step);
+        Contraction D^T C^-1 D of the derivative matrix D (matDerivT, see _fish_mat_deriv_block) with the covariance
+        matrix C (factorised, covFactT) at a single redshift, written to valFishT (full, row-major).
 
-        spec_arg_set_dk(specArg1, sampleArgK -> step);
-        spec_arg_set_dk(specArg2, sampleArgK -> step);
+        The product W = C^-1 D is solved for once (mat_fact_solve_ip), and D^T W is formed with one dgemm.
+        Both D and W are row-major (N x M), i.e. column-major (M x N) for BLAS.
 
-        spec_arg_set_dmu(specArg1, sampleArgMu -> step);
-        spec_arg_set_dmu(specArg2, sampleArgMu -> step);
+    */
+
+    /* Dimensions */
+    int laN = (int) matDerivT -> dim[0];
+    int laM = (int) matDerivT -> dim[1];
+
+    if (covFactT -> dim != matDerivT -> dim[0])
+      {
+        printf("Cannot contract a covariance matrix with total dimension %ld with %ld derivatives.\n", covFactT -> dim, matDerivT -> dim[0]);
+        exit(1);
+
+        return 1;
+      }
+
+    /* W = C^-1 D */
+    mat_t *matW = mat_cp(matDerivT);
+    matW = mat_fact_solve_ip(covFactT, matW);
+
+    double *laD = matDerivT -> matrix;
+    double *laW = matW -> matrix;
+
+    double laOne = 1.;
+    double laZero = 0.;
+
+    /* F_t = D^T W */
+    char laTRANSA = 'N';
+    char laTRANSB = 'T';
+
+    dgemm_(&laTRANSA, &laTRANSB, &laM, &laM, &laN, &laOne, laD, &laM, laW, &laM, &laZero, valFishT, &laM);
+
+    /* Free memory */
+    matW = mat_free(matW);
+
+    return 0;
+}
 
-        /* Kern struct */
-        kern_t *kern1 = kernels_new_order(info -> specOrders[info -> specSize - 1], kernOrder);
-        kern_t *kern2 = kernels_new_order(info -> specOrders[info -> specSize - 1], kernOrder);
 
-        spec_arg_set_kern(specArg1, kern1);
-        spec_arg_set_kern(specArg2, kern2);
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+typedef struct
+{
+    /*
+
+        Element (f1, f2) of the Fisher matrix, with f1 (f2) the r'th (s'th) derivative value of the n'th (m'th)
+        partial parameter
+
+    */
+
+    size_t n;
+    size_t m;
+    size_t r;
+    size_t s;
+
+    size_t f1;
+    size_t f2;
+
+} _fish_elem_t;
+
+
+static double _fish_mat_eig_elem(_fish_info_t *info, mat_t *corrEigval, mat_t *matDeriv, _fish_elem_t *elem, bool spatial)
+{
+    /*
+
+        Calculate the Fisher matrix element elem as sum_z sum_i (dP_1 U^T)^T Λ^-1 (dP_2 U^T), given the eigenvalues
+        (corrEigval) and the derivatives times eigenvectors (matDeriv) of the correlation matrices
+
+        If spatial is true, the loop over shapes is parallelised and the per-thread compensated partial sums are
+        reduced in thread order, otherwise the element is calculated by the calling thread alone.
+
+    */
+
+    /* Variables */
+    sample_raw_t *sampleRawZ = flss_get_sample_redshift();
+    sample_arg_t *sampleArgZ = sampleRawZ -> sampleArg;
+
+    /* Compensated partial sums (one per thread) */
+    size_t threadsSize = (spatial) ? (size_t) omp_get_max_threads() : 1;
+    misc_csum_t *valFishThreads = malloc(sizeof(misc_csum_t) * threadsSize);
+
+    for (size_t i = 0; i < threadsSize; i++)
+      {
+        valFishThreads[i].sum = 0.;
+        valFishThreads[i].comp = 0.;
+      }
+
+    #pragma omp parallel if(spatial) num_threads((int) threadsSize)
+
+      { // Start pragma parallel
+
+        /* Declare and define variables */
+
+        /* Partial sum of this thread */
+        misc_csum_t valFishThread = {0., 0.};
 
         /* Deriv struct */
         spec_deriv_t *deriv1 = spec_deriv_new();
         spec_deriv_t *deriv2 = spec_deriv_new();
 
-        spec_arg_set_deriv(specArg1, deriv1);
-        spec_arg_set_deriv(specArg2, deriv2);
+        /* Set the logarithmic flags */
+        spec_deriv_set_log(deriv1, *(info -> partsDerivLog[elem -> n]));
+        spec_deriv_set_log(deriv2, *(info -> partsDerivLog[elem -> m]));
 
-        /* Print stage */
-        #pragma omp single
+        /* Set the derivative variables for the first spectrum */
+        for (size_t i = 0; i < info -> partsDerivVals[elem -> n] -> xDim; i++)
           {
-            print_fish(print);
+            spec_deriv_set_var(deriv1, dat_get_label(info -> partsDerivVals[elem -> n], i, 'x'), dat_get_value(info -> partsDerivVals[elem -> n], i, elem -> r, 'x'));
           }
 
-        /* Print progress */
-        #pragma omp single
+        /* Set the derivative variables for the second spectrum */
+        for (size_t i = 0; i < info -> partsDerivVals[elem -> m] -> xDim; i++)
           {
-            print_fish(print);
+            spec_deriv_set_var(deriv2, dat_get_label(info -> partsDerivVals[elem -> m], i, 'x'), dat_get_value(info -> partsDerivVals[elem -> m], i, elem -> s, 'x'));
           }
 
+        for (size_t t = 0; t < sampleArgZ -> size; t++)
 
-        /* Calculate the fisher matrix */
+          { // Start temporal for
 
-        for (size_t n = 0, m = 0, f1 = 0, f2 = 0; n < info -> partsSize; n = (m < info -> partsSize - 1) ? n : n + 1, m = (m < info -> partsSize - 1) ? m + 1 : n)
+            /* Skip partial multiplicities with unequal redshifts */
+            if ((info -> partsMult[elem -> n][0] == -1 && deriv1 -> z != sampleRawZ -> array[t]) || (info -> partsMult[elem -> m][0] == -1 && deriv2 -> z != sampleRawZ -> array[t]))
+                continue;
 
-          { // Start info -> partsSize for
+            /* Temporal block of the eigenvalues */
+            size_t locCorrEigvalT[2] = {t, t};
+            mat_t *corrEigvalT = mat_fget_block(corrEigval, locCorrEigvalT);
 
-            /* Skip if one element does not exist */
-            if (!*(info -> partsExist[n]) || !*(info -> partsExist[m]))
-                continue;
+            /* Temporal block of the derivatives */
+            size_t locDerivT[2] = {t, 0};
+            mat_t *matDerivT = mat_fget_block(matDeriv, locDerivT);
 
-            /* Set the logarithmic flags */
-            spec_deriv_set_log(deriv1, *(info -> partsDerivLog[n]));
-            spec_deriv_set_log(deriv2, *(info -> partsDerivLog[m]));
+            for (size_t i = 0; i < info -> specSize; i++)
 
-            for (size_t r = 0, s = 0; r < info -> partsDerivVals[n] -> size; r = (s < info -> partsDerivVals[m] -> size - 1) ? r : r + 1, s = (s < info -> partsDerivVals[m] -> size - 1) ? s + 1 : ( (n == m) ? r : 0 ))
+              { // Start info -> specSize for
 
-              { // Start info -> partsDerivVals -> size for TODO: What about constant parameters?
+                /* Variables */
+                sample_shape_t *sampleShape = flss_get_sample_shape(info -> specLabels[i]);
 
-                /* Set the derivative variables for the first spectrum */
-                for (size_t i = 0; i < info -> partsDerivVals[n] -> xDim; i++)
-                  {
-                    spec_deriv_set_var(deriv1, dat_get_label(info -> partsDerivVals[n], i, 'x'), dat_get_value(info -> partsDerivVals[n], i, r, 'x'));
-                  }
+                sample_raw_t *sampleRawK = sampleShape -> sampleRawLength;
+                sample_arg_t *sampleArgK = sampleRawK -> sampleArg;
+
+                /* Skip if one spectrum's deriv -> k is not included in the sample */
+                if (info -> partsMult[elem -> n][1] == 1 && !misc_bsearch(sampleRawK -> array, sampleArgK -> size, deriv1 -> k, __ABSTOL__, NULL))
+                    continue;
+
+                if (info -> partsMult[elem -> m][1] == 1 && !misc_bsearch(sampleRawK -> array, sampleArgK -> size, deriv2 -> k, __ABSTOL__, NULL))
+                    continue;
 
-                /* Set the derivative variables for the second spectrum */
-                for (size_t i = 0; i < info -> partsDerivVals[m] -> xDim; i++)
+                /* Spectral block of the eigenvalues */
+                size_t locCorrEigvalTBlock[2] = {i, i};
+                mat_t *corrEigvalTBlock = mat_fget_block(corrEigvalT, locCorrEigvalTBlock);
+
+                /* Spectral blocks of the derivatives */
+                size_t locDerivTBlock1[2] = {i, elem -> f1};
+                mat_t *matDerivTBlock1 = mat_fget_block(matDerivT, locDerivTBlock1);
+
+                size_t locDerivTBlock2[2] = {i, elem -> f2};
+                mat_t *matDerivTBlock2 = mat_fget_block(matDerivT, locDerivTBlock2);
+
+                /* Block does not exist */
+                if (corrEigvalTBlock == NULL)
                   {
-                    spec_deriv_set_var(deriv2, dat_get_label(info -> partsDerivVals[m], i, 'x'), dat_get_value(info -> partsDerivVals[m], i, s, 'x'));
+                    matDerivTBlock1 = mat_ffree(matDerivTBlock1);
+                    matDerivTBlock2 = mat_ffree(matDerivTBlock2);
+
+                    continue;
                   }
 
-                /* Fisher matrix element */
-                #pragma omp single
-                valFish = 0.q;
+                #pragma omp for schedule(static)
+                for (size_t s = 0; s < sampleShape -> size; s++)
 
-                for (size_t t = 0; t < sampleArgZ -> size; t++)
+                  { // Start spatial for
 
-                  { // Start temporal for
+                    shape_t *shape = sampleShape -> arrayShape[s];
 
-                    /* Skip partial multiplicities with unequal redshifts */
-                    if ((info -> partsMult[n][0] == -1 && deriv1 -> z != sampleRawZ -> array[t]) || (info -> partsMult[m][0] == -1 && deriv2 -> z != sampleRawZ -> array[t]))
-                        continue;
+                    for (size_t p = 0; p < 1 + (size_t) (!shape -> parity); p++)
 
-                    /* Set the redshift + fiducials in the kern structs */
-                    kernels_set_z(kern1, sampleRawZ -> array[t]);
-                    kernels_set_z(kern2, sampleRawZ -> array[t]);
+                      { // Start parity for
 
-                    /* Temporal block of the covariance matrix */
-                    size_t locT[2] = {t, t};
-                    mat_t *covInvT = mat_fget_block(covInv, locT);
+                        /* (Spatial) Location in the eigenvalues */
+                        size_t locCorrEigvalS[2];
 
-                    for (size_t i1 = 0, i2 = 0; i1 < info -> specSize; i1 = (i2 < info -> specSize - 1) ? i1 : i1 + 1, i2 = (i2 < info -> specSize - 1) ? i2 + 1 : i1)
+                        locCorrEigvalS[0] = (s < sampleShape -> sizeParity) ? s : sampleShape -> sizeParity + 2 * (s - sampleShape -> sizeParity) + p;
+                        locCorrEigvalS[1] = locCorrEigvalS[0];
 
-                      { // Start info -> specSize for
+                        /* Value */
+                        double eigVal = mat_get_value(corrEigvalTBlock, locCorrEigvalS);
 
-                        /* Variables */
-                        sample_shape_t *sampleShape1 = flss_get_sample_shape(info -> specLabels[i1]);
-                        sample_shape_t *sampleShape2 = flss_get_sample_shape(info -> specLabels[i2]);
+                        /* Skip negative or zero eigenvalues (covariance matrix should be positive definite) */
+                        if (eigVal <= 0.)
+                            continue;
 
-                        sample_raw_t *sampleRawK1 = sampleShape1 -> sampleRawLength;
-                        sample_raw_t *sampleRawK2 = sampleShape2 -> sampleRawLength;
+                        /* (Spatial) Location in the derivatives */
+                        size_t locDerivS[2] = {locCorrEigvalS[0], 0};
 
-                        sample_arg_t *sampleArgK1 = sampleRawK1 -> sampleArg;
-                        sample_arg_t *sampleArgK2 = sampleRawK2 -> sampleArg;
+                        /* Values */
+                        double derivVal1 = mat_get_value(matDerivTBlock1, locDerivS);
+                        double derivVal2 = mat_get_value(matDerivTBlock2, locDerivS);
 
-                        /* Skip if one spectrum's deriv -> k is not included in the sample */
-                        if (info -> partsMult[n][1] == 1 && !misc_bsearch(sampleRawK1 -> array, sampleArgK1 -> size, deriv1 -> k, __ABSTOL__, NULL))
-                            continue;
+                        /* Update the Fisher matrix element */
+                        misc_csum_add(&valFishThread, derivVal1 * derivVal2 / eigVal);
 
-                        if (info -> partsMult[m][1] == 1 && !misc_bsearch(sampleRawK2 -> array, sampleArgK2 -> size, deriv2 -> k, __ABSTOL__, NULL))
-                            continue;
+                      } // End parity for
 
-                        /* Spectral derivative functions */
-                        double (*dSpecFunc1)(void*, void*) = _specPoly_(info -> specLabels[i1], info -> partsLabels[n]);
-                        double (*dSpecFunc2)(void*, void*) = _specPoly_(info -> specLabels[i2], info -> partsLabels[m]);
+                  } // End spatial for
 
-                        /* Average flags */
-                        bool avrFlag1 = flss_get_avr_shape_flag(info -> specLabels[i1]);
-                        bool avrFlag2 = flss_get_avr_shape_flag(info -> specLabels[i2]);
+                /* Free memory */
+                corrEigvalTBlock = mat_ffree(corrEigvalTBlock);
 
-                        /* Average functions */
-                        int (*avrFunc1)(double (*)(void*, void*), spec_arg_t *, double*) = (avrFlag1) ? avr_shape_get_func(info -> specOrders[i1]) : avr_shape_inf;
-                        int (*avrFunc2)(double (*)(void*, void*), spec_arg_t *, double*) = (avrFlag2) ? avr_shape_get_func(info -> specOrders[i2]) : avr_shape_inf;
+                matDerivTBlock1 = mat_ffree(matDerivTBlock1);
+                matDerivTBlock2 = mat_ffree(matDerivTBlock2);
 
-                        /* Spectral block of the covariance matrix */
-                        size_t locTBlock[2] = {i1, i2};
-                        mat_t *covInvTBlock = mat_fget_block(covInvT, locTBlock);
+              } // End info -> specSize for
 
-                        /* Block does not exist */
-                        if (covInvTBlock == NULL)
-                            continue;
+            /* Free memory */
+            corrEigvalT = mat_ffree(corrEigvalT);
 
-                        #pragma omp for schedule(dynamic)
+            matDerivT = mat_ffree(matDerivT);
 
-                        for (size_t s1 = 0; s1 < sampleShape1 -> size; s1++)
+          } // End temporal for
 
-                          { // Start spatial for 1
+        /* Store the partial sum */
+        valFishThreads[omp_get_thread_num()] = valFishThread;
+
+        /* Free memory */
+        deriv1 = spec_deriv_free(deriv1);
+        deriv2 = spec_deriv_free(deriv2);
 
-                            /* (Spatial) Location in the inverse covariance matrix */
-                            size_t locS[2];
+      } // End pragma parallel
 
-                            /* Scalar product between inverse covariance matrix and derivative vector */
-                            __float128 valFishTemp = 0.q;
+    /* Reduce the partial sums in thread order (deterministic for a fixed number of threads) */
+    misc_csum_t valFishSum = {0., 0.};
 
-                            /* Shape of first spectrum */
-                            shape_t *shape1 = sampleShape1 -> arrayShape[s1];
+    for (size_t i = 0; i < threadsSize; i++)
+        misc_csum_merge(&valFishSum, &valFishThreads[i]);
+
+    /* Free memory */
+    free(valFishThreads);
+
+    return misc_csum_get(&valFishSum);
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------   Fisher Matrix Function   --------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+mats_t *fish_mat_poly(fish_mat_t *fishMat)
+{
+    /*
+
+        Calculate the fisher matrix
+
+    */
+
+
+    /* Exit if nothing should be calculated */
+
+    /* fishMat itself is NULL */
+    if (fishMat == NULL)
+      {
+        return NULL;
+      }
+
+    /* Outsize is 0 */
+    if (fishMat -> out -> size == 0)
+      {
+        return NULL;
+      }
+
+    /* fishMat is faulty */
+    if (!_fish_mat_test(fishMat))
+      {
+        return NULL;
+      }
 
-                            /* Set variables for first shape */
-                            for (size_t i = 0; i < shape1 -> dim; i++)
-                              {
-                                kernels_qset_k(kern1, i, shape1 -> length[i]);
-                                kernels_qset_mu(kern1, i, shape1 -> orientation[i]);
 
-                                for (size_t j = i + 1; j < shape1 -> dim; j++)
-                                    kernels_qset_nu(kern1, i, j, shape1 -> angle[shape_get_vertex_angle_index(shape1 -> dim, i, j)]);
-                              }
+    // TODO: Clean this mess up...
 
-                            /* Spectra derivative */
-                            double dSpecVal1 = dat_get_yvalue(datDeriv[i1], f1, t * sampleShape1 -> size + s1);
+    /* Get parameters from fishMat */
 
-                            if (isnan(dSpecVal1))
-                              {
-                                dSpecVal1 = avr_shape_direct(avrFunc1, dSpecFunc1, specArg1);
-                                dat_set_yvalue(datDeriv[i1], f1, t * sampleShape1 -> size + s1, dSpecVal1);
-                              }
+    /* Info on spectrum */
+    _fish_info_t *info = _fish_info_get_struct(fishMat -> id);
 
-                            for (size_t p1 = 0; p1 < 1 + (size_t) (!shape1 -> parity); p1++)
+    /* Kern order */
+    size_t kernOrder = fish_info_get_kern_order(info -> id);
 
-                              { // Start parity for 1
+    /* Get the output matrix struct */
+    mats_t *mats = mats_new(1);
+    mat_t *mat = _fish_setup_mat(fishMat);
+    mats_set_mat(mats, 0, mat);
 
-                                /* (Spatial) Row dimension in the inverse covariance matrix */
-                                locS[0] = (s1 < sampleShape1 -> sizeParity) ? s1 : sampleShape1 -> sizeParity + 2 * (s1 - sampleShape1 -> sizeParity) + p1;
+    /* Variables */
+    sample_raw_t *sampleRawZ = flss_get_sample_redshift();
+    sample_arg_t *sampleArgZ = sampleRawZ -> sampleArg;
 
-                                /* Boundaries */
-                                size_t spatialBounds2[2];
-                                spatialBounds2[0] = (!strcmp(covInvTBlock -> mtype -> id, "d")) ? s1 : 0;
-                                spatialBounds2[1] = (!strcmp(covInvTBlock -> mtype -> id, "d")) ? s1 + 1 : sampleShape2 -> size;
+    sample_arg_t *sampleArgK = ((sample_raw_t*) flss_get_sample_shape(info -> specLabels[0]) -> sampleRawLength) -> sampleArg;
+    sample_arg_t *sampleArgMu = ((sample_raw_t*) flss_get_sample_shape(info -> specLabels[0]) -> sampleRawOrientation) -> sampleArg;
 
-                                for (size_t s2 = spatialBounds2[0]; s2 < spatialBounds2[1]; s2++)
+    /* Covariance matrix (factorised at each redshift) */
+    mat_fact_t **covFact = malloc(sizeof(mat_fact_t*) * sampleArgZ -> size);
 
-                                  { // Start spatial for 2
+    mat_reduce_t red = {1.e-14}; // TODO: Improve this...
 
-                                    /* Shape of second spectrum */
-                                    shape_t *shape2 = sampleShape2 -> arrayShape[s2];
+    for (size_t locT[2] = {0, 0}; locT[0] < sampleArgZ -> size; locT[1] = ++locT[0])
+      {
+        /* Put the single covariance matrices into blocks at each redshift */
+        size_t covDimTBlock[2] = {info -> specSize, info -> specSize};
+        mat_t *covBlock = mat_new("s", covDimTBlock, _true_);
 
-                                    /* Set variables for second shape */
-                                    for (size_t i = 0; i < shape2 -> dim; i++)
-                                      {
-                                        kernels_qset_k(kern2, i, shape2 -> length[i]);
-                                        kernels_qset_mu(kern2, i, shape2 -> orientation[i]);
+        for (size_t loc[2] = {0, 0}, index = 0; loc[0] < info -> specSize; loc[0] = (loc[1] < info -> specSize - 1) ? loc[0] : loc[0] + 1, loc[1] = (loc[1] < info -> specSize - 1) ? loc[1] + 1 : loc[0], index++)
+          {
+            cov_mat_t *covMat = cov_mat_new(info -> covLabels[index]);
+            cov_out_add_label(cov_mat_get_out(covMat), cov_in_get_label(info -> covLabels[index]));
 
-                                        for (size_t j = i + 1; j < shape2 -> dim; j++)
-                                            kernels_qset_nu(kern2, i, j, shape2 -> angle[shape_get_vertex_angle_index(shape2 -> dim, i, j)]);
-                                      }
+            /* Get the block */
+            mat_t *covBlockSub = mat_get_block(_covPolyMat_(info -> covLabels[index])(covMat, NULL), locT);
 
-                                    /* Spectra derivative */
-                                    double dSpecVal2 = dat_get_yvalue(datDeriv[i2], f2, t * sampleShape2 -> size + s2);
+            /* Set the block */
+            mat_fset_block(covBlock, loc, covBlockSub);
 
-                                    if (isnan(dSpecVal2))
-                                      {
-                                        dSpecVal2 = avr_shape_direct(avrFunc2, dSpecFunc2, specArg2);
-                                        dat_set_yvalue(datDeriv[i2], f2, t * sampleShape2 -> size + s2, dSpecVal2);
-                                      }
+            /* Free memory */
+            covMat = cov_mat_free(covMat);
+          }
 
-                                    for (size_t p2 = 0; p2 < 1 + (size_t) (!shape2 -> parity); p2++)
+        /* Reduce the matrix */
+        covBlock = mat_reduce(covBlock, &red);
 
-                                      { // Start parity for 2
+        /* Factorise the covariance matrix */
+        covFact[locT[0]] = mat_fact_cov(covBlock);
 
-                                        /* (Spatial) Column dimension in the inverse covariance matrix */
-                                        locS[1] = (s2 < sampleShape2 -> sizeParity) ? s2 : sampleShape2 -> sizeParity + 2 * (s2 - sampleShape2 -> sizeParity) + p2;
+        if (covFact[locT[0]] == NULL)
+          {
+            printf("Cannot factorise the covariance matrix at redshift index %ld.\n", locT[0]);
+            exit(1);
 
-                                        /* Spatial element of the covariance matrix */
-                                        double valCovInv = mat_get_value(covInvTBlock, locS);
+            return NULL;
+          }
 
-                                        /* No need to calculate the spectra */
-                                        if (valCovInv == 0.)
-                                            continue;
+        /* Free memory */
+        covBlock = mat_free(covBlock);
+      }
 
-                                        /* Calculate the fisher matrix element */
-                                        valFishTemp += ((__float128) valCovInv) * ((__float128) dSpecVal2);
+    /* Sizes */
+    size_t sizes[5] = {sampleArgZ -> size, sampleArgK -> size, sampleArgMu -> size, mat -> dim[0], mat -> dim[0] * (mat -> dim[1] + 1) / 2};
 
-                                      } // End parity for 2
+    /* Print struct */
+    print_t *print = print_new();
 
-                                  } // End spatial for 2
+    print_set_id(print, fishMat -> id);
+    print_set_flags(print, fishMat -> flags);
 
-                              } // End parity for 1
+    print_set_sizes(print, sizes);
 
-                            /* Update the Fisher matrix element */
-                            #pragma omp atomic
-                            valFish += ((__float128) dSpecVal1) * valFishTemp;
+    /* Store derivatives (partial parameters that do not contribute remain zero) */
+    dat_t **datDeriv = malloc(sizeof(dat_t*) * info -> specSize);
 
-                          } // End spatial for 1
+    for (size_t i = 0; i < info -> specSize; i++)
+      {
+        sample_shape_t *sampleShape = flss_get_sample_shape(info -> specLabels[i]);
 
-                        /* Free memory */
-                        covInvTBlock = mat_ffree(covInvTBlock);
+        datDeriv[i] = dat_new(0, mat -> dim[0], sampleArgZ -> size * sampleShape -> size);
 
-                      } // End info -> specSize for
+        for (size_t n = 0; n < datDeriv[i] -> size; n++)
+          {
+            for (size_t m = 0; m < datDeriv[i] -> yDim; m++)
+                dat_set_yvalue(datDeriv[i], m, n, 0.);
+          }
+      }
 
-                    /* Free memory */
-                    covInvT = mat_ffree(covInvT);
+    /* Print stage */
+    print_fish(print);
 
-                  } // End temporal for
+    /* Print progress */
+    print_fish(print);
 
-                #pragma omp single
-                  {
-                    /* Insert the value */
-                    size_t locFish1[2] = {f1, f2};
-                    size_t locFish2[2] = {f2, f1};
 
-                    mat_set_value(mat, locFish1, (double) valFish);
-                    mat_set_value(mat, locFish2, (double) valFish);
+    /**  Calculate the Derivatives  **/
 
-                    /* Update the progress */
-                    print_update_progress(print, 1. / (double) (print -> sizes[4]));
-                    print_fish(print);
-                  }
+    _fish_mat_deriv(info, kernOrder, mat -> dim[0], datDeriv, print);
 
-                /* Update the fisher indices */
-                if (r < info -> partsDerivVals[n] -> size - 1 || s < info -> partsDerivVals[m] -> size - 1)
-                  {
-                    f1 = (s < info -> partsDerivVals[m] -> size - 1) ? f1 : f1 + 1;
-                    f2 = (s < info -> partsDerivVals[m] -> size - 1) ? f2 + 1 : ( (n == m) ? f1 : f2 + 1 - info -> partsDerivVals[m] -> size );
-                  }
 
-              } // End info -> partsDerivVals -> size for
+    /**  Calculate the Fisher Matrix  **/
 
-            /* Update the fisher indices */
-            f1 = (f2 < mat -> dim[1] - 1) ? f1 + 1 - info -> partsDerivVals[n] -> size : f1 + 1;
-            f2 = (f2 < mat -> dim[1] - 1) ? f2 + 1 : f1;
+    /* F = sum_z D^T C^-1 D (full, row-major), summed over redshifts with compensation */
+    misc_csum_t *valFish = calloc(mat -> dim[0] * mat -> dim[1], sizeof(misc_csum_t));
+    double *valFishT = malloc(sizeof(double) * mat -> dim[0] * mat -> dim[1]);
 
-          } // End info -> partsSize for
+    for (size_t t = 0; t < sampleArgZ -> size; t++)
+      {
+        /* Derivatives */
+        mat_t *matDerivT = _fish_mat_deriv_block(info, datDeriv, t, mat -> dim[0]);
 
+        /* Contract the derivatives with the covariance matrix */
+        _fish_mat_contract(covFact[t], matDerivT, valFishT);
 
-        /* Stage has finished: print a message and the execution time */
+        for (size_t f = 0; f < mat -> dim[0] * mat -> dim[1]; f++)
+            misc_csum_add(&valFish[f], valFishT[f]);
 
-        print -> stageFinished = 1;
+        /* Free memory */
+        matDerivT = mat_free(matDerivT);
+      }
 
-        #pragma omp single
+    /* Insert the values */
+    for (size_t f1 = 0; f1 < mat -> dim[0]; f1++)
+      {
+        for (size_t f2 = f1; f2 < mat -> dim[1]; f2++)
           {
-            print_set_stagefinished(print, 1);
-            print_set_progress(print, 1.);
+            size_t locFish1[2] = {f1, f2};
+            size_t locFish2[2] = {f2, f1};
 
-            print_fish(print);
+            mat_set_value(mat, locFish1, misc_csum_get(&valFish[f1 * mat -> dim[1] + f2]));
+            mat_set_value(mat, locFish2, misc_csum_get(&valFish[f1 * mat -> dim[1] + f2]));
           }
+      }
 
 
-        /* Free memory */
-
-        specArg1 = spec_arg_free(specArg1);
-        specArg2 = spec_arg_free(specArg2);
+    /* Stage has finished: print a message and the execution time */
 
+    print_set_stagefinished(print, 1);
+    print_set_progress(print, 1.);
 
-      } // End pragma parallel
+    print_fish(print);
 
 
     /* Free memory */
 
-    covInv = mat_free(covInv);
+    free(valFish);
+    free(valFishT);
+
+    for (size_t t = 0; t < sampleArgZ -> size; t++)
+      {
+        covFact[t] = mat_fact_free(covFact[t]);
+      }
+
+    free(covFact);
 
     for (size_t i = 0; i < info -> specSize; i++)
       {
@@ -2189,7 +2504,7 @@ mats_t *fish_mat_poly_eig(fish_mat_t *fishMat)
 
     print_set_sizes(print, sizes);
 
-    /* Store derivatives */
+    /* Store derivatives (partial parameters that do not contribute remain zero) */
     dat_t **datDeriv = malloc(sizeof(dat_t*) * info -> specSize);
 
     for (size_t i = 0; i < info -> specSize; i++)
@@ -2201,50 +2516,35 @@ mats_t *fish_mat_poly_eig(fish_mat_t *fishMat)
         for (size_t n = 0; n < datDeriv[i] -> size; n++)
           {
             for (size_t m = 0; m < datDeriv[i] -> yDim; m++)
-                dat_set_yvalue(datDeriv[i], m, n, NAN);
+                dat_set_yvalue(datDeriv[i], m, n, 0.);
           }
       }
 
+    /* Print stage */
+    print_fish(print);
 
-    /**  Prepare the Derivatives  **/
+    /* Print progress */
+    print_fish(print);
 
-    #pragma omp parallel shared(matDeriv)
 
-      { // Start pragma parallel
+    /**  Calculate the Derivatives  **/
 
-        /* Declare and define variables */
+    _fish_mat_deriv(info, kernOrder, mat -> dim[0], datDeriv, print);
 
-        /* Spec args struct */
-        spec_arg_t *specArg = spec_arg_new(NULL);
 
-        spec_arg_set_dz(specArg, sampleArgZ -> step);
-        spec_arg_set_dk(specArg, sampleArgK -> step);
-        spec_arg_set_dmu(specArg, sampleArgMu -> step);
+    /**  Prepare the Derivatives  **/
 
-        /* Kern struct */
-        kern_t *kern = kernels_new_order(info -> specOrders[info -> specSize - 1], kernOrder);
+    #pragma omp parallel shared(matDeriv)
 
-        spec_arg_set_kern(specArg, kern);
+      { // Start pragma parallel
+
+        /* Declare and define variables */
 
         /* Deriv struct */
         spec_deriv_t *deriv = spec_deriv_new();
 
-        spec_arg_set_deriv(specArg, deriv);
-
-        /* Print stage */
-        #pragma omp single
-          {
-            print_fish(print);
-          }
-
-        /* Print progress */
-        #pragma omp single
-          {
-            print_fish(print);
-          }
-
 
-        /* Calculate the fisher matrix */
+        /* Project the derivatives onto the eigenvectors */
 
         for (size_t n = 0, f = 0; n < info -> partsSize; n++)
 
@@ -2275,9 +2575,6 @@ mats_t *fish_mat_poly_eig(fish_mat_t *fishMat)
                     if (info -> partsMult[n][0] == -1 && deriv -> z != sampleRawZ -> array[t])
                         continue;
 
-                    /* Set the redshift + fiducials in the kern structs */
-                    kernels_set_z(kern, sampleRawZ -> array[t]);
-
                     /* Temporal block of the eigenvectors */
                     size_t locCorrEigvecT[2] = {t, t};
                     mat_t *corrEigvecT = mat_fget_block(corrEigvec, locCorrEigvecT);
@@ -2308,15 +2605,6 @@ mats_t *fish_mat_poly_eig(fish_mat_t *fishMat)
                         if (info -> partsMult[n][1] == 1 && !(misc_bsearch(sampleRawK1 -> array, sampleArgK1 -> size, deriv -> k, __ABSTOL__, NULL)
                                                               && misc_bsearch(sampleRawK2 -> array, sampleArgK2 -> size, deriv -> k, __ABSTOL__, NULL))) continue;
 
-                        /* Spectral derivative function */
-                        double (*dSpecFunc)(void*, void*) = _specPoly_(info -> specLabels[i2], info -> partsLabels[n]);
-
-                        /* Average flag */
-                        bool avrFlag = flss_get_avr_shape_flag(info -> specLabels[i2]);
-
-                        /* Average function */
-                        int (*avrFunc)(double (*)(void*, void*), spec_arg_t *, double*) = (avrFlag) ? avr_shape_get_func(info -> specOrders[i2]) : avr_shape_inf;
-
                         /* Spectral block of the eigenvectors */
                         size_t locCorrEigvecTBlock[2] = {i1, i2};
                         mat_t *corrEigvecTBlock = mat_fget_block(corrEigvecT, locCorrEigvecTBlock);
@@ -2376,25 +2664,9 @@ mats_t *fish_mat_poly_eig(fish_mat_t *fishMat)
                                     /* Shape of second spectrum */
                                     shape_t *shape2 = sampleShape2 -> arrayShape[s2];
 
-                                    /* Set variables for second shape */
-                                    for (size_t i = 0; i < shape2 -> dim; i++)
-                                      {
-                                        kernels_qset_k(kern, i, shape2 -> length[i]);
-                                        kernels_qset_mu(kern, i, shape2 -> orientation[i]);
-
-                                        for (size_t j = i + 1; j < shape2 -> dim; j++)
-                                            kernels_qset_nu(kern, i, j, shape2 -> angle[shape_get_vertex_angle_index(shape2 -> dim, i, j)]);
-                                      }
-
                                     /* Spectra derivative */
                                     double dSpecVal = dat_get_yvalue(datDeriv[i2], f, t * sampleShape2 -> size + s2);
 
-                                    if (isnan(dSpecVal))
-                                      {
-                                        dSpecVal = avr_shape_direct(avrFunc, dSpecFunc, specArg);
-                                        dat_set_yvalue(datDeriv[i2], f, t * sampleShape2 -> size + s2, dSpecVal);
-                                      }
-
                                     for (size_t p2 = 0; p2 < 1 + (size_t) (!shape2 -> parity); p2++)
 
                                       { // Start parity for 2
@@ -2442,13 +2714,6 @@ mats_t *fish_mat_poly_eig(fish_mat_t *fishMat)
 
                   } // End temporal for
 
-                #pragma omp single
-                  {
-                    /* Update the progress */
-                    print_update_progress(print, 1. / (double) (print -> sizes[4]));
-                    print_fish(print);
-                  }
-
                 /* Update the fisher index */
                 f++;
 
@@ -2457,22 +2722,9 @@ mats_t *fish_mat_poly_eig(fish_mat_t *fishMat)
           } // End info -> partsSize for
 
 
-        /* Stage has finished: print a message and the execution time */
-
-        print -> stageFinished = 1;
-
-        #pragma omp single
-          {
-            print_set_stagefinished(print, 1);
-            print_set_progress(print, 1.);
-
-            print_fish(print);
-          }
-
-
         /* Free memory */
 
-        specArg = spec_arg_free(specArg);
+        deriv = spec_deriv_free(deriv);
 
 
       } // End pragma parallel
@@ -2488,228 +2740,85 @@ mats_t *fish_mat_poly_eig(fish_mat_t *fishMat)
 
     /**  Calculate the Fisher Matrix  **/
 
-    double valFish;
-
-    #pragma omp parallel shared(valFish)
-
-      { // Start pragma parallel
+    /* Offsets of the partial parameters in the Fisher matrix */
+    size_t *partsOffset = malloc(sizeof(size_t) * info -> partsSize);
 
-        /* Declare and define variables */
+    for (size_t n = 0, f = 0; n < info -> partsSize; n++)
+      {
+        partsOffset[n] = f;
 
-        /* Deriv struct */
-        spec_deriv_t *deriv1 = spec_deriv_new();
-        spec_deriv_t *deriv2 = spec_deriv_new();
+        if (*(info -> partsExist[n]))
+            f += info -> partsDerivVals[n] -> size;
+      }
 
-        /* Print stage */
-        #pragma omp single
-          {
-//            print_fish(print);
-          }
+    /* Enumerate the elements of the (upper triangle of the) Fisher matrix */
+    _fish_elem_t *elems = malloc(sizeof(_fish_elem_t) * mat -> dim[0] * (mat -> dim[1] + 1) / 2);
+    size_t elemsSize = 0;
 
-        /* Print progress */
-        #pragma omp single
+    for (size_t n = 0; n < info -> partsSize; n++)
+      {
+        for (size_t m = n; m < info -> partsSize; m++)
           {
-//            print_fish(print);
-          }
-
-
-        /*  Calculate the Fisher Matrix  */
-
-        for (size_t n = 0, m = 0, f1 = 0, f2 = 0; n < info -> partsSize; n = (m < info -> partsSize - 1) ? n : n + 1, m = (m < info -> partsSize - 1) ? m + 1 : n)
-
-          { // Start info -> partsSize for
-
             /* Skip if one element does not exist */
             if (!*(info -> partsExist[n]) || !*(info -> partsExist[m]))
                 continue;
 
-            /* Set the logarithmic flags */
-            spec_deriv_set_log(deriv1, *(info -> partsDerivLog[n]));
-            spec_deriv_set_log(deriv2, *(info -> partsDerivLog[m]));
-
-            for (size_t r = 0, s = 0; r < info -> partsDerivVals[n] -> size; r = (s < info -> partsDerivVals[m] -> size - 1) ? r : r + 1, s = (s < info -> partsDerivVals[m] -> size - 1) ? s + 1 : ( (n == m) ? r : 0 ))
-
-              { // Start info -> partsDerivVals -> size for TODO: What about constant parameters?
-
-                /* Set the derivative variables for the first spectrum */
-                for (size_t i = 0; i < info -> partsDerivVals[n] -> xDim; i++)
-                  {
-                    spec_deriv_set_var(deriv1, dat_get_label(info -> partsDerivVals[n], i, 'x'), dat_get_value(info -> partsDerivVals[n], i, r, 'x'));
-                  }
-
-                /* Set the derivative variables for the second spectrum */
-                for (size_t i = 0; i < info -> partsDerivVals[m] -> xDim; i++)
+            for (size_t r = 0; r < info -> partsDerivVals[n] -> size; r++)
+              {
+                for (size_t s = (n == m) ? r : 0; s < info -> partsDerivVals[m] -> size; s++)
                   {
-                    spec_deriv_set_var(deriv2, dat_get_label(info -> partsDerivVals[m], i, 'x'), dat_get_value(info -> partsDerivVals[m], i, s, 'x'));
+                    _fish_elem_t elem = {n, m, r, s, partsOffset[n] + r, partsOffset[m] + s};
+                    elems[elemsSize++] = elem;
                   }
+              }
+          }
+      }
 
-                /* Fisher matrix element */
-                #pragma omp single
-                valFish = 0.;
-
-                for (size_t t = 0; t < sampleArgZ -> size; t++)
-
-                  { // Start temporal for
-
-                    /* Skip partial multiplicities with unequal redshifts */
-                    if ((info -> partsMult[n][0] == -1 && deriv1 -> z != sampleRawZ -> array[t]) || (info -> partsMult[m][0] == -1 && deriv2 -> z != sampleRawZ -> array[t]))
-                        continue;
-
-                    /* Temporal block of the eigenvalues */
-                    size_t locCorrEigvalT[2] = {t, t};
-                    mat_t *corrEigvalT = mat_fget_block(corrEigval, locCorrEigvalT);
-
-                    /* Temporal block of the derivatives */
-                    size_t locDerivT[2] = {t, 0};
-                    mat_t *matDerivT = mat_fget_block(matDeriv, locDerivT);
-
-                    for (size_t i = 0; i < info -> specSize; i++)
-
-                      { // Start info -> specSize for
-
-                        /* Variables */
-                        sample_shape_t *sampleShape = flss_get_sample_shape(info -> specLabels[i]);
-
-                        sample_raw_t *sampleRawK = sampleShape -> sampleRawLength;
-                        sample_arg_t *sampleArgK = sampleRawK -> sampleArg;
-
-                        /* Skip if one spectrum's deriv -> k is not included in the sample */
-                        if (info -> partsMult[n][1] == 1 && !misc_bsearch(sampleRawK -> array, sampleArgK -> size, deriv1 -> k, __ABSTOL__, NULL))
-                            continue;
-
-                        if (info -> partsMult[m][1] == 1 && !misc_bsearch(sampleRawK -> array, sampleArgK -> size, deriv2 -> k, __ABSTOL__, NULL))
-                            continue;
-
-                        /* Spectral block of the eigenvalues */
-                        size_t locCorrEigvalTBlock[2] = {i, i};
-                        mat_t *corrEigvalTBlock = mat_fget_block(corrEigvalT, locCorrEigvalTBlock);
-
-                        /* Spectral blocks of the derivatives */
-                        size_t locDerivTBlock1[2] = {i, f1};
-                        mat_t *matDerivTBlock1 = mat_fget_block(matDerivT, locDerivTBlock1);
-
-                        size_t locDerivTBlock2[2] = {i, f2};
-                        mat_t *matDerivTBlock2 = mat_fget_block(matDerivT, locDerivTBlock2);
-
-                        /* Block does not exist */
-                        if (corrEigvalTBlock == NULL)
-                            continue;
-
-                        #pragma omp for
-                        for (size_t s = 0; s < sampleShape -> size; s++)
-
-                          { // Start spatial for 1
-
-                            shape_t *shape = sampleShape -> arrayShape[s];
-
-                            for (size_t p = 0; p < 1 + (size_t) (!shape -> parity); p++)
-
-                              { // Start parity for 1
-
-                                /* (Spatial) Location in the eigenvalues */
-                                size_t locCorrEigvalS[2];
-
-                                locCorrEigvalS[0] = (s < sampleShape -> sizeParity) ? s : sampleShape -> sizeParity + 2 * (s - sampleShape -> sizeParity) + p;
-                                locCorrEigvalS[1] = (s < sampleShape -> sizeParity) ? s : sampleShape -> sizeParity + 2 * (s - sampleShape -> sizeParity) + p;
-
-                                /* Value */
-                                double eigVal = mat_get_value(corrEigvalTBlock, locCorrEigvalS);
-
-                                /* Skip negative or zero eigenvalues (covariance matrix should be positive definite) */
-                                if (eigVal <= 0.)
-                                  {
-//                                    printf("Skipped the %ld'th eigenvalue (%e).\n", locCorrEigvalS[0], eigVal);
-
-                                    continue;
-                                  }
-
-                                /* (Spatial) Location in the derivatives */
-                                size_t locDerivS[2];
-
-                                locDerivS[0] = locCorrEigvalS[0];
-                                locDerivS[1] = 0;
-
-                                /* Values */
-                                double derivVal1 = mat_get_value(matDerivTBlock1, locDerivS);
-                                double derivVal2 = mat_get_value(matDerivTBlock2, locDerivS);
-
-                                /* Update the Fisher matrix element */
-                                #pragma omp atomic
-                                valFish += derivVal1 * derivVal2 / eigVal;
-
-                              } // End parity for 1
-
-                          } // End spatial for 1
-
-                        /* Free memory */
-                        corrEigvalTBlock = mat_ffree(corrEigvalTBlock);
-
-                        matDerivTBlock1 = mat_ffree(matDerivTBlock1);
-                        matDerivTBlock2 = mat_ffree(matDerivTBlock2);
-
-                      } // End info -> specSize for
-
-                    /* Free memory */
-                    corrEigvalT = mat_ffree(corrEigvalT);
-
-                    matDerivT = mat_ffree(matDerivT);
-
-                  } // End temporal for
-
-                #pragma omp single
-                  {
-                    /* Insert the value */
-                    size_t locFish1[2] = {f1, f2};
-                    size_t locFish2[2] = {f2, f1};
-
-                    mat_set_value(mat, locFish1, valFish);
-                    mat_set_value(mat, locFish2, valFish);
-
-                    /* Update the progress */
-//                    print_update_progress(print, 1. / (double) (print -> sizes[4]));
-//                    print_fish(print);
-                  }
+    /* Parallelise over the elements, or over the shapes of each element if there are fewer elements than threads */
+    bool spatial = elemsSize < (size_t) omp_get_max_threads();
 
-                /* Update the fisher indices */
-                if (r < info -> partsDerivVals[n] -> size - 1 || s < info -> partsDerivVals[m] -> size - 1)
-                  {
-                    f1 = (s < info -> partsDerivVals[m] -> size - 1) ? f1 : f1 + 1;
-                    f2 = (s < info -> partsDerivVals[m] -> size - 1) ? f2 + 1 : ( (n == m) ? f1 : f2 + 1 - info -> partsDerivVals[m] -> size );
-                  }
+    /* Progress of the elements */
+    print_set_progress(print, 0.);
 
-              } // End info -> partsDerivVals -> size for
+    #pragma omp parallel for schedule(dynamic) if(!spatial)
 
-            /* Update the fisher indices */
-            f1 = (f2 < mat -> dim[1] - 1) ? f1 + 1 - info -> partsDerivVals[n] -> size : f1 + 1;
-            f2 = (f2 < mat -> dim[1] - 1) ? f2 + 1 : f1;
+    for (size_t e = 0; e < elemsSize; e++)
 
-          } // End info -> partsSize for
+      { // Start elements for
 
+        double valFish = _fish_mat_eig_elem(info, corrEigval, matDeriv, &elems[e], spatial);
 
-        /* Stage has finished: print a message and the execution time */
+        /* Insert the value */
+        size_t locFish1[2] = {elems[e].f1, elems[e].f2};
+        size_t locFish2[2] = {elems[e].f2, elems[e].f1};
 
-        print -> stageFinished = 1;
+        mat_set_value(mat, locFish1, valFish);
+        mat_set_value(mat, locFish2, valFish);
 
-        #pragma omp single
+        /* Update the progress */
+        #pragma omp critical
           {
-            print_set_stagefinished(print, 1);
-            print_set_progress(print, 1.);
-
-//            print_fish(print);
+            print_update_progress(print, 1. / (double) elemsSize);
+            print_fish(print);
           }
 
+      } // End elements for
 
-        /* Free memory */
 
-        deriv1 = spec_deriv_free(deriv1);
-        deriv2 = spec_deriv_free(deriv2);
+    /* Stage has finished: print a message and the execution time */
 
+    print_set_stagefinished(print, 1);
+    print_set_progress(print, 1.);
 
-      } // End pragma parallel
+    print_fish(print);
 
 
     /* Free memory */
 
+    free(partsOffset);
+    free(elems);
+
+
     corrEigval = mat_free(corrEigval);
     corrEigvec = mat_free(corrEigvec);
 
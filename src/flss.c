@@ -85,6 +85,8 @@ const char *_idInf_ = "inf";
 const char *_idIntgrtCQUAD_ = "cquad";
 const char *_idIntgrtVegas_ = "vegas";
 const char *_idIntgrtDivonne_ = "divonne";
+const char *_idIntgrtQMC_ = "qmc";
+const char *_idIntgrtCubature_ = "cubature";
 
 
 /**  Shape Identifiers  **/
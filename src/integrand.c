@@ -204,12 +204,928 @@ double integrand_spec_pnl_p13_1loop(double *var, size_t dim, void *params)
 }
 
 
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrand_spec_pnl_p22_1loop_batch(double *var, size_t dim, size_t nVec, void *params, double *result)
+{
+    /*
+
+        Integrand of P_22(k_) (see integrand_spec_pnl_p22_1loop) for nVec points var[i * dim + j] at once.
+
+        The points are processed in blocks of __INTGRND_BATCH_SIZE__: the scales and angles are first collected in
+        separate arrays, then the power spectra and the kernels (kernels_z2_batch) are evaluated over the whole block.
+
+    */
+
+    /* Kern parameters */
+    kern_t *kern = (kern_t*) params;
+
+    /* Scales and angles at which loop integral is performed */
+    double k = kernels_qget_k(kern, 0);
+    double mu = kernels_qget_mu(kern, 0);
+
+    /* Variables of a block */
+    double q[__INTGRND_BATCH_SIZE__];
+    double muq[__INTGRND_BATCH_SIZE__];
+    double kq[__INTGRND_BATCH_SIZE__];
+    double mukq[__INTGRND_BATCH_SIZE__];
+    double nukq[__INTGRND_BATCH_SIZE__];
+
+    /* Variables of the renormalisation term Z2(-q_, q_) */
+    double muqRe[__INTGRND_BATCH_SIZE__];
+    double nuRe[__INTGRND_BATCH_SIZE__];
+
+    /* Contributions of a block */
+    double pq[__INTGRND_BATCH_SIZE__];
+    double pkq[__INTGRND_BATCH_SIZE__];
+
+    double z2[__INTGRND_BATCH_SIZE__];
+    double z2Re[__INTGRND_BATCH_SIZE__];
+
+    for (size_t start = 0; start < nVec; start += __INTGRND_BATCH_SIZE__)
+      {
+        size_t n = (nVec - start < __INTGRND_BATCH_SIZE__) ? nVec - start : __INTGRND_BATCH_SIZE__;
+
+        /* Variables */
+        for (size_t i = 0; i < n; i++)
+          {
+            double *x = var + (start + i) * dim;
+
+            /* |q_| + q_.s_ / q */
+            q[i] = x[0];
+            muq[i] = sqrt( (1. - mu*mu) * (1. - x[1]*x[1]) ) * cos(x[2]) + mu*x[1];
+
+            /* |k_ - q_| + (k_ - q_).s_ / |k_ - q_| + (k_ - q_).q_ / (|k_ - q_| q) */
+            kq[i] = sqrt( q[i]*q[i] + k*k - 2.*k*q[i]*x[1] );
+            mukq[i] = (k*mu - q[i]*muq[i]) / kq[i];
+            nukq[i] = (k*x[1] - q[i]) / kq[i];
+
+            muqRe[i] = -muq[i];
+            nuRe[i] = -1.;
+          }
+
+        /* Power spectrum */
+        fid_pk_eval_n(q, pq, n);
+        fid_pk_eval_n(kq, pkq, n);
+
+        /* Kernels */
+        kernels_z2_batch(kern, n, kq, q, nukq, mukq, muq, z2);
+        kernels_z2_batch(kern, n, q, q, nuRe, muqRe, muq, z2Re);
+
+        /* Integrand */
+        for (size_t i = 0; i < n; i++)
+            result[start + i] = q[i]*q[i] * pq[i] * (z2[i]*z2[i] * pkq[i] - z2Re[i]*z2Re[i] * pq[i]);
+      }
+
+    return 0;
+}
+
+
+double integrand_spec_pnl_p22_sym_1loop(double *var, size_t dim, void *params)
+{
+    /*
+
+        IR-safe integrand of P_22(k_): the integrand of integrand_spec_pnl_p22_1loop (without the renormalisation) is
+        symmetric under q_ <-> k_-q_, so it is restricted to q < |k_-q_| (i.e. nu < k / (2q)) and doubled. Averaging
+        the points q_ and -q_ then cancels the IR-sensitive terms (Z2 ~ k_.q_ / q^2 for q -> 0) point by point:
+
+            q^2 P^(0)(q) ( Θ(|k_-q_| - q) Z2(k_-q_, q_) Z2(k_-q_, q_) P^(0)(|k_-q_|)
+                            + Θ(|k_+q_| - q) Z2(k_+q_, -q_) Z2(k_+q_, -q_) P^(0)(|k_+q_|)
+                            - Z2(-q_, q_) Z2(-q_, q_) P^(0)(q) ).
+
+    */
+
+
+    /* Not used */
+    (void) dim;
+
+    /* Kern parameters */
+    kern_t *kern = (kern_t*) params;
+
+
+    /* Use correct variables */
+
+    /* Scales and angles at which loop integral is performed */
+    double k = kernels_qget_k(kern, 0);
+    double mu = kernels_qget_mu(kern, 0);
+
+    /* Integration variables */
+    double q = var[0];
+    double nu = var[1];
+    double cphi = cos(var[2]);
+
+    /* |q_| */
+    kernels_qset_k(kern, 1, q);
+
+    /* q_.s_ / q */
+    double muq = sqrt( (1. - mu*mu) * (1. - nu*nu) ) * cphi + mu*nu;
+
+
+    /* Contributions */
+
+    /* Power spectrum */
+    double pq = _fidPk_(&q, _fidParamsPk_);
+
+    /* Points q_ and -q_ with q < |k_ -+ q_| */
+    double result = 0.;
+
+    for (int sign = 1; sign >= -1; sign -= 2)
+      {
+        double nuSign = sign * nu;
+        double muqSign = sign * muq;
+
+        if (2. * q * nuSign >= k)
+            continue;
+
+        kernels_qset_mu(kern, 1, muqSign);
+
+        /* |k_ -+ q_| */
+        double kq = sqrt( q*q + k*k - 2.*k*q*nuSign );
+        kernels_qset_k(kern, 0, kq);
+
+        /* (k_ -+ q_).s_ / |k_ -+ q_| */
+        double mukq = (k*mu - q*muqSign) / kq;
+        kernels_qset_mu(kern, 0, mukq);
+
+        /* (k_ -+ q_).(+-q_) / (|k_ -+ q_| q) */
+        double nukq = (k*nuSign - q) / kq;
+        kernels_qset_nu(kern, 0, 1, nukq);
+
+        double pkq = _fidPk_(&kq, _fidParamsPk_);
+        double z2 = kernels_z2(kern);
+
+        result += z2*z2 * pkq;
+      }
+
+    /* Renormalisation term */
+    kernels_qset_k(kern, 0, q);
+    kernels_qset_mu(kern, 0, -muq);
+    kernels_qset_mu(kern, 1, muq);
+    kernels_qset_nu(kern, 0, 1, -1.);
+
+    double z2Re = kernels_z2(kern);
+
+    /* Compute the integrand */
+    result = q*q * pq * (result - z2Re*z2Re * pq);
+
+    /* Reset kern */
+    kernels_qset_k(kern, 0, k);
+    kernels_qset_mu(kern, 0, mu);
+
+    return result;
+}
+
+
+int integrand_spec_pnl_p22_sym_1loop_batch(double *var, size_t dim, size_t nVec, void *params, double *result)
+{
+    /*
+
+        IR-safe integrand of P_22(k_) (see integrand_spec_pnl_p22_sym_1loop) for nVec points var[i * dim + j] at once.
+
+        The points q_ and -q_ of a block are collected in the two halves of the arrays, so that kernels_z2_batch
+        evaluates both at once (points outside of q < |k_ -+ q_| are kept, but do not contribute).
+
+    */
+
+    /* Kern parameters */
+    kern_t *kern = (kern_t*) params;
+
+    /* Scales and angles at which loop integral is performed */
+    double k = kernels_qget_k(kern, 0);
+    double mu = kernels_qget_mu(kern, 0);
+
+    /* Variables of a block (q_ in [0, n) and -q_ in [n, 2n)) */
+    double q[2 * __INTGRND_BATCH_SIZE__];
+    double muq[2 * __INTGRND_BATCH_SIZE__];
+    double kq[2 * __INTGRND_BATCH_SIZE__];
+    double mukq[2 * __INTGRND_BATCH_SIZE__];
+    double nukq[2 * __INTGRND_BATCH_SIZE__];
+
+    bool inside[2 * __INTGRND_BATCH_SIZE__];
+
+    /* Variables of the renormalisation term Z2(-q_, q_) */
+    double muqRe[__INTGRND_BATCH_SIZE__];
+    double nuRe[__INTGRND_BATCH_SIZE__];
+
+    /* Contributions of a block */
+    double pq[__INTGRND_BATCH_SIZE__];
+    double pkq[2 * __INTGRND_BATCH_SIZE__];
+
+    double z2[2 * __INTGRND_BATCH_SIZE__];
+    double z2Re[__INTGRND_BATCH_SIZE__];
+
+    for (size_t start = 0; start < nVec; start += __INTGRND_BATCH_SIZE__)
+      {
+        size_t n = (nVec - start < __INTGRND_BATCH_SIZE__) ? nVec - start : __INTGRND_BATCH_SIZE__;
+
+        /* Variables */
+        for (size_t i = 0; i < n; i++)
+          {
+            double *x = var + (start + i) * dim;
+
+            /* |q_| + q_.s_ / q */
+            q[i] = x[0];
+            q[n + i] = x[0];
+
+            muq[i] = sqrt( (1. - mu*mu) * (1. - x[1]*x[1]) ) * cos(x[2]) + mu*x[1];
+            muq[n + i] = -muq[i];
+
+            /* |k_ -+ q_| + (k_ -+ q_).s_ / |k_ -+ q_| + (k_ -+ q_).(+-q_) / (|k_ -+ q_| q) */
+            for (size_t j = i; j < 2 * n; j += n)
+              {
+                double nuSign = (j < n) ? x[1] : -x[1];
+
+                inside[j] = 2. * q[j] * nuSign < k;
+
+                kq[j] = sqrt( q[j]*q[j] + k*k - 2.*k*q[j]*nuSign );
+                mukq[j] = (k*mu - q[j]*muq[j]) / kq[j];
+                nukq[j] = (k*nuSign - q[j]) / kq[j];
+              }
+
+            muqRe[i] = -muq[i];
+            nuRe[i] = -1.;
+          }
+
+        /* Power spectrum */
+        fid_pk_eval_n(q, pq, n);
+        fid_pk_eval_n(kq, pkq, 2 * n);
+
+        for (size_t j = 0; j < 2 * n; j++)
+            pkq[j] = (inside[j]) ? pkq[j] : 0.;
+
+        /* Kernels */
+        kernels_z2_batch(kern, 2 * n, kq, q, nukq, mukq, muq, z2);
+        kernels_z2_batch(kern, n, q, q, nuRe, muqRe, muq, z2Re);
+
+        /* Integrand */
+        for (size_t i = 0; i < n; i++)
+            result[start + i] = q[i]*q[i] * pq[i] * (z2[i]*z2[i] * pkq[i] + z2[n + i]*z2[n + i] * pkq[n + i]
+                                                       - z2Re[i]*z2Re[i] * pq[i]);
+      }
+
+    return 0;
+}
+
+
+int integrand_spec_pnl_p13_1loop_batch(double *var, size_t dim, size_t nVec, void *params, double *result)
+{
+    /*
+
+        Integrand of P_13(k_) (see integrand_spec_pnl_p13_1loop) for nVec points var[i * dim + j] at once.
+
+        The points are processed in blocks of __INTGRND_BATCH_SIZE__ for which the scales, angles, power spectra and
+        kernels (kernels_z3_batch) are evaluated over the whole block.
+
+    */
+
+    /* Kern parameters */
+    kern_t *kern = (kern_t*) params;
+
+    /* Renormalise b2 -> 0 */
+    double b2 = kern -> bias -> b2;
+    kern -> bias -> b2 = 0.;
+
+    /* Scales and angles at which loop integral is performed */
+    double k = kernels_qget_k(kern, 0);
+    double mu = kernels_qget_mu(kern, 0);
+
+    /* Contributions independent of q_ */
+    double pk = _fidPk_(&k, _fidParamsPk_);
+    double z1 = kernels_z1(kern);
+
+    /* Variables of a block (the configuration of Z3 is (k_, q_, -q_)) */
+    double q[__INTGRND_BATCH_SIZE__];
+    double nu[__INTGRND_BATCH_SIZE__];
+    double nuRe[__INTGRND_BATCH_SIZE__];
+    double muq[__INTGRND_BATCH_SIZE__];
+    double muqRe[__INTGRND_BATCH_SIZE__];
+
+    double kk[__INTGRND_BATCH_SIZE__];
+    double mukk[__INTGRND_BATCH_SIZE__];
+    double nuqq[__INTGRND_BATCH_SIZE__];
+
+    /* Contributions of a block */
+    double pq[__INTGRND_BATCH_SIZE__];
+    double z3[__INTGRND_BATCH_SIZE__];
+
+    for (size_t i = 0; i < __INTGRND_BATCH_SIZE__; i++)
+      {
+        kk[i] = k;
+        mukk[i] = mu;
+        nuqq[i] = -1.;
+      }
+
+    for (size_t start = 0; start < nVec; start += __INTGRND_BATCH_SIZE__)
+      {
+        size_t n = (nVec - start < __INTGRND_BATCH_SIZE__) ? nVec - start : __INTGRND_BATCH_SIZE__;
+
+        /* Variables */
+        for (size_t i = 0; i < n; i++)
+          {
+            double *x = var + (start + i) * dim;
+
+            q[i] = x[0];
+            nu[i] = x[1];
+            muq[i] = sqrt( (1. - mu*mu) * (1. - x[1]*x[1]) ) * cos(x[2]) + mu*x[1];
+
+            nuRe[i] = -nu[i];
+            muqRe[i] = -muq[i];
+          }
+
+        /* Power spectrum */
+        fid_pk_eval_n(q, pq, n);
+
+        /* Kernels */
+        kernels_z3_batch(kern, n, kk, q, q, nu, nuRe, nuqq, mukk, muq, muqRe, z3);
+
+        /* Integrand */
+        for (size_t i = 0; i < n; i++)
+            result[start + i] = 3. * q[i]*q[i] * pq[i] * z3[i] * z1 * pk;
+      }
+
+    /* Reset b2 */
+    kern -> bias -> b2 = b2;
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+double integrand_spec_pnl_p22_basis_1loop(double *var, size_t dim, void *params)
+{
+    /*
+
+        Integrand of the bias and RSD basis term (i, j) of P_22(k_) (see kernels_z2_basis):
+
+            q^2 P^(0)(q) ( Z2_i(k_-q_, q_) Z2_j(k_-q_, q_) P^(0)(|k_-q_|)
+                            - Z2_i(-q_, q_) Z2_j(-q_, q_) P^(0)(q) ).
+
+    */
+
+
+    /* Not used */
+    (void) dim;
+
+    /* Basis parameters */
+    intgrnd_basis_t *basis = (intgrnd_basis_t*) params;
+
+    /* Kern parameters */
+    kern_t *kern = basis -> kern;
+
+
+    /* Use correct variables */
+
+    /* Scales and angles at which loop integral is performed */
+    double k = kernels_qget_k(kern, 0);
+    double mu = kernels_qget_mu(kern, 0);
+
+    /* Integration variables */
+    double q = var[0];
+    double nu = var[1];
+    double cphi = cos(var[2]);
+
+    /* |q_| */
+    kernels_qset_k(kern, 1, q);
+
+    /* q_.s_ / q */
+    double muq = sqrt( (1. - mu*mu) * (1. - nu*nu) ) * cphi + mu*nu;
+    kernels_qset_mu(kern, 1, muq);
+
+    /* |k_ - q_| */
+    double kq = sqrt( q*q + k*k - 2.*k*q*nu );
+    kernels_qset_k(kern, 0, kq);
+
+    /* (k_ - q_).s_ / |k_ - q_| */
+    double mukq = (k*mu - q*muq) / kq;
+    kernels_qset_mu(kern, 0, mukq);
+
+    /* (k_ - q_).q_ / (|k_ - q_| q) */
+    double nukq = (k*nu - q) / kq;
+    kernels_qset_nu(kern, 0, 1, nukq);
+
+
+    /* Contributions */
+
+    /* Power spectrum */
+    double pq = _fidPk_(&q, _fidParamsPk_);
+    double pkq = _fidPk_(&kq, _fidParamsPk_);
+
+    /* Compute kernels */
+    double z2Basis[__KERN_Z2_BASIS_SIZE__];
+    kernels_z2_basis(kern, z2Basis);
+
+    kernels_qset_k(kern, 0, q);
+    kernels_qset_mu(kern, 0, -muq);
+    kernels_qset_nu(kern, 0, 1, -1.);
+
+    double z2BasisRe[__KERN_Z2_BASIS_SIZE__];
+    kernels_z2_basis(kern, z2BasisRe);
+
+    /* Compute the integrand */
+    double result = q*q * pq * ( z2Basis[basis -> index1] * z2Basis[basis -> index2] * pkq
+                               - z2BasisRe[basis -> index1] * z2BasisRe[basis -> index2] * pq );
+
+    /* Reset kern */
+    kernels_qset_k(kern, 0, k);
+    kernels_qset_mu(kern, 0, mu);
+
+    return result;
+}
+
+
+double integrand_spec_pnl_p13_basis_1loop(double *var, size_t dim, void *params)
+{
+    /*
+
+        Integrand of the bias and RSD basis term i of P_13(k_) / Z1(k_) (see kernels_z3_basis):
+
+            3 q^2 Z3_i(k_, -q_, q_) P^(0)(q) P^(0)(k).
+
+    */
+
+
+    /* Not used */
+    (void) dim;
+
+    /* Basis parameters */
+    intgrnd_basis_t *basis = (intgrnd_basis_t*) params;
+
+    /* Kern parameters */
+    kern_t *kern = basis -> kern;
+
+
+    /* Use correct variables */
+
+    /* Scales and angles at which loop integral is performed */
+    double k = kernels_qget_k(kern, 0);
+    double mu = kernels_qget_mu(kern, 0);
+
+    /* Integration variables */
+    double q = var[0];
+    double nu = var[1];
+    double cphi = cos(var[2]);
+
+    kernels_qset_k(kern, 1, q);
+    kernels_qset_k(kern, 2, q);
+
+    kernels_qset_nu(kern, 0, 1, nu);
+    kernels_qset_nu(kern, 0, 2, -nu);
+    kernels_qset_nu(kern, 1, 2, -1.);
+
+    /* q_.s_ / q */
+    double muq = sqrt( (1. - mu*mu) * (1. - nu*nu) ) * cphi + mu*nu;
+    kernels_qset_mu(kern, 1, muq);
+
+    /* -q_.s_ / q */
+    kernels_qset_mu(kern, 2, -muq);
+
+
+    /* Contributions */
+
+    /* Power spectrum */
+    double pk = _fidPk_(&k, _fidParamsPk_);
+    double pq = _fidPk_(&q, _fidParamsPk_);
+
+    /* Kernels */
+    double z3Basis[__KERN_Z3_BASIS_SIZE__];
+    kernels_z3_basis(kern, z3Basis);
+
+    /* Integrand */
+    double result = 3. * q*q * pq * z3Basis[basis -> index1] * pk;
+
+    return result;
+}
+
+
+int integrand_spec_pnl_basis_1loop_vec(double *var, size_t dim, void *params, double *result)
+{
+    /*
+
+        Vector valued integrand of all bias and RSD basis terms of P_22(k_) and P_13(k_) / Z1(k_) (see the corresponding
+        scalar integrands), where only the components flagged in params -> comp are computed and stored (in order) in
+        result.
+
+        The kinematics, power spectra and kernels shared by all components are only computed once per point.
+
+    */
+
+
+    /* Not used */
+    (void) dim;
+
+    /* Parameters */
+    intgrnd_basis_vec_t *paramsBasis = (intgrnd_basis_vec_t*) params;
+    bool *comp = paramsBasis -> comp;
+
+    /* Kern parameters */
+    kern_t *kern = paramsBasis -> kern;
+
+
+    /* Use correct variables */
+
+    /* Scales and angles at which loop integral is performed */
+    double k = kernels_qget_k(kern, 0);
+    double mu = kernels_qget_mu(kern, 0);
+
+    /* Integration variables */
+    double q = var[0];
+    double nu = var[1];
+    double cphi = cos(var[2]);
+
+    /* q_.s_ / q */
+    double muq = sqrt( (1. - mu*mu) * (1. - nu*nu) ) * cphi + mu*nu;
+
+    /* Power spectrum */
+    double pk = _fidPk_(&k, _fidParamsPk_);
+    double pq = _fidPk_(&q, _fidParamsPk_);
+
+
+    /**  P22  **/
+
+    /* |q_| */
+    kernels_qset_k(kern, 1, q);
+    kernels_qset_mu(kern, 1, muq);
+
+    /* |k_ - q_| */
+    double kq = sqrt( q*q + k*k - 2.*k*q*nu );
+    kernels_qset_k(kern, 0, kq);
+
+    /* (k_ - q_).s_ / |k_ - q_| */
+    double mukq = (k*mu - q*muq) / kq;
+    kernels_qset_mu(kern, 0, mukq);
+
+    /* (k_ - q_).q_ / (|k_ - q_| q) */
+    double nukq = (k*nu - q) / kq;
+    kernels_qset_nu(kern, 0, 1, nukq);
+
+    /* Power spectrum */
+    double pkq = _fidPk_(&kq, _fidParamsPk_);
+
+    /* Compute kernels */
+    double z2Basis[__KERN_Z2_BASIS_SIZE__];
+    kernels_z2_basis(kern, z2Basis);
+
+    kernels_qset_k(kern, 0, q);
+    kernels_qset_mu(kern, 0, -muq);
+    kernels_qset_nu(kern, 0, 1, -1.);
+
+    double z2BasisRe[__KERN_Z2_BASIS_SIZE__];
+    kernels_z2_basis(kern, z2BasisRe);
+
+    /* Reset kern */
+    kernels_qset_k(kern, 0, k);
+    kernels_qset_mu(kern, 0, mu);
+
+    size_t n = 0;
+    size_t index = 0;
+
+    for (size_t i = 0; i < __KERN_Z2_BASIS_SIZE__; i++)
+      {
+        for (size_t j = i; j < __KERN_Z2_BASIS_SIZE__; j++)
+          {
+            if (comp[index++])
+                result[n++] = q*q * pq * ( z2Basis[i] * z2Basis[j] * pkq - z2BasisRe[i] * z2BasisRe[j] * pq );
+          }
+      }
+
+
+    /**  P13  **/
+
+    kernels_qset_k(kern, 2, q);
+
+    kernels_qset_nu(kern, 0, 1, nu);
+    kernels_qset_nu(kern, 0, 2, -nu);
+    kernels_qset_nu(kern, 1, 2, -1.);
+
+    /* -q_.s_ / q */
+    kernels_qset_mu(kern, 2, -muq);
+
+    /* Kernels */
+    double z3Basis[__KERN_Z3_BASIS_SIZE__];
+    kernels_z3_basis(kern, z3Basis);
+
+    for (size_t i = 0; i < __KERN_Z3_BASIS_SIZE__; i++)
+      {
+        if (comp[index++])
+            result[n++] = 3. * q*q * pq * z3Basis[i] * pk;
+      }
+
+    return 0;
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ####################################   Function Declarations   #######################################  */
+
+static double _integrand_radial_nu(intgrnd_radial_t *radial, double *varAng, double nuMin, double nuMax, double whole, double absErr,
+                                   size_t depth);
+static double _integrand_radial_panel(intgrnd_radial_t *radial, double *varAng, double nuMin, double nuMax);
+
+/*  ######################################################################################################  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+double integrand_spec_p13_radial_1loop(double *var, size_t dim, void *params)
+{
+    /*
+
+        Angular part of a P13-type integrand f(q, nu, phi) (given in params) at fixed q = var[0]:
+
+            int_{-1}^{1} dnu int_{0}^{2 pi} dphi f(q, nu, phi).
+
+        The P13 integrands only depend on phi through q_.s_, i.e. they are polynomials in cos(phi) of at most sixth
+        order (Z3 has at most six factors of the line of sight), so the integral over phi is done exactly with the
+        __INTGRND_RADIAL_PHI_SIZE__ point Gauss-Chebyshev rule in cos(phi) (exact up to order 2 __INTGRND_RADIAL_PHI_SIZE__ - 1),
+        where the nodes phi and 2 pi - phi are combined.
+
+        The integrand is peaked in nu near the endpoints nu -> ±1 if q is close to k, so the integral over nu is
+        adaptive: a panel with __INTGRND_RADIAL_NU_SIZE__ Gauss-Legendre nodes is bisected until the two halves agree
+        with the whole panel within __INTGRND_RADIAL_NU_RELERR__ (or the depth __INTGRND_RADIAL_NU_DEPTH__ is reached),
+        starting from the whole range [-1, 1].
+
+    */
+
+    /* Not used */
+    (void) dim;
+
+    /* Radial parameters */
+    intgrnd_radial_t *radial = (intgrnd_radial_t*) params;
+
+    /* Integration variables of the 3d integrand */
+    double varAng[3] = {var[0], 0., 0.};
+
+    /* Integrate over nu and phi (the error is relative to the halves of the whole range to allow for cancellations) */
+    double whole = _integrand_radial_panel(radial, varAng, -1., 1.);
+
+    double left = _integrand_radial_panel(radial, varAng, -1., 0.);
+    double right = _integrand_radial_panel(radial, varAng, 0., 1.);
+
+    double absErr = __INTGRND_RADIAL_NU_RELERR__ * (fabs(left) + fabs(right));
+
+    if (fabs(left + right - whole) <= absErr)
+        return left + right;
+
+    double result = _integrand_radial_nu(radial, varAng, -1., 0., left, absErr / 2., __INTGRND_RADIAL_NU_DEPTH__)
+                  + _integrand_radial_nu(radial, varAng, 0., 1., right, absErr / 2., __INTGRND_RADIAL_NU_DEPTH__);
+
+    return result;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static double _integrand_radial_nu(intgrnd_radial_t *radial, double *varAng, double nuMin, double nuMax, double whole, double absErr,
+                                   size_t depth)
+{
+    /*
+
+        Adaptive integral over nu in [nuMin, nuMax], where whole is the integral of the panel: the panel is bisected
+        (recursively, at most depth times) until the halves agree with the whole panel within absErr
+
+    */
+
+    double nuMid = (nuMin + nuMax) / 2.;
+
+    double left = _integrand_radial_panel(radial, varAng, nuMin, nuMid);
+    double right = _integrand_radial_panel(radial, varAng, nuMid, nuMax);
+
+    if (depth == 0 || fabs(left + right - whole) <= absErr)
+        return left + right;
+
+    return _integrand_radial_nu(radial, varAng, nuMin, nuMid, left, absErr / 2., depth - 1)
+         + _integrand_radial_nu(radial, varAng, nuMid, nuMax, right, absErr / 2., depth - 1);
+}
+
+
+static double _integrand_radial_panel(intgrnd_radial_t *radial, double *varAng, double nuMin, double nuMax)
+{
+    /*
+
+        Integral over the panel nu in [nuMin, nuMax] (Gauss-Legendre) and phi in [0, 2 pi] (Gauss-Chebyshev in cos(phi),
+        i.e. the midpoint rule in phi with the nodes phi and 2 pi - phi combined)
+
+    */
+
+    double result = 0.;
+
+    for (size_t i = 0; i < __INTGRND_RADIAL_NU_SIZE__; i++)
+      {
+        double weightNu;
+        gsl_integration_glfixed_point(nuMin, nuMax, i, &varAng[1], &weightNu, radial -> table);
+
+        double resultPhi = 0.;
+
+        for (size_t j = 0; j < __INTGRND_RADIAL_PHI_SIZE__; j++)
+          {
+            varAng[2] = M_PI * (2. * (double) j + 1.) / (2. * (double) __INTGRND_RADIAL_PHI_SIZE__);
+
+            resultPhi += radial -> integrand(varAng, 3, radial -> params);
+          }
+
+        result += weightNu * resultPhi;
+      }
+
+    result *= 2. * M_PI / (double) __INTGRND_RADIAL_PHI_SIZE__;
+
+    return result;
+}
+
 
 /*  ------------------------------------------------------------------------------------------------------  */
 /*  -----------------------    Non-Linear Power Spectrum (Analytical) Derivatives    ---------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
+int integrand_spec_dpnl_1loop_vec(double *var, size_t dim, void *params, double *result)
+{
+    /*
+
+        Vector valued integrand of Pnl(k_) and its derivatives (see the corresponding scalar integrands), where only the
+        components flagged in params -> comp are computed and stored (in order) in result.
+
+        The kinematics, power spectra and kernels shared by all components are only computed once per point.
+
+    */
+
+
+    /* Not used */
+    (void) dim;
+
+    /* Parameters */
+    intgrnd_dpnl_t *paramsDPnl = (intgrnd_dpnl_t*) params;
+    bool *comp = paramsDPnl -> comp;
+
+    /* Kern parameters */
+    kern_t *kern = paramsDPnl -> kern;
+
+
+    /* Use correct variables */
+
+    /* Scales and angles at which loop integral is performed */
+    double k = kernels_qget_k(kern, 0);
+    double mu = kernels_qget_mu(kern, 0);
+
+    /* Integration variables */
+    double q = var[0];
+    double nu = var[1];
+    double cphi = cos(var[2]);
+
+    /* q_.s_ / q */
+    double muq = sqrt( (1. - mu*mu) * (1. - nu*nu) ) * cphi + mu*nu;
+
+    /* Power spectrum */
+    double pk = _fidPk_(&k, _fidParamsPk_);
+    double pq = _fidPk_(&q, _fidParamsPk_);
+
+    /* Components */
+    double dp[__INTGRND_DPNL_SIZE__] = {0.};
+
+
+    /**  P22  **/
+
+    /* |q_| */
+    kernels_qset_k(kern, 1, q);
+    kernels_qset_mu(kern, 1, muq);
+
+    /* |k_ - q_| */
+    double kq = sqrt( q*q + k*k - 2.*k*q*nu );
+    double dkq = (k - q*nu) / kq;
+    kernels_qset_k(kern, 0, kq);
+
+    /* (k_ - q_).s_ / |k_ - q_| */
+    double mukq = (k*mu - q*muq) / kq;
+    double dmukq = (mu - mukq * dkq) / kq;
+    kernels_qset_mu(kern, 0, mukq);
+
+    /* (k_ - q_).q_ / (|k_ - q_| q) */
+    double nukq = (k*nu - q) / kq;
+    double dnukq = (nu - nukq * dkq) / kq;
+    kernels_qset_nu(kern, 0, 1, nukq);
+
+    /* Power spectrum */
+    double pkq = _fidPk_(&kq, _fidParamsPk_);
+
+    /* Kernel and its derivatives w.r.t. all kernel parameters (in one pass) */
+    kern_dual_t z2Dual;
+    kernels_z2_dual(kern, &z2Dual);
+
+    double z2 = z2Dual.val;
+
+    /* Derivatives (the contributions of a3ga, d3ga and bGam3 vanish) */
+    if (comp[__INTGRND_DPNL_A2GA__]) dp[__INTGRND_DPNL_A2GA__] = 2. * q*q * pq * z2 * z2Dual.d[__KERN_DUAL_A2GA__] * pkq;
+    if (comp[__INTGRND_DPNL_D2GA__]) dp[__INTGRND_DPNL_D2GA__] = 2. * q*q * pq * z2 * z2Dual.d[__KERN_DUAL_D2GA__] * pkq;
+
+    if (comp[__INTGRND_DPNL_B1__]) dp[__INTGRND_DPNL_B1__] = 2. * q*q * pq * z2 * z2Dual.d[__KERN_DUAL_B1__] * pkq;
+    if (comp[__INTGRND_DPNL_B2__]) dp[__INTGRND_DPNL_B2__] = 2. * q*q * pq * z2 * z2Dual.d[__KERN_DUAL_B2__] * pkq;
+    if (comp[__INTGRND_DPNL_C2GA__]) dp[__INTGRND_DPNL_C2GA__] = 2. * q*q * pq * z2 * z2Dual.d[__KERN_DUAL_C2GA__] * pkq;
+
+    if (comp[__INTGRND_DPNL_F__]) dp[__INTGRND_DPNL_F__] = 2. * q*q * pq * z2 * z2Dual.d[__KERN_DUAL_F__] * pkq;
+
+    if (comp[__INTGRND_DPNL_K__])
+      {
+        double dpkq = _fidDPk_(&kq, _fidParamsDPk_) * dkq;
+        double dz2 = kernels_dz2_k(kern) * dkq + kernels_dz2_nu(kern) * dnukq + kernels_dz2_mu(kern) * dmukq;
+
+        dp[__INTGRND_DPNL_K__] = q*q * pq * z2 * (2. * dz2 * pkq + z2 * dpkq);
+      }
+
+    /* Renormalisation */
+    if (comp[__INTGRND_DPNL_PNL__] || comp[__INTGRND_DPNL_B2__])
+      {
+        kernels_qset_k(kern, 0, q);
+        kernels_qset_mu(kern, 0, -muq);
+        kernels_qset_nu(kern, 0, 1, -1.);
+
+        double z2Re = kernels_z2(kern);
+
+        if (comp[__INTGRND_DPNL_PNL__]) dp[__INTGRND_DPNL_PNL__] = q*q * pq * (z2*z2 * pkq - z2Re*z2Re * pq);
+        if (comp[__INTGRND_DPNL_B2__]) dp[__INTGRND_DPNL_B2__] -= 2. * q*q * pq * z2Re * kernels_dz2_b2(kern) * pq;
+      }
+
+    /* Reset kern */
+    kernels_qset_k(kern, 0, k);
+    kernels_qset_mu(kern, 0, mu);
+
+
+    /**  P13  **/
+
+    /* Renormalise b2 -> 0 */
+    double b2 = kern -> bias -> b2;
+    kern -> bias -> b2 = 0.;
+
+    kernels_qset_k(kern, 1, q);
+    kernels_qset_k(kern, 2, q);
+
+    kernels_qset_nu(kern, 0, 1, nu);
+    kernels_qset_nu(kern, 0, 2, -nu);
+    kernels_qset_nu(kern, 1, 2, -1.);
+
+    /* q_.s_ / q */
+    kernels_qset_mu(kern, 1, muq);
+
+    /* -q_.s_ / q */
+    kernels_qset_mu(kern, 2, -muq);
+
+    /* Kernels and their derivatives w.r.t. all kernel parameters (in one pass) */
+    kern_dual_t z1Dual, z3Dual;
+    kernels_z1_dual(kern, &z1Dual);
+    kernels_z3_dual(kern, &z3Dual);
+
+    double z1 = z1Dual.val;
+    double z3 = z3Dual.val;
+
+    /* Common factor */
+    double factor = 3. * q*q * pq * pk;
+
+    /* Derivatives (the contribution of b2 vanishes, a^(2)_γ enters Z3 also through h) */
+    if (comp[__INTGRND_DPNL_PNL__]) dp[__INTGRND_DPNL_PNL__] += factor * z3 * z1;
+
+    if (comp[__INTGRND_DPNL_A2GA__]) dp[__INTGRND_DPNL_A2GA__] += factor * (z3Dual.d[__KERN_DUAL_A2GA__] + z3Dual.d[__KERN_DUAL_H__]) * z1;
+    if (comp[__INTGRND_DPNL_D2GA__]) dp[__INTGRND_DPNL_D2GA__] += factor * z3Dual.d[__KERN_DUAL_D2GA__] * z1;
+
+    if (comp[__INTGRND_DPNL_A3GAA__]) dp[__INTGRND_DPNL_A3GAA__] += factor * z3Dual.d[__KERN_DUAL_A3GAA__] * z1;
+    if (comp[__INTGRND_DPNL_A3GAB__]) dp[__INTGRND_DPNL_A3GAB__] += factor * z3Dual.d[__KERN_DUAL_A3GAB__] * z1;
+    if (comp[__INTGRND_DPNL_D3GAA__]) dp[__INTGRND_DPNL_D3GAA__] += factor * z3Dual.d[__KERN_DUAL_D3GAA__] * z1;
+    if (comp[__INTGRND_DPNL_D3GAB__]) dp[__INTGRND_DPNL_D3GAB__] += factor * z3Dual.d[__KERN_DUAL_D3GAB__] * z1;
+
+    if (comp[__INTGRND_DPNL_B1__]) dp[__INTGRND_DPNL_B1__] += factor * (z3Dual.d[__KERN_DUAL_B1__] * z1 + z3 * z1Dual.d[__KERN_DUAL_B1__]);
+    if (comp[__INTGRND_DPNL_C2GA__]) dp[__INTGRND_DPNL_C2GA__] += factor * z3Dual.d[__KERN_DUAL_C2GA__] * z1;
+    if (comp[__INTGRND_DPNL_BGAM3__]) dp[__INTGRND_DPNL_BGAM3__] += factor * z3Dual.d[__KERN_DUAL_BGAM3__] * z1;
+
+    if (comp[__INTGRND_DPNL_F__]) dp[__INTGRND_DPNL_F__] += factor * (z3Dual.d[__KERN_DUAL_F__] * z1 + z3 * z1Dual.d[__KERN_DUAL_F__]);
+
+    if (comp[__INTGRND_DPNL_K__])
+      {
+        double dpk = _fidDPk_(&k, _fidParamsDPk_);
+
+        dp[__INTGRND_DPNL_K__] += 3. * q*q * pq * (kernels_dz3_k(kern) * pk + z3 * dpk) * z1;
+      }
+
+    /* Reset b2 */
+    kern -> bias -> b2 = b2;
+
+
+    /* Store the requested components */
+    size_t n = 0;
+
+    for (size_t i = 0; i < __INTGRND_DPNL_SIZE__; i++)
+      {
+        if (comp[i])
+            result[n++] = dp[i];
+      }
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
 double integrand_spec_dpnl_a2ga_1loop(double *var, size_t dim, void *params)
 {
     /*
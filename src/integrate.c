@@ -8,6 +8,11 @@
 #include "integrate.h"
 
 
+/* Cuba's integrand_t omits the trailing argument (const int *nvec) that Cuba passes to the integrand (see cuba.h), the
+   cast through a generic function pointer type avoids -Wcast-function-type */
+#define __INTGRT_CUBA_INTEGRAND__(integrand) ((integrand_t) (void (*)(void)) (integrand))
+
+
 /**  Integration Routines  **/
 
 const char *integrate_find_routine(const char *routine)
@@ -30,6 +35,14 @@ const char *integrate_find_routine(const char *routine)
     if (misc_sinci(routine, _idIntgrtDivonne_))
         return _idIntgrtDivonne_;
 
+    /* QMC */
+    if (misc_sinci(routine, _idIntgrtQMC_))
+        return _idIntgrtQMC_;
+
+    /* Cubature */
+    if (misc_sinci(routine, _idIntgrtCubature_))
+        return _idIntgrtCubature_;
+
     /* No routine found */
     printf("Did not find any '%s' integration routine.\n", routine);
     exit(1);
@@ -339,6 +352,83 @@ int integrate_vegas_set_verbose(intgrt_vegas_t *vegas, int verbose)
 
 
 
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ----------------------------------------   Vegas Grid Struct   ---------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+intgrt_vegas_grid_t *integrate_vegas_grid_new(void)
+{
+    /*
+
+        Create a new (empty) intgrt_vegas_grid_t struct
+
+    */
+
+    intgrt_vegas_grid_t *grid = malloc(sizeof(intgrt_vegas_grid_t));
+
+    grid -> state = NULL;
+
+    grid -> dim = 0;
+    grid -> lowerBounds = NULL;
+    grid -> upperBounds = NULL;
+
+    grid -> adapted = false;
+
+    return grid;
+}
+
+
+intgrt_vegas_grid_t *integrate_vegas_grid_free(intgrt_vegas_grid_t *grid)
+{
+    /*
+
+        Free grid
+
+    */
+
+    /* Check for NULL */
+    if (grid == NULL)
+        return NULL;
+
+    integrate_vegas_grid_reset(grid);
+
+    free(grid);
+
+    return NULL;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate_vegas_grid_reset(intgrt_vegas_grid_t *grid)
+{
+    /*
+
+        Discard the adapted grid, such that the next integral starts from a fresh one
+
+    */
+
+    if (grid -> state != NULL)
+        gsl_monte_vegas_free(grid -> state);
+
+    free(grid -> lowerBounds);
+    free(grid -> upperBounds);
+
+    grid -> state = NULL;
+
+    grid -> dim = 0;
+    grid -> lowerBounds = NULL;
+    grid -> upperBounds = NULL;
+
+    grid -> adapted = false;
+
+    return 0;
+}
+
+
+
 /*  ------------------------------------------------------------------------------------------------------  */
 /*  -----------------------------------------   Divonne Struct   -----------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
@@ -658,64 +748,45 @@ int integrate_divonne_set_verbose(intgrt_divonne_t *divonne, int verbose)
 
 
 /*  ------------------------------------------------------------------------------------------------------  */
-/*  ----------------------------------------   Integrate Struct   ----------------------------------------  */
+/*  -------------------------------------------   QMC Struct   -------------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-intgrt_t *integrate_new(void)
+intgrt_qmc_t *integrate_qmc_new(void)
 {
     /*
 
-        Create a new intgrt_t struct
+        Create a new intgrt_qmc_t struct
 
     */
 
-    intgrt_t *intgrt = malloc(sizeof(intgrt_t));
+    intgrt_qmc_t *qmc = malloc(sizeof(intgrt_qmc_t));
 
-    intgrt -> dim = 0;
+    qmc -> points = 1024;
+    qmc -> maxPoints = 65536;
 
-    intgrt -> upperBounds = NULL;
-    intgrt -> lowerBounds = NULL;
+    qmc -> scramblings = 8;
 
-    intgrt -> cquad = NULL;
-    intgrt -> vegas = NULL;
-    intgrt -> divonne = NULL;
+    qmc -> relErr = 1.e-3;
 
-    intgrt -> routine = _idIntgrtVegas_;
+    qmc -> seed = 0;
 
-    intgrt -> params = NULL;
+    qmc -> verbose = 0;
 
-    return intgrt;
+    return qmc;
 }
 
 
-intgrt_t *integrate_free(intgrt_t *intgrt)
+intgrt_qmc_t *integrate_qmc_free(intgrt_qmc_t *qmc)
 {
     /*
 
-        Free intgrt
+        Free qmc
 
     */
 
-    /* Check for NULL */
-    if (intgrt == NULL)
-        return NULL;
-
-    /* Free bounds */
-    free(intgrt -> upperBounds);
-    free(intgrt -> lowerBounds);
-
-    /* Free cquad */
-    intgrt -> cquad = integrate_cquad_free(intgrt -> cquad);
-
-    /* Free vegas */
-    intgrt -> vegas = integrate_vegas_free(intgrt -> vegas);
-
-    /* Free divonne */
-    intgrt -> divonne = integrate_divonne_free(intgrt -> divonne);
-
-    /* Free intgrt itself */
-    free(intgrt);
+    /* Free qmc (no need to check if qmc is NULL) */
+    free(qmc);
 
     return NULL;
 }
@@ -724,33 +795,32 @@ intgrt_t *integrate_free(intgrt_t *intgrt)
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-intgrt_t *integrate_cp(intgrt_t *intgrt)
+intgrt_qmc_t *integrate_qmc_cp(intgrt_qmc_t *qmc)
 {
     /*
 
-        Copy intgrt
+        Copy qmc
 
     */
 
     /* Check for NULL */
-    if (intgrt == NULL)
+    if (qmc == NULL)
         return NULL;
 
-    intgrt_t *intgrtCp = integrate_new();
+    intgrt_qmc_t *qmcCp = malloc(sizeof(intgrt_qmc_t));
 
-    integrate_set_dim(intgrtCp, intgrt -> dim);
-    integrate_set_bounds_upper(intgrtCp, intgrt -> upperBounds);
-    integrate_set_bounds_lower(intgrtCp, intgrt -> lowerBounds);
+    qmcCp -> points = qmc -> points;
+    qmcCp -> maxPoints = qmc -> maxPoints;
 
-    integrate_set_cquad(intgrtCp, intgrt -> cquad);
-    integrate_set_vegas(intgrtCp, intgrt -> vegas);
-    integrate_set_divonne(intgrtCp, intgrt -> divonne);
+    qmcCp -> scramblings = qmc -> scramblings;
 
-    integrate_set_routine(intgrtCp, intgrt -> routine);
+    qmcCp -> relErr = qmc -> relErr;
 
-    integrate_set_params(intgrtCp, intgrt -> params);
+    qmcCp -> seed = qmc -> seed;
 
-    return intgrtCp;
+    qmcCp -> verbose = qmc -> verbose;
+
+    return qmcCp;
 }
 
 
@@ -758,584 +828,2407 @@ intgrt_t *integrate_cp(intgrt_t *intgrt)
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-int integrate_set_bounds(intgrt_t *intgrt, size_t dim, double *ubounds, double *lbounds)
+int integrate_qmc_set_points(intgrt_qmc_t *qmc, size_t points)
 {
     /*
 
-        Set the integration bounds for intgrt
+        Set the initial number of points per scrambling in qmc
 
     */
 
-    intgrt -> dim = dim;
-
-    intgrt -> upperBounds = realloc(intgrt -> upperBounds, sizeof(double) * dim);
-    intgrt -> lowerBounds = realloc(intgrt -> lowerBounds, sizeof(double) * dim);
-
-    for (size_t i = 0; i < dim; i++)
-      {
-        intgrt -> upperBounds[i] = ubounds[i];
-        intgrt -> lowerBounds[i] = lbounds[i];
-      }
+    qmc -> points = points;
 
     return 0;
 }
 
-
-int integrate_set_dim(intgrt_t *intgrt, size_t dim)
+int integrate_qmc_set_maxpoints(intgrt_qmc_t *qmc, size_t maxPoints)
 {
     /*
 
-        Set the integration dimension for intgrt
+        Set the maximum number of points per scrambling in qmc
 
     */
 
-    intgrt -> dim = dim;
-
-    intgrt -> upperBounds = realloc(intgrt -> upperBounds, sizeof(double) * dim);
-    intgrt -> lowerBounds = realloc(intgrt -> lowerBounds, sizeof(double) * dim);
+    qmc -> maxPoints = maxPoints;
 
     return 0;
 }
 
-
-int integrate_set_bounds_upper(intgrt_t *intgrt, double *ubounds)
+int integrate_qmc_set_scramblings(intgrt_qmc_t *qmc, size_t scramblings)
 {
     /*
 
-        Set the integration upper bounds for intgrt
+        Set the number of scramblings in qmc
 
     */
 
-    if (intgrt -> dim == 0)
-      {
-        printf("Cannot set the integration upper bounds if the dimension is not yet specified.\n");
-        exit(1);
-
-        return 1;
-      }
-
-    for (size_t i = 0; i < intgrt -> dim; i++)
-      {
-        intgrt -> upperBounds[i] = ubounds[i];
-      }
+    qmc -> scramblings = scramblings;
 
     return 0;
 }
 
-
-int integrate_set_bounds_lower(intgrt_t *intgrt, double *lbounds)
+int integrate_qmc_set_relerr(intgrt_qmc_t *qmc, double relErr)
 {
     /*
 
-        Set the integration lower bounds for intgrt
+        Set relErr in qmc
 
     */
 
-    if (intgrt -> dim == 0)
-      {
-        printf("Cannot set the integration lower bounds if the dimension is not yet specified.\n");
-        exit(1);
-
-        return 1;
-      }
-
-    for (size_t i = 0; i < intgrt -> dim; i++)
-      {
-        intgrt -> lowerBounds[i] = lbounds[i];
-      }
+    qmc -> relErr = relErr;
 
     return 0;
 }
 
+int integrate_qmc_set_seed(intgrt_qmc_t *qmc, unsigned long seed)
+{
+    /*
 
-/*  ------------------------------------------------------------------------------------------------------  */
+        Set seed in qmc
+
+    */
 
+    qmc -> seed = seed;
 
-int integrate_set_routine(intgrt_t *intgrt, const char *routine)
+    return 0;
+}
+
+int integrate_qmc_set_verbose(intgrt_qmc_t *qmc, int verbose)
 {
     /*
 
-        Set the integration routine
+        Set verbose in qmc
 
     */
 
-    intgrt -> routine = integrate_find_routine(routine);
+    qmc -> verbose = verbose;
 
     return 0;
 }
 
 
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  -----------------------------------------   Cubature Struct   ----------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-int integrate_set_cquad(intgrt_t *intgrt, intgrt_cquad_t *cquad)
+intgrt_cubature_t *integrate_cubature_new(void)
 {
     /*
 
-        Set the cquad parameters for intgrt
+        Create a new intgrt_cubature_t struct
 
     */
 
-    intgrt -> cquad = integrate_cquad_free(intgrt -> cquad);
-    intgrt -> cquad = integrate_cquad_cp(cquad);
+    intgrt_cubature_t *cubature = malloc(sizeof(intgrt_cubature_t));
 
-    return 0;
+    cubature -> relErr = 1.e-4;
+    cubature -> absErr = 0.;
+
+    cubature -> maxEval = 100000;
+
+    cubature -> verbose = 0;
+
+    return cubature;
 }
 
 
-int integrate_set_vegas(intgrt_t *intgrt, intgrt_vegas_t *vegas)
+intgrt_cubature_t *integrate_cubature_free(intgrt_cubature_t *cubature)
 {
     /*
 
-        Set the vegas parameters for intgrt
+        Free cubature
 
     */
 
-    intgrt -> vegas = integrate_vegas_free(intgrt -> vegas);
-    intgrt -> vegas = integrate_vegas_cp(vegas);
+    /* Free cubature (no need to check if cubature is NULL) */
+    free(cubature);
 
-    return 0;
+    return NULL;
 }
 
 
-int integrate_set_divonne(intgrt_t *intgrt, intgrt_divonne_t *divonne)
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+intgrt_cubature_t *integrate_cubature_cp(intgrt_cubature_t *cubature)
 {
     /*
 
-        Set the divonne parameters for intgrt
+        Copy cubature
 
     */
 
-    intgrt -> divonne = integrate_divonne_free(intgrt -> divonne);
-    intgrt -> divonne = integrate_divonne_cp(divonne);
+    /* Check for NULL */
+    if (cubature == NULL)
+        return NULL;
 
-    return 0;
+    intgrt_cubature_t *cubatureCp = malloc(sizeof(intgrt_cubature_t));
+
+    cubatureCp -> relErr = cubature -> relErr;
+    cubatureCp -> absErr = cubature -> absErr;
+
+    cubatureCp -> maxEval = cubature -> maxEval;
+
+    cubatureCp -> verbose = cubature -> verbose;
+
+    return cubatureCp;
 }
 
 
+/*  ------------------------------------------------------------------------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-int integrate_set_integrand(intgrt_t *intgrt, double (*integrand)(double*, size_t, void*))
+int integrate_cubature_set_relerr(intgrt_cubature_t *cubature, double relErr)
 {
     /*
 
-        Set the integrand for intgrt
+        Set relErr in cubature
 
     */
 
-    intgrt -> integrand = integrand;
+    cubature -> relErr = relErr;
 
     return 0;
 }
 
-
-int integrate_set_params(intgrt_t *intgrt, void *params)
+int integrate_cubature_set_abserr(intgrt_cubature_t *cubature, double absErr)
 {
     /*
 
-        Set the additional parameters of the integrand for intgrt
+        Set absErr in cubature
 
     */
 
-    intgrt -> params = params;
+    cubature -> absErr = absErr;
 
     return 0;
 }
 
-
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  ------------------------------------------------------------------------------------------------------  */
-
-
-intgrt_cquad_t *integrate_get_cquad(intgrt_t *intgrt)
+int integrate_cubature_set_maxeval(intgrt_cubature_t *cubature, size_t maxEval)
 {
     /*
 
-        Get the cquad parameters from intgrt
+        Set maxEval in cubature
 
     */
 
-    return intgrt -> cquad;
-}
+    cubature -> maxEval = maxEval;
 
+    return 0;
+}
 
-intgrt_vegas_t *integrate_get_vegas(intgrt_t *intgrt)
+int integrate_cubature_set_verbose(intgrt_cubature_t *cubature, int verbose)
 {
     /*
 
-        Get the vegas parameters from intgrt
+        Set verbose in cubature
 
     */
 
-    return intgrt -> vegas;
+    cubature -> verbose = verbose;
+
+    return 0;
 }
 
 
-intgrt_divonne_t *integrate_get_divonne(intgrt_t *intgrt)
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ----------------------------------------   Integrate Struct   ----------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+intgrt_t *integrate_new(void)
 {
     /*
 
-        Get the divonne parameters from intgrt
+        Create a new intgrt_t struct
 
     */
 
-    return intgrt -> divonne;
-}
+    intgrt_t *intgrt = malloc(sizeof(intgrt_t));
 
+    intgrt -> dim = 0;
 
+    intgrt -> upperBounds = NULL;
+    intgrt -> lowerBounds = NULL;
 
+    intgrt -> cquad = NULL;
+    intgrt -> vegas = NULL;
+    intgrt -> divonne = NULL;
+    intgrt -> qmc = NULL;
+    intgrt -> cubature = NULL;
 
+    intgrt -> vegasGrid = NULL;
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
-/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%     INTEGRATE FUNCTION     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
-/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
-/*  ------------------------------------------------------------------------------------------------------  */
+    intgrt -> routine = _idIntgrtVegas_;
 
+    intgrt -> params = NULL;
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  ----------------------------------   General Integrate Function   ------------------------------------  */
-/*  ------------------------------------------------------------------------------------------------------  */
+    intgrt -> integrandVec = NULL;
+    intgrt -> nComp = 1;
 
+    intgrt -> integrandBatch = NULL;
 
-int integrate(double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result)
+    intgrt -> buffer = NULL;
+
+    return intgrt;
+}
+
+
+intgrt_t *integrate_free(intgrt_t *intgrt)
 {
     /*
 
-        Integrate a function over a region (provided in intgrt) using the integration routine provided in intgrt -> routine.
+        Free intgrt
 
     */
 
-    /* CQUAD */
+    /* Check for NULL */
+    if (intgrt == NULL)
+        return NULL;
+
+    /* Free bounds */
+    free(intgrt -> upperBounds);
+    free(intgrt -> lowerBounds);
+
+    /* Free cquad */
+    intgrt -> cquad = integrate_cquad_free(intgrt -> cquad);
+
+    /* Free vegas */
+    intgrt -> vegas = integrate_vegas_free(intgrt -> vegas);
+
+    /* Free divonne */
+    intgrt -> divonne = integrate_divonne_free(intgrt -> divonne);
+
+    /* Free qmc */
+    intgrt -> qmc = integrate_qmc_free(intgrt -> qmc);
+
+    /* Free cubature */
+    intgrt -> cubature = integrate_cubature_free(intgrt -> cubature);
+
+    /* Free buffer */
+    free(intgrt -> buffer);
+
+    /* Free intgrt itself */
+    free(intgrt);
+
+    return NULL;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+intgrt_t *integrate_cp(intgrt_t *intgrt)
+{
+    /*
+
+        Copy intgrt
+
+    */
+
+    /* Check for NULL */
+    if (intgrt == NULL)
+        return NULL;
+
+    intgrt_t *intgrtCp = integrate_new();
+
+    integrate_set_dim(intgrtCp, intgrt -> dim);
+    integrate_set_bounds_upper(intgrtCp, intgrt -> upperBounds);
+    integrate_set_bounds_lower(intgrtCp, intgrt -> lowerBounds);
+
+    integrate_set_cquad(intgrtCp, intgrt -> cquad);
+    integrate_set_vegas(intgrtCp, intgrt -> vegas);
+    integrate_set_divonne(intgrtCp, intgrt -> divonne);
+    integrate_set_qmc(intgrtCp, intgrt -> qmc);
+    integrate_set_cubature(intgrtCp, intgrt -> cubature);
+
+    integrate_set_routine(intgrtCp, intgrt -> routine);
+
+    integrate_set_params(intgrtCp, intgrt -> params);
+
+    return intgrtCp;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate_set_bounds(intgrt_t *intgrt, size_t dim, double *ubounds, double *lbounds)
+{
+    /*
+
+        Set the integration bounds for intgrt
+
+    */
+
+    intgrt -> dim = dim;
+
+    intgrt -> upperBounds = realloc(intgrt -> upperBounds, sizeof(double) * dim);
+    intgrt -> lowerBounds = realloc(intgrt -> lowerBounds, sizeof(double) * dim);
+
+    for (size_t i = 0; i < dim; i++)
+      {
+        intgrt -> upperBounds[i] = ubounds[i];
+        intgrt -> lowerBounds[i] = lbounds[i];
+      }
+
+    return 0;
+}
+
+
+int integrate_set_dim(intgrt_t *intgrt, size_t dim)
+{
+    /*
+
+        Set the integration dimension for intgrt
+
+    */
+
+    intgrt -> dim = dim;
+
+    intgrt -> upperBounds = realloc(intgrt -> upperBounds, sizeof(double) * dim);
+    intgrt -> lowerBounds = realloc(intgrt -> lowerBounds, sizeof(double) * dim);
+
+    return 0;
+}
+
+
+int integrate_set_bounds_upper(intgrt_t *intgrt, double *ubounds)
+{
+    /*
+
+        Set the integration upper bounds for intgrt
+
+    */
+
+    if (intgrt -> dim == 0)
+      {
+        printf("Cannot set the integration upper bounds if the dimension is not yet specified.\n");
+        exit(1);
+
+        return 1;
+      }
+
+    for (size_t i = 0; i < intgrt -> dim; i++)
+      {
+        intgrt -> upperBounds[i] = ubounds[i];
+      }
+
+    return 0;
+}
+
+
+int integrate_set_bounds_lower(intgrt_t *intgrt, double *lbounds)
+{
+    /*
+
+        Set the integration lower bounds for intgrt
+
+    */
+
+    if (intgrt -> dim == 0)
+      {
+        printf("Cannot set the integration lower bounds if the dimension is not yet specified.\n");
+        exit(1);
+
+        return 1;
+      }
+
+    for (size_t i = 0; i < intgrt -> dim; i++)
+      {
+        intgrt -> lowerBounds[i] = lbounds[i];
+      }
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate_set_routine(intgrt_t *intgrt, const char *routine)
+{
+    /*
+
+        Set the integration routine
+
+    */
+
+    intgrt -> routine = integrate_find_routine(routine);
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate_set_cquad(intgrt_t *intgrt, intgrt_cquad_t *cquad)
+{
+    /*
+
+        Set the cquad parameters for intgrt
+
+    */
+
+    intgrt -> cquad = integrate_cquad_free(intgrt -> cquad);
+    intgrt -> cquad = integrate_cquad_cp(cquad);
+
+    return 0;
+}
+
+
+int integrate_set_vegas(intgrt_t *intgrt, intgrt_vegas_t *vegas)
+{
+    /*
+
+        Set the vegas parameters for intgrt
+
+    */
+
+    intgrt -> vegas = integrate_vegas_free(intgrt -> vegas);
+    intgrt -> vegas = integrate_vegas_cp(vegas);
+
+    return 0;
+}
+
+
+int integrate_set_divonne(intgrt_t *intgrt, intgrt_divonne_t *divonne)
+{
+    /*
+
+        Set the divonne parameters for intgrt
+
+    */
+
+    intgrt -> divonne = integrate_divonne_free(intgrt -> divonne);
+    intgrt -> divonne = integrate_divonne_cp(divonne);
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate_set_qmc(intgrt_t *intgrt, intgrt_qmc_t *qmc)
+{
+    /*
+
+        Set the qmc parameters for intgrt
+
+    */
+
+    intgrt -> qmc = integrate_qmc_free(intgrt -> qmc);
+    intgrt -> qmc = integrate_qmc_cp(qmc);
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate_set_cubature(intgrt_t *intgrt, intgrt_cubature_t *cubature)
+{
+    /*
+
+        Set the cubature parameters for intgrt
+
+    */
+
+    intgrt -> cubature = integrate_cubature_free(intgrt -> cubature);
+    intgrt -> cubature = integrate_cubature_cp(cubature);
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate_set_vegas_grid(intgrt_t *intgrt, intgrt_vegas_grid_t *grid)
+{
+    /*
+
+        Set the vegas grid intgrt starts from (and which is adapted further by the next integral)
+
+    */
+
+    intgrt -> vegasGrid = grid;
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate_set_integrand(intgrt_t *intgrt, double (*integrand)(double*, size_t, void*))
+{
+    /*
+
+        Set the integrand for intgrt
+
+    */
+
+    intgrt -> integrand = integrand;
+
+    return 0;
+}
+
+
+int integrate_set_integrand_vec(intgrt_t *intgrt, int (*integrandVec)(double*, size_t, void*, double*), size_t nComp)
+{
+    /*
+
+        Set the vector valued integrand (with nComp components) for intgrt
+
+    */
+
+    intgrt -> integrandVec = integrandVec;
+    intgrt -> nComp = nComp;
+
+    return 0;
+}
+
+
+int integrate_set_integrand_batch(intgrt_t *intgrt, int (*integrandBatch)(double*, size_t, size_t, void*, double*))
+{
+    /*
+
+        Set the batched integrand for intgrt, which evaluates nVec points at once: the points are given one after another
+        in var[i * dim + j] and their values are stored in result[i]
+
+    */
+
+    intgrt -> integrandBatch = integrandBatch;
+
+    return 0;
+}
+
+
+int integrate_set_params(intgrt_t *intgrt, void *params)
+{
+    /*
+
+        Set the additional parameters of the integrand for intgrt
+
+    */
+
+    intgrt -> params = params;
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+intgrt_cquad_t *integrate_get_cquad(intgrt_t *intgrt)
+{
+    /*
+
+        Get the cquad parameters from intgrt
+
+    */
+
+    return intgrt -> cquad;
+}
+
+
+intgrt_vegas_t *integrate_get_vegas(intgrt_t *intgrt)
+{
+    /*
+
+        Get the vegas parameters from intgrt
+
+    */
+
+    return intgrt -> vegas;
+}
+
+
+intgrt_divonne_t *integrate_get_divonne(intgrt_t *intgrt)
+{
+    /*
+
+        Get the divonne parameters from intgrt
+
+    */
+
+    return intgrt -> divonne;
+}
+
+
+intgrt_qmc_t *integrate_get_qmc(intgrt_t *intgrt)
+{
+    /*
+
+        Get the qmc parameters from intgrt
+
+    */
+
+    return intgrt -> qmc;
+}
+
+
+intgrt_cubature_t *integrate_get_cubature(intgrt_t *intgrt)
+{
+    /*
+
+        Get the cubature parameters from intgrt
+
+    */
+
+    return intgrt -> cubature;
+}
+
+
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%     INTEGRATE FUNCTION     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ----------------------------------   General Integrate Function   ------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate(double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result)
+{
+    /*
+
+        Integrate a function over a region (provided in intgrt) using the integration routine provided in intgrt -> routine.
+
+    */
+
+    /* CQUAD */
+    if (misc_sinci((const char*) intgrt -> routine, _idIntgrtCQUAD_))
+      {
+        integrate_cquad(integrand, intgrt, result);
+
+        return 0;
+      }
+
+    /* Vegas */
+    if (misc_sinci((const char*) intgrt -> routine, _idIntgrtVegas_))
+      {
+        integrate_vegas(integrand, intgrt, result);
+
+        return 0;
+      }
+
+    /* Divonne */
+    if (misc_sinci((const char*) intgrt -> routine, _idIntgrtDivonne_))
+      {
+        integrate_divonne(integrand, intgrt, result);
+
+        return 0;
+      }
+
+    /* QMC */
+    if (misc_sinci((const char*) intgrt -> routine, _idIntgrtQMC_))
+      {
+        integrate_qmc(integrand, intgrt, result);
+
+        return 0;
+      }
+
+    /* Cubature */
+    if (misc_sinci((const char*) intgrt -> routine, _idIntgrtCubature_))
+      {
+        integrate_cubature(integrand, intgrt, result);
+
+        return 0;
+      }
+
+    /* Did not find routine */
+    printf("Did not find any '%s' integration routine.\n", intgrt -> routine);
+    exit(1);
+
+    return 1;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate_batch(double integrand(double*, size_t, void*), int integrandBatch(double*, size_t, size_t, void*, double*), intgrt_t *intgrt,
+                    double *result)
+{
+    /*
+
+        Integrate a function over a region (provided in intgrt), where integrandBatch evaluates the same function for
+        blocks of points (see integrate_set_integrand_batch).
+
+        Only Divonne (if divonne -> nVec > 1), QMC and cubature hand over more than one point at a time, all other
+        routines use integrand.
+
+    */
+
+    /* Divonne */
+    if (misc_sinci((const char*) intgrt -> routine, _idIntgrtDivonne_) && intgrt -> divonne -> nVec > 1)
+      {
+        integrate_set_integrand_batch(intgrt, integrandBatch);
+        integrate_divonne(integrand, intgrt, result);
+        integrate_set_integrand_batch(intgrt, NULL);
+
+        return 0;
+      }
+
+    /* QMC */
+    if (misc_sinci((const char*) intgrt -> routine, _idIntgrtQMC_))
+      {
+        integrate_set_integrand_batch(intgrt, integrandBatch);
+        integrate_qmc(integrand, intgrt, result);
+        integrate_set_integrand_batch(intgrt, NULL);
+
+        return 0;
+      }
+
+    /* Cubature */
+    if (misc_sinci((const char*) intgrt -> routine, _idIntgrtCubature_))
+      {
+        integrate_set_integrand_batch(intgrt, integrandBatch);
+        integrate_cubature(integrand, intgrt, result);
+        integrate_set_integrand_batch(intgrt, NULL);
+
+        return 0;
+      }
+
+    integrate(integrand, intgrt, result);
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+typedef struct
+{
+    /*
+
+        Single component of a vector valued integrand (integrated by _integrate_vec_comps)
+
+    */
+
+    intgrt_t *intgrt;
+
+    size_t comp;
+
+    double *buffer;
+
+} _intgrt_comp_t;
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ####################################   Function Declarations   #######################################  */
+
+static int _integrate_vec_comps(int integrateComp(double (*)(double*, size_t, void*), intgrt_t*, double*),
+                                int integrandVec(double*, size_t, void*, double*), size_t nComp, intgrt_t *intgrt, double *result);
+
+static double _integrate_vec_comp_integrand(double *var, size_t dim, void *params);
+
+/*  ######################################################################################################  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate_vec(int integrandVec(double*, size_t, void*, double*), size_t nComp, intgrt_t *intgrt, double *result)
+{
+    /*
+
+        Integrate a vector valued function with nComp components over a region (provided in intgrt). The results of
+        the i'th component are stored in result[3*i], result[3*i + 1] and result[3*i + 2].
+
+        Divonne, QMC and the adaptive cubature integrate the components in the same sweep, i.e. the integrand is only
+        evaluated once per point (see integrate_vec_sweep). GSL's CQUAD and VEGAS only handle scalar integrands, the
+        components are integrated one after another with the same routine and settings as in integrate.
+
+    */
+
+    /* CQUAD */
     if (misc_sinci((const char*) intgrt -> routine, _idIntgrtCQUAD_))
       {
-        integrate_cquad(integrand, intgrt, result);
+        integrate_cquad_vec(integrandVec, nComp, intgrt, result);
+
+        return 0;
+      }
+
+    /* Vegas */
+    if (misc_sinci((const char*) intgrt -> routine, _idIntgrtVegas_))
+      {
+        integrate_vegas_vec(integrandVec, nComp, intgrt, result);
+
+        return 0;
+      }
+
+    /* Divonne */
+    if (misc_sinci((const char*) intgrt -> routine, _idIntgrtDivonne_))
+      {
+        integrate_divonne_vec(integrandVec, nComp, intgrt, result);
+
+        return 0;
+      }
+
+    /* QMC */
+    if (misc_sinci((const char*) intgrt -> routine, _idIntgrtQMC_))
+      {
+        integrate_qmc_vec(integrandVec, nComp, intgrt, result);
+
+        return 0;
+      }
+
+    /* Cubature */
+    if (misc_sinci((const char*) intgrt -> routine, _idIntgrtCubature_))
+      {
+        integrate_cubature_vec(integrandVec, nComp, intgrt, result);
+
+        return 0;
+      }
+
+    /* Did not find routine */
+    printf("Did not find any '%s' integration routine.\n", intgrt -> routine);
+    exit(1);
+
+    return 1;
+}
+
+
+bool integrate_vec_sweep(intgrt_t *intgrt)
+{
+    /*
+
+        Check whether the routine of intgrt integrates all components of a vector valued integrand in the same sweep (true
+        for Divonne, QMC and the adaptive cubature), or one after another (CQUAD and VEGAS)
+
+    */
+
+    return misc_sinci((const char*) intgrt -> routine, _idIntgrtDivonne_) || misc_sinci((const char*) intgrt -> routine, _idIntgrtQMC_) ||
+           misc_sinci((const char*) intgrt -> routine, _idIntgrtCubature_);
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static int _integrate_vec_comps(int integrateComp(double (*)(double*, size_t, void*), intgrt_t*, double*),
+                                int integrandVec(double*, size_t, void*, double*), size_t nComp, intgrt_t *intgrt, double *result)
+{
+    /*
+
+        Integrate the nComp components of a vector valued integrand one after another with the scalar routine
+        integrateComp. The results of the i'th component are stored in result[3*i], result[3*i + 1] and result[3*i + 2].
+
+    */
+
+    /* Set integrand */
+    integrate_set_integrand_vec(intgrt, integrandVec, nComp);
+
+    /* Single component (on a copy of intgrt, which does not hold the vegas grid) */
+    _intgrt_comp_t paramsComp = {intgrt, 0, malloc(sizeof(double) * nComp)};
+
+    intgrt_t *intgrtComp = integrate_cp(intgrt);
+    integrate_set_params(intgrtComp, &paramsComp);
+
+    for (size_t i = 0; i < nComp; i++)
+      {
+        paramsComp.comp = i;
+
+        result[3*i + 2] = 0.;
+
+        integrateComp(&_integrate_vec_comp_integrand, intgrtComp, &result[3*i]);
+      }
+
+    /* Free memory */
+    intgrtComp = integrate_free(intgrtComp);
+    free(paramsComp.buffer);
+
+    return 0;
+}
+
+
+static double _integrate_vec_comp_integrand(double *var, size_t dim, void *params)
+{
+    /*
+
+        Integrand for _integrate_vec_comps, i.e. a single component of the vector valued integrand
+
+    */
+
+    _intgrt_comp_t *paramsComp = (_intgrt_comp_t*) params;
+
+    intgrt_t *intgrt = paramsComp -> intgrt;
+
+    intgrt -> integrandVec(var, dim, intgrt -> params, paramsComp -> buffer);
+
+    return paramsComp -> buffer[paramsComp -> comp];
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------   GSL's CQUAD   -------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate_cquad(double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result)
+{
+    /*
+
+        Integrate a function over a 1d region (provided in intgrt) using the CQUAD routine from GSL.
+
+    */
+
+    /* Reset result */
+    result[0] = 0.;
+    result[1] = 0.;
+
+    /* Set integrand */
+    integrate_set_integrand(intgrt, integrand);
+
+    /* intgrt_cquad_t struct */
+    intgrt_cquad_t *cquad = intgrt -> cquad;
+
+    /* Allocate working memory for CQUAD */
+    gsl_integration_cquad_workspace *work = gsl_integration_cquad_workspace_alloc(cquad -> limit);
+
+    /* Integrand to be passed to CQUAD */
+    gsl_function integrandCQUAD;
+    integrandCQUAD.function = &integrate_cquad_integrand;
+    integrandCQUAD.params = intgrt;
+
+    /* Integrate */
+    gsl_integration_cquad(&integrandCQUAD, *(intgrt -> lowerBounds), *(intgrt -> upperBounds), cquad -> absErr, cquad -> relErr, work, &result[0], &result[1], NULL);
+
+    /* Free allocated memory */
+    gsl_integration_cquad_workspace_free(work);
+
+    return 0;
+}
+
+
+int integrate_cquad_vec(int integrandVec(double*, size_t, void*, double*), size_t nComp, intgrt_t *intgrt, double *result)
+{
+    /*
+
+        Integrate a vector valued function with nComp components over a 1d region (provided in intgrt) using the CQUAD
+        routine from GSL. CQUAD only handles scalar integrands, so the components are integrated one after another (the
+        full vector is evaluated at every point). The results of the i'th component are stored in result[3*i] and
+        result[3*i + 1] (result[3*i + 2] is set to 0).
+
+    */
+
+    return _integrate_vec_comps(integrate_cquad, integrandVec, nComp, intgrt, result);
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+double integrate_cquad_integrand(double x, void *params)
+{
+    /*
+
+        Integrand for integrate_divonne
+
+    */
+
+    intgrt_t *intgrt = (intgrt_t*) params;
+
+    return intgrt -> integrand(&x, intgrt -> dim, intgrt -> params);
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------   GSL's VEGAS   -------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ####################################   Function Declarations   #######################################  */
+
+static bool _integrate_vegas_grid_match(intgrt_vegas_grid_t *grid, intgrt_t *intgrt);
+
+/*  ######################################################################################################  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate_vegas(double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result)
+{
+    /*
+
+        Integrate a function over a region (provided in intgrt) using the Monte-Carlo integration algorithm VEGAS from GSL.
+
+        If intgrt holds a vegas grid that has already been adapted to the same region, the integral starts from that grid
+        and the warm up is skipped. Afterwards the grid holds the grid adapted to this integrand.
+
+    */
+
+    /* Reset result */
+    result[0] = 0.;
+    result[1] = 0.;
+    result[2] = 0.;
+
+    /* intgrt_vegas_t struct */
+    intgrt_vegas_t *vegas = intgrt -> vegas;
+
+    /* Setup VEGAS */
+
+    const gsl_rng_type *T;
+    gsl_rng *r;
+
+    gsl_monte_function monteIntegral = {integrand, intgrt -> dim, intgrt -> params};
+
+    gsl_rng_env_setup();
+
+    T = gsl_rng_default;
+    r = gsl_rng_alloc(T);
+
+    /* Grid to start from */
+    intgrt_vegas_grid_t *grid = intgrt -> vegasGrid;
+
+    if (grid != NULL && grid -> state != NULL && !_integrate_vegas_grid_match(grid, intgrt))
+        integrate_vegas_grid_reset(grid);
+
+    if (grid != NULL && grid -> state == NULL)
+      {
+        grid -> state = gsl_monte_vegas_alloc(intgrt -> dim);
+
+        grid -> dim = intgrt -> dim;
+
+        grid -> lowerBounds = malloc(sizeof(double) * intgrt -> dim);
+        grid -> upperBounds = malloc(sizeof(double) * intgrt -> dim);
+
+        memcpy(grid -> lowerBounds, intgrt -> lowerBounds, sizeof(double) * intgrt -> dim);
+        memcpy(grid -> upperBounds, intgrt -> upperBounds, sizeof(double) * intgrt -> dim);
+      }
+
+    gsl_monte_vegas_state *s = (grid != NULL) ? grid -> state : gsl_monte_vegas_alloc(intgrt -> dim);
+
+
+    /* VEGAS warm up (only for a fresh grid) */
+
+    if (grid == NULL || !grid -> adapted)
+      {
+        /* Integrate */
+        gsl_monte_vegas_integrate(&monteIntegral, intgrt -> lowerBounds, intgrt -> upperBounds, intgrt -> dim, vegas -> warmUpCalls, r, s, &result[0], &result[1]);
+
+        /* χ^2 */
+        result[2] = gsl_monte_vegas_chisq(s);
+      }
+
+
+    /* VEGAS main stage */
+
+    int loop = 0;
+    size_t mainCalls = vegas -> mainCalls;
+    double relErr = 0.;
+
+
+    do
+      {
+        /* If the algorithm does not converge break the loop after vegas -> maxLoop iterations */
+        if (loop == vegas -> maxLoop)
+          {
+            if (vegas -> verbose)
+                printf("Integral did not converge after %d iterations.\n", vegas -> maxLoop);
+
+            break;
+          }
+
+        loop++;
+
+        /* Integrate */
+        gsl_monte_vegas_integrate(&monteIntegral, intgrt -> lowerBounds, intgrt -> upperBounds, intgrt -> dim, mainCalls, r, s, &result[0], &result[1]);
+
+        /* χ^2 */
+        result[2] = gsl_monte_vegas_chisq(s);
+
+        /* Check for relative error */
+        if (vegas -> relErr != 0.)
+          {
+            /* Relative error */
+            relErr = (result[0] != 0.) ? result[1] / fabs(result[0]) : 0.;
+
+            /* Relative error out of bounds -> increase number of function evaluations and continue loop */
+            if (relErr > vegas -> relErr)
+              {
+                mainCalls = (size_t) (((double) mainCalls) * vegas -> updateCalls);
+
+                continue;
+              }
+
+            /* Relative error in bounds and chisq error in bounds -> break loop */
+            else if (fabs(result[2] - 1.) < vegas -> chisqErr)
+              {
+                if (vegas -> verbose)
+                    printf("Integral converged after %d iterations.\n", loop);
+
+                break;
+              }
+          }
+
+        /* Chisq error in bounds -> break loop */
+        if (fabs(result[2] - 1.) < vegas -> chisqErr)
+          {
+            if (vegas -> verbose)
+                printf("Integral converged after %d iterations.\n", loop);
+
+            break;
+          }
+      }
+
+    while (true);
+
+
+    /* Free allocated memory */
+
+    gsl_rng_free(r);
+
+    if (grid == NULL)
+        gsl_monte_vegas_free(s);
+
+    else
+        grid -> adapted = true;
+
+    return 0;
+}
+
+
+int integrate_vegas_vec(int integrandVec(double*, size_t, void*, double*), size_t nComp, intgrt_t *intgrt, double *result)
+{
+    /*
+
+        Integrate a vector valued function with nComp components over a region (provided in intgrt) using VEGAS from GSL
+        with the settings in intgrt -> vegas. GSL's VEGAS only handles scalar integrands, so the components are integrated
+        one after another (the full vector is evaluated at every point) and intgrt -> vegasGrid is not used. The results
+        of the i'th component are stored in result[3*i], result[3*i + 1] and result[3*i + 2] (χ^2 per dof).
+
+    */
+
+    return _integrate_vec_comps(integrate_vegas, integrandVec, nComp, intgrt, result);
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static bool _integrate_vegas_grid_match(intgrt_vegas_grid_t *grid, intgrt_t *intgrt)
+{
+    /*
+
+        Check if the vegas grid was set up for the region of intgrt
+
+    */
+
+    if (grid -> dim != intgrt -> dim)
+        return false;
+
+    for (size_t i = 0; i < grid -> dim; i++)
+      {
+        if (grid -> lowerBounds[i] != intgrt -> lowerBounds[i] || grid -> upperBounds[i] != intgrt -> upperBounds[i])
+            return false;
+      }
+
+    return true;
+}
+
+
+int integrate_plain(double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result)
+{
+    /*
+
+        Integrate a function over a region (provided in "intgrt") using the plain Monte-Carlo integration from GSL.
+
+    */
+
+    /* Reset result */
+    result[0] = 0.;
+    result[1] = 0.;
+    result[2] = 0.;
+
+    /* Setup */
+    const gsl_rng_type *T;
+    gsl_rng *r;
+
+    gsl_monte_function monteIntegral = {integrand, intgrt -> dim, intgrt -> params};
+
+    gsl_rng_env_setup();
+
+    T = gsl_rng_default;
+    r = gsl_rng_alloc(T);
+
+    gsl_monte_plain_state *s = gsl_monte_plain_alloc(intgrt -> dim);
+
+    /* Integrate */
+    gsl_monte_plain_integrate(&monteIntegral, intgrt -> lowerBounds, intgrt -> upperBounds, intgrt -> dim, intgrt -> vegas -> mainCalls, r, s, &result[0], &result[1]);
+
+    /* Free allocated memory */
+    gsl_rng_free(r);
+    gsl_monte_plain_free(s);
+
+    return 0;
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ----------------------------------------   CUBA's Divonne   ------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate_divonne(double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result)
+{
+    /*
+
+        Integrate a function over a region (provided in "intgrt") with the Divonne integration from CUBA
+
+    */
+
+    int nRegions, nEval, fail;
+    cubareal integral, error, prob;
+
+    /* Divonne struct */
+    intgrt_divonne_t *divonne = intgrt -> divonne;
+
+    /* Set integrand */
+    integrate_set_integrand(intgrt, integrand);
+
+    /* Buffer for a block of points and their values */
+    intgrt -> buffer = realloc(intgrt -> buffer, sizeof(double) * (size_t) divonne -> nVec * (intgrt -> dim + 1));
+
+    /* Integrate */
+    Divonne((int) intgrt -> dim, divonne -> nComp, __INTGRT_CUBA_INTEGRAND__(integrate_divonne_integrand), intgrt, divonne -> nVec,
+            divonne -> epsRel, divonne -> epsAbs,
+            divonne -> verbose,
+            divonne -> seed,
+            divonne -> minEval, divonne -> maxEval,
+            divonne -> key1, divonne -> key2, divonne -> key3,
+            divonne -> maxPass,
+            divonne -> border,
+            divonne -> maxChisq, divonne -> minDeviation,
+            0, 0, NULL, 0, NULL, NULL, NULL, // Never used
+            &nRegions, &nEval, &fail, &integral, &error, &prob); // Output
+
+    /* Result */
+    result[0] = (double) integral;
+    result[1] = (double) error;
+    result[2] = (double) prob;
+
+    return 0;
+}
+
+
+int integrate_divonne_vec(int integrandVec(double*, size_t, void*, double*), size_t nComp, intgrt_t *intgrt, double *result)
+{
+    /*
+
+        Integrate a vector valued function with nComp components over a region (provided in "intgrt") with the Divonne
+        integration from CUBA (all components are integrated in the same sweep)
+
+    */
+
+    int nRegions, nEval, fail;
+
+    cubareal *integral = malloc(sizeof(cubareal) * nComp);
+    cubareal *error = malloc(sizeof(cubareal) * nComp);
+    cubareal *prob = malloc(sizeof(cubareal) * nComp);
+
+    /* Divonne struct */
+    intgrt_divonne_t *divonne = intgrt -> divonne;
+
+    /* Set integrand */
+    integrate_set_integrand_vec(intgrt, integrandVec, nComp);
+
+    /* Buffer for a single point and its values */
+    intgrt -> buffer = realloc(intgrt -> buffer, sizeof(double) * (intgrt -> dim + nComp));
+
+    /* Integrate */
+    Divonne((int) intgrt -> dim, (int) nComp, __INTGRT_CUBA_INTEGRAND__(integrate_divonne_integrand_vec), intgrt, divonne -> nVec,
+            divonne -> epsRel, divonne -> epsAbs,
+            divonne -> verbose,
+            divonne -> seed,
+            divonne -> minEval, divonne -> maxEval,
+            divonne -> key1, divonne -> key2, divonne -> key3,
+            divonne -> maxPass,
+            divonne -> border,
+            divonne -> maxChisq, divonne -> minDeviation,
+            0, 0, NULL, 0, NULL, NULL, NULL, // Never used
+            &nRegions, &nEval, &fail, integral, error, prob); // Output
+
+    /* Result */
+    for (size_t i = 0; i < nComp; i++)
+      {
+        result[3*i] = (double) integral[i];
+        result[3*i + 1] = (double) error[i];
+        result[3*i + 2] = (double) prob[i];
+      }
+
+    /* Free memory */
+    free(integral);
+    free(error);
+    free(prob);
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate_divonne_integrand(const int *nDim, const cubareal xx[], const int *nComp, cubareal ff[], void *usrData, const int *nVec)
+{
+    /*
+
+        Integrand for integrate_divonne
+
+        Divonne hands over *nVec points at once, given one after another in xx. If a batched integrand was set (see
+        integrate_batch) the whole block is evaluated in a single call, otherwise point by point.
+
+    */
+
+    (void) nComp;
+
+    /* Integrate struct */
+    intgrt_t *intgrt = (intgrt_t*) usrData;
+
+    size_t dim = (size_t) *nDim;
+    size_t nPoints = (size_t) *nVec;
+
+    /* x Data + f Data (preallocated in integrate_divonne) */
+    double *xData = intgrt -> buffer;
+    double *fData = intgrt -> buffer + nPoints * dim;
+
+    /* Jacobian to obtain unicube as integration region */
+    double jac = 1.;
+
+    for (size_t i = 0; i < dim; i++)
+        jac *= intgrt -> upperBounds[i] - intgrt -> lowerBounds[i];
+
+    /* Transform to unicube */
+    for (size_t n = 0; n < nPoints; n++)
+      {
+        for (size_t i = 0; i < dim; i++)
+            xData[n * dim + i] = intgrt -> lowerBounds[i] + xx[n * dim + i] * (intgrt -> upperBounds[i] - intgrt -> lowerBounds[i]);
+      }
+
+    /* Integrand */
+    if (intgrt -> integrandBatch != NULL)
+        intgrt -> integrandBatch(xData, dim, nPoints, intgrt -> params, fData);
+
+    else
+      {
+        for (size_t n = 0; n < nPoints; n++)
+            fData[n] = intgrt -> integrand(xData + n * dim, dim, intgrt -> params);
+      }
+
+    for (size_t n = 0; n < nPoints; n++)
+        ff[n] = fData[n] * jac;
+
+    return 0;
+}
+
+
+int integrate_divonne_integrand_vec(const int *nDim, const cubareal xx[], const int *nComp, cubareal ff[], void *usrData, const int *nVec)
+{
+    /*
+
+        Vector valued integrand for integrate_divonne_vec (evaluated point by point for the *nVec points in xx)
+
+    */
+
+    /* Integrate struct */
+    intgrt_t *intgrt = (intgrt_t*) usrData;
+
+    size_t dim = (size_t) *nDim;
+    size_t nComps = (size_t) *nComp;
+
+    /* x Data + f Data (preallocated in integrate_divonne_vec) */
+    double *xData = intgrt -> buffer;
+    double *fData = intgrt -> buffer + dim;
+
+    /* Jacobian to obtain unicube as integration region */
+    double jac = 1.;
+
+    for (size_t i = 0; i < dim; i++)
+        jac *= intgrt -> upperBounds[i] - intgrt -> lowerBounds[i];
+
+    for (size_t n = 0; n < (size_t) *nVec; n++)
+      {
+        /* Transform to unicube */
+        for (size_t i = 0; i < dim; i++)
+            xData[i] = intgrt -> lowerBounds[i] + xx[n * dim + i] * (intgrt -> upperBounds[i] - intgrt -> lowerBounds[i]);
+
+        /* Integrand */
+        intgrt -> integrandVec(xData, dim, intgrt -> params, fData);
+
+        for (size_t i = 0; i < nComps; i++)
+            ff[n * nComps + i] = fData[i] * jac;
+      }
+
+    return 0;
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  -----------------------------------   Randomised Quasi-Monte Carlo   ---------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+/* Number of (unscrambled) points evaluated in one block */
+#ifndef __INTGRT_QMC_BLOCK__
+#define __INTGRT_QMC_BLOCK__ 256
+#endif
+
+/* Number of bits of GSL's Sobol points and maximum dimension of the Sobol sequence */
+#ifndef __INTGRT_QMC_BITS__
+#define __INTGRT_QMC_BITS__ 30
+#endif
+
+#ifndef __INTGRT_QMC_MAX_DIM__
+#define __INTGRT_QMC_MAX_DIM__ 40
+#endif
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ####################################   Function Declarations   #######################################  */
+
+static int _integrate_qmc(double integrand(double*, size_t, void*), int integrandVec(double*, size_t, void*, double*), size_t nComp,
+                          intgrt_t *intgrt, double *result);
+
+/*  ######################################################################################################  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate_qmc(double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result)
+{
+    /*
+
+        Integrate a function over a region (provided in intgrt) with randomised quasi-Monte Carlo points.
+
+        Every scrambling applies an independent random digital shift (plus a random shift within the finest cell) to the
+        first 2^m points of the Sobol sequence (including the origin). The integral is the mean of the scramblings'
+        estimates and the error is the standard error of this mean. The number of points is doubled until
+        qmc -> relErr or qmc -> maxPoints is reached.
+
+        The points only depend on qmc -> seed, i.e. the results are reproducible regardless of the thread calling this
+        function. If a batched integrand was set (see integrate_batch), the points are evaluated in blocks.
+
+        The results are stored as result[0] = integral, result[1] = error and result[2] = number of points per scrambling.
+
+    */
+
+    return _integrate_qmc(integrand, NULL, 1, intgrt, result);
+}
+
+
+int integrate_qmc_vec(int integrandVec(double*, size_t, void*, double*), size_t nComp, intgrt_t *intgrt, double *result)
+{
+    /*
+
+        Integrate a vector valued function with nComp components over a region (provided in intgrt) with randomised
+        quasi-Monte Carlo points (see integrate_qmc). All components are integrated with the same points, and the number
+        of points is doubled until every component has reached qmc -> relErr.
+
+        The results of the i'th component are stored in result[3*i], result[3*i + 1] and result[3*i + 2].
+
+    */
+
+    return _integrate_qmc(NULL, integrandVec, nComp, intgrt, result);
+}
+
+
+static int _integrate_qmc(double integrand(double*, size_t, void*), int integrandVec(double*, size_t, void*, double*), size_t nComp,
+                          intgrt_t *intgrt, double *result)
+{
+    /*
+
+        Randomised quasi-Monte Carlo integration of a scalar (integrand) or vector valued (integrandVec with nComp
+        components) function
+
+    */
+
+    /* Reset result */
+    for (size_t c = 0; c < 3 * nComp; c++)
+        result[c] = 0.;
+
+    /* intgrt_qmc_t struct */
+    intgrt_qmc_t *qmc = intgrt -> qmc;
+
+    size_t dim = intgrt -> dim;
+
+    if (dim > __INTGRT_QMC_MAX_DIM__)
+      {
+        printf("The QMC integration routine supports at most %d dimensions (got %ld).\n", __INTGRT_QMC_MAX_DIM__, dim);
+        exit(1);
 
-        return 0;
+        return 1;
+      }
+
+    /* At least two scramblings for an error estimate */
+    size_t scramblings = (qmc -> scramblings < 2) ? 2 : qmc -> scramblings;
+
+    /* Number of points per scrambling (power of 2) */
+    size_t points = 1;
+
+    while (points < qmc -> points)
+        points *= 2;
+
+    /* Volume of the region */
+    double vol = 1.;
+
+    for (size_t j = 0; j < dim; j++)
+        vol *= intgrt -> upperBounds[j] - intgrt -> lowerBounds[j];
+
+
+    /* Scramblings */
+
+    gsl_rng *r = gsl_rng_alloc(gsl_rng_mt19937);
+    gsl_rng_set(r, qmc -> seed);
+
+    unsigned long *shift = malloc(sizeof(unsigned long) * scramblings * dim);
+    double *offset = malloc(sizeof(double) * scramblings * dim);
+
+    for (size_t i = 0; i < scramblings * dim; i++)
+      {
+        shift[i] = gsl_rng_uniform_int(r, 1UL << __INTGRT_QMC_BITS__);
+        offset[i] = gsl_rng_uniform(r);
+      }
+
+    gsl_rng_free(r);
+
+    /* Sobol sequence */
+    gsl_qrng *q = gsl_qrng_alloc(gsl_qrng_sobol, (unsigned int) dim);
+
+    double *sobol = malloc(sizeof(double) * dim);
+
+    double scale = ldexp(1., -__INTGRT_QMC_BITS__);
+
+    /* Buffer for the points and values of a block */
+    size_t block = __INTGRT_QMC_BLOCK__;
+
+    intgrt -> buffer = realloc(intgrt -> buffer, sizeof(double) * block * scramblings * (dim + nComp));
+
+    double *xData = intgrt -> buffer;
+    double *fData = intgrt -> buffer + block * scramblings * dim;
+
+    /* Sums of the integrand for every scrambling (and component) */
+    double *sums = calloc(scramblings * nComp, sizeof(double));
+
+
+    /* Integrate */
+
+    size_t n = 0;
+
+    do
+      {
+        /* Evaluate the next points */
+        while (n < points)
+          {
+            size_t nBlock = (points - n < block) ? points - n : block;
+
+            for (size_t b = 0; b < nBlock; b++)
+              {
+                /* Sobol point (GSL's sequence starts after the origin) */
+                if (n + b == 0)
+                  {
+                    for (size_t j = 0; j < dim; j++)
+                        sobol[j] = 0.;
+                  }
+
+                else
+                    gsl_qrng_get(q, sobol);
+
+                /* Scrambled points */
+                for (size_t l = 0; l < scramblings; l++)
+                  {
+                    for (size_t j = 0; j < dim; j++)
+                      {
+                        unsigned long digits = ((unsigned long) (sobol[j] / scale)) ^ shift[l * dim + j];
+                        double u = ((double) digits + offset[l * dim + j]) * scale;
+
+                        xData[(b * scramblings + l) * dim + j] = intgrt -> lowerBounds[j] + u * (intgrt -> upperBounds[j] - intgrt -> lowerBounds[j]);
+                      }
+                  }
+              }
+
+            /* Integrand */
+            if (integrandVec != NULL)
+              {
+                for (size_t i = 0; i < nBlock * scramblings; i++)
+                    integrandVec(xData + i * dim, dim, intgrt -> params, fData + i * nComp);
+              }
+
+            else if (intgrt -> integrandBatch != NULL)
+                intgrt -> integrandBatch(xData, dim, nBlock * scramblings, intgrt -> params, fData);
+
+            else
+              {
+                for (size_t i = 0; i < nBlock * scramblings; i++)
+                    fData[i] = integrand(xData + i * dim, dim, intgrt -> params);
+              }
+
+            for (size_t b = 0; b < nBlock; b++)
+              {
+                for (size_t l = 0; l < scramblings; l++)
+                  {
+                    for (size_t c = 0; c < nComp; c++)
+                        sums[l * nComp + c] += fData[(b * scramblings + l) * nComp + c];
+                  }
+              }
+
+            n += nBlock;
+          }
+
+        /* Mean and standard error of the scramblings */
+        bool converged = true;
+
+        for (size_t c = 0; c < nComp; c++)
+          {
+            double mean = 0.;
+            double var = 0.;
+
+            for (size_t l = 0; l < scramblings; l++)
+                mean += vol * sums[l * nComp + c] / (double) n;
+
+            mean /= (double) scramblings;
+
+            for (size_t l = 0; l < scramblings; l++)
+                var += pow(vol * sums[l * nComp + c] / (double) n - mean, 2.);
+
+            result[3*c] = mean;
+            result[3*c + 1] = sqrt(var / (double) (scramblings * (scramblings - 1)));
+            result[3*c + 2] = (double) n;
+
+            converged = converged && result[3*c + 1] <= qmc -> relErr * fabs(result[3*c]);
+          }
+
+        /* Relative error in bounds -> break loop */
+        if (qmc -> relErr == 0. || converged)
+          {
+            if (qmc -> verbose)
+                printf("Integral converged with %ld points per scrambling.\n", n);
+
+            break;
+          }
+
+        /* Maximum number of points reached -> break loop */
+        if (2 * points > qmc -> maxPoints)
+          {
+            if (qmc -> verbose)
+                printf("Integral did not converge with %ld points per scrambling.\n", n);
+
+            break;
+          }
+
+        points *= 2;
+      }
+
+    while (true);
+
+
+    /* Free memory */
+    gsl_qrng_free(q);
+
+    free(shift);
+    free(offset);
+    free(sobol);
+    free(sums);
+
+    return 0;
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ---------------------------------------   Adaptive Cubature   ----------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+typedef struct
+{
+    /*
+
+        Subregion of the adaptive cubature
+
+    */
+
+    double *center;
+    double *halfWidth;
+
+    /* Integrals and error estimates (of every component), largest scaled error and the axis along which the region is
+       bisected */
+    double *value;
+    double *error;
+
+    double errorMax;
+
+    size_t axis;
+
+} _intgrt_region_t;
+
+
+typedef struct
+{
+    /*
+
+        Integrand of the adaptive cubature, either scalar (integrand) or vector valued (integrandVec with nComp
+        components), and the scales of the errors of the components
+
+    */
+
+    double (*integrand)(double*, size_t, void*);
+    int (*integrandVec)(double*, size_t, void*, double*);
+
+    size_t nComp;
+
+    double *scale;
+
+    intgrt_t *intgrt;
+
+} _intgrt_cubature_eval_t;
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ####################################   Function Declarations   #######################################  */
+
+static int _integrate_cubature(double integrand(double*, size_t, void*), int integrandVec(double*, size_t, void*, double*), size_t nComp,
+                               intgrt_cubature_t *cubature, intgrt_t *intgrt, double *result);
+
+static size_t _integrate_cubature_points(size_t dim);
+
+static _intgrt_region_t *_integrate_cubature_region_new(size_t dim, size_t nComp);
+static _intgrt_region_t *_integrate_cubature_region_free(_intgrt_region_t *region);
+
+static int _integrate_cubature_rule(_intgrt_cubature_eval_t *eval, _intgrt_region_t *region);
+static int _integrate_cubature_rule_gk(_intgrt_cubature_eval_t *eval, _intgrt_region_t *region);
+static int _integrate_cubature_rule_gm(_intgrt_cubature_eval_t *eval, _intgrt_region_t *region);
+
+static int _integrate_cubature_eval(_intgrt_cubature_eval_t *eval, size_t nPoints);
+
+static int _integrate_cubature_push(_intgrt_region_t **heap, size_t *size, _intgrt_region_t *region);
+static _intgrt_region_t *_integrate_cubature_pop(_intgrt_region_t **heap, size_t *size);
+
+/*  ######################################################################################################  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int integrate_cubature(double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result)
+{
+    /*
+
+        Integrate a function over a region (provided in intgrt) with deterministic h-adaptive cubature: the subregion with
+        the largest error estimate is bisected until the total error is below max(absErr, relErr * |integral|) or the
+        next bisection would exceed cubature -> maxEval evaluations.
+
+        Every subregion is integrated with the embedded degree 7/5 rule of Genz & Malik (the 15 point Gauss-Kronrod rule in
+        one dimension) and is bisected along the axis with the largest fourth divided difference.
+
+        The results are stored as result[0] = integral, result[1] = error and result[2] = number of evaluations.
+
+    */
+
+    return _integrate_cubature(integrand, NULL, 1, intgrt -> cubature, intgrt, result);
+}
+
+
+int integrate_cubature_vec(int integrandVec(double*, size_t, void*, double*), size_t nComp, intgrt_t *intgrt, double *result)
+{
+    /*
+
+        Integrate a vector valued function with nComp components over a region (provided in intgrt) with deterministic
+        h-adaptive cubature (see integrate_cubature). All components share the subregions: the subregion with the largest
+        error of any component (relative to the tolerance of the component) is bisected until every component has
+        converged.
+
+        The results of the i'th component are stored in result[3*i], result[3*i + 1] and result[3*i + 2].
+
+    */
+
+    return _integrate_cubature(NULL, integrandVec, nComp, intgrt -> cubature, intgrt, result);
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static int _integrate_cubature(double integrand(double*, size_t, void*), int integrandVec(double*, size_t, void*, double*), size_t nComp,
+                               intgrt_cubature_t *cubature, intgrt_t *intgrt, double *result)
+{
+    /*
+
+        Adaptive cubature of a scalar (integrand) or vector valued (integrandVec with nComp components) function with the
+        settings in cubature
+
+    */
+
+    size_t dim = intgrt -> dim;
+
+    /* Integrand */
+    double *scale = malloc(sizeof(double) * nComp);
+
+    for (size_t c = 0; c < nComp; c++)
+        scale[c] = 1.;
+
+    _intgrt_cubature_eval_t eval = {integrand, integrandVec, nComp, scale, intgrt};
+
+    /* Points per subregion */
+    size_t nPoints = _integrate_cubature_points(dim);
+
+    intgrt -> buffer = realloc(intgrt -> buffer, sizeof(double) * nPoints * (dim + nComp));
+
+    /* Heap of the subregions (largest error first) */
+    size_t capacity = 64;
+    size_t size = 0;
+
+    _intgrt_region_t **heap = malloc(sizeof(_intgrt_region_t*) * capacity);
+
+    /* Whole region */
+    _intgrt_region_t *region = _integrate_cubature_region_new(dim, nComp);
+
+    for (size_t j = 0; j < dim; j++)
+      {
+        region -> center[j] = (intgrt -> upperBounds[j] + intgrt -> lowerBounds[j]) / 2.;
+        region -> halfWidth[j] = (intgrt -> upperBounds[j] - intgrt -> lowerBounds[j]) / 2.;
+      }
+
+    _integrate_cubature_rule(&eval, region);
+    _integrate_cubature_push(heap, &size, region);
+
+    /* Scale the errors by the tolerance of the component, such that the components of different size are refined alike */
+    for (size_t c = 0; c < nComp; c++)
+      {
+        double tol = fmax(cubature -> absErr, cubature -> relErr * fabs(region -> value[c]));
+
+        scale[c] = (tol > 0.) ? tol : 1.;
+      }
+
+    size_t nEval = nPoints;
+
+    double *value = malloc(sizeof(double) * nComp);
+    double *error = malloc(sizeof(double) * nComp);
+
+    memcpy(value, region -> value, sizeof(double) * nComp);
+    memcpy(error, region -> error, sizeof(double) * nComp);
+
+
+    /* Bisect subregions */
+
+    while (true)
+      {
+        /* All components converged -> break loop */
+        bool converged = true;
+
+        for (size_t c = 0; c < nComp; c++)
+            converged = converged && error[c] <= fmax(cubature -> absErr, cubature -> relErr * fabs(value[c]));
+
+        if (converged)
+          {
+            if (cubature -> verbose)
+                printf("Integral converged after %ld evaluations.\n", nEval);
+
+            break;
+          }
+
+        /* Maximum number of evaluations reached -> break loop */
+        if (nEval + 2 * nPoints > cubature -> maxEval)
+          {
+            if (cubature -> verbose)
+                printf("Integral did not converge after %ld evaluations.\n", nEval);
+
+            break;
+          }
+
+        /* Make room for one more subregion */
+        if (size + 1 >= capacity)
+          {
+            capacity *= 2;
+            heap = realloc(heap, sizeof(_intgrt_region_t*) * capacity);
+          }
+
+        /* Subregion with the largest error */
+        region = _integrate_cubature_pop(heap, &size);
+
+        for (size_t c = 0; c < nComp; c++)
+          {
+            value[c] -= region -> value[c];
+            error[c] -= region -> error[c];
+          }
+
+        /* Bisect */
+        _intgrt_region_t *regionCp = _integrate_cubature_region_new(dim, nComp);
+
+        memcpy(regionCp -> center, region -> center, sizeof(double) * dim);
+        memcpy(regionCp -> halfWidth, region -> halfWidth, sizeof(double) * dim);
+
+        size_t axis = region -> axis;
+
+        region -> halfWidth[axis] /= 2.;
+        regionCp -> halfWidth[axis] /= 2.;
+
+        region -> center[axis] -= region -> halfWidth[axis];
+        regionCp -> center[axis] += regionCp -> halfWidth[axis];
+
+        _integrate_cubature_rule(&eval, region);
+        _integrate_cubature_rule(&eval, regionCp);
+
+        _integrate_cubature_push(heap, &size, region);
+        _integrate_cubature_push(heap, &size, regionCp);
+
+        nEval += 2 * nPoints;
+
+        for (size_t c = 0; c < nComp; c++)
+          {
+            value[c] += region -> value[c] + regionCp -> value[c];
+            error[c] += region -> error[c] + regionCp -> error[c];
+          }
       }
 
-    /* Vegas */
-    if (misc_sinci((const char*) intgrt -> routine, _idIntgrtVegas_))
-      {
-        integrate_vegas(integrand, intgrt, result);
 
-        return 0;
+    /* Result (summed again to avoid the rounding errors of the updates) */
+
+    for (size_t c = 0; c < nComp; c++)
+      {
+        result[3*c] = 0.;
+        result[3*c + 1] = 0.;
+        result[3*c + 2] = (double) nEval;
       }
 
-    /* Divonne */
-    if (misc_sinci((const char*) intgrt -> routine, _idIntgrtDivonne_))
+    for (size_t i = 0; i < size; i++)
       {
-        integrate_divonne(integrand, intgrt, result);
+        for (size_t c = 0; c < nComp; c++)
+          {
+            result[3*c] += heap[i] -> value[c];
+            result[3*c + 1] += heap[i] -> error[c];
+          }
 
-        return 0;
+        heap[i] = _integrate_cubature_region_free(heap[i]);
       }
 
-    /* Did not find routine */
-    printf("Did not find any '%s' integration routine.\n", intgrt -> routine);
-    exit(1);
+    /* Free memory */
+    free(heap);
 
-    return 1;
-}
+    free(value);
+    free(error);
 
+    free(scale);
+
+    return 0;
+}
 
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  ------------------------------------------   GSL's CQUAD   -------------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-int integrate_cquad(double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result)
+static size_t _integrate_cubature_points(size_t dim)
 {
     /*
 
-        Integrate a function over a 1d region (provided in intgrt) using the CQUAD routine from GSL.
+        Number of points of the cubature rule in dim dimensions
 
     */
 
-    /* Reset result */
-    result[0] = 0.;
-    result[1] = 0.;
+    /* Gauss-Kronrod */
+    if (dim == 1)
+        return 15;
 
-    /* Set integrand */
-    integrate_set_integrand(intgrt, integrand);
+    /* Genz-Malik: centre + 2 * 2 * dim axes + 2 * dim * (dim - 1) planes + 2^dim corners */
+    return 1 + 4 * dim + 2 * dim * (dim - 1) + ((size_t) 1 << dim);
+}
 
-    /* intgrt_cquad_t struct */
-    intgrt_cquad_t *cquad = intgrt -> cquad;
 
-    /* Allocate working memory for CQUAD */
-    gsl_integration_cquad_workspace *work = gsl_integration_cquad_workspace_alloc(cquad -> limit);
+static _intgrt_region_t *_integrate_cubature_region_new(size_t dim, size_t nComp)
+{
+    /*
 
-    /* Integrand to be passed to CQUAD */
-    gsl_function integrandCQUAD;
-    integrandCQUAD.function = &integrate_cquad_integrand;
-    integrandCQUAD.params = intgrt;
+        Create a new subregion in dim dimensions for nComp components
 
-    /* Integrate */
-    gsl_integration_cquad(&integrandCQUAD, *(intgrt -> lowerBounds), *(intgrt -> upperBounds), cquad -> absErr, cquad -> relErr, work, &result[0], &result[1], NULL);
+    */
 
-    /* Free allocated memory */
-    gsl_integration_cquad_workspace_free(work);
+    _intgrt_region_t *region = malloc(sizeof(_intgrt_region_t));
 
-    return 0;
-}
+    region -> center = malloc(sizeof(double) * dim);
+    region -> halfWidth = malloc(sizeof(double) * dim);
 
+    region -> value = malloc(sizeof(double) * nComp);
+    region -> error = malloc(sizeof(double) * nComp);
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  ------------------------------------------------------------------------------------------------------  */
+    region -> errorMax = 0.;
+    region -> axis = 0;
+
+    return region;
+}
 
 
-double integrate_cquad_integrand(double x, void *params)
+static _intgrt_region_t *_integrate_cubature_region_free(_intgrt_region_t *region)
 {
     /*
 
-        Integrand for integrate_divonne
+        Free a subregion
 
     */
 
-    intgrt_t *intgrt = (intgrt_t*) params;
+    if (region == NULL)
+        return NULL;
 
-    return intgrt -> integrand(&x, intgrt -> dim, intgrt -> params);
-}
+    free(region -> center);
+    free(region -> halfWidth);
 
+    free(region -> value);
+    free(region -> error);
 
+    free(region);
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  ------------------------------------------   GSL's VEGAS   -------------------------------------------  */
-/*  ------------------------------------------------------------------------------------------------------  */
+    return NULL;
+}
 
 
-int integrate_vegas(double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result)
+static int _integrate_cubature_rule(_intgrt_cubature_eval_t *eval, _intgrt_region_t *region)
 {
     /*
 
-        Integrate a function over a region (provided in intgrt) using the Monte-Carlo integration algorithm VEGAS from GSL.
+        Integrate the function over region and estimate the error of the result
 
     */
 
-    /* Reset result */
-    result[0] = 0.;
-    result[1] = 0.;
-    result[2] = 0.;
+    if (eval -> intgrt -> dim == 1)
+        _integrate_cubature_rule_gk(eval, region);
 
-    /* intgrt_vegas_t struct */
-    intgrt_vegas_t *vegas = intgrt -> vegas;
+    else
+        _integrate_cubature_rule_gm(eval, region);
 
-    /* Setup VEGAS */
+    /* Largest scaled error of the components */
+    region -> errorMax = 0.;
 
-    const gsl_rng_type *T;
-    gsl_rng *r;
+    for (size_t c = 0; c < eval -> nComp; c++)
+        region -> errorMax = fmax(region -> errorMax, region -> error[c] / eval -> scale[c]);
 
-    gsl_monte_function monteIntegral = {integrand, intgrt -> dim, intgrt -> params};
+    return 0;
+}
 
-    gsl_rng_env_setup();
 
-    T = gsl_rng_default;
-    r = gsl_rng_alloc(T);
+static int _integrate_cubature_rule_gk(_intgrt_cubature_eval_t *eval, _intgrt_region_t *region)
+{
+    /*
 
-    gsl_monte_vegas_state *s = gsl_monte_vegas_alloc(intgrt -> dim);
+        15 point Gauss-Kronrod rule with the embedded 7 point Gauss rule (one dimension)
 
+    */
 
-    /* VEGAS warm up */
+    /* Abscissae and weights of the Kronrod rule, and the weights of the Gauss rule (at every second abscissa) */
+    static const double xgk[8] = {0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+                                  0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+                                  0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+                                  0.207784955007898467600689403773245, 0.000000000000000000000000000000000};
 
-    /* Integrate */
-    gsl_monte_vegas_integrate(&monteIntegral, intgrt -> lowerBounds, intgrt -> upperBounds, intgrt -> dim, vegas -> warmUpCalls, r, s, &result[0], &result[1]);
+    static const double wgk[8] = {0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+                                  0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+                                  0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+                                  0.204432940075298892414161999234649, 0.209482141084727828012999174891714};
 
-    /* χ^2 */
-    result[2] = gsl_monte_vegas_chisq(s);
+    static const double wg[4] = {0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+                                 0.381830050505118944950369775488975, 0.417959183673469387755102040816327};
 
+    size_t nComp = eval -> nComp;
 
-    /* VEGAS main stage */
+    double center = region -> center[0];
+    double halfWidth = region -> halfWidth[0];
 
-    int loop = 0;
-    size_t mainCalls = vegas -> mainCalls;
-    double relErr = 0.;
+    /* Points: centre, then pairs ±xgk[i] */
+    double *xData = eval -> intgrt -> buffer;
+    double *fData = eval -> intgrt -> buffer + 15;
 
+    xData[0] = center;
 
-    do
+    for (size_t i = 0; i < 7; i++)
       {
-        /* If the algorithm does not converge break the loop after vegas -> maxLoop iterations */
-        if (loop == vegas -> maxLoop)
+        xData[1 + 2 * i] = center - halfWidth * xgk[i];
+        xData[2 + 2 * i] = center + halfWidth * xgk[i];
+      }
+
+    _integrate_cubature_eval(eval, 15);
+
+    /* Kronrod and Gauss results */
+    for (size_t c = 0; c < nComp; c++)
+      {
+        double resultK = wgk[7] * fData[c];
+        double resultG = wg[3] * fData[c];
+
+        for (size_t i = 0; i < 7; i++)
           {
-            if (vegas -> verbose)
-                printf("Integral did not converge after %d iterations.\n", vegas -> maxLoop);
+            resultK += wgk[i] * (fData[(1 + 2 * i) * nComp + c] + fData[(2 + 2 * i) * nComp + c]);
 
-            break;
+            if (i % 2 == 1)
+                resultG += wg[i / 2] * (fData[(1 + 2 * i) * nComp + c] + fData[(2 + 2 * i) * nComp + c]);
           }
 
-        loop++;
+        region -> value[c] = resultK * halfWidth;
+        region -> error[c] = fabs((resultK - resultG) * halfWidth);
+      }
 
-        /* Integrate */
-        gsl_monte_vegas_integrate(&monteIntegral, intgrt -> lowerBounds, intgrt -> upperBounds, intgrt -> dim, mainCalls, r, s, &result[0], &result[1]);
+    region -> axis = 0;
 
-        /* χ^2 */
-        result[2] = gsl_monte_vegas_chisq(s);
+    return 0;
+}
 
-        /* Check for relative error */
-        if (vegas -> relErr != 0.)
-          {
-            /* Relative error */
-            relErr = (result[0] != 0.) ? result[1] / fabs(result[0]) : 0.;
 
-            /* Relative error out of bounds -> increase number of function evaluations and continue loop */
-            if (relErr > vegas -> relErr)
-              {
-                mainCalls = (size_t) (((double) mainCalls) * vegas -> updateCalls);
+static int _integrate_cubature_rule_gm(_intgrt_cubature_eval_t *eval, _intgrt_region_t *region)
+{
+    /*
 
-                continue;
-              }
+        Embedded degree 7/5 rule of Genz & Malik (dim >= 2)
 
-            /* Relative error in bounds and chisq error in bounds -> break loop */
-            else if (fabs(result[2] - 1.) < vegas -> chisqErr)
-              {
-                if (vegas -> verbose)
-                    printf("Integral converged after %d iterations.\n", loop);
+    */
 
-                break;
-              }
+    size_t dim = eval -> intgrt -> dim;
+    size_t nComp = eval -> nComp;
+
+    double n = (double) dim;
+
+    /* Generators */
+    const double lambda2 = sqrt(9. / 70.);
+    const double lambda3 = sqrt(9. / 10.);
+    const double lambda4 = sqrt(9. / 10.);
+    const double lambda5 = sqrt(9. / 19.);
+
+    /* Weights of the degree 7 rule */
+    const double w1 = (12824. - 9120. * n + 400. * n*n) / 19683.;
+    const double w2 = 980. / 6561.;
+    const double w3 = (1820. - 400. * n) / 19683.;
+    const double w4 = 200. / 19683.;
+    const double w5 = 6859. / 19683. / ldexp(1., (int) dim);
+
+    /* Weights of the degree 5 rule */
+    const double v1 = (729. - 950. * n + 50. * n*n) / 729.;
+    const double v2 = 245. / 486.;
+    const double v3 = (265. - 100. * n) / 1458.;
+    const double v4 = 25. / 729.;
+
+    size_t nPoints = _integrate_cubature_points(dim);
+
+    double *xData = eval -> intgrt -> buffer;
+    double *fData = eval -> intgrt -> buffer + nPoints * dim;
+
+    double *center = region -> center;
+    double *halfWidth = region -> halfWidth;
+
+
+    /* Points */
+
+    size_t index = 0;
+
+    /* Centre */
+    memcpy(xData, center, sizeof(double) * dim);
+    index++;
+
+    /* ±lambda2 e_i and ±lambda3 e_i (in the order -lambda2, +lambda2, -lambda3, +lambda3 for every axis) */
+    for (size_t i = 0; i < dim; i++)
+      {
+        double lambda[4] = {-lambda2, lambda2, -lambda3, lambda3};
+
+        for (size_t l = 0; l < 4; l++)
+          {
+            memcpy(xData + index * dim, center, sizeof(double) * dim);
+            xData[index * dim + i] += lambda[l] * halfWidth[i];
+
+            index++;
           }
+      }
 
-        /* Chisq error in bounds -> break loop */
-        if (fabs(result[2] - 1.) < vegas -> chisqErr)
+    /* ±lambda4 e_i ±lambda4 e_j */
+    for (size_t i = 0; i < dim; i++)
+      {
+        for (size_t j = i + 1; j < dim; j++)
           {
-            if (vegas -> verbose)
-                printf("Integral converged after %d iterations.\n", loop);
+            for (size_t l = 0; l < 4; l++)
+              {
+                memcpy(xData + index * dim, center, sizeof(double) * dim);
+                xData[index * dim + i] += ((l & 1) ? lambda4 : -lambda4) * halfWidth[i];
+                xData[index * dim + j] += ((l & 2) ? lambda4 : -lambda4) * halfWidth[j];
 
-            break;
+                index++;
+              }
           }
       }
 
-    while (true);
+    /* Corners (±lambda5, ..., ±lambda5) */
+    for (size_t l = 0; l < ((size_t) 1 << dim); l++)
+      {
+        for (size_t i = 0; i < dim; i++)
+            xData[index * dim + i] = center[i] + (((l >> i) & 1) ? lambda5 : -lambda5) * halfWidth[i];
 
+        index++;
+      }
 
-    /* Free allocated memory */
+    _integrate_cubature_eval(eval, nPoints);
 
-    gsl_rng_free(r);
-    gsl_monte_vegas_free(s);
 
-    return 0;
-}
+    /* Volume */
+    double vol = 1.;
 
+    for (size_t i = 0; i < dim; i++)
+        vol *= 2. * halfWidth[i];
 
-int integrate_plain(double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result)
-{
-    /*
 
-        Integrate a function over a region (provided in "intgrt") using the plain Monte-Carlo integration from GSL.
+    /* Sums + bisection axis (largest fourth divided difference of any component) */
 
-    */
+    double maxDiff = -1.;
+    region -> axis = 0;
 
-    /* Reset result */
-    result[0] = 0.;
-    result[1] = 0.;
-    result[2] = 0.;
+    for (size_t c = 0; c < nComp; c++)
+      {
+        double f0 = fData[c];
 
-    /* Setup */
-    const gsl_rng_type *T;
-    gsl_rng *r;
+        double sum2 = 0.;
+        double sum3 = 0.;
+        double sum4 = 0.;
+        double sum5 = 0.;
 
-    gsl_monte_function monteIntegral = {integrand, intgrt -> dim, intgrt -> params};
+        for (size_t i = 0; i < dim; i++)
+          {
+            double f2 = fData[(1 + 4 * i) * nComp + c] + fData[(2 + 4 * i) * nComp + c];
+            double f3 = fData[(3 + 4 * i) * nComp + c] + fData[(4 + 4 * i) * nComp + c];
 
-    gsl_rng_env_setup();
+            sum2 += f2;
+            sum3 += f3;
 
-    T = gsl_rng_default;
-    r = gsl_rng_alloc(T);
+            /* Fourth divided difference (lambda2^2 / lambda3^2 = 1/7) */
+            double diff = fabs(f2 - 2. * f0 - (f3 - 2. * f0) / 7.);
 
-    gsl_monte_plain_state *s = gsl_monte_plain_alloc(intgrt -> dim);
+            if (diff > maxDiff || (diff == maxDiff && halfWidth[i] > halfWidth[region -> axis]))
+              {
+                maxDiff = diff;
+                region -> axis = i;
+              }
+          }
 
-    /* Integrate */
-    gsl_monte_plain_integrate(&monteIntegral, intgrt -> lowerBounds, intgrt -> upperBounds, intgrt -> dim, intgrt -> vegas -> mainCalls, r, s, &result[0], &result[1]);
+        for (size_t l = 1 + 4 * dim; l < 1 + 4 * dim + 2 * dim * (dim - 1); l++)
+            sum4 += fData[l * nComp + c];
 
-    /* Free allocated memory */
-    gsl_rng_free(r);
-    gsl_monte_plain_free(s);
+        for (size_t l = 1 + 4 * dim + 2 * dim * (dim - 1); l < nPoints; l++)
+            sum5 += fData[l * nComp + c];
+
+        /* Degree 7 and degree 5 results */
+        double result7 = vol * (w1 * f0 + w2 * sum2 + w3 * sum3 + w4 * sum4 + w5 * sum5);
+        double result5 = vol * (v1 * f0 + v2 * sum2 + v3 * sum3 + v4 * sum4);
+
+        region -> value[c] = result7;
+        region -> error[c] = fabs(result7 - result5);
+      }
 
     return 0;
 }
 
 
-
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  ----------------------------------------   CUBA's Divonne   ------------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-int integrate_divonne(double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result)
+static int _integrate_cubature_eval(_intgrt_cubature_eval_t *eval, size_t nPoints)
 {
     /*
 
-        Integrate a function over a region (provided in "intgrt") with the Divonne integration from CUBA
+        Evaluate the integrand at the nPoints points in intgrt -> buffer (the values of all components are stored after
+        the points, point by point)
 
     */
 
-    int nRegions, nEval, fail;
-    cubareal integral, error, prob;
+    intgrt_t *intgrt = eval -> intgrt;
 
-    /* Divonne struct */
-    intgrt_divonne_t *divonne = intgrt -> divonne;
+    double *xData = intgrt -> buffer;
+    double *fData = intgrt -> buffer + nPoints * intgrt -> dim;
 
-    /* Set integrand */
-    integrate_set_integrand(intgrt, integrand);
+    if (eval -> integrandVec != NULL)
+      {
+        for (size_t i = 0; i < nPoints; i++)
+            eval -> integrandVec(xData + i * intgrt -> dim, intgrt -> dim, intgrt -> params, fData + i * eval -> nComp);
+      }
 
-    /* Integrate */
-    Divonne((int) intgrt -> dim, divonne -> nComp, integrate_divonne_integrand, intgrt, divonne -> nVec,
-            divonne -> epsRel, divonne -> epsAbs,
-            divonne -> verbose,
-            divonne -> seed,
-            divonne -> minEval, divonne -> maxEval,
-            divonne -> key1, divonne -> key2, divonne -> key3,
-            divonne -> maxPass,
-            divonne -> border,
-            divonne -> maxChisq, divonne -> minDeviation,
-            0, 0, NULL, 0, NULL, NULL, NULL, // Never used
-            &nRegions, &nEval, &fail, &integral, &error, &prob); // Output
+    else if (intgrt -> integrandBatch != NULL)
+        intgrt -> integrandBatch(xData, intgrt -> dim, nPoints, intgrt -> params, fData);
 
-    /* Result */
-    result[0] = (double) integral;
-    result[1] = (double) error;
-    result[2] = (double) prob;
+    else
+      {
+        for (size_t i = 0; i < nPoints; i++)
+            fData[i] = eval -> integrand(xData + i * intgrt -> dim, intgrt -> dim, intgrt -> params);
+      }
 
     return 0;
 }
 
 
-/*  ------------------------------------------------------------------------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-int integrate_divonne_integrand(const int *nDim, const cubareal xx[], const int *nComp, cubareal ff[], void *usrData)
+static int _integrate_cubature_push(_intgrt_region_t **heap, size_t *size, _intgrt_region_t *region)
 {
     /*
 
-        Integrand for integrate_divonne
+        Add a subregion to the heap (ordered by the largest scaled error, the heap must have room for it)
 
     */
 
-    (void) nComp;
+    size_t i = (*size)++;
 
-    /* Integrate struct */
-    intgrt_t *intgrt = (intgrt_t*) usrData;
+    while (i > 0 && heap[(i - 1) / 2] -> errorMax < region -> errorMax)
+      {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+      }
 
-    /* x Data */
-    double *xData = malloc(sizeof(double) * ((size_t) *nDim));
+    heap[i] = region;
 
-    /* Jacobian to obtain unicube as integration region */
-    double jac = 1.;
+    return 0;
+}
 
-    /* Transform to unicube */
-    for (size_t i = 0; i < (size_t) *nDim; i++)
+
+static _intgrt_region_t *_integrate_cubature_pop(_intgrt_region_t **heap, size_t *size)
+{
+    /*
+
+        Remove the subregion with the largest scaled error from the heap
+
+    */
+
+    _intgrt_region_t *top = heap[0];
+    _intgrt_region_t *last = heap[--(*size)];
+
+    size_t i = 0;
+
+    while (2 * i + 1 < *size)
       {
-        xData[i] = intgrt -> lowerBounds[i] + xx[i] * (intgrt -> upperBounds[i] - intgrt -> lowerBounds[i]);
-        jac *= intgrt -> upperBounds[i] - intgrt -> lowerBounds[i];
-      }
+        size_t child = 2 * i + 1;
 
-    /* Integrand */
-    ff[0] = intgrt -> integrand(xData, (size_t) *nDim, intgrt -> params) * jac;
+        if (child + 1 < *size && heap[child + 1] -> errorMax > heap[child] -> errorMax)
+            child++;
 
-    /* Free memory */
-    free(xData);
+        if (heap[child] -> errorMax <= last -> errorMax)
+            break;
 
-    return 0;
+        heap[i] = heap[child];
+        i = child;
+      }
+
+    if (*size > 0)
+        heap[i] = last;
+
+    return top;
 }
 
 
@@ -8,6 +8,71 @@
 #include "interpolate.h"
 
 
+/**  Uniform Grid  **/
+
+typedef struct
+{
+    /*
+
+        Cubic Hermite spline on a uniform grid in t = x (or t = log(x)) with nodes t_i = t0 + i * dt
+
+    */
+
+    /* Number of nodes */
+    size_t size;
+
+    /* Grid parameters */
+    double t0;
+    double dt;
+    double invDt;
+
+    /* Logarithmic grid */
+    bool log;
+
+    /* Values and scaled slopes dt * dy/dt, interleaved as (y_0, m_0, y_1, m_1, ...) */
+    double *ym;
+
+} _interp_uniform_t;
+
+
+/**  Regular Grid  **/
+
+typedef struct
+{
+    /*
+
+        Tensor product of cubic Hermite splines on a regular (not necessarily equidistant) grid, restricted to the
+        dimensions with at least two nodes (i.e. to the xIndUniq dimensions of the interp_t struct)
+
+    */
+
+    /* Number of dimensions */
+    size_t dim;
+
+    /* Number of nodes and strides of each dimension */
+    size_t *sizes;
+    size_t *strides;
+
+    /* Nodes (sorted) of each dimension */
+    double **nodes;
+
+    /* Values at the grid points (row-major) */
+    double *values;
+
+} _interp_grid_t;
+
+
+/*  ####   Function Declarations   ####  */
+
+static interp_t *_interp_init_uniform(dat_t *dat, double (*extrapolate)(void*, void*, void*, size_t*, size_t), bool logGrid);
+static double _interp_eval_uniform(void *values, interp_t *interp, void *params, bool deriv);
+static int _interp_eval_uniform_n(double *values, size_t n, interp_t *interp, void *params, bool deriv, double *result);
+static inline double _interp_uniform_hermite(const _interp_uniform_t *uniform, double x, bool deriv);
+
+static int _interp_cmp_double(const void *a, const void *b);
+static size_t _interp_grid_find(const double *nodes, size_t size, double x);
+static size_t _interp_grid_weights(const double *nodes, size_t size, double x, size_t *lower, double *weights);
+
 
 
 
@@ -382,301 +447,1150 @@ interp_t *interpolate_interp_init_gsl(dat_t *dat, double (*extrapolate)(void*, v
 
 
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  ---------------------------------   Evaluate Interpolation Functions   -------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-double interpolate_interp_eval(double (*interpEval)(void*, interp_t*, void*), void *values, interp_t *interp, void *params)
+interp_t *interpolate_interp_init_uniform(dat_t *dat, double (*extrapolate)(void*, void*, void*, size_t*, size_t))
 {
     /*
 
-        Master interpolation function calls the interpolation function "interpFunc"
-        for the input values "values" with additional parameters "params" for the extrapolation function.
+        Setup the 1-d cubic spline interpolation on a uniform grid in x (see _interp_init_uniform).
 
     */
 
-    return interpEval(values, interp, params);
+    return _interp_init_uniform(dat, extrapolate, false);
 }
 
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  ------------------------------------------------------------------------------------------------------  */
-
-
-double interpolate_interp_eval_splinter(void *values, interp_t *interp, void *params)
+interp_t *interpolate_interp_init_uniform_log(dat_t *dat, double (*extrapolate)(void*, void*, void*, size_t*, size_t))
 {
     /*
 
-        Evaluate the spline interpolation by splinter (see interpolate_interp_init_splinter).
+        Setup the 1-d cubic spline interpolation on a uniform grid in log(x) (see _interp_init_uniform).
 
     */
 
-    double *xValues = (double*) values;
+    return _interp_init_uniform(dat, extrapolate, true);
+}
 
-    /* If spline is NULL the interpolation function was fed a constant */
-    if (interp -> spline == NULL)
-      {
-        return interp -> yBounds[0];
-      }
 
-    /* Only keep the unique x-dimensions */
-    double *xValuesUniq = malloc(sizeof(double) * interp -> xDimUniq);
+static interp_t *_interp_init_uniform(dat_t *dat, double (*extrapolate)(void*, void*, void*, size_t*, size_t), bool logGrid)
+{
+    /*
 
-    size_t indicesExtrapSize = 0;
-    size_t *indicesExtrap = NULL;
-    bool inBounds = true;
+        Setup the 1-d cubic spline interpolation on a uniform grid in t = x (or t = log(x) if logGrid is true): the data
+        is resampled once with a steffen spline by gsl (linear for two data points) at
+        max(__INTERP_UNIFORM_FACTOR__ * size, __INTERP_UNIFORM_MIN_SIZE__) equidistant nodes, whose values and slopes are
+        stored for a cubic Hermite interpolation. The node of a given x is thus found in O(1) and evaluations neither
+        allocate memory nor modify any state, i.e. they are thread-safe.
 
-    for (size_t i = 0; i < interp -> xDimUniq; i++)
+    */
+
+    if (dat -> xDim != 1)
       {
-        xValuesUniq[i] = xValues[interp -> xIndUniq[i]];
+        printf("The uniform grid interpolation requires 1-d x-data (got %ld dimensions).\n", dat -> xDim);
+        exit(1);
 
-        /* Check the lower bounds */
-        if (xValuesUniq[i] < interp -> xBounds[interp -> xIndUniq[i]][0])
-          {
-            if (fabs(xValuesUniq[i] - interp -> xBounds[interp -> xIndUniq[i]][0]) < __ABSTOL__)
-              {
-                xValuesUniq[i] = interp -> xBounds[interp -> xIndUniq[i]][0];
+        return NULL;
+      }
 
-                continue;
-              }
 
-            indicesExtrap = realloc(indicesExtrap, sizeof(size_t) * (indicesExtrapSize + 1));
-            indicesExtrap[indicesExtrapSize++] = interp -> xIndUniq[i];
+    /* xData and yData as 1-d arrays, sorted in x */
 
-            inBounds = false;
-          }
+    size_t size = dat -> size;
 
-        /* Check the upper bounds */
-        if (xValuesUniq[i] > interp -> xBounds[interp -> xIndUniq[i]][1])
-          {
-            if (fabs(xValuesUniq[i] - interp -> xBounds[interp -> xIndUniq[i]][1]) < __ABSTOL__)
-              {
-                xValuesUniq[i] = interp -> xBounds[interp -> xIndUniq[i]][1];
+    double *xData = dat_get_array(dat, 0, 'x');
+    double *yData = dat_get_array(dat, 0, 'y');
 
-                continue;
-              }
+    for (size_t n = 1; n < size; n++)
+      {
+        double xPnt = xData[n];
+        double yPnt = yData[n];
 
-            indicesExtrap = realloc(indicesExtrap, sizeof(size_t) * (indicesExtrapSize + 1));
-            indicesExtrap[indicesExtrapSize++] = interp -> xIndUniq[i];
+        size_t i = n;
 
-            inBounds = false;
+        while (i > 0 && xData[i - 1] > xPnt)
+          {
+            xData[i] = xData[i - 1];
+            yData[i] = yData[i - 1];
+
+            i--;
           }
+
+        xData[i] = xPnt;
+        yData[i] = yPnt;
       }
 
-    /* Result of the interpolation */
-    double *res, resReturn;
 
-    /* In bounds, no need for extrapolation */
-    if (inBounds)
-      {
-        res = splinter_bspline_eval_row_major((splinter_obj_ptr) interp -> spline, xValuesUniq, (int) interp -> xDimUniq);
-        resReturn = *res;
-        free(res);
-      }
+    /* Setup the interp_t struct */
 
-    /* Out of bounds, need to extrapolate */
-    else
-      {
-        if (interp -> extrapolate == NULL)
-          {
-            /* Cannot extrapolate */
-            printf("Cannot extrapolate if no extrapolation function has been provided.\n");
-            exit(1);
+    interp_t *interp = malloc(sizeof(interp_t));
 
-            return NAN;
-          }
+    interp -> acc = NULL;
+    interp -> spline = NULL;
+    interp -> extrapolate = extrapolate;
 
-        resReturn = interp -> extrapolate(values, interp, params, indicesExtrap, indicesExtrapSize);
-      }
+    /* Bounds of interpolation */
+    interp -> xBounds = malloc(sizeof(double*));
+    interp -> xBounds[0] = malloc(sizeof(double) * 2);
+    interp -> yBounds = malloc(sizeof(double) * 2);
 
-    /* Free memories */
-    free(xValuesUniq);
-    free(indicesExtrap);
+    interp -> xBounds[0][0] = xData[0];
+    interp -> yBounds[0] = yData[0];
 
-    return resReturn;
-}
+    interp -> xBounds[0][1] = xData[size - 1];
+    interp -> yBounds[1] = yData[size - 1];
 
+    /* xDim + xDimUniq + xIndUniq */
+    interp -> xDim = 1;
+    interp -> xDimUniq = 1;
+    interp -> xIndUniq = NULL;
 
-/*  ------------------------------------------------------------------------------------------------------  */
 
+    /* Constant data (spline stays NULL) */
 
-double interpolate_interp_eval_gsl(void *values, interp_t *interp, void *params)
-{
-    /*
+    bool constant = true;
 
-        Evaluate the interpolation function by gsl (1-d).
+    for (size_t n = 1; n < size; n++)
+      {
+        if (yData[n] != yData[0])
+          {
+            constant = false;
+            break;
+          }
+      }
 
-    */
+    if (constant)
+      {
+        free(xData);
+        free(yData);
 
-    /* Convert input variables */
-    double *xValues = (double*) values;
+        return interp;
+      }
 
-    double res;
 
-    /* x is inside interpolated region */
-    if (*xValues >= interp -> xBounds[0][0] && *xValues <= interp -> xBounds[0][1])
-        res = gsl_spline_eval(interp -> spline, *xValues, interp -> acc);
+    /* Need strictly increasing (and positive for logarithmic grids) x-data */
 
-    /* Out of bounds */
-    else
+    for (size_t n = 1; n < size; n++)
       {
-        if (interp -> extrapolate == NULL)
+        if (xData[n] == xData[n - 1])
           {
-            printf("Cannot extrapolate if no extrapolation function has been provided.\n");
+            printf("Cannot interpolate degenerate x-data points (x = %e) on a uniform grid.\n", xData[n]);
             exit(1);
 
-            return NAN;
+            return NULL;
           }
+      }
 
-        size_t size = 1;
-        size_t indices[1] = {0};
+    if (logGrid && xData[0] <= 0.)
+      {
+        printf("Cannot interpolate non-positive x-data points (x = %e) on a logarithmic grid.\n", xData[0]);
+        exit(1);
 
-        res = interp -> extrapolate(values, interp, params, indices, size);
+        return NULL;
       }
 
-    return res;
-}
 
+    /* Resample the data on the uniform grid */
 
-double interpolate_interp_eval_deriv_gsl(void *values, interp_t *interp, void *params)
-{
-    /*
+    gsl_interp_accel *acc = gsl_interp_accel_alloc();
+    gsl_spline *spline = gsl_spline_alloc((size < 3) ? gsl_interp_linear : gsl_interp_steffen, size);
 
-        Evaluate the derivative of the interpolation function by gsl (1-d)
+    gsl_spline_init(spline, xData, yData, size);
 
-    */
+    _interp_uniform_t *uniform = malloc(sizeof(_interp_uniform_t));
 
-    /* Convert input variables */
-    double *xValues = (double*) values;
+    uniform -> size = (__INTERP_UNIFORM_FACTOR__ * size > __INTERP_UNIFORM_MIN_SIZE__) ? __INTERP_UNIFORM_FACTOR__ * size : __INTERP_UNIFORM_MIN_SIZE__;
+    uniform -> log = logGrid;
 
-    double res;
+    uniform -> t0 = (logGrid) ? log(xData[0]) : xData[0];
+    uniform -> dt = (((logGrid) ? log(xData[size - 1]) : xData[size - 1]) - uniform -> t0) / (double) (uniform -> size - 1);
+    uniform -> invDt = 1. / uniform -> dt;
 
-    /* x in interpolated region */
-    if (*xValues >= interp -> xBounds[0][0] && *xValues <= interp -> xBounds[0][1])
-        res = gsl_spline_eval_deriv(interp -> spline, *xValues, interp -> acc);
+    uniform -> ym = malloc(sizeof(double) * 2 * uniform -> size);
 
-    /* Out of bounds */
-    else
+    for (size_t i = 0; i < uniform -> size; i++)
       {
-        if (interp -> extrapolate == NULL)
-          {
-            goto extrapolateErr;
-          }
+        double t = uniform -> t0 + (double) i * uniform -> dt;
+        double x = (logGrid) ? exp(t) : t;
 
-        size_t size = 1;
-        size_t indices[1] = {0};
+        /* Avoid leaving the data range due to round-off */
+        if (i == 0 || x < xData[0])
+            x = xData[0];
 
-        res = interp -> extrapolate(values, interp, params, indices, size);
+        if (i == uniform -> size - 1 || x > xData[size - 1])
+            x = xData[size - 1];
+
+        /* dy/dt = dy/dx * dx/dt */
+        uniform -> ym[2 * i] = gsl_spline_eval(spline, x, acc);
+        uniform -> ym[2 * i + 1] = gsl_spline_eval_deriv(spline, x, acc) * ((logGrid) ? x : 1.) * uniform -> dt;
       }
 
-    return res;
+    interp -> spline = uniform;
 
-    /* Cannot extrapolate */
-    extrapolateErr:
-    printf("\nCannot extrapolate if no extrapolation function has been provided.\n\n");
-    exit(1);
 
-    return 0.;
+    /* Free allocated memory */
+
+    gsl_spline_free(spline);
+    gsl_interp_accel_free(acc);
+
+    free(xData);
+    free(yData);
+
+
+    return interp;
 }
 
 
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  -----------------------------------   Free Interpolation Functions   ---------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-interp_t *interpolate_interp_free(interp_t *(*interpFree)(interp_t*), interp_t *interp)
+interp_t *interpolate_interp_init_grid(dat_t *dat, double (*extrapolate)(void*, void*, void*, size_t*, size_t))
 {
     /*
 
-        Master function to free the allocated memory of the interp_t struct.
+        Setup the tensor product cubic interpolation for data "dat" on a regular grid, i.e. the data points must be the
+        outer product of the unique x-data points of each dimension (in any order). Dimensions with a single unique
+        x-data point are ignored. Returns NULL if the data is not on a regular grid (e.g. to fall back to
+        interpolate_interp_init_splinter).
+
+        The slopes of the cubic Hermite splines are the finite differences of the neighbouring nodes, so that the
+        setup only copies the data and an evaluation is a weighted sum over the 4^dim neighbouring grid points.
 
     */
 
-    interp = interpFree(interp);
 
-    return interp;
-}
+    /* Unique x-data points of each dimension */
 
+    double **nodes = malloc(sizeof(double*) * dat -> xDim);
+    size_t *sizes = malloc(sizeof(size_t) * dat -> xDim);
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  ------------------------------------------------------------------------------------------------------  */
+    for (size_t i = 0; i < dat -> xDim; i++)
+      {
+        nodes[i] = dat_get_array(dat, i, 'x');
 
+        qsort(nodes[i], dat -> size, sizeof(double), _interp_cmp_double);
 
-interp_t *interpolate_interp_free_splinter(interp_t *interp)
-{
-    /*
+        sizes[i] = (dat -> size > 0) ? 1 : 0;
 
-        Free the allocated memory of an interp_t struct for the splinter library (see interpolate_interp_init_splinter).
+        for (size_t n = 1; n < dat -> size; n++)
+          {
+            if (nodes[i][n] != nodes[i][sizes[i] - 1])
+                nodes[i][sizes[i]++] = nodes[i][n];
+          }
+      }
 
-    */
 
+    /* Setup the grid (only dimensions with at least two nodes) */
 
-    /* If interp is NULL simply return NULL as well */
-    if (interp == NULL)
-        return NULL;
+    _interp_grid_t *grid = malloc(sizeof(_interp_grid_t));
 
-    /* Free interp's contents */
-    if (interp -> spline != NULL) splinter_bspline_delete((splinter_obj_ptr) interp -> spline);
+    size_t *xIndUniq = malloc(sizeof(size_t) * dat -> xDim);
+    size_t gridSize = 1;
 
-    if (interp -> xBounds != NULL)
+    grid -> dim = 0;
+
+    for (size_t i = 0; i < dat -> xDim; i++)
       {
-        for (size_t i = 0; i < interp -> xDim; i++)
-          {
-            if (interp -> xBounds[i] != NULL)  free(interp -> xBounds[i]);
-          }
+        if (sizes[i] < 2)
+            continue;
 
-        free(interp -> xBounds);
+        xIndUniq[grid -> dim++] = i;
+        gridSize *= sizes[i];
       }
 
-    free(interp -> yBounds);
-    free(interp -> xIndUniq);
-
-    /* Free interp as well */
-    free(interp);
+    grid -> sizes = malloc(sizeof(size_t) * grid -> dim);
+    grid -> strides = malloc(sizeof(size_t) * grid -> dim);
+    grid -> nodes = malloc(sizeof(double*) * grid -> dim);
 
-    return NULL;
-}
+    for (size_t d = grid -> dim; d-- > 0;)
+      {
+        grid -> sizes[d] = sizes[xIndUniq[d]];
+        grid -> strides[d] = (d == grid -> dim - 1) ? 1 : grid -> strides[d + 1] * grid -> sizes[d + 1];
 
+        grid -> nodes[d] = realloc(nodes[xIndUniq[d]], sizeof(double) * grid -> sizes[d]);
+        nodes[xIndUniq[d]] = NULL;
+      }
 
-/*  ------------------------------------------------------------------------------------------------------  */
+    grid -> values = malloc(sizeof(double) * gridSize);
 
 
-interp_t *interpolate_interp_free_gsl(interp_t *interp)
-{
-    /*
+    /* Every grid point must appear exactly once (as the sizes match, it suffices that no two data points coincide) */
 
-        Free the allocated memory of an interp_t struct.
+    bool regular = (gridSize == dat -> size);
+    bool *filled = calloc(gridSize, sizeof(bool));
 
-    */
+    for (size_t n = 0; n < dat -> size && regular; n++)
+      {
+        size_t index = 0;
 
+        for (size_t d = 0; d < grid -> dim; d++)
+          {
+            double x = dat_get_value(dat, xIndUniq[d], n, 'x');
+            size_t i = _interp_grid_find(grid -> nodes[d], grid -> sizes[d], x);
 
-    /* If interp is NULL simply return NULL as well */
-    if (interp == NULL)
-        return NULL;
+            /* The last node is found as the lower node of the last cell */
+            if (grid -> nodes[d][i] != x)
+                i++;
 
-    /* Free interp's contents */
-    if (interp -> acc != NULL) gsl_interp_accel_free(interp -> acc);
-    if (interp -> spline != NULL) gsl_spline_free(interp -> spline);
+            index += grid -> strides[d] * i;
+          }
 
-    if (interp -> xBounds != NULL)
-      {
-        if (interp -> xBounds[0] != NULL) free(interp -> xBounds[0]);
+        regular = !filled[index];
+        filled[index] = true;
 
-        free(interp -> xBounds);
+        grid -> values[index] = dat_get_value(dat, 0, n, 'y');
       }
 
-    free(interp -> yBounds);
+    free(filled);
 
-    /* Free interp as well */
-    free(interp);
 
-    return NULL;
+    /* Free memory */
+
+    for (size_t i = 0; i < dat -> xDim; i++)
+        free(nodes[i]);
+
+    free(nodes);
+    free(sizes);
+
+    /* Not a regular grid */
+    if (!regular)
+      {
+        for (size_t d = 0; d < grid -> dim; d++)
+            free(grid -> nodes[d]);
+
+        free(grid -> nodes);
+        free(grid -> sizes);
+        free(grid -> strides);
+        free(grid -> values);
+        free(grid);
+
+        free(xIndUniq);
+
+        return NULL;
+      }
+
+
+    /* Store the result in the interp_t struct */
+
+    interp_t *interp = malloc(sizeof(interp_t));
+
+    interp -> acc = NULL;
+    interp -> spline = grid;
+    interp -> extrapolate = extrapolate;
+
+    /* Bounds of interpolation */
+    interp -> xBounds = malloc(sizeof(double*) * dat -> xDim);
+    interp -> yBounds = malloc(sizeof(double) * 2);
+
+    for (size_t i = 0; i < dat -> xDim; i++)
+      {
+        interp -> xBounds[i] = malloc(sizeof(double) * 2);
+
+        interp -> xBounds[i][0] = dat_get_value(dat, i, 0, 'x');
+        interp -> xBounds[i][1] = dat_get_value(dat, i, 0, 'x');
+
+        for (size_t n = 1; n < dat -> size; n++)
+          {
+            double xval = dat_get_value(dat, i, n, 'x');
+
+            if (xval < interp -> xBounds[i][0])
+                interp -> xBounds[i][0] = xval;
+
+            if (xval > interp -> xBounds[i][1])
+                interp -> xBounds[i][1] = xval;
+          }
+      }
+
+    interp -> yBounds[0] = dat_get_value(dat, 0, 0, 'y');
+    interp -> yBounds[1] = dat_get_value(dat, 0, dat -> size - 1, 'y');
+
+    /* xDim + xDimUniq + xIndUniq */
+    interp -> xDim = dat -> xDim;
+    interp -> xDimUniq = grid -> dim;
+    interp -> xIndUniq = realloc(xIndUniq, sizeof(size_t) * grid -> dim);
+
+
+    return interp;
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ---------------------------------   Evaluate Interpolation Functions   -------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+double interpolate_interp_eval(double (*interpEval)(void*, interp_t*, void*), void *values, interp_t *interp, void *params)
+{
+    /*
+
+        Master interpolation function calls the interpolation function "interpFunc"
+        for the input values "values" with additional parameters "params" for the extrapolation function.
+
+    */
+
+    return interpEval(values, interp, params);
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+double interpolate_interp_eval_splinter(void *values, interp_t *interp, void *params)
+{
+    /*
+
+        Evaluate the spline interpolation by splinter (see interpolate_interp_init_splinter).
+
+    */
+
+    double *xValues = (double*) values;
+
+    /* If spline is NULL the interpolation function was fed a constant */
+    if (interp -> spline == NULL)
+      {
+        return interp -> yBounds[0];
+      }
+
+    /* Only keep the unique x-dimensions (on the stack, as the evaluation runs in the integrands) */
+    double xValuesUniq[interp -> xDimUniq];
+
+    size_t indicesExtrapSize = 0;
+    size_t indicesExtrap[interp -> xDimUniq];
+    bool inBounds = true;
+
+    for (size_t i = 0; i < interp -> xDimUniq; i++)
+      {
+        xValuesUniq[i] = xValues[interp -> xIndUniq[i]];
+
+        /* Check the lower bounds */
+        if (xValuesUniq[i] < interp -> xBounds[interp -> xIndUniq[i]][0])
+          {
+            if (fabs(xValuesUniq[i] - interp -> xBounds[interp -> xIndUniq[i]][0]) < __ABSTOL__)
+              {
+                xValuesUniq[i] = interp -> xBounds[interp -> xIndUniq[i]][0];
+
+                continue;
+              }
+
+            indicesExtrap[indicesExtrapSize++] = interp -> xIndUniq[i];
+
+            inBounds = false;
+
+            continue;
+          }
+
+        /* Check the upper bounds */
+        if (xValuesUniq[i] > interp -> xBounds[interp -> xIndUniq[i]][1])
+          {
+            if (fabs(xValuesUniq[i] - interp -> xBounds[interp -> xIndUniq[i]][1]) < __ABSTOL__)
+              {
+                xValuesUniq[i] = interp -> xBounds[interp -> xIndUniq[i]][1];
+
+                continue;
+              }
+
+            indicesExtrap[indicesExtrapSize++] = interp -> xIndUniq[i];
+
+            inBounds = false;
+          }
+      }
+
+    /* Result of the interpolation */
+    double *res, resReturn;
+
+    /* In bounds, no need for extrapolation */
+    if (inBounds)
+      {
+        res = splinter_bspline_eval_row_major((splinter_obj_ptr) interp -> spline, xValuesUniq, (int) interp -> xDimUniq);
+        resReturn = *res;
+        free(res);
+      }
+
+    /* Out of bounds, need to extrapolate */
+    else
+      {
+        if (interp -> extrapolate == NULL)
+          {
+            /* Cannot extrapolate */
+            printf("Cannot extrapolate if no extrapolation function has been provided.\n");
+            exit(1);
+
+            return NAN;
+          }
+
+        resReturn = interp -> extrapolate(values, interp, params, indicesExtrap, indicesExtrapSize);
+      }
+
+    return resReturn;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+double interpolate_interp_eval_gsl(void *values, interp_t *interp, void *params)
+{
+    /*
+
+        Evaluate the interpolation function by gsl (1-d).
+
+    */
+
+    /* Convert input variables */
+    double *xValues = (double*) values;
+
+    double res;
+
+    /* x is inside interpolated region */
+    if (*xValues >= interp -> xBounds[0][0] && *xValues <= interp -> xBounds[0][1])
+        res = gsl_spline_eval(interp -> spline, *xValues, interp -> acc);
+
+    /* Out of bounds */
+    else
+      {
+        if (interp -> extrapolate == NULL)
+          {
+            printf("Cannot extrapolate if no extrapolation function has been provided.\n");
+            exit(1);
+
+            return NAN;
+          }
+
+        size_t size = 1;
+        size_t indices[1] = {0};
+
+        res = interp -> extrapolate(values, interp, params, indices, size);
+      }
+
+    return res;
+}
+
+
+double interpolate_interp_eval_deriv_gsl(void *values, interp_t *interp, void *params)
+{
+    /*
+
+        Evaluate the derivative of the interpolation function by gsl (1-d)
+
+    */
+
+    /* Convert input variables */
+    double *xValues = (double*) values;
+
+    double res;
+
+    /* x in interpolated region */
+    if (*xValues >= interp -> xBounds[0][0] && *xValues <= interp -> xBounds[0][1])
+        res = gsl_spline_eval_deriv(interp -> spline, *xValues, interp -> acc);
+
+    /* Out of bounds */
+    else
+      {
+        if (interp -> extrapolate == NULL)
+          {
+            goto extrapolateErr;
+          }
+
+        size_t size = 1;
+        size_t indices[1] = {0};
+
+        res = interp -> extrapolate(values, interp, params, indices, size);
+      }
+
+    return res;
+
+    /* Cannot extrapolate */
+    extrapolateErr:
+    printf("\nCannot extrapolate if no extrapolation function has been provided.\n\n");
+    exit(1);
+
+    return 0.;
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+double interpolate_interp_eval_uniform(void *values, interp_t *interp, void *params)
+{
+    /*
+
+        Evaluate the uniform grid interpolation function (see interpolate_interp_init_uniform).
+
+    */
+
+    return _interp_eval_uniform(values, interp, params, false);
+}
+
+
+double interpolate_interp_eval_deriv_uniform(void *values, interp_t *interp, void *params)
+{
+    /*
+
+        Evaluate the derivative (wrt x) of the uniform grid interpolation function (see interpolate_interp_init_uniform).
+
+    */
+
+    return _interp_eval_uniform(values, interp, params, true);
+}
+
+
+int interpolate_interp_eval_uniform_n(double *values, size_t n, interp_t *interp, void *params, double *result)
+{
+    /*
+
+        Evaluate the uniform grid interpolation function for n values at once (see interpolate_interp_eval_uniform).
+
+    */
+
+    return _interp_eval_uniform_n(values, n, interp, params, false, result);
+}
+
+
+int interpolate_interp_eval_deriv_uniform_n(double *values, size_t n, interp_t *interp, void *params, double *result)
+{
+    /*
+
+        Evaluate the derivative of the uniform grid interpolation function for n values at once.
+
+    */
+
+    return _interp_eval_uniform_n(values, n, interp, params, true, result);
+}
+
+
+static double _interp_eval_uniform(void *values, interp_t *interp, void *params, bool deriv)
+{
+    /*
+
+        Evaluate the cubic Hermite spline (or its derivative wrt x if deriv is true) on the uniform grid of interp
+
+    */
+
+    /* Convert input variables */
+    double x = *((double*) values);
+
+    /* If spline is NULL the interpolation function was fed a constant */
+    if (interp -> spline == NULL)
+      {
+        return (deriv) ? 0. : interp -> yBounds[0];
+      }
+
+    /* Out of bounds (up to __ABSTOL__) */
+    if (x < interp -> xBounds[0][0] - __ABSTOL__ || x > interp -> xBounds[0][1] + __ABSTOL__)
+      {
+        if (interp -> extrapolate == NULL)
+          {
+            printf("Cannot extrapolate if no extrapolation function has been provided.\n");
+            exit(1);
+
+            return NAN;
+          }
+
+        size_t size = 1;
+        size_t indices[1] = {0};
+
+        return interp -> extrapolate(values, interp, params, indices, size);
+      }
+
+    return _interp_uniform_hermite((_interp_uniform_t*) interp -> spline, x, deriv);
+}
+
+
+static int _interp_eval_uniform_n(double *values, size_t n, interp_t *interp, void *params, bool deriv, double *result)
+{
+    /*
+
+        Evaluate the cubic Hermite spline (or its derivative wrt x if deriv is true) on the uniform grid of interp for the
+        n values "values": the spline is evaluated for all values (clamped to the grid) in a branch-free loop, and only
+        the values out of bounds are then replaced by the extrapolation function.
+
+    */
+
+    /* If spline is NULL the interpolation function was fed a constant */
+    if (interp -> spline == NULL)
+      {
+        for (size_t i = 0; i < n; i++)
+            result[i] = (deriv) ? 0. : interp -> yBounds[0];
+
+        return 0;
+      }
+
+    const _interp_uniform_t *uniform = (_interp_uniform_t*) interp -> spline;
+
+    for (size_t i = 0; i < n; i++)
+        result[i] = _interp_uniform_hermite(uniform, values[i], deriv);
+
+    /* Out of bounds (up to __ABSTOL__) */
+    double xMin = interp -> xBounds[0][0] - __ABSTOL__;
+    double xMax = interp -> xBounds[0][1] + __ABSTOL__;
+
+    for (size_t i = 0; i < n; i++)
+      {
+        if (values[i] >= xMin && values[i] <= xMax)
+            continue;
+
+        if (interp -> extrapolate == NULL)
+          {
+            printf("Cannot extrapolate if no extrapolation function has been provided.\n");
+            exit(1);
+
+            return 1;
+          }
+
+        size_t size = 1;
+        size_t indices[1] = {0};
+
+        result[i] = interp -> extrapolate(&values[i], interp, params, indices, size);
+      }
+
+    return 0;
+}
+
+
+static inline double _interp_uniform_hermite(const _interp_uniform_t *uniform, double x, bool deriv)
+{
+    /*
+
+        Cubic Hermite spline (or its derivative wrt x if deriv is true) at x, which is clamped to the grid
+
+    */
+
+    /* Index of the node left of x and position s in [0, 1] within the cell */
+    double s = (((uniform -> log) ? log(x) : x) - uniform -> t0) * uniform -> invDt;
+
+    s = fmin(fmax(s, 0.), (double) (uniform -> size - 1));
+
+    size_t i = (size_t) s;
+    i -= (i == uniform -> size - 1);
+
+    s -= (double) i;
+
+    const double *ym = uniform -> ym + 2 * i;
+
+    /* Hermite basis functions */
+    double s2 = s * s;
+
+    if (!deriv)
+        return (1. + 2. * s) * (1. - s) * (1. - s) * ym[0] + s * (1. - s) * (1. - s) * ym[1] + s2 * (3. - 2. * s) * ym[2] + s2 * (s - 1.) * ym[3];
+
+    /* dy/dx = dy/dt * dt/dx */
+    double dydt = ((6. * s2 - 6. * s) * (ym[0] - ym[2]) + (3. * s2 - 4. * s + 1.) * ym[1] + (3. * s2 - 2. * s) * ym[3]) * uniform -> invDt;
+
+    return (uniform -> log) ? dydt / x : dydt;
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+double interpolate_interp_eval_grid(void *values, interp_t *interp, void *params)
+{
+    /*
+
+        Evaluate the regular grid interpolation function (see interpolate_interp_init_grid).
+
+    */
+
+    double *xValues = (double*) values;
+
+    _interp_grid_t *grid = (_interp_grid_t*) interp -> spline;
+
+    /* No dimension with more than one node */
+    if (grid -> dim == 0)
+      {
+        return grid -> values[0];
+      }
+
+    /* Weights of the (at most 4) neighbouring nodes of each dimension (on the stack, as the evaluation runs in the integrands) */
+    size_t lower[grid -> dim];
+    size_t weightsSize[grid -> dim];
+    double weights[grid -> dim][4];
+
+    size_t indicesExtrapSize = 0;
+    size_t indicesExtrap[grid -> dim];
+
+    for (size_t d = 0; d < grid -> dim; d++)
+      {
+        size_t i = interp -> xIndUniq[d];
+        double x = xValues[i];
+
+        /* Out of bounds (up to __ABSTOL__) */
+        if (x < interp -> xBounds[i][0] - __ABSTOL__ || x > interp -> xBounds[i][1] + __ABSTOL__)
+          {
+            indicesExtrap[indicesExtrapSize++] = i;
+
+            continue;
+          }
+
+        weightsSize[d] = _interp_grid_weights(grid -> nodes[d], grid -> sizes[d], x, &lower[d], weights[d]);
+      }
+
+    /* Out of bounds, need to extrapolate */
+    if (indicesExtrapSize > 0)
+      {
+        if (interp -> extrapolate == NULL)
+          {
+            printf("Cannot extrapolate if no extrapolation function has been provided.\n");
+            exit(1);
+
+            return NAN;
+          }
+
+        return interp -> extrapolate(values, interp, params, indicesExtrap, indicesExtrapSize);
+      }
+
+    /* Sum over the neighbouring grid points (the last dimension runs fastest) */
+    size_t counter[grid -> dim];
+    size_t index = 0;
+
+    for (size_t d = 0; d < grid -> dim; d++)
+      {
+        counter[d] = 0;
+        index += grid -> strides[d] * lower[d];
+      }
+
+    double result = 0.;
+
+    while (true)
+      {
+        double weight = 1.;
+
+        for (size_t d = 0; d < grid -> dim; d++)
+            weight *= weights[d][counter[d]];
+
+        result += weight * grid -> values[index];
+
+        /* Next grid point */
+        size_t d = grid -> dim;
+
+        while (d-- > 0)
+          {
+            if (++counter[d] < weightsSize[d])
+              {
+                index += grid -> strides[d];
+                break;
+              }
+
+            index -= grid -> strides[d] * (weightsSize[d] - 1);
+            counter[d] = 0;
+          }
+
+        if (d == (size_t) -1)
+            break;
+      }
+
+    return result;
+}
+
+
+static size_t _interp_grid_find(const double *nodes, size_t size, double x)
+{
+    /*
+
+        Index i of the sorted nodes with nodes[i] <= x < nodes[i + 1] (clamped to [0, size - 2], or 0 if size < 2)
+
+    */
+
+    if (size < 2 || x <= nodes[0])
+        return 0;
+
+    size_t lo = 0;
+    size_t hi = size - 1;
+
+    while (hi - lo > 1)
+      {
+        size_t mid = (lo + hi) / 2;
+
+        if (nodes[mid] <= x)
+            lo = mid;
+
+        else
+            hi = mid;
+      }
+
+    return lo;
+}
+
+
+static size_t _interp_grid_weights(const double *nodes, size_t size, double x, size_t *lower, double *weights)
+{
+    /*
+
+        Weights of the nodes lower, lower + 1, ... (at most four, the number is returned) of the cubic Hermite spline at x,
+        whose slopes are the (one-sided at the boundaries) finite differences of the neighbouring nodes
+
+    */
+
+    size_t i = _interp_grid_find(nodes, size, x);
+
+    double h = nodes[i + 1] - nodes[i];
+    double s = fmin(fmax((x - nodes[i]) / h, 0.), 1.);
+
+    /* Linear for two nodes */
+    if (size == 2)
+      {
+        *lower = i;
+
+        weights[0] = 1. - s;
+        weights[1] = s;
+
+        return 2;
+      }
+
+    /* Hermite basis functions */
+    double h00 = (1. + 2. * s) * (1. - s) * (1. - s);
+    double h10 = s * (1. - s) * (1. - s);
+    double h01 = s * s * (3. - 2. * s);
+    double h11 = s * s * (s - 1.);
+
+    /* Weights of the nodes i - 1, i, i + 1, i + 2 */
+    double w[4] = {0., h00, h01, 0.};
+
+    /* Slope at i */
+    if (i == 0)
+      {
+        w[1] -= h10;
+        w[2] += h10;
+      }
+
+    else
+      {
+        w[0] -= h * h10 / (nodes[i + 1] - nodes[i - 1]);
+        w[2] += h * h10 / (nodes[i + 1] - nodes[i - 1]);
+      }
+
+    /* Slope at i + 1 */
+    if (i + 2 == size)
+      {
+        w[1] -= h11;
+        w[2] += h11;
+      }
+
+    else
+      {
+        w[1] -= h * h11 / (nodes[i + 2] - nodes[i]);
+        w[3] += h * h11 / (nodes[i + 2] - nodes[i]);
+      }
+
+    /* Only keep the nodes inside the grid */
+    size_t first = (i == 0) ? 1 : 0;
+    size_t last = (i + 2 == size) ? 2 : 3;
+
+    *lower = i + first - 1;
+
+    for (size_t j = first; j <= last; j++)
+        weights[j - first] = w[j];
+
+    return last - first + 1;
+}
+
+
+static int _interp_cmp_double(const void *a, const void *b)
+{
+    /*
+
+        Compare two doubles (for qsort)
+
+    */
+
+    double x = *((const double*) a);
+    double y = *((const double*) b);
+
+    return (x > y) - (x < y);
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  -----------------------------------   Free Interpolation Functions   ---------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+interp_t *interpolate_interp_free(interp_t *(*interpFree)(interp_t*), interp_t *interp)
+{
+    /*
+
+        Master function to free the allocated memory of the interp_t struct.
+
+    */
+
+    interp = interpFree(interp);
+
+    return interp;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+interp_t *interpolate_interp_free_splinter(interp_t *interp)
+{
+    /*
+
+        Free the allocated memory of an interp_t struct for the splinter library (see interpolate_interp_init_splinter).
+
+    */
+
+
+    /* If interp is NULL simply return NULL as well */
+    if (interp == NULL)
+        return NULL;
+
+    /* Free interp's contents */
+    if (interp -> spline != NULL) splinter_bspline_delete((splinter_obj_ptr) interp -> spline);
+
+    if (interp -> xBounds != NULL)
+      {
+        for (size_t i = 0; i < interp -> xDim; i++)
+          {
+            if (interp -> xBounds[i] != NULL)  free(interp -> xBounds[i]);
+          }
+
+        free(interp -> xBounds);
+      }
+
+    free(interp -> yBounds);
+    free(interp -> xIndUniq);
+
+    /* Free interp as well */
+    free(interp);
+
+    return NULL;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+interp_t *interpolate_interp_free_gsl(interp_t *interp)
+{
+    /*
+
+        Free the allocated memory of an interp_t struct.
+
+    */
+
+
+    /* If interp is NULL simply return NULL as well */
+    if (interp == NULL)
+        return NULL;
+
+    /* Free interp's contents */
+    if (interp -> acc != NULL) gsl_interp_accel_free(interp -> acc);
+    if (interp -> spline != NULL) gsl_spline_free(interp -> spline);
+
+    if (interp -> xBounds != NULL)
+      {
+        if (interp -> xBounds[0] != NULL) free(interp -> xBounds[0]);
+
+        free(interp -> xBounds);
+      }
+
+    free(interp -> yBounds);
+
+    /* Free interp as well */
+    free(interp);
+
+    return NULL;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+interp_t *interpolate_interp_free_uniform(interp_t *interp)
+{
+    /*
+
+        Free the allocated memory of an interp_t struct for the uniform grids (see interpolate_interp_init_uniform).
+
+    */
+
+
+    /* If interp is NULL simply return NULL as well */
+    if (interp == NULL)
+        return NULL;
+
+    /* Free interp's contents */
+    if (interp -> spline != NULL)
+      {
+        free(((_interp_uniform_t*) interp -> spline) -> ym);
+        free(interp -> spline);
+      }
+
+    if (interp -> xBounds != NULL)
+      {
+        if (interp -> xBounds[0] != NULL) free(interp -> xBounds[0]);
+
+        free(interp -> xBounds);
+      }
+
+    free(interp -> yBounds);
+
+    /* Free interp as well */
+    free(interp);
+
+    return NULL;
 }
 
 
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+interp_t *interpolate_interp_free_grid(interp_t *interp)
+{
+    /*
+
+        Free the allocated memory of an interp_t struct for regular grids (see interpolate_interp_init_grid).
+
+    */
+
+
+    /* If interp is NULL simply return NULL as well */
+    if (interp == NULL)
+        return NULL;
+
+    /* Free interp's contents */
+    _interp_grid_t *grid = (_interp_grid_t*) interp -> spline;
+
+    if (grid != NULL)
+      {
+        for (size_t d = 0; d < grid -> dim; d++)
+            free(grid -> nodes[d]);
+
+        free(grid -> nodes);
+        free(grid -> sizes);
+        free(grid -> strides);
+        free(grid -> values);
+        free(grid);
+      }
+
+    if (interp -> xBounds != NULL)
+      {
+        for (size_t i = 0; i < interp -> xDim; i++)
+          {
+            if (interp -> xBounds[i] != NULL)  free(interp -> xBounds[i]);
+          }
+
+        free(interp -> xBounds);
+      }
+
+    free(interp -> yBounds);
+    free(interp -> xIndUniq);
+
+    /* Free interp as well */
+    free(interp);
+
+    return NULL;
+}
 
 
 
@@ -51,6 +51,9 @@ static kern_t *_kernels_work_new(size_t kernOrder)
     kern -> mu = calloc((size_t) ((1 << kernOrder) - 1), sizeof(double));
     kern -> nu = calloc(((size_t) pow(3., (double) kernOrder) - (size_t) ((1 << (kernOrder + 1)) - 1)) / 2, sizeof(double));
 
+    /* Nothing computed yet */
+    kern -> workDirty = ~0ul;
+
     return kern;
 }
 
@@ -99,6 +102,8 @@ static int _kernels_work_var_nu_cp(kern_t *kernWorkIn, kern_t *kernWorkOut, size
 static size_t _kernels_work_index_k(size_t kernOrder, size_t *indices, size_t size);
 static size_t _kernels_work_index_nu(size_t kernOrder, size_t **indices, size_t *size);
 
+static unsigned long _kernels_work_mask(size_t *indices, size_t size);
+
 /*  ######################################################################################################  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
@@ -111,12 +116,22 @@ static int _kernels_work_var(kern_t *kernVar, size_t kernOrder)
 
         Assumes that kernOrder <= kernVar -> kernOrder!
 
+        Only the variables of the highest order kern_t struct that involve a vertex changed by kernels_(q)set_... since
+        its last update are recomputed (see workDirty). The lower order kern_t structs are overwritten by the kernels_...
+        functions, so they are always copied and their variables are considered to be outdated afterwards.
+
     */
 
 
     /* Working kern_t structs */
     kern_t **kernWork = (kern_t**) kernVar -> kernWork;
 
+    /* Pass the changed vertices on to the working kern_t structs */
+    for (size_t n = 0; n < kernVar -> kernOrder; n++)
+        kernWork[n] -> workDirty |= kernVar -> workDirty;
+
+    kernVar -> workDirty = 0;
+
     /* Recursion depth */
     size_t depth = 0;
 
@@ -143,9 +158,16 @@ static int _kernels_work_var(kern_t *kernVar, size_t kernOrder)
         offset[0][0] = 0;
         offset[1][0] = 0;
 
-        /* Calculate all variables for the highest order kern_t struct */
+        /* Calculate all outdated variables for the highest order kern_t struct */
         if ((size_t) n == kernOrder - 1)
           {
+            /* Only the first kernOrder vertices enter */
+            kernWork[n] -> workDirty &= (1ul << kernOrder) - 1;
+
+            /* Nothing has changed */
+            if (kernWork[n] -> workDirty == 0)
+                continue;
+
             /* ki, mui, nuij */
             for (size_t i = 0; i < kernWork[n] -> kernOrder; i++)
               {
@@ -175,6 +197,9 @@ static int _kernels_work_var(kern_t *kernVar, size_t kernOrder)
                 /* Calculate all possible k, mu, and nu */
                 _kernels_work_var_k(kernWork[n], indices, size, offset, &depth);
               }
+
+            /* Up to date */
+            kernWork[n] -> workDirty = 0;
           }
 
         /* Copy all variables from the highest order kern_t struct */
@@ -189,6 +214,9 @@ static int _kernels_work_var(kern_t *kernVar, size_t kernOrder)
                 /* Copy all possible k, mu, and nu */
                 _kernels_work_var_k_cp(kernWork[kernOrder - 1], kernWork[n], indices, size, offset, &depth);
               }
+
+            /* The kernels_... functions may overwrite the variables */
+            kernWork[n] -> workDirty = ~0ul;
           }
       }
 
@@ -333,9 +361,12 @@ static int _kernels_work_var_k(kern_t *kernWork, size_t **indices, size_t *size,
         double k2 = kernWork -> k[offset[0][2]];
         double nu12 = kernWork -> nu[indexNu];
 
-        /* Calculate k and mu ; If k = 0, mu is undefined -> mu = 0 to avoid issues involving multiplications of mu with finite quantities */
-        kernWork -> k[offset[0][0]] = (fabs(k1 - k2) > __ABSTOL__ || fabs(nu12 + 1) > __ABSTOL__) ? sqrt( fabs(k1*k1 + k2*k2 + 2. * k1 * k2 * nu12) ) : __ABSTOL__;
-        kernWork -> mu[offset[0][0]] = (kernWork -> k[offset[0][0]] > __ABSTOL__) ? (k1 * kernWork -> mu[offset[0][1]] + k2 * kernWork -> mu[offset[0][2]]) / kernWork -> k[offset[0][0]] : 0.;
+        /* Calculate k and mu (only if one of ki1_, ..., kim1_ has changed) ; If k = 0, mu is undefined -> mu = 0 to avoid issues involving multiplications of mu with finite quantities */
+        if (_kernels_work_mask(*indices, *size) & kernWork -> workDirty)
+          {
+            kernWork -> k[offset[0][0]] = (fabs(k1 - k2) > __ABSTOL__ || fabs(nu12 + 1) > __ABSTOL__) ? sqrt( fabs(k1*k1 + k2*k2 + 2. * k1 * k2 * nu12) ) : __ABSTOL__;
+            kernWork -> mu[offset[0][0]] = (kernWork -> k[offset[0][0]] > __ABSTOL__) ? (k1 * kernWork -> mu[offset[0][1]] + k2 * kernWork -> mu[offset[0][2]]) / kernWork -> k[offset[0][0]] : 0.;
+          }
 
 
         /**
@@ -423,6 +454,14 @@ static int _kernels_work_var_nu(kern_t *kernWork, size_t **indices, size_t *size
 
         **/
 
+        /* Nothing to do if none of ki1_, ..., kim1_, kj1_, ..., kjm2_ has changed */
+        if (!((_kernels_work_mask(indices[0], size[0]) | _kernels_work_mask(indices[1], size[1])) & kernWork -> workDirty))
+          {
+            offset[1][0] += 1;
+
+            return 0;
+          }
+
         /* If k = |ki1_ + ... + kim1_| = 0, we get issues for nu (see below) -> nu = 0 to avoid issues involving multiplications of nu with finite quantities */
         if (kernWork -> k[offset[0][0]] <= __ABSTOL__)
           {
@@ -880,6 +919,23 @@ static size_t _kernels_work_index_nu(size_t kernOrder, size_t **indices, size_t
 }
 
 
+static unsigned long _kernels_work_mask(size_t *indices, size_t size)
+{
+    /*
+
+        Get the vertices {i1, ..., im} of k_ = ki1_ + ... + kim_ as a bit mask (bit i for the i'th vertex, see workDirty)
+
+    */
+
+    unsigned long mask = 0;
+
+    for (size_t n = 0; n < size; n++)
+        mask |= 1ul << indices[n];
+
+    return mask;
+}
+
+
 #if false
 
 static size_t _kernels_work_index_nu_(size_t kernOrder, size_t **indices, size_t *size)
@@ -1050,6 +1106,9 @@ kern_t *kernels_new(size_t specOrder, size_t loopOrder)
     kern -> ctr = NULL;
     kern -> surv = NULL;
 
+    /* Batch kernel variant */
+    kern -> variant = __KERN_VARIANT_FULL__;
+
     /* Working kern_t structs */
     kern_t **kernWork = malloc(sizeof(kern_t*) * kern -> kernOrder);
 
@@ -1060,6 +1119,7 @@ kern_t *kernels_new(size_t specOrder, size_t loopOrder)
 
     /* Need to compute variables for working kern_t structs */
     kern -> computeWork = true;
+    kern -> workDirty = 0;
 
     return kern;
 }
@@ -1108,6 +1168,9 @@ kern_t *kernels_new_order(size_t specOrder, size_t kernOrder)
     kern -> ctr = NULL;
     kern -> surv = NULL;
 
+    /* Batch kernel variant */
+    kern -> variant = __KERN_VARIANT_FULL__;
+
     /* Working kern_t structs */
     kern_t **kernWork = malloc(sizeof(kern_t*) * kern -> kernOrder);
 
@@ -1118,6 +1181,7 @@ kern_t *kernels_new_order(size_t specOrder, size_t kernOrder)
 
     /* Need to compute variables for working kern_t structs */
     kern -> computeWork = true;
+    kern -> workDirty = 0;
 
     return kern;
 }
@@ -1140,13 +1204,8 @@ kern_t *kernels_free(kern_t *kern)
     free(kern -> nu);
     free(kern -> mu);
 
-    /* Fiducials */
-    kern -> lcdm = fid_lcdm_free(kern -> lcdm);
-    kern -> btst = fid_btst_free(kern -> btst);
+    /* Fiducials (only the bias is owned by kern, see kernels_set_z) */
     kern -> bias = fid_bias_free(kern -> bias);
-    kern -> rsd = fid_rsd_free(kern -> rsd);
-    kern -> ctr = fid_ctr_free(kern -> ctr);
-    kern -> surv = fid_surv_free(kern -> surv);
 
     /* Working kern_t structs */
     kern_t **kernWork = (kern_t**) kern -> kernWork;
@@ -1176,39 +1235,48 @@ int kernels_set_z(kern_t *kern, double z)
 
         Set the redshift z of kern
 
+        The fiducials are taken from the snapshot at z (see fid_snap_get), which is shared with all other kern_t
+        structs. Only the bias is copied, since the loop integrands renormalise b2 in place.
+
+        The variant of the batch kernels is chosen here from the fiducial values of the snapshot, i.e. without bias
+        (b1 = 1, b2 = bG2 = bGam3 = 0) and / or in real space (f = 0) the specialised variants drop the vanishing terms
+        (see __KERN_VARIANTS__).
+
     */
 
     /* Set the redshift */
     kern -> z = z;
 
     /* Set the fiducials */
+    const fid_snap_t *snap = fid_snap_get(z);
 
     /* Growth */
-    kern -> growth = _fidGrowth_(&z, _fidParamsGrowth_);
+    kern -> growth = snap -> growth;
 
     /* LCDM */
-    kern -> lcdm = fid_lcdm_free(kern -> lcdm);
-    kern -> lcdm = _fidLCDM_(&z, _fidParamsLCDM_);
+    kern -> lcdm = snap -> lcdm;
 
     /* BTST */
-    kern -> btst = fid_btst_free(kern -> btst);
-    kern -> btst = _fidBTST_(&z, _fidParamsBTST_);
+    kern -> btst = snap -> btst;
 
     /* Bias */
-    kern -> bias = fid_bias_free(kern -> bias);
-    kern -> bias = _fidBias_(&z, _fidParamsBias_);
+    if (kern -> bias == NULL)
+        kern -> bias = fid_bias_new();
+
+    *kern -> bias = *snap -> bias;
 
     /* RSD */
-    kern -> rsd = fid_rsd_free(kern -> rsd);
-    kern -> rsd = _fidRSD_(&z, _fidParamsRSD_);
+    kern -> rsd = snap -> rsd;
 
     /* Ctr */
-    kern -> ctr = fid_ctr_free(kern -> ctr);
-    kern -> ctr = _fidCtr_(&z, _fidParamsCtr_);
+    kern -> ctr = snap -> ctr;
 
     /* Surv */
-    kern -> surv = fid_surv_free(kern -> surv);
-    kern -> surv = _fidSurv_(&z, _fidParamsSurv_);
+    kern -> surv = snap -> surv;
+
+    /* Batch kernel variant */
+    kern -> variant = (!snap -> noBias) ? ((!snap -> noRSD) ? __KERN_VARIANT_FULL__ : __KERN_VARIANT_REAL__)
+                                        : ((!snap -> noRSD) ? __KERN_VARIANT_NOBIAS__ : __KERN_VARIANT_MATTER__);
 
     return 0;
 }
@@ -1233,8 +1301,12 @@ int kernels_set_k(kern_t *kern, size_t index, double k)
         return 1;
       }
 
-    /* Set the mode */
-    kern -> k[index] = k;
+    /* Set the mode (and mark the vertex as changed) */
+    if (kern -> k[index] != k)
+      {
+        kern -> k[index] = k;
+        kern -> workDirty |= 1ul << index;
+      }
 
     return 0;
 }
@@ -1248,8 +1320,12 @@ int kernels_qset_k(kern_t *kern, size_t index, double k)
 
     */
 
-    /* Set the mode */
-    kern -> k[index] = k;
+    /* Set the mode (and mark the vertex as changed) */
+    if (kern -> k[index] != k)
+      {
+        kern -> k[index] = k;
+        kern -> workDirty |= 1ul << index;
+      }
 
     return 0;
 }
@@ -1274,8 +1350,12 @@ int kernels_set_mu(kern_t *kern, size_t index, double mu)
         return 1;
       }
 
-    /* Set the angle */
-    kern -> mu[index] = mu;
+    /* Set the angle (and mark the vertex as changed) */
+    if (kern -> mu[index] != mu)
+      {
+        kern -> mu[index] = mu;
+        kern -> workDirty |= 1ul << index;
+      }
 
     return 0;
 }
@@ -1289,8 +1369,12 @@ int kernels_qset_mu(kern_t *kern, size_t index, double mu)
 
     */
 
-    /* Set the angle */
-    kern -> mu[index] = mu;
+    /* Set the angle (and mark the vertex as changed) */
+    if (kern -> mu[index] != mu)
+      {
+        kern -> mu[index] = mu;
+        kern -> workDirty |= 1ul << index;
+      }
 
     return 0;
 }
@@ -1323,8 +1407,14 @@ int kernels_set_nu(kern_t *kern, size_t index1, size_t index2, double nu)
         return 1;
       }
 
-    /* Set nu */
-    kern -> nu[kernels_get_nu_index(kern -> maxOrder, index1, index2)] = nu;
+    /* Set nu (and mark both vertices as changed) */
+    size_t index = kernels_get_nu_index(kern -> maxOrder, index1, index2);
+
+    if (kern -> nu[index] != nu)
+      {
+        kern -> nu[index] = nu;
+        kern -> workDirty |= (1ul << index1) | (1ul << index2);
+      }
 
     return 0;
 }
@@ -1338,8 +1428,14 @@ int kernels_qset_nu(kern_t *kern, size_t index1, size_t index2, double nu)
 
     */
 
-    /* Set nu */
-    kern -> nu[kernels_get_nu_index(kern -> maxOrder, index1, index2)] = nu;
+    /* Set nu (and mark both vertices as changed) */
+    size_t index = kernels_get_nu_index(kern -> maxOrder, index1, index2);
+
+    if (kern -> nu[index] != nu)
+      {
+        kern -> nu[index] = nu;
+        kern -> workDirty |= (1ul << index1) | (1ul << index2);
+      }
 
     return 0;
 }
@@ -3212,6 +3308,51 @@ double kernels_z1(kern_t *kernVar)
 }
 
 
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static inline __attribute__((always_inline)) int _kernels_z1_batch(kern_t *kernVar, size_t nVec, double *mu1, double *z1Kernels,
+                                                                   const bool inclBias, const bool inclRSD)
+{
+    /*
+
+        Kernel Z1 over nVec configurations (see kernels_z1_batch) for the compile-time flags inclBias and inclRSD
+
+    */
+
+    /* Fiducials */
+    double b1 = (inclBias) ? kernVar -> bias -> b1 : 1.;
+    double f = (inclRSD) ? kernVar -> rsd -> f : 0.;
+
+    for (size_t i = 0; i < nVec; i++)
+        z1Kernels[i] = (inclRSD) ? b1 + f * mu1[i]*mu1[i] : b1;
+
+    return 0;
+}
+
+
+int kernels_z1_batch(kern_t *kernVar, size_t nVec, double *mu1, double *z1Kernels)
+{
+    /*
+
+        This function calculates the kernel Z1 (see kernels_z1) for nVec configurations mu1[i] at once and stores them in
+        z1Kernels[i] (only the fiducials of kernVar are used).
+
+        The variant of kernVar (see kernels_set_z) selects a specialised copy of the loop.
+
+    */
+
+    switch (kernVar -> variant)
+      {
+#define X(variant, inclBias, inclRSD) case variant: return _kernels_z1_batch(kernVar, nVec, mu1, z1Kernels, inclBias, inclRSD);
+        __KERN_VARIANTS__(X)
+#undef X
+      }
+
+    return 1;
+}
+
+
 /*  ------------------------------------------------------------------------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
@@ -3367,6 +3508,182 @@ double kernels_z2(kern_t *kernVar)
 }
 
 
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int kernels_z2_basis(kern_t *kernVar, double *z2Basis)
+{
+    /*
+
+        This function calculates the second order biased density kernel decomposed into its bias and RSD monomials:
+
+                Z2(k1_, k2_) = sum_i c_i Z2_i(k1_, k2_)
+
+        with c_i = (b1, b2, c^(2)_γ, f, f b1, f^2) (see kernels_z2_basis_coeff) and
+
+                Z2_b1 = F2(k1, k2, nu12) - a^(2)_γ / 2 γ(nu12)
+                Z2_b2 = 1/2
+                Z2_c2Ga = γ(nu12) / 2
+                Z2_f = mu12^2 G2(k1, k2, nu12)
+                Z2_fb1 = k12 mu12 / 2 * (mu2/k2 + mu1/k1)
+                Z2_ff = k12 mu12 / 2 * (mu2/k2 mu1^2 + mu1/k1 mu2^2)
+
+        The basis only depends on the bootstrap parameters, but neither on the bias nor on the RSD parameters.
+
+    */
+
+    /* Fiducials */
+    fid_btst_t *btst = kernVar -> btst;
+
+    /* Compute all variables */
+    bool computedWork = (kernVar -> computeWork) ? !_kernels_work_var(kernVar, 2) : false;
+
+    /* Second order kernel struct */
+    kern_t *kernVarZ2 = ((kern_t**) kernVar -> kernWork)[1];
+
+
+    /* Calculate kernels */
+
+    /* F2(k1_, k2_) + G2(k1_, k2_) */
+    double h2Kernels[2];
+    kernels_btst_h2(kernVar, h2Kernels);
+
+    /* γ(k1_, k2_) */
+    double gamma = kernels_gamma(kernVarZ2);
+
+    /* k12 mu12 / 2 */
+    double kmu = kernVarZ2 -> k[2] * kernVarZ2 -> mu[2] / 2.;
+
+    /* Z2_i(k1_, k2_) */
+    z2Basis[0] = h2Kernels[0] - btst -> a2Ga / 2. * gamma;
+    z2Basis[1] = 1. / 2.;
+    z2Basis[2] = gamma / 2.;
+    z2Basis[3] = (kernVarZ2 -> mu[2] * kernVarZ2 -> mu[2]) * h2Kernels[1];
+    z2Basis[4] = kmu * (kernVarZ2 -> mu[1] / kernVarZ2 -> k[1] + kernVarZ2 -> mu[0] / kernVarZ2 -> k[0]);
+    z2Basis[5] = kmu * (kernVarZ2 -> mu[1] / kernVarZ2 -> k[1] * kernVarZ2 -> mu[0] * kernVarZ2 -> mu[0]
+                        + kernVarZ2 -> mu[0] / kernVarZ2 -> k[0] * kernVarZ2 -> mu[1] * kernVarZ2 -> mu[1]);
+
+    /* Reset computeWork */
+    kernVar -> computeWork = computedWork;
+
+    return 0;
+}
+
+
+int kernels_z2_basis_coeff(kern_t *kernVar, double *z2Coeff)
+{
+    /*
+
+        This function calculates the bias and RSD monomials of the second order kernel (see kernels_z2_basis):
+
+                c_i = (b1, b2, c^(2)_γ, f, f b1, f^2)
+
+    */
+
+    /* Fiducials */
+    fid_bias_t *bias = kernVar -> bias;
+    fid_rsd_t *rsd = kernVar -> rsd;
+
+    z2Coeff[0] = bias -> b1;
+    z2Coeff[1] = bias -> b2;
+    z2Coeff[2] = bias -> c2Ga;
+    z2Coeff[3] = rsd -> f;
+    z2Coeff[4] = rsd -> f * bias -> b1;
+    z2Coeff[5] = rsd -> f * rsd -> f;
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static inline __attribute__((always_inline)) int _kernels_z2_batch(kern_t *kernVar, size_t nVec, double *k1, double *k2, double *nu12,
+                                                                   double *mu1, double *mu2, double *z2Kernels,
+                                                                   const bool inclBias, const bool inclRSD)
+{
+    /*
+
+        Kernel Z2 over nVec configurations (see kernels_z2_batch) for the compile-time flags inclBias and inclRSD
+
+        Without bias b1 = 1, b2 = 0 and c^(2)_γ = a^(2)_γ, such that the γ(nu12) term vanishes. In real space only the
+        density part b1 F2(k1, k2, nu12) remains and k12, mu12 are not needed at all.
+
+    */
+
+    /* Fiducials */
+    double b1 = (inclBias) ? kernVar -> bias -> b1 : 1.;
+    double b2 = (inclBias) ? kernVar -> bias -> b2 : 0.;
+    double c2Ga = (inclBias) ? kernVar -> bias -> c2Ga : 0.;
+
+    double f = (inclRSD) ? kernVar -> rsd -> f : 0.;
+
+    double a2Ga = kernVar -> btst -> a2Ga;
+    double d2Ga = kernVar -> btst -> d2Ga;
+
+    /* (b1 a^(2)_γ - c^(2)_γ) / 2 */
+    double cGa = (inclBias) ? (b1 * a2Ga - c2Ga) / 2. : 0.;
+
+    for (size_t i = 0; i < nVec; i++)
+      {
+        /* β(k1_, k2_) + γ(k1_, k2_) */
+        double beta = nu12[i] * (nu12[i] + (k1[i] / k2[i] + k2[i] / k1[i]) / 2.);
+        double gamma = 1. - nu12[i] * nu12[i];
+
+        /* Z2(k1_, k2_) */
+        double z2 = b1 * (beta + 0.5 * a2Ga * gamma);
+
+        if (inclBias)
+            z2 += - cGa * gamma + b2 / 2.;
+
+        if (inclRSD)
+          {
+            /* k12 mu12 = k1 mu1 + k2 mu2 */
+            double k12Mu12 = k1[i] * mu1[i] + k2[i] * mu2[i];
+
+            /* k12^2 (same treatment of k12 -> 0 as in _kernels_work_var_k) */
+            double k12Sq = (fabs(k1[i] - k2[i]) > __ABSTOL__ || fabs(nu12[i] + 1.) > __ABSTOL__) ?
+                            fabs(k1[i]*k1[i] + k2[i]*k2[i] + 2. * k1[i] * k2[i] * nu12[i]) : __ABSTOL__ * __ABSTOL__;
+
+            double mu12Sq = (k12Sq > __ABSTOL__ * __ABSTOL__) ? k12Mu12 * k12Mu12 / k12Sq : 0.;
+            k12Mu12 = (k12Sq > __ABSTOL__ * __ABSTOL__) ? k12Mu12 : 0.;
+
+            z2 += f * mu12Sq * (beta + 0.5 * d2Ga * gamma)
+                   + f * k12Mu12 / 2. * (mu2[i] / k2[i] * (b1 + f * mu1[i]*mu1[i]) + mu1[i] / k1[i] * (b1 + f * mu2[i]*mu2[i]));
+          }
+
+        z2Kernels[i] = z2;
+      }
+
+    return 0;
+}
+
+
+int kernels_z2_batch(kern_t *kernVar, size_t nVec, double *k1, double *k2, double *nu12, double *mu1, double *mu2, double *z2Kernels)
+{
+    /*
+
+        This function calculates the second order biased density kernel Z2 (see kernels_z2) for nVec configurations at
+        once, where the i'th configuration is given by (k1[i], k2[i], nu12[i], mu1[i], mu2[i]) and its kernel is stored in
+        z2Kernels[i].
+
+        Only the fiducials of kernVar are used, i.e. none of its variables or working kern_t structs. All arrays are
+        traversed in plain loops, such that the compiler may vectorise them. The variant of kernVar (see kernels_set_z)
+        selects a copy of the loop specialised for the fiducial flags.
+
+    */
+
+    switch (kernVar -> variant)
+      {
+#define X(variant, inclBias, inclRSD) case variant: return _kernels_z2_batch(kernVar, nVec, k1, k2, nu12, mu1, mu2, z2Kernels, inclBias, inclRSD);
+        __KERN_VARIANTS__(X)
+#undef X
+      }
+
+    return 1;
+}
+
+
 /*  ------------------------------------------------------------------------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
@@ -4055,67 +4372,42 @@ double kernels_z3(kern_t *kernVar)
 }
 
 
-/*  ------------------------------------------------------------------------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-double kernels_dz3_k(kern_t *kernVar)
+int kernels_z3_basis(kern_t *kernVar, double *z3Basis)
 {
     /*
 
-        This function calculates the derivative of the third order biased density kernel with respect to k1 (first variable):
-
-                dZ3/dk1(k1_, k2_, k3_) = dZ3/dk1(k1, k2, k3, nu12, nu23, nu31, mu1, mu2, mu3)
-                                       = b1 dF3/dk1(k1_, k2_, k3_) + d(mu123^2 f G3(k1_, k2_, k3_))/dk1
-                                          + f d(mu123 k123)/dk1 / 3 * (mu1/k1 Z2'(k2_, k3_) + mu2/k2 Z2'(k1_, k3_) + mu3/k3 Z2'(k1_, k2_))
-                                              + f mu123 k123 / 3 * (-mu1/k1^2 Z2'(k2_, k3_) + mu2/k2 dZ2'/dk1(k1_, k3_) + mu3/k3 dZ2'/dk1(k1_, k2_))
-                                          + f d(mu123 k123)/dk1 / 3 * (mu12/k12 G2(k1_, k2_) Z1(k3_) + mu23/k23 G2(k2_, k3_) Z1(k1_) + mu31/k31 G2(k3_, k1_) Z1(k2_))
-                                              + f mu123 k123 / 3 * (d(mu12/k12 G2(k1_, k2_))/dk1 Z1(k3_) + d(mu31/k31 G2(k3_, k1_))/dk1 Z1(k2_))
-                                          + b2 / 3 * (dF2(k1_, k2_)/dk1 + dF2(k1_, k3_)/dk1)
-                                          - (b1 a2Ga - c2Ga) / 3 * (d(γ(k12_, k3_) F2(k1_, k2_))/dk1 + d(γ(k31_, k2_) F2(k3_, k1_))/dk1)
-                                          - 2 bGam3 / 3 * ( d(γ(k12_, k3_) (F2(k1_, k2_) - G2(k1_, k2_)))/dk1 + d(γ(k31_, k2_) (F2(k3_, k1_) - G2(k3_, k1_)))/dk1 )
-
-        where
-
-                Z2'(k1_, k2_) = b1 F2(k1_, k2_) + (mu12)^2 f G2(k1_, k2_) + f mu123 k123 / 4 * (mu1/k1 Z1(k2_) + mu2/k2 Z1(k1_)) - (b1 a2Ga - c2Ga) / 2 γ(k1_, k2_) + b2/2
-                dZ2'/dk1(k1_, k2_) = b1 dF2/dk1(k1_, k2_) + d((mu12)^2 f G2(k1_, k2_))/dk1
-                                        + f d(mu123 k123)/dk1 / 4 * (mu1/k1 Z1(k2_) + mu2/k2 Z1(k1_)) - f mu123 k123 / 4 * mu1/k1^2 Z1(k2_)
-
-        and
-
-                kij_ = ki_ + kj_
-
-                    =>  kij^2 = |kij_|^2 = ki^2 + kj^2 + 2 ki kj nuij
-                    =>  muij = kij_.s_ / kij = (ki mui + kj muj) / kij
-
-                    =>  dk1i/k1 = (k1 + ki nu1i) / k1i
-                    =>  dmu1i/dk1 = mu1 / k1i - mu1i/k1i dk1i/dk1
-                    =>  d(mu1i k1i) = mu1
+        This function calculates the third order biased density kernel decomposed into its bias and RSD monomials:
 
-        and
+                Z3(k1_, k2_, k3_) = sum_i c_i Z3_i(k1_, k2_, k3_)
 
-                k123_ = k1_ + k2_ + k3_
+        with c_i = (b1, b2, c^(2)_γ, bΓ3, f, f b1, f b2, f c^(2)_γ, f^2, f^2 b1, f^3) (see kernels_z3_basis_coeff). Using the
+        basis Z2'_j of Z2'(ki_, kj_) (see kernels_z3 and kernels_z2_basis) the individual terms read
 
-                    =>  k123^2 = |k1_ + k2_ + k3_|^2 = k1^2 + k2^2 + k3^2 + 2 k1 k2 nu12 + 2 k2 k3 nu23 + 2 k3 k1 nu31
-                    =>  mu123 = k123_.s_ / k123 = (k1 mu1 + k2 mu2 + k3 mu3) / k123
+                Z3_b1 = F3(k1_, k2_, k3_) - a^(2)_γ / 3 * (γ(k12_, k3_) F2(k1_, k2_) + cyc.)
+                Z3_b2 = 1 / 3 * (F2(k1_, k2_) + cyc.)
+                Z3_c2Ga = 1 / 3 * (γ(k12_, k3_) F2(k1_, k2_) + cyc.)
+                Z3_bGam3 = - 2 / 3 * (γ(k12_, k3_) (F2(k1_, k2_) - G2(k1_, k2_)) + cyc.)
+                Z3_f = mu123^2 G3(k1_, k2_, k3_)
+                Z3_fb1 = mu123 k123 / 3 * (mu3/k3 Z2'_b1(k1_, k2_) + cyc.) + mu123 k123 / 3 * (mu12/k12 G2(k1_, k2_) + cyc.)
+                Z3_fb2 = mu123 k123 / 3 * (mu3/k3 Z2'_b2(k1_, k2_) + cyc.)
+                Z3_fc2Ga = mu123 k123 / 3 * (mu3/k3 Z2'_c2Ga(k1_, k2_) + cyc.)
+                Z3_ff = mu123 k123 / 3 * (mu3/k3 Z2'_f(k1_, k2_) + cyc.) + mu123 k123 / 3 * (mu12/k12 G2(k1_, k2_) mu3^2 + cyc.)
+                Z3_ffb1 = mu123 k123 / 3 * (mu3/k3 Z2'_fb1(k1_, k2_) + cyc.)
+                Z3_fff = mu123 k123 / 3 * (mu3/k3 Z2'_ff(k1_, k2_) + cyc.)
 
-                    =>  dk123/dk1 = (k1 + k2 nu12 + k3 nu13) / k123
-                    =>  dmu123/dk1 = mu1 / k123 - mu123/k123 dk123/dk1
-                    =>  d(mu123 k123)/dk1 = mu1
+        The basis only depends on the bootstrap parameters, but neither on the bias nor on the RSD parameters.
 
     */
 
     /* Fiducials */
-    fid_bias_t *bias = kernVar -> bias;
-    fid_rsd_t *rsd = kernVar -> rsd;
     fid_btst_t *btst = kernVar -> btst;
 
     /* Compute all variables */
     bool computedWork = (kernVar -> computeWork) ? !_kernels_work_var(kernVar, 3) : false;
 
-    /* First order kernel struct */
-    kern_t *kernVarZ1 = ((kern_t**) kernVar -> kernWork)[0];
-
     /* Second order kernel struct */
     kern_t *kernVarZ2 = ((kern_t**) kernVar -> kernWork)[1];
 
@@ -4123,49 +4415,441 @@ double kernels_dz3_k(kern_t *kernVar)
     kern_t *kernVarZ3 = ((kern_t**) kernVar -> kernWork)[2];
 
     /* Declare kernels */
-    double h3Kernels[2];
-    double dh3Kernels[2];
-
     double h2Kernels[3][2];
-    double dh2Kernels[3][2];
 
     double gammaSin[3];
     double gammaSum[3];
-    double dgammaSum[3];
-
-    double z1Kernels[3];
-
-    double z2Kernels[3];
-    double dz2Kernels[3];
-
-    /* Additional variables */
-    double dk[3];
-    double dmu[3];
-    double dnu[3];
 
-    double dk123 = (kernVarZ3 -> k[0] + kernVarZ3 -> k[1] * kernVarZ3 -> nu[0] + kernVarZ3 -> k[2] * kernVarZ3 -> nu[1]) / kernVarZ3 -> k[6];
-    double dmu123 = (kernVarZ3 -> mu[0] - kernVarZ3 -> mu[6] * dk123) / kernVarZ3 -> k[6];
+    double z2Basis[3][6];
 
 
     /* Calculate kernels */
 
     /* F3(k1_, k2_, k3_) + G3(k1_, k2_, k3_) */
+    double h3Kernels[2];
     kernels_btst_h3(kernVar, h3Kernels);
 
-    /* dF3/dk1(k1_, k2_, k3_) + dG3/dk1(k1_, k2_, k3_) */
-    kernels_btst_dh3_k(kernVar, dh3Kernels);
-
-    /* Z1(k1_) */
-    kernVarZ1 -> mu[0] = kernVarZ3 -> mu[0];
-    z1Kernels[0] = kernels_z1(kernVar);
-
-    /* Z1(k2_) */
-    kernVarZ1 -> mu[0] = kernVarZ3 -> mu[1];
-    z1Kernels[1] = kernels_z1(kernVar);
-
-    /* Z1(k3_) */
-    kernVarZ1 -> mu[0] = kernVarZ3 -> mu[2];
-    z1Kernels[2] = kernels_z1(kernVar);
+    /* mu123 k123 / 3 */
+    double kmu = kernVarZ3 -> mu[6] * kernVarZ3 -> k[6] / 3.;
+
+
+    size_t index = 0;
+
+    for (size_t i = 0; i < kernVarZ2 -> kernOrder; i++)
+      {
+        for (size_t j = i; j < kernVarZ2 -> kernOrder; j++)
+          {
+            /*
+
+                    F2(k1_, k2_) + G2(k1_, k2_) + γ(k1_, k2_)
+
+                for k1, k2, nu12 given in the following order: (k[0],k[1],nu[0]) -> (k[0],k[2],nu[1]) -> (k[1],k[2],nu[2])
+
+            */
+
+            /* Variables */
+            kernVarZ2 -> k[0] = kernVarZ3 -> k[i];
+            kernVarZ2 -> mu[0] = kernVarZ3 -> mu[i];
+
+            kernVarZ2 -> k[1] = kernVarZ3 -> k[j + 1];
+            kernVarZ2 -> mu[1] = kernVarZ3 -> mu[j + 1];
+
+            kernVarZ2 -> nu[0] = kernVarZ3 -> nu[index];
+
+            /* Kernels */
+            kernels_btst_h2(kernVar, h2Kernels[index]);
+
+            gammaSin[index] = kernels_gamma(kernVarZ2);
+
+            /* Z2'_i(k1_, k2_; k3_) */
+            z2Basis[index][0] = h2Kernels[index][0] - btst -> a2Ga / 2. * gammaSin[index];
+            z2Basis[index][1] = 1. / 2.;
+            z2Basis[index][2] = gammaSin[index] / 2.;
+            z2Basis[index][3] = (kernVarZ3 -> mu[index + 3] * kernVarZ3 -> mu[index + 3]) * h2Kernels[index][1];
+            z2Basis[index][4] = 3. / 4. * kmu * (kernVarZ2 -> mu[0] / kernVarZ2 -> k[0] + kernVarZ2 -> mu[1] / kernVarZ2 -> k[1]);
+            z2Basis[index][5] = 3. / 4. * kmu * ( kernVarZ2 -> mu[0] / kernVarZ2 -> k[0] * kernVarZ3 -> mu[j + 1] * kernVarZ3 -> mu[j + 1]
+                                                + kernVarZ2 -> mu[1] / kernVarZ2 -> k[1] * kernVarZ3 -> mu[i] * kernVarZ3 -> mu[i] );
+
+
+            /*
+
+                    γ(k12_, k3_)
+
+                for k12, k3, nu12,3 given in the following order: (k[3],k[2],nu[3]) -> (k[4],k[1],nu[4]) -> (k[5],k[0],nu[5])
+
+            */
+
+            /* Variables (only need nu12,3 for γ(k12_, k3_)) */
+            kernVarZ2 -> nu[0] = kernVarZ3 -> nu[3 + index];
+
+            /* Kernels */
+            gammaSum[index] = kernels_gamma(kernVarZ2);
+
+
+            index++;
+          }
+      }
+
+    /* mu3/k3, mu2/k2, mu1/k1 (multiplying Z2'(k1_, k2_), Z2'(k1_, k3_), Z2'(k2_, k3_)) */
+    double muk[3] = {kernVarZ3 -> mu[2] / kernVarZ3 -> k[2], kernVarZ3 -> mu[1] / kernVarZ3 -> k[1], kernVarZ3 -> mu[0] / kernVarZ3 -> k[0]};
+
+    /* mu12/k12 G2(k1_, k2_), mu13/k13 G2(k1_, k3_), mu23/k23 G2(k2_, k3_) (multiplying Z1(k3_), Z1(k2_), Z1(k1_)) */
+    double mukG2[3];
+
+    for (size_t i = 0; i < 3; i++)
+        mukG2[i] = kernVarZ3 -> mu[i + 3] / kernVarZ3 -> k[i + 3] * h2Kernels[i][1];
+
+    /* Z3_i(k1_, k2_, k3_) */
+    z3Basis[0] = h3Kernels[0] - btst -> a2Ga / 3. * (gammaSum[0] * h2Kernels[0][0] + gammaSum[1] * h2Kernels[1][0] + gammaSum[2] * h2Kernels[2][0]);
+    z3Basis[1] = (h2Kernels[0][0] + h2Kernels[1][0] + h2Kernels[2][0]) / 3.;
+    z3Basis[2] = (gammaSum[0] * h2Kernels[0][0] + gammaSum[1] * h2Kernels[1][0] + gammaSum[2] * h2Kernels[2][0]) / 3.;
+    z3Basis[3] = - 2. / 3. * ( gammaSum[0] * (h2Kernels[0][0] - h2Kernels[0][1])
+                             + gammaSum[1] * (h2Kernels[1][0] - h2Kernels[1][1])
+                             + gammaSum[2] * (h2Kernels[2][0] - h2Kernels[2][1]) );
+    z3Basis[4] = (kernVarZ3 -> mu[6] * kernVarZ3 -> mu[6]) * h3Kernels[1];
+
+    /* Terms proportional to f Z2'_j */
+    for (size_t i = 0; i < 6; i++)
+      {
+        z3Basis[5 + i] = kmu * (muk[0] * z2Basis[0][i] + muk[1] * z2Basis[1][i] + muk[2] * z2Basis[2][i]);
+      }
+
+    /* Terms proportional to f G2 Z1 */
+    z3Basis[5] += kmu * (mukG2[0] + mukG2[1] + mukG2[2]);
+    z3Basis[8] += kmu * ( mukG2[0] * kernVarZ3 -> mu[2] * kernVarZ3 -> mu[2]
+                        + mukG2[1] * kernVarZ3 -> mu[1] * kernVarZ3 -> mu[1]
+                        + mukG2[2] * kernVarZ3 -> mu[0] * kernVarZ3 -> mu[0] );
+
+    /* Reset computeWork */
+    kernVar -> computeWork = computedWork;
+
+    return 0;
+}
+
+
+int kernels_z3_basis_coeff(kern_t *kernVar, double *z3Coeff)
+{
+    /*
+
+        This function calculates the bias and RSD monomials of the third order kernel (see kernels_z3_basis):
+
+                c_i = (b1, b2, c^(2)_γ, bΓ3, f, f b1, f b2, f c^(2)_γ, f^2, f^2 b1, f^3)
+
+    */
+
+    /* Fiducials */
+    fid_bias_t *bias = kernVar -> bias;
+    fid_rsd_t *rsd = kernVar -> rsd;
+
+    z3Coeff[0] = bias -> b1;
+    z3Coeff[1] = bias -> b2;
+    z3Coeff[2] = bias -> c2Ga;
+    z3Coeff[3] = bias -> bGam3;
+    z3Coeff[4] = rsd -> f;
+    z3Coeff[5] = rsd -> f * bias -> b1;
+    z3Coeff[6] = rsd -> f * bias -> b2;
+    z3Coeff[7] = rsd -> f * bias -> c2Ga;
+    z3Coeff[8] = rsd -> f * rsd -> f;
+    z3Coeff[9] = rsd -> f * rsd -> f * bias -> b1;
+    z3Coeff[10] = rsd -> f * rsd -> f * rsd -> f;
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static inline __attribute__((always_inline)) int _kernels_z3_batch(kern_t *kernVar, size_t nVec, double *k1, double *k2, double *k3,
+                                                                   double *nu12, double *nu13, double *nu23, double *mu1, double *mu2,
+                                                                   double *mu3, double *z3Kernels, const bool inclBias, const bool inclRSD)
+{
+    /*
+
+        Kernel Z3 over nVec configurations (see kernels_z3_batch) for the compile-time flags inclBias and inclRSD
+
+        Without bias b1 = 1, b2 = bGam3 = 0 and c^(2)_γ = a^(2)_γ, such that only the F3 and RSD terms remain. In real space
+        Z3 reduces to the density terms, for which neither Z1, G3, mu_ab nor k123 are needed.
+
+    */
+
+    /* Fiducials */
+    double b1 = (inclBias) ? kernVar -> bias -> b1 : 1.;
+    double b2 = (inclBias) ? kernVar -> bias -> b2 : 0.;
+    double c2Ga = (inclBias) ? kernVar -> bias -> c2Ga : 0.;
+    double bGam3 = (inclBias) ? kernVar -> bias -> bGam3 : 0.;
+
+    double f = (inclRSD) ? kernVar -> rsd -> f : 0.;
+
+    fid_btst_t *btst = kernVar -> btst;
+
+    double a2Ga = btst -> a2Ga;
+    double d2Ga = btst -> d2Ga;
+
+    /* (b1 a^(2)_γ - c^(2)_γ) */
+    double cGa = (inclBias) ? b1 * a2Ga - c2Ga : 0.;
+
+    /* Coefficients of the F3 and G3 terms (see kernels_btst_h3) */
+    double cF3[4] = {(btst -> a3GaA / 2. + btst -> a3GaB) / 6., (btst -> a3GaA / 2. - btst -> a3GaB) / 6.,
+                     (btst -> a3GaA / 2. - btst -> a3GaB - 2. * btst -> h) / 6., (btst -> a3GaA / 2. - btst -> a3GaB + btst -> a2Ga - btst -> h) / 3.};
+    double cG3[4] = {(btst -> d3GaA / 2. + btst -> d3GaB) / 6., (btst -> d3GaA / 2. - btst -> d3GaB) / 6.,
+                     (btst -> d3GaA / 2. - btst -> d3GaB - 2. * btst -> h) / 6., (btst -> d3GaA / 2. - btst -> d3GaB + btst -> d2Ga - btst -> h) / 3.};
+
+    for (size_t n = 0; n < nVec; n++)
+      {
+        /* Single wavevectors and their angles nu12, nu13, nu23 */
+        double k[3] = {k1[n], k2[n], k3[n]};
+        double mu[3] = {mu1[n], mu2[n], mu3[n]};
+        double nu[3] = {nu12[n], nu13[n], nu23[n]};
+
+        /* Pairs (a, b) with remaining wavevector c, and the indices of nu_ac and nu_bc */
+        const size_t a[3] = {0, 0, 1};
+        const size_t b[3] = {1, 2, 2};
+        const size_t c[3] = {2, 1, 0};
+
+        const size_t nuAC[3] = {1, 0, 0};
+        const size_t nuBC[3] = {2, 2, 1};
+
+        /* Z1(ki_) */
+        double z1[3];
+
+        for (size_t i = 0; i < 3; i++)
+            z1[i] = (inclRSD) ? b1 + f * mu[i]*mu[i] : b1;
+
+        /* kab = |ka_ + kb_|, muab and nu(kab_, kc_) */
+        double kab[3], muab[3], nuab[3];
+
+        for (size_t p = 0; p < 3; p++)
+          {
+            double ka = k[a[p]];
+            double kb = k[b[p]];
+
+            kab[p] = (fabs(ka - kb) > __ABSTOL__ || fabs(nu[p] + 1.) > __ABSTOL__) ? sqrt( fabs(ka*ka + kb*kb + 2. * ka * kb * nu[p]) ) : __ABSTOL__;
+            muab[p] = (inclRSD && kab[p] > __ABSTOL__) ? (ka * mu[a[p]] + kb * mu[b[p]]) / kab[p] : 0.;
+            nuab[p] = (kab[p] > __ABSTOL__) ? (nu[nuAC[p]] * ka + nu[nuBC[p]] * kb) / kab[p] : 0.;
+          }
+
+        /* k123 = |k12_ + k3_| and mu123 */
+        double k123 = 0., mu123 = 0.;
+
+        if (inclRSD)
+          {
+            k123 = (fabs(kab[0] - k[2]) > __ABSTOL__ || fabs(nuab[0] + 1.) > __ABSTOL__) ?
+                    sqrt( fabs(kab[0]*kab[0] + k[2]*k[2] + 2. * kab[0] * k[2] * nuab[0]) ) : __ABSTOL__;
+            mu123 = (k123 > __ABSTOL__) ? (kab[0] * muab[0] + k[2] * mu[2]) / k123 : 0.;
+          }
+
+        double kmu = f * k123 * mu123;
+
+        /* Sums over the pairs */
+        double f3 = 0., g3 = 0.;
+        double sumZ2 = 0., sumG2Z1 = 0.;
+        double sumF2 = 0., sumGaF2 = 0., sumGaF2G2 = 0.;
+
+        for (size_t p = 0; p < 3; p++)
+          {
+            double ka = k[a[p]];
+            double kb = k[b[p]];
+            double kc = k[c[p]];
+
+            /* β(ka_, kb_) + γ(ka_, kb_) -> F2(ka_, kb_) + G2(ka_, kb_) */
+            double betaSin = nu[p] * (nu[p] + (ka / kb + kb / ka) / 2.);
+            double gammaSin = 1. - nu[p]*nu[p];
+
+            double f2 = betaSin + 0.5 * a2Ga * gammaSin;
+            double g2 = betaSin + 0.5 * d2Ga * gammaSin;
+
+            /* β(kab_, kc_) + α^(a)(kab_, kc_) + γ(kab_, kc_) */
+            double betaSum = nuab[p] * (nuab[p] + (kab[p] / kc + kc / kab[p]) / 2.);
+            double alphaSum = nuab[p] / 2. * (kc / kab[p] - kab[p] / kc);
+            double gammaSum = 1. - nuab[p]*nuab[p];
+
+            /* F3 + G3 (ignoring apparent singularities kab -> 0) */
+            if (kab[p] > __ABSTOL__)
+              {
+                f3 += betaSum * betaSin / 3. + cF3[0] * gammaSum * gammaSin + cF3[1] * alphaSum * gammaSin
+                       - cF3[2] * betaSum * gammaSin + cF3[3] * gammaSum * betaSin;
+
+                if (inclRSD)
+                    g3 += betaSum * betaSin / 3. + cG3[0] * gammaSum * gammaSin + cG3[1] * alphaSum * gammaSin
+                           - cG3[2] * betaSum * gammaSin + cG3[3] * gammaSum * betaSin;
+              }
+
+            if (inclRSD)
+              {
+                /* Z2'(ka_, kb_) */
+                double z2 = b1 * f2 + f * muab[p]*muab[p] * g2
+                             + kmu / 4. * (mu[a[p]] / ka * z1[b[p]] + mu[b[p]] / kb * z1[a[p]]);
+
+                if (inclBias)
+                    z2 += - cGa / 2. * gammaSin + b2 / 2.;
+
+                sumZ2 += mu[c[p]] / kc * z2;
+                sumG2Z1 += muab[p] / kab[p] * g2 * z1[c[p]];
+              }
+
+            if (inclBias)
+              {
+                sumF2 += f2;
+                sumGaF2 += gammaSum * f2;
+                sumGaF2G2 += gammaSum * (f2 - g2);
+              }
+          }
+
+        /* Z3(k1_, k2_, k3_) */
+        double z3 = b1 * f3;
+
+        if (inclRSD)
+            z3 += f * mu123*mu123 * g3 + kmu / 3. * (sumZ2 + sumG2Z1);
+
+        if (inclBias)
+            z3 += b2 / 3. * sumF2 - cGa / 3. * sumGaF2 - 2. * bGam3 / 3. * sumGaF2G2;
+
+        z3Kernels[n] = z3;
+      }
+
+    return 0;
+}
+
+
+int kernels_z3_batch(kern_t *kernVar, size_t nVec, double *k1, double *k2, double *k3, double *nu12, double *nu13, double *nu23,
+                     double *mu1, double *mu2, double *mu3, double *z3Kernels)
+{
+    /*
+
+        This function calculates the third order biased density kernel Z3 (see kernels_z3) for nVec configurations at
+        once, where the i'th configuration is given by (k1[i], k2[i], k3[i], nu12[i], nu13[i], nu23[i], mu1[i], mu2[i], mu3[i])
+        and its kernel is stored in z3Kernels[i].
+
+        As in kernels_z2_batch, only the fiducials of kernVar are used and the derived scales and angles (see
+        _kernels_work_var_k, incl. its treatment of kij -> 0) are computed inline, such that the compiler may vectorise
+        the loop. The pairs (ki_, kj_) are ordered as (k1_, k2_) -> (k1_, k3_) -> (k2_, k3_), each with the remaining
+        wavevector k3_ -> k2_ -> k1_.
+
+    */
+
+    switch (kernVar -> variant)
+      {
+#define X(variant, inclBias, inclRSD) case variant: return _kernels_z3_batch(kernVar, nVec, k1, k2, k3, nu12, nu13, nu23, mu1, mu2, mu3, z3Kernels, inclBias, inclRSD);
+        __KERN_VARIANTS__(X)
+#undef X
+      }
+
+    return 1;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+double kernels_dz3_k(kern_t *kernVar)
+{
+    /*
+
+        This function calculates the derivative of the third order biased density kernel with respect to k1 (first variable):
+
+                dZ3/dk1(k1_, k2_, k3_) = dZ3/dk1(k1, k2, k3, nu12, nu23, nu31, mu1, mu2, mu3)
+                                       = b1 dF3/dk1(k1_, k2_, k3_) + d(mu123^2 f G3(k1_, k2_, k3_))/dk1
+                                          + f d(mu123 k123)/dk1 / 3 * (mu1/k1 Z2'(k2_, k3_) + mu2/k2 Z2'(k1_, k3_) + mu3/k3 Z2'(k1_, k2_))
+                                              + f mu123 k123 / 3 * (-mu1/k1^2 Z2'(k2_, k3_) + mu2/k2 dZ2'/dk1(k1_, k3_) + mu3/k3 dZ2'/dk1(k1_, k2_))
+                                          + f d(mu123 k123)/dk1 / 3 * (mu12/k12 G2(k1_, k2_) Z1(k3_) + mu23/k23 G2(k2_, k3_) Z1(k1_) + mu31/k31 G2(k3_, k1_) Z1(k2_))
+                                              + f mu123 k123 / 3 * (d(mu12/k12 G2(k1_, k2_))/dk1 Z1(k3_) + d(mu31/k31 G2(k3_, k1_))/dk1 Z1(k2_))
+                                          + b2 / 3 * (dF2(k1_, k2_)/dk1 + dF2(k1_, k3_)/dk1)
+                                          - (b1 a2Ga - c2Ga) / 3 * (d(γ(k12_, k3_) F2(k1_, k2_))/dk1 + d(γ(k31_, k2_) F2(k3_, k1_))/dk1)
+                                          - 2 bGam3 / 3 * ( d(γ(k12_, k3_) (F2(k1_, k2_) - G2(k1_, k2_)))/dk1 + d(γ(k31_, k2_) (F2(k3_, k1_) - G2(k3_, k1_)))/dk1 )
+
+        where
+
+                Z2'(k1_, k2_) = b1 F2(k1_, k2_) + (mu12)^2 f G2(k1_, k2_) + f mu123 k123 / 4 * (mu1/k1 Z1(k2_) + mu2/k2 Z1(k1_)) - (b1 a2Ga - c2Ga) / 2 γ(k1_, k2_) + b2/2
+                dZ2'/dk1(k1_, k2_) = b1 dF2/dk1(k1_, k2_) + d((mu12)^2 f G2(k1_, k2_))/dk1
+                                        + f d(mu123 k123)/dk1 / 4 * (mu1/k1 Z1(k2_) + mu2/k2 Z1(k1_)) - f mu123 k123 / 4 * mu1/k1^2 Z1(k2_)
+
+        and
+
+                kij_ = ki_ + kj_
+
+                    =>  kij^2 = |kij_|^2 = ki^2 + kj^2 + 2 ki kj nuij
+                    =>  muij = kij_.s_ / kij = (ki mui + kj muj) / kij
+
+                    =>  dk1i/k1 = (k1 + ki nu1i) / k1i
+                    =>  dmu1i/dk1 = mu1 / k1i - mu1i/k1i dk1i/dk1
+                    =>  d(mu1i k1i) = mu1
+
+        and
+
+                k123_ = k1_ + k2_ + k3_
+
+                    =>  k123^2 = |k1_ + k2_ + k3_|^2 = k1^2 + k2^2 + k3^2 + 2 k1 k2 nu12 + 2 k2 k3 nu23 + 2 k3 k1 nu31
+                    =>  mu123 = k123_.s_ / k123 = (k1 mu1 + k2 mu2 + k3 mu3) / k123
+
+                    =>  dk123/dk1 = (k1 + k2 nu12 + k3 nu13) / k123
+                    =>  dmu123/dk1 = mu1 / k123 - mu123/k123 dk123/dk1
+                    =>  d(mu123 k123)/dk1 = mu1
+
+    */
+
+    /* Fiducials */
+    fid_bias_t *bias = kernVar -> bias;
+    fid_rsd_t *rsd = kernVar -> rsd;
+    fid_btst_t *btst = kernVar -> btst;
+
+    /* Compute all variables */
+    bool computedWork = (kernVar -> computeWork) ? !_kernels_work_var(kernVar, 3) : false;
+
+    /* First order kernel struct */
+    kern_t *kernVarZ1 = ((kern_t**) kernVar -> kernWork)[0];
+
+    /* Second order kernel struct */
+    kern_t *kernVarZ2 = ((kern_t**) kernVar -> kernWork)[1];
+
+    /* Third order kernel struct */
+    kern_t *kernVarZ3 = ((kern_t**) kernVar -> kernWork)[2];
+
+    /* Declare kernels */
+    double h3Kernels[2];
+    double dh3Kernels[2];
+
+    double h2Kernels[3][2];
+    double dh2Kernels[3][2];
+
+    double gammaSin[3];
+    double gammaSum[3];
+    double dgammaSum[3];
+
+    double z1Kernels[3];
+
+    double z2Kernels[3];
+    double dz2Kernels[3];
+
+    /* Additional variables */
+    double dk[3];
+    double dmu[3];
+    double dnu[3];
+
+    double dk123 = (kernVarZ3 -> k[0] + kernVarZ3 -> k[1] * kernVarZ3 -> nu[0] + kernVarZ3 -> k[2] * kernVarZ3 -> nu[1]) / kernVarZ3 -> k[6];
+    double dmu123 = (kernVarZ3 -> mu[0] - kernVarZ3 -> mu[6] * dk123) / kernVarZ3 -> k[6];
+
+
+    /* Calculate kernels */
+
+    /* F3(k1_, k2_, k3_) + G3(k1_, k2_, k3_) */
+    kernels_btst_h3(kernVar, h3Kernels);
+
+    /* dF3/dk1(k1_, k2_, k3_) + dG3/dk1(k1_, k2_, k3_) */
+    kernels_btst_dh3_k(kernVar, dh3Kernels);
+
+    /* Z1(k1_) */
+    kernVarZ1 -> mu[0] = kernVarZ3 -> mu[0];
+    z1Kernels[0] = kernels_z1(kernVar);
+
+    /* Z1(k2_) */
+    kernVarZ1 -> mu[0] = kernVarZ3 -> mu[1];
+    z1Kernels[1] = kernels_z1(kernVar);
+
+    /* Z1(k3_) */
+    kernVarZ1 -> mu[0] = kernVarZ3 -> mu[2];
+    z1Kernels[2] = kernels_z1(kernVar);
 
 
     size_t index = 0;
@@ -4804,6 +5488,8 @@ double kernels_dz3_a2ga(kern_t *kernVar)
                             + kernVarZ3 -> mu[4] / kernVarZ3 -> k[4] * dh2Kernels[1][1] * z1Kernels[1]
                             + kernVarZ3 -> mu[5] / kernVarZ3 -> k[5] * dh2Kernels[2][1] * z1Kernels[0] )
 
+                       + bias -> b2 / 3. * ( dh2Kernels[0][0] + dh2Kernels[1][0] + dh2Kernels[2][0] )
+
                        - bias -> b1 / 3. * ( gammaSum[0] * h2Kernels[0][0]
                                           + gammaSum[1] * h2Kernels[1][0]
                                           + gammaSum[2] * h2Kernels[2][0] )
@@ -4880,7 +5566,6 @@ double kernels_dz3_d2ga(kern_t *kernVar)
     double h2Kernels[3][2];
     double dh2Kernels[3][2];
 
-    double gammaSin[3];
     double gammaSum[3];
 
     double z1Kernels[3];
@@ -4934,11 +5619,8 @@ double kernels_dz3_d2ga(kern_t *kernVar)
             kernels_btst_h2(kernVar, h2Kernels[index]);
             kernels_btst_dh2_d2ga(kernVar, dh2Kernels[index]);
 
-            gammaSin[index] = kernels_gamma(kernVarZ2);
-
             /* Z2'(k1_, k2_; k3_) */
-            dz2Kernels[index] = bias -> b1 * dh2Kernels[index][0] + rsd -> f * (kernVarZ3 -> mu[index + 3] * kernVarZ3 -> mu[index + 3]) * dh2Kernels[index][1]
-                                - bias -> b1 / 2. * gammaSin[index];
+            dz2Kernels[index] = bias -> b1 * dh2Kernels[index][0] + rsd -> f * (kernVarZ3 -> mu[index + 3] * kernVarZ3 -> mu[index + 3]) * dh2Kernels[index][1];
 
 
             /*
@@ -5821,6 +6503,398 @@ double kernels_dz3_f(kern_t *kernVar)
 
 
 
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%     DUAL KERNELS     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  -------------------------------------   Dual Number Arithmetic   -------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static inline kern_dual_t _kernels_dual_const(double val)
+{
+    /*
+
+        Constant val (all derivatives vanish)
+
+    */
+
+    kern_dual_t x = {.val = val};
+
+    return x;
+}
+
+
+static inline kern_dual_t _kernels_dual_param(double val, size_t index)
+{
+    /*
+
+        Parameter with value val and index __KERN_DUAL_...__ (derivative 1 w.r.t. itself)
+
+    */
+
+    kern_dual_t x = {.val = val};
+    x.d[index] = 1.;
+
+    return x;
+}
+
+
+static inline kern_dual_t _kernels_dual_scale(double a, kern_dual_t x)
+{
+    /*
+
+        a x for constant a
+
+    */
+
+    kern_dual_t z;
+
+    z.val = a * x.val;
+
+    for (size_t i = 0; i < __KERN_DUAL_SIZE__; i++)
+        z.d[i] = a * x.d[i];
+
+    return z;
+}
+
+
+static inline kern_dual_t _kernels_dual_lin(double a, kern_dual_t x, double b, kern_dual_t y)
+{
+    /*
+
+        a x + b y for constants a and b
+
+    */
+
+    kern_dual_t z;
+
+    z.val = a * x.val + b * y.val;
+
+    for (size_t i = 0; i < __KERN_DUAL_SIZE__; i++)
+        z.d[i] = a * x.d[i] + b * y.d[i];
+
+    return z;
+}
+
+
+static inline kern_dual_t _kernels_dual_mul(kern_dual_t x, kern_dual_t y)
+{
+    /*
+
+        x y (product rule)
+
+    */
+
+    kern_dual_t z;
+
+    z.val = x.val * y.val;
+
+    for (size_t i = 0; i < __KERN_DUAL_SIZE__; i++)
+        z.d[i] = x.d[i] * y.val + x.val * y.d[i];
+
+    return z;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+typedef struct
+{
+    /*
+
+        Kernel parameters as dual numbers
+
+    */
+
+    kern_dual_t a2Ga, d2Ga;
+    kern_dual_t a3GaA, a3GaB, d3GaA, d3GaB;
+    kern_dual_t h;
+
+    kern_dual_t b1, b2, c2Ga, bGam3;
+    kern_dual_t f;
+
+} _kern_dual_params_t;
+
+
+static _kern_dual_params_t _kernels_dual_params(kern_t *kernVar)
+{
+    /*
+
+        Seed the kernel parameters of kernVar, each with a unit derivative with respect to itself
+
+    */
+
+    fid_btst_t *btst = kernVar -> btst;
+    fid_bias_t *bias = kernVar -> bias;
+
+    _kern_dual_params_t params;
+
+    params.a2Ga = _kernels_dual_param(btst -> a2Ga, __KERN_DUAL_A2GA__);
+    params.d2Ga = _kernels_dual_param(btst -> d2Ga, __KERN_DUAL_D2GA__);
+
+    params.a3GaA = _kernels_dual_param(btst -> a3GaA, __KERN_DUAL_A3GAA__);
+    params.a3GaB = _kernels_dual_param(btst -> a3GaB, __KERN_DUAL_A3GAB__);
+    params.d3GaA = _kernels_dual_param(btst -> d3GaA, __KERN_DUAL_D3GAA__);
+    params.d3GaB = _kernels_dual_param(btst -> d3GaB, __KERN_DUAL_D3GAB__);
+
+    params.h = _kernels_dual_param(btst -> h, __KERN_DUAL_H__);
+
+    params.b1 = _kernels_dual_param(bias -> b1, __KERN_DUAL_B1__);
+    params.b2 = _kernels_dual_param(bias -> b2, __KERN_DUAL_B2__);
+    params.c2Ga = _kernels_dual_param(bias -> c2Ga, __KERN_DUAL_C2GA__);
+    params.bGam3 = _kernels_dual_param(bias -> bGam3, __KERN_DUAL_BGAM3__);
+
+    params.f = _kernels_dual_param(kernVar -> rsd -> f, __KERN_DUAL_F__);
+
+    return params;
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ---------------------------------------   Biased Dual Kernels   --------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int kernels_z1_dual(kern_t *kernVar, kern_dual_t *z1Dual)
+{
+    /*
+
+        This function calculates the kernel Z1 (see kernels_z1) together with its derivatives with respect to all
+        parameters __KERN_DUAL_...__ in one pass (forward-mode differentiation), i.e.
+
+                z1Dual -> d[__KERN_DUAL_B1__] = dZ1/db1, ...
+
+    */
+
+    _kern_dual_params_t params = _kernels_dual_params(kernVar);
+
+    double mu = kernels_qget_mu(kernVar, 0);
+
+    /* Z1(k1_) = b1 + f mu1^2 */
+    *z1Dual = _kernels_dual_lin(1., params.b1, mu*mu, params.f);
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int kernels_z2_dual(kern_t *kernVar, kern_dual_t *z2Dual)
+{
+    /*
+
+        This function calculates the second order biased density kernel Z2 (see kernels_z2) together with its
+        derivatives with respect to all parameters __KERN_DUAL_...__ in one pass (forward-mode differentiation).
+
+        The scales and angles are treated as in kernels_z2_batch; the derivatives agree with kernels_dz2_a2ga, ...,
+        kernels_dz2_f.
+
+    */
+
+    _kern_dual_params_t params = _kernels_dual_params(kernVar);
+
+    /* Variables */
+    double k1 = kernels_qget_k(kernVar, 0);
+    double k2 = kernels_qget_k(kernVar, 1);
+
+    double mu1 = kernels_qget_mu(kernVar, 0);
+    double mu2 = kernels_qget_mu(kernVar, 1);
+
+    double nu12 = kernels_qget_nu(kernVar, 0, 1);
+
+    /* k12 mu12 and k12^2 (same treatment of k12 -> 0 as in _kernels_work_var_k) */
+    double k12Mu12 = k1 * mu1 + k2 * mu2;
+    double k12Sq = (fabs(k1 - k2) > __ABSTOL__ || fabs(nu12 + 1.) > __ABSTOL__) ? fabs(k1*k1 + k2*k2 + 2. * k1 * k2 * nu12) : __ABSTOL__ * __ABSTOL__;
+
+    double mu12Sq = (k12Sq > __ABSTOL__ * __ABSTOL__) ? k12Mu12 * k12Mu12 / k12Sq : 0.;
+    k12Mu12 = (k12Sq > __ABSTOL__ * __ABSTOL__) ? k12Mu12 : 0.;
+
+    /* β(k1_, k2_) + γ(k1_, k2_) */
+    double beta = nu12 * (nu12 + (k1 / k2 + k2 / k1) / 2.);
+    double gamma = 1. - nu12 * nu12;
+
+    /* F2(k1_, k2_) + G2(k1_, k2_) */
+    kern_dual_t f2 = _kernels_dual_lin(1., _kernels_dual_const(beta), gamma / 2., params.a2Ga);
+    kern_dual_t g2 = _kernels_dual_lin(1., _kernels_dual_const(beta), gamma / 2., params.d2Ga);
+
+    /* Z1(k1_) + Z1(k2_) */
+    kern_dual_t z11 = _kernels_dual_lin(1., params.b1, mu1*mu1, params.f);
+    kern_dual_t z12 = _kernels_dual_lin(1., params.b1, mu2*mu2, params.f);
+
+    /* b1 a^(2)_γ - c^(2)_γ */
+    kern_dual_t cGa = _kernels_dual_lin(1., _kernels_dual_mul(params.b1, params.a2Ga), -1., params.c2Ga);
+
+    /* Z2(k1_, k2_) */
+    kern_dual_t z2 = _kernels_dual_mul(params.b1, f2);
+
+    z2 = _kernels_dual_lin(1., z2, mu12Sq, _kernels_dual_mul(params.f, g2));
+    z2 = _kernels_dual_lin(1., z2, k12Mu12 / 2., _kernels_dual_mul(params.f, _kernels_dual_lin(mu2 / k2, z11, mu1 / k1, z12)));
+    z2 = _kernels_dual_lin(1., z2, - gamma / 2., cGa);
+    z2 = _kernels_dual_lin(1., z2, 1. / 2., params.b2);
+
+    *z2Dual = z2;
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int kernels_z3_dual(kern_t *kernVar, kern_dual_t *z3Dual)
+{
+    /*
+
+        This function calculates the third order biased density kernel Z3 (see kernels_z3) together with its derivatives
+        with respect to all parameters __KERN_DUAL_...__ in one pass (forward-mode differentiation).
+
+        The scales and angles are treated as in kernels_z3_batch; the derivatives agree with kernels_dz3_a2ga, ...,
+        kernels_dz3_f, where the derivative w.r.t. a^(2)_γ is taken at fixed h (see kernels_dz3_h).
+
+    */
+
+    _kern_dual_params_t params = _kernels_dual_params(kernVar);
+
+    /* Coefficients of the F3 and G3 terms (see kernels_btst_h3) */
+    kern_dual_t half = _kernels_dual_scale(0.5, params.a3GaA);
+    kern_dual_t halfD = _kernels_dual_scale(0.5, params.d3GaA);
+
+    kern_dual_t cF3[4] = {_kernels_dual_lin(1. / 6., half, 1. / 6., params.a3GaB),
+                          _kernels_dual_lin(1. / 6., half, - 1. / 6., params.a3GaB),
+                          _kernels_dual_lin(1. / 6., _kernels_dual_lin(1., half, -1., params.a3GaB), - 1. / 3., params.h),
+                          _kernels_dual_lin(1. / 3., _kernels_dual_lin(1., half, -1., params.a3GaB), 1. / 3., _kernels_dual_lin(1., params.a2Ga, -1., params.h))};
+    kern_dual_t cG3[4] = {_kernels_dual_lin(1. / 6., halfD, 1. / 6., params.d3GaB),
+                          _kernels_dual_lin(1. / 6., halfD, - 1. / 6., params.d3GaB),
+                          _kernels_dual_lin(1. / 6., _kernels_dual_lin(1., halfD, -1., params.d3GaB), - 1. / 3., params.h),
+                          _kernels_dual_lin(1. / 3., _kernels_dual_lin(1., halfD, -1., params.d3GaB), 1. / 3., _kernels_dual_lin(1., params.d2Ga, -1., params.h))};
+
+    /* b1 a^(2)_γ - c^(2)_γ */
+    kern_dual_t cGa = _kernels_dual_lin(1., _kernels_dual_mul(params.b1, params.a2Ga), -1., params.c2Ga);
+
+    /* Single wavevectors and their angles nu12, nu13, nu23 */
+    double k[3] = {kernels_qget_k(kernVar, 0), kernels_qget_k(kernVar, 1), kernels_qget_k(kernVar, 2)};
+    double mu[3] = {kernels_qget_mu(kernVar, 0), kernels_qget_mu(kernVar, 1), kernels_qget_mu(kernVar, 2)};
+    double nu[3] = {kernels_qget_nu(kernVar, 0, 1), kernels_qget_nu(kernVar, 0, 2), kernels_qget_nu(kernVar, 1, 2)};
+
+    /* Pairs (a, b) with remaining wavevector c, and the indices of nu_ac and nu_bc (see kernels_z3_batch) */
+    const size_t a[3] = {0, 0, 1};
+    const size_t b[3] = {1, 2, 2};
+    const size_t c[3] = {2, 1, 0};
+
+    const size_t nuAC[3] = {1, 0, 0};
+    const size_t nuBC[3] = {2, 2, 1};
+
+    /* Z1(ki_) */
+    kern_dual_t z1[3];
+
+    for (size_t i = 0; i < 3; i++)
+        z1[i] = _kernels_dual_lin(1., params.b1, mu[i]*mu[i], params.f);
+
+    /* kab = |ka_ + kb_|, muab and nu(kab_, kc_) */
+    double kab[3], muab[3], nuab[3];
+
+    for (size_t p = 0; p < 3; p++)
+      {
+        double ka = k[a[p]];
+        double kb = k[b[p]];
+
+        kab[p] = (fabs(ka - kb) > __ABSTOL__ || fabs(nu[p] + 1.) > __ABSTOL__) ? sqrt( fabs(ka*ka + kb*kb + 2. * ka * kb * nu[p]) ) : __ABSTOL__;
+        muab[p] = (kab[p] > __ABSTOL__) ? (ka * mu[a[p]] + kb * mu[b[p]]) / kab[p] : 0.;
+        nuab[p] = (kab[p] > __ABSTOL__) ? (nu[nuAC[p]] * ka + nu[nuBC[p]] * kb) / kab[p] : 0.;
+      }
+
+    /* k123 = |k12_ + k3_| and mu123 */
+    double k123 = (fabs(kab[0] - k[2]) > __ABSTOL__ || fabs(nuab[0] + 1.) > __ABSTOL__) ?
+                   sqrt( fabs(kab[0]*kab[0] + k[2]*k[2] + 2. * kab[0] * k[2] * nuab[0]) ) : __ABSTOL__;
+    double mu123 = (k123 > __ABSTOL__) ? (kab[0] * muab[0] + k[2] * mu[2]) / k123 : 0.;
+
+    /* f k123 mu123 */
+    kern_dual_t kmu = _kernels_dual_scale(k123 * mu123, params.f);
+
+    /* Sums over the pairs */
+    kern_dual_t zero = _kernels_dual_const(0.);
+
+    kern_dual_t f3 = zero, g3 = zero;
+    kern_dual_t sumZ2 = zero, sumG2Z1 = zero;
+    kern_dual_t sumF2 = zero, sumGaF2 = zero, sumGaF2G2 = zero;
+
+    for (size_t p = 0; p < 3; p++)
+      {
+        double ka = k[a[p]];
+        double kb = k[b[p]];
+        double kc = k[c[p]];
+
+        /* β(ka_, kb_) + γ(ka_, kb_) -> F2(ka_, kb_) + G2(ka_, kb_) */
+        double betaSin = nu[p] * (nu[p] + (ka / kb + kb / ka) / 2.);
+        double gammaSin = 1. - nu[p]*nu[p];
+
+        kern_dual_t f2 = _kernels_dual_lin(1., _kernels_dual_const(betaSin), gammaSin / 2., params.a2Ga);
+        kern_dual_t g2 = _kernels_dual_lin(1., _kernels_dual_const(betaSin), gammaSin / 2., params.d2Ga);
+
+        /* β(kab_, kc_) + α^(a)(kab_, kc_) + γ(kab_, kc_) */
+        double betaSum = nuab[p] * (nuab[p] + (kab[p] / kc + kc / kab[p]) / 2.);
+        double alphaSum = nuab[p] / 2. * (kc / kab[p] - kab[p] / kc);
+        double gammaSum = 1. - nuab[p]*nuab[p];
+
+        /* F3 + G3 (ignoring apparent singularities kab -> 0) */
+        if (kab[p] > __ABSTOL__)
+          {
+            kern_dual_t bb = _kernels_dual_const(betaSum * betaSin / 3.);
+
+            f3 = _kernels_dual_lin(1., f3, 1., bb);
+            f3 = _kernels_dual_lin(1., f3, gammaSum * gammaSin, cF3[0]);
+            f3 = _kernels_dual_lin(1., f3, alphaSum * gammaSin, cF3[1]);
+            f3 = _kernels_dual_lin(1., f3, - betaSum * gammaSin, cF3[2]);
+            f3 = _kernels_dual_lin(1., f3, gammaSum * betaSin, cF3[3]);
+
+            g3 = _kernels_dual_lin(1., g3, 1., bb);
+            g3 = _kernels_dual_lin(1., g3, gammaSum * gammaSin, cG3[0]);
+            g3 = _kernels_dual_lin(1., g3, alphaSum * gammaSin, cG3[1]);
+            g3 = _kernels_dual_lin(1., g3, - betaSum * gammaSin, cG3[2]);
+            g3 = _kernels_dual_lin(1., g3, gammaSum * betaSin, cG3[3]);
+          }
+
+        /* Z2'(ka_, kb_) */
+        kern_dual_t z2 = _kernels_dual_mul(params.b1, f2);
+
+        z2 = _kernels_dual_lin(1., z2, muab[p]*muab[p], _kernels_dual_mul(params.f, g2));
+        z2 = _kernels_dual_lin(1., z2, 1. / 4., _kernels_dual_mul(kmu, _kernels_dual_lin(mu[a[p]] / ka, z1[b[p]], mu[b[p]] / kb, z1[a[p]])));
+        z2 = _kernels_dual_lin(1., z2, - gammaSin / 2., cGa);
+        z2 = _kernels_dual_lin(1., z2, 1. / 2., params.b2);
+
+        sumZ2 = _kernels_dual_lin(1., sumZ2, mu[c[p]] / kc, z2);
+        sumG2Z1 = _kernels_dual_lin(1., sumG2Z1, muab[p] / kab[p], _kernels_dual_mul(g2, z1[c[p]]));
+
+        sumF2 = _kernels_dual_lin(1., sumF2, 1., f2);
+        sumGaF2 = _kernels_dual_lin(1., sumGaF2, gammaSum, f2);
+        sumGaF2G2 = _kernels_dual_lin(1., sumGaF2G2, gammaSum, _kernels_dual_lin(1., f2, -1., g2));
+      }
+
+    /* Z3(k1_, k2_, k3_) */
+    kern_dual_t z3 = _kernels_dual_mul(params.b1, f3);
+
+    z3 = _kernels_dual_lin(1., z3, mu123*mu123, _kernels_dual_mul(params.f, g3));
+    z3 = _kernels_dual_lin(1., z3, 1. / 3., _kernels_dual_mul(kmu, _kernels_dual_lin(1., sumZ2, 1., sumG2Z1)));
+    z3 = _kernels_dual_lin(1., z3, 1. / 3., _kernels_dual_mul(params.b2, sumF2));
+    z3 = _kernels_dual_lin(1., z3, - 1. / 3., _kernels_dual_mul(cGa, sumGaF2));
+    z3 = _kernels_dual_lin(1., z3, - 2. / 3., _kernels_dual_mul(params.bGam3, sumGaF2G2));
+
+    *z3Dual = z3;
+
+    return 0;
+}
+
+
+
+
 /*  ------------------------------------------------------------------------------------------------------  */
 /*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
 /*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
@@ -10004,6 +10004,311 @@ static mat_t *_mat_inv_cov_b(mat_t *inv(mat_t*, mat_reduce_t*), mat_t *mat)
 
 
 
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ----------------------------------   Covariance Factorisation   --------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ####################################   Function Declarations   #######################################  */
+
+static bool _mat_fact_diag(mat_t *mat);
+
+/*  ######################################################################################################  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+mat_fact_t *mat_fact_cov(mat_t *mat)
+{
+    /*
+
+        Factorise a covariance matrix (mat) for repeated solves C X = B without forming C^-1
+
+        The correlation matrix R is Cholesky factorised (dpotrf). If R is not numerically positive definite, a
+        pivoted UDU^T factorisation (dsytrf) is used instead. Returns NULL if the factorisation fails.
+
+    */
+
+    /* Check dimensions */
+    size_t fdim[2];
+    mat_get_fdim(mat, fdim);
+
+    if (fdim[0] != fdim[1])
+      {
+        printf("Cannot factorise a non-square covariance matrix.\n");
+        exit(1);
+
+        return NULL;
+      }
+
+    /* Factorisation */
+    mat_fact_t *fact = malloc(sizeof(mat_fact_t));
+
+    fact -> dim = fdim[0];
+    fact -> scale = malloc(sizeof(double) * fdim[0]);
+    fact -> factor = NULL;
+    fact -> ipiv = NULL;
+
+    /* Inverse standard deviations */
+    for (size_t i = 0; i < fdim[0]; i++)
+      {
+        size_t loc[2] = {i, i};
+        double val = mat_get_value(mat, loc);
+
+        if (!(val > 0.))
+          {
+            printf("Covariance matrix has a non-positive variance (%e) at index %ld.\n", val, i);
+
+            fact = mat_fact_free(fact);
+
+            return NULL;
+          }
+
+        fact -> scale[i] = 1. / sqrt(val);
+      }
+
+    /* Diagonal matrix (R = 1) */
+    if (_mat_fact_diag(mat))
+      {
+        return fact;
+      }
+
+
+    /* LAPACK VARIABLES */
+
+    /* Dimensions of matrix */
+    int laN = (int) fdim[0];
+
+    /* Leading dimension of A */
+    int laLDA = laN;
+
+    /* Upper triangle */
+    char laUPLO = 'U';
+
+    /* INFO == 0 (success), == -i (i-th argument had illegal value, == i (algorithm failed...)) */
+    int laINFO;
+
+
+    /* Correlation matrix (full and symmetric, i.e. row- and column-major agree) */
+    mat_t *matCorr = mat_corr(mat, NULL);
+    mat_t *matCorrFull = mat_trafo(matCorr, _matTypeF.id, fdim, false, NULL);
+
+    matCorr = mat_free(matCorr);
+
+    fact -> factor = malloc(sizeof(double) * fdim[0] * fdim[1]);
+    memcpy(fact -> factor, matCorrFull -> matrix, sizeof(double) * fdim[0] * fdim[1]);
+
+    /* Cholesky decomposition */
+    dpotrf_(&laUPLO, &laN, fact -> factor, &laLDA, &laINFO);
+
+    /* Not positive definite: pivoted UDU decomposition */
+    if (laINFO > 0)
+      {
+        memcpy(fact -> factor, matCorrFull -> matrix, sizeof(double) * fdim[0] * fdim[1]);
+
+        fact -> ipiv = malloc(sizeof(int) * fdim[0]);
+
+        /* Workspace query */
+        int laLWORK = -1;
+        double laWORKSize;
+
+        dsytrf_(&laUPLO, &laN, fact -> factor, &laLDA, fact -> ipiv, &laWORKSize, &laLWORK, &laINFO);
+
+        laLWORK = (int) laWORKSize;
+        double *laWORK = malloc(sizeof(double) * ((size_t) laLWORK));
+
+        dsytrf_(&laUPLO, &laN, fact -> factor, &laLDA, fact -> ipiv, laWORK, &laLWORK, &laINFO);
+
+        free(laWORK);
+
+        if (laINFO != 0)
+          {
+            printf("UDU decomposition failed.\n");
+            printf("LAPACK output : %d\n", laINFO);
+
+            fact = mat_fact_free(fact);
+          }
+      }
+
+    else if (laINFO < 0)
+      {
+        printf("Cholesky decomposition failed.\n");
+        printf("LAPACK output : %d\n", laINFO);
+
+        fact = mat_fact_free(fact);
+      }
+
+    /* Free memory */
+    matCorrFull = mat_free(matCorrFull);
+
+    return fact;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+mat_fact_t *mat_fact_free(mat_fact_t *fact)
+{
+    /*
+
+        Free a covariance factorisation (fact)
+
+    */
+
+    if (fact == NULL)
+        return NULL;
+
+    free(fact -> scale);
+    free(fact -> factor);
+    free(fact -> ipiv);
+
+    free(fact);
+
+    return NULL;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+mat_t *mat_fact_solve_ip(mat_fact_t *fact, mat_t *mat)
+{
+    /*
+
+        Overwrite an ordinary matrix B (mat) with C^-1 B, using the factorisation (fact) of C
+
+        C^-1 B = S^-1 R^-1 S^-1 B, with the (column-major) solve R X = S^-1 B done by dpotrs or dsytrs.
+
+    */
+
+    /* Check dimensions */
+    if (mat -> mblock != NULL || mat -> dim[0] != fact -> dim)
+      {
+        printf("Cannot solve for a block matrix or a matrix with %ld rows given a factorisation with dimension %ld.\n", mat -> dim[0], fact -> dim);
+        exit(1);
+
+        return NULL;
+      }
+
+    /* Full matrix */
+    if (mat -> mtype != &_matTypeF)
+      {
+        mat = mat_trafo_ip(mat, _matTypeF.id, mat -> dim, false, NULL);
+      }
+
+    size_t dim = mat -> dim[0];
+    size_t nrhs = mat -> dim[1];
+
+    double *matB = mat -> matrix;
+
+    /* S^-1 B */
+    for (size_t i = 0; i < dim; i++)
+      {
+        for (size_t j = 0; j < nrhs; j++)
+            matB[i * nrhs + j] *= fact -> scale[i];
+      }
+
+    /* R^-1 S^-1 B */
+    if (fact -> factor != NULL)
+      {
+        /* LAPACK VARIABLES */
+
+        int laN = (int) dim;
+        int laNRHS = (int) nrhs;
+
+        int laLDA = laN;
+        int laLDB = laN;
+
+        char laUPLO = 'U';
+
+        int laINFO;
+
+        /* Right-hand side (column-major) */
+        double *laB = malloc(sizeof(double) * dim * nrhs);
+
+        for (size_t i = 0; i < dim; i++)
+          {
+            for (size_t j = 0; j < nrhs; j++)
+                laB[j * dim + i] = matB[i * nrhs + j];
+          }
+
+        /* Cholesky factor */
+        if (fact -> ipiv == NULL)
+          {
+            dpotrs_(&laUPLO, &laN, &laNRHS, fact -> factor, &laLDA, laB, &laLDB, &laINFO);
+          }
+
+        /* UDU factor */
+        else
+          {
+            dsytrs_(&laUPLO, &laN, &laNRHS, fact -> factor, &laLDA, fact -> ipiv, laB, &laLDB, &laINFO);
+          }
+
+        if (laINFO != 0)
+          {
+            printf("Solving with the covariance factorisation failed.\n");
+            printf("LAPACK output : %d\n", laINFO);
+            exit(1);
+
+            return NULL;
+          }
+
+        for (size_t i = 0; i < dim; i++)
+          {
+            for (size_t j = 0; j < nrhs; j++)
+                matB[i * nrhs + j] = laB[j * dim + i];
+          }
+
+        /* Free memory */
+        free(laB);
+      }
+
+    /* S^-1 R^-1 S^-1 B */
+    for (size_t i = 0; i < dim; i++)
+      {
+        for (size_t j = 0; j < nrhs; j++)
+            matB[i * nrhs + j] *= fact -> scale[i];
+      }
+
+    return mat;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static bool _mat_fact_diag(mat_t *mat)
+{
+    /*
+
+        Test if a (block) matrix only has (block) diagonal elements down to its last level
+
+    */
+
+    if (mat -> mtype != &_matTypeD && mat -> mtype != &_matTypeNull)
+        return false;
+
+    if (mat -> mblock == NULL)
+        return true;
+
+    bool diag = true;
+
+    for (size_t i = 0; i < mat -> dim[0] && diag; i++)
+      {
+        size_t loc[2] = {i, i};
+        mat_t *matBlock = mat_fget_block(mat, loc);
+
+        diag = (matBlock == NULL) || _mat_fact_diag(matBlock);
+
+        matBlock = mat_ffree(matBlock);
+      }
+
+    return diag;
+}
+
+
+
 
 
 /*  ------------------------------------------------------------------------------------------------------  */
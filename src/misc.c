@@ -1192,6 +1192,66 @@ size_t misc_multinom(size_t n, size_t *m, size_t size)
 
 
 
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%     COMPENSATED SUMMATION     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int misc_csum_add(misc_csum_t *csum, double value)
+{
+    /*
+
+        Add value to the compensated sum csum (Neumaier's variant of Kahan summation)
+
+    */
+
+    double sum = csum -> sum + value;
+
+    /* Low-order bits lost in the addition */
+    if (fabs(csum -> sum) >= fabs(value))
+        csum -> comp += (csum -> sum - sum) + value;
+
+    else
+        csum -> comp += (value - sum) + csum -> sum;
+
+    csum -> sum = sum;
+
+    return 0;
+}
+
+
+int misc_csum_merge(misc_csum_t *csum1, misc_csum_t *csum2)
+{
+    /*
+
+        Add the compensated sum csum2 to csum1
+
+    */
+
+    misc_csum_add(csum1, csum2 -> sum);
+
+    csum1 -> comp += csum2 -> comp;
+
+    return 0;
+}
+
+
+double misc_csum_get(misc_csum_t *csum)
+{
+    /*
+
+        Value of the compensated sum csum
+
+    */
+
+    return csum -> sum + csum -> comp;
+}
+
+
+
+
 /*  ------------------------------------------------------------------------------------------------------  */
 /*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
 /*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%     TIME     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
@@ -67,6 +67,12 @@ typedef struct
     size_t loopOrder; // Can change this
     intgrt_t **loopIntgrt; // Can change this
 
+    bool loopSymP22; // Can change this
+
+    bool loopRadial; // Can change this
+    intgrt_t *loopRadialIntgrt; // Can change this
+    gsl_integration_glfixed_table *loopRadialTable; // Gauss-Legendre nodes in nu of the radial integrand
+
     size_t partsSize;
 
     char **partsLabels;
@@ -149,6 +155,11 @@ static _spec_info_t *_spec_info_free(_spec_info_t *info)
 
     free(info -> loopIntgrt);
 
+    info -> loopRadialIntgrt = integrate_free(info -> loopRadialIntgrt);
+
+    if (info -> loopRadialTable != NULL)
+        gsl_integration_glfixed_table_free(info -> loopRadialTable);
+
     /* Parts variables */
     free(info -> partsLabels);
     free(info -> partsExist);
@@ -216,6 +227,57 @@ int spec_info_set_loop_order(const char *id, size_t loopOrder)
 }
 
 
+int spec_info_set_loop_sym_p22(const char *id, bool loopSymP22)
+{
+    /*
+
+        Integrate the one-loop P22 contribution of the power spectrum with the IR-safe integrand (see
+        integrand_spec_pnl_p22_sym_1loop), which has a much smaller variance than the default one.
+
+    */
+
+    _spec_info_t *info = _spec_info_get_struct(id);
+
+    if (info != _pnlInfo)
+      {
+        printf("Only the one-loop P22 contribution of the power spectrum ('%s') can be integrated with the IR-safe integrand.\n", _idSpecPnl_);
+        exit(1);
+
+        return 1;
+      }
+
+    info -> loopSymP22 = loopSymP22;
+
+    return 0;
+}
+
+
+int spec_info_set_loop_radial(const char *id, bool loopRadial)
+{
+    /*
+
+        Integrate the one-loop P13 contributions of a spectrum over the angles first (see
+        integrand_spec_p13_radial_1loop), so that only a 1d integral in q remains, which is computed with the
+        integrate struct from spec_info_get_loop_radial_integrate. The 3d integral is kept for validation.
+
+    */
+
+    _spec_info_t *info = _spec_info_get_struct(id);
+
+    if (info -> loopRadialIntgrt == NULL)
+      {
+        printf("Spectrum with ID '%s' has no one-loop P13 contribution that can be integrated radially.\n", id);
+        exit(1);
+
+        return 1;
+      }
+
+    info -> loopRadial = loopRadial;
+
+    return 0;
+}
+
+
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
@@ -269,6 +331,48 @@ intgrt_t *spec_info_get_loop_integrate(const char *id, size_t loopOrder)
 }
 
 
+bool spec_info_get_loop_sym_p22(const char *id)
+{
+    /*
+
+        Check if the one-loop P22 contribution of a spectrum is integrated with the IR-safe integrand
+
+    */
+
+    _spec_info_t *info = _spec_info_get_struct(id);
+
+    return info -> loopSymP22;
+}
+
+
+bool spec_info_get_loop_radial(const char *id)
+{
+    /*
+
+        Check if the one-loop P13 contributions of a spectrum are integrated radially
+
+    */
+
+    _spec_info_t *info = _spec_info_get_struct(id);
+
+    return info -> loopRadial;
+}
+
+
+intgrt_t *spec_info_get_loop_radial_integrate(const char *id)
+{
+    /*
+
+        Get the integrate struct of the radial one-loop P13 integrals (NULL if there are none)
+
+    */
+
+    _spec_info_t *info = _spec_info_get_struct(id);
+
+    return info -> loopRadialIntgrt;
+}
+
+
 size_t spec_info_get_kern_order(const char *id)
 {
     /*
@@ -295,7 +399,14 @@ static const double _pnlOneLoopIntgrtUpperBounds[3] = {8., 1., 2. * M_PI};
 static const double _pnlOneLoopIntgrtLowerBounds[3] = {0.0001, -1., 0.};
 static const char* _pnlOneLoopIntgrtRoutine = "vegas";
 static const intgrt_vegas_t _pnlOneLoopIntgrtVegas = {10000, 1000, 1., 10, 0.5, 0., 0};
-static const intgrt_divonne_t _pnlOneLoopIntgrtDivonne = {1, 1, 1.e-3, 1.e-12, 0, 0, 50000, 47, 1, 1, 5, 0., 10., 0.25, 0};
+static const intgrt_divonne_t _pnlOneLoopIntgrtDivonne = {1, 64, 1.e-3, 1.e-12, 0, 0, 50000, 47, 1, 1, 5, 0., 10., 0.25, 0};
+static const intgrt_qmc_t _pnlOneLoopIntgrtQMC = {1024, 65536, 8, 1.e-3, 0, 0};
+static const intgrt_cubature_t _pnlOneLoopIntgrtCubature = {1.e-4, 0., 100000, 0};
+
+static const bool _pnlOneLoopSymP22 = false;
+
+static const bool _pnlOneLoopRadial = false;
+static const intgrt_cquad_t _pnlOneLoopRadialIntgrtCQUAD = {1.e-5, 0., 1000};
 
 /* Part Labels */
 static const char *_pnlLabelTree = NULL;
@@ -315,6 +426,11 @@ static const double _dpnlOneLoopIntgrtLowerBounds[3] = {0.0001, -1., 0.};
 static const char *_dpnlOneLoopIntgrtRoutine = "vegas";
 static const intgrt_vegas_t _dpnlOneLoopIntgrtVegas = {10000, 1000, 1., 10, 0.5, 0., 0};
 static const intgrt_divonne_t _dpnlOneLoopIntgrtDivonne = {1, 1, 1.e-3, 1.e-12, 0, 0, 50000, 47, 1, 1, 5, 0., 10., 0.25, 0};
+static const intgrt_qmc_t _dpnlOneLoopIntgrtQMC = {1024, 65536, 8, 1.e-3, 0, 0};
+static const intgrt_cubature_t _dpnlOneLoopIntgrtCubature = {1.e-4, 0., 100000, 0};
+
+static const bool _dpnlOneLoopRadial = false;
+static const intgrt_cquad_t _dpnlOneLoopRadialIntgrtCQUAD = {1.e-5, 0., 1000};
 
 /* Part Labels */
 static const char *_dpnlLabelA2Ga = NULL;
@@ -483,6 +599,192 @@ static double **_dpnlK1LoopBin;
 static double **_dpnlMu1LoopBin;
 
 
+/**  Loop integrals as polynomials in mu^2  **/
+
+/* Number of coefficients (the one-loop integrals are polynomials of degree 4 in mu^2) */
+#ifndef __SPEC_MU_POLY_SIZE__
+#define __SPEC_MU_POLY_SIZE__ 5
+#endif
+
+/* Number of integrands that can be stored per thread */
+#ifndef __SPEC_MU_POLY_SLOTS__
+#define __SPEC_MU_POLY_SLOTS__ 16
+#endif
+
+typedef struct
+{
+    /*
+
+        Loop integral at fixed (z, k) as a polynomial in mu^2, stored by its values at the Chebyshev-Lobatto nodes in
+        mu^2 in [0, 1]
+
+    */
+
+    /* Integrand (both NULL if the slot is empty) */
+    double (*integrand)(double*, size_t, void*);
+    int (*integrandVec)(double*, size_t, void*, double*);
+
+    /* Variables and fiducials the polynomial was computed for */
+    double z;
+    double k;
+
+    fid_btst_t btst;
+    fid_bias_t bias;
+    fid_rsd_t rsd;
+
+    /* Values and integration errors at the nodes (for every component of integrandVec) */
+    bool computed;
+
+    double values[__INTGRND_DPNL_SIZE__][__SPEC_MU_POLY_SIZE__];
+    double errors[__INTGRND_DPNL_SIZE__][__SPEC_MU_POLY_SIZE__];
+
+    double info[__INTGRND_DPNL_SIZE__];
+
+} _spec_mu_poly_t;
+
+
+static _spec_mu_poly_t **_loopMuPoly;
+
+/* Components of the power spectrum derivatives that are integrated in the same sweep (see integrand_spec_dpnl_1loop_vec) */
+static bool _dpnlLoopComp[__INTGRND_DPNL_SIZE__];
+
+
+/**  Warm-started VEGAS grids of the loop integrals  **/
+
+/* Width of the cells in (log k, mu) within which an adapted grid is reused */
+#ifndef __SPEC_VEGAS_GRID_DLOGK__
+#define __SPEC_VEGAS_GRID_DLOGK__ 0.1
+#endif
+
+#ifndef __SPEC_VEGAS_GRID_DMU__
+#define __SPEC_VEGAS_GRID_DMU__ 0.25
+#endif
+
+/* Number of grids that can be stored per thread */
+#ifndef __SPEC_VEGAS_GRID_SLOTS__
+#define __SPEC_VEGAS_GRID_SLOTS__ 32
+#endif
+
+typedef struct
+{
+    /*
+
+        VEGAS grid adapted to a loop integrand in a cell of (log k, mu)
+
+    */
+
+    /* Integrand (NULL if the slot is empty) */
+    double (*integrand)(double*, size_t, void*);
+
+    /* Cell */
+    long cellK;
+    long cellMu;
+
+    /* Grid */
+    intgrt_vegas_grid_t *grid;
+
+} _spec_vegas_grid_t;
+
+
+static _spec_vegas_grid_t **_loopVegasGrid;
+static size_t *_loopVegasGridNext;
+
+
+/**  Tabulated loop contributions  **/
+
+/* Number of nodes of the Lagrange stencils in log(k) (cubic) and in mu^2 (quartic, the one-loop power spectrum is a
+   polynomial of degree 4 in mu^2) */
+#define __SPEC_TABLE_STENCIL_K__ 4
+#define __SPEC_TABLE_STENCIL_MU__ 5
+
+
+typedef struct
+{
+    /*
+
+        Loop contributions at fixed redshift tabulated on a grid uniform in log(k) and mu^2
+
+    */
+
+    /* Redshift */
+    double z;
+
+    /* Bootstrap parameters at z (tables of the bias and RSD basis are valid for any z with these parameters) */
+    fid_btst_t btst;
+    bool basis;
+
+    /* Bias and RSD parameters at z (other tables are only valid for these parameters) */
+    fid_bias_t bias;
+    fid_rsd_t rsd;
+
+    /* Grid */
+    size_t kSize;
+    size_t muSize;
+
+    double logkMin;
+    double logkMax;
+
+    /* Values and integration errors of every part (without growth and smoothing), stored as [kSize * muSize] */
+    size_t partsSize;
+
+    double **values;
+    double **errors;
+
+} _spec_table_t;
+
+
+typedef struct
+{
+    /*
+
+        Interpolation stencils of a point on a _spec_table_t grid (shared by all parts of the table)
+
+    */
+
+    /* Lagrange stencils (values) */
+    size_t indexX;
+    size_t indexY;
+
+    double weightsX[__SPEC_TABLE_STENCIL_K__];
+    double weightsY[__SPEC_TABLE_STENCIL_MU__];
+
+    /* Linear stencils (errors) */
+    size_t indexErrX;
+    size_t indexErrY;
+
+    double tX;
+    double tY;
+
+} _spec_table_point_t;
+
+
+/* Power spectrum tables (one for each redshift, or for each set of bootstrap parameters if the basis is used) */
+static _spec_table_t **_pnlTable;
+static size_t _pnlTableSize;
+
+static bool _pnlTableBasis;
+
+/* Power spectrum table parts */
+static const size_t _pnlTablePartsSize = 2;
+
+static const size_t _pnlTableP22 = 0;
+static const size_t _pnlTableP13 = 1;
+
+/* Power spectrum table parts of the bias and RSD basis (symmetric pairs of Z2 monomials followed by the Z3 monomials) */
+static const size_t _pnlTableBasisP22Size = __KERN_Z2_BASIS_SIZE__ * (__KERN_Z2_BASIS_SIZE__ + 1) / 2;
+static const size_t _pnlTableBasisP13Size = __KERN_Z3_BASIS_SIZE__;
+
+/* Z3 monomials which vanish in P13 after renormalisation of b2 (b2 and f b2) */
+static const bool _pnlTableBasisP13Renorm[__KERN_Z3_BASIS_SIZE__] = {false, true, false, false, false, false, true, false, false, false, false};
+
+/* Power spectrum table grid */
+static size_t _pnlTableKSize;
+static double _pnlTableKMin;
+static double _pnlTableKMax;
+
+static size_t _pnlTableMuSize;
+
+
 
 /*  ------------------------------------------------------------------------------------------------------  */
 /*  -----------------------------------   Initialise Local Variables   -----------------------------------  */
@@ -495,6 +797,7 @@ static double **_dpnlMu1LoopBin;
 static int _ini_labels(void);
 static int _ini_info(void);
 static int _ini_bin(void);
+static int _ini_table(void);
 static int _ini_interp(void);
 static int _ini_func(void);
 
@@ -520,6 +823,9 @@ int spec_ini(void)
     /* Initialise integration bins */
     _ini_bin();
 
+    /* Initialise the tabulated loop contributions */
+    _ini_table();
+
     /* Initialise the interpolation of spectra */
     _ini_interp();
 
@@ -809,6 +1115,24 @@ static int _ini_info_pnl(void)
 
     integrate_set_vegas(_pnlInfo -> loopIntgrt[0], (intgrt_vegas_t*) &_pnlOneLoopIntgrtVegas);
     integrate_set_divonne(_pnlInfo -> loopIntgrt[0], (intgrt_divonne_t*) &_pnlOneLoopIntgrtDivonne);
+    integrate_set_qmc(_pnlInfo -> loopIntgrt[0], (intgrt_qmc_t*) &_pnlOneLoopIntgrtQMC);
+    integrate_set_cubature(_pnlInfo -> loopIntgrt[0], (intgrt_cubature_t*) &_pnlOneLoopIntgrtCubature);
+
+    /* 1 - loop P22 with the IR-safe integrand */
+    _pnlInfo -> loopSymP22 = _pnlOneLoopSymP22;
+
+    /* 1 - loop P13 as a radial integral */
+    _pnlInfo -> loopRadial = _pnlOneLoopRadial;
+    _pnlInfo -> loopRadialIntgrt = integrate_new();
+
+    integrate_set_dim(_pnlInfo -> loopRadialIntgrt, 1);
+    integrate_set_bounds_upper(_pnlInfo -> loopRadialIntgrt, (double*) _pnlOneLoopIntgrtUpperBounds);
+    integrate_set_bounds_lower(_pnlInfo -> loopRadialIntgrt, (double*) _pnlOneLoopIntgrtLowerBounds);
+
+    integrate_set_routine(_pnlInfo -> loopRadialIntgrt, _idIntgrtCQUAD_);
+    integrate_set_cquad(_pnlInfo -> loopRadialIntgrt, (intgrt_cquad_t*) &_pnlOneLoopRadialIntgrtCQUAD);
+
+    _pnlInfo -> loopRadialTable = gsl_integration_glfixed_table_alloc(__INTGRND_RADIAL_NU_SIZE__);
 
 
     /**  Parts of the Power Spectrum  **/
@@ -891,6 +1215,24 @@ static int _ini_info_dpnl(void)
 
     integrate_set_vegas(_dpnlInfo -> loopIntgrt[0], (intgrt_vegas_t*) &_dpnlOneLoopIntgrtVegas);
     integrate_set_divonne(_dpnlInfo -> loopIntgrt[0], (intgrt_divonne_t*) &_dpnlOneLoopIntgrtDivonne);
+    integrate_set_qmc(_dpnlInfo -> loopIntgrt[0], (intgrt_qmc_t*) &_dpnlOneLoopIntgrtQMC);
+    integrate_set_cubature(_dpnlInfo -> loopIntgrt[0], (intgrt_cubature_t*) &_dpnlOneLoopIntgrtCubature);
+
+    /* 1 - loop P22 with the IR-safe integrand (only for the power spectrum itself) */
+    _dpnlInfo -> loopSymP22 = false;
+
+    /* 1 - loop P13 as a radial integral */
+    _dpnlInfo -> loopRadial = _dpnlOneLoopRadial;
+    _dpnlInfo -> loopRadialIntgrt = integrate_new();
+
+    integrate_set_dim(_dpnlInfo -> loopRadialIntgrt, 1);
+    integrate_set_bounds_upper(_dpnlInfo -> loopRadialIntgrt, (double*) _dpnlOneLoopIntgrtUpperBounds);
+    integrate_set_bounds_lower(_dpnlInfo -> loopRadialIntgrt, (double*) _dpnlOneLoopIntgrtLowerBounds);
+
+    integrate_set_routine(_dpnlInfo -> loopRadialIntgrt, _idIntgrtCQUAD_);
+    integrate_set_cquad(_dpnlInfo -> loopRadialIntgrt, (intgrt_cquad_t*) &_dpnlOneLoopRadialIntgrtCQUAD);
+
+    _dpnlInfo -> loopRadialTable = gsl_integration_glfixed_table_alloc(__INTGRND_RADIAL_NU_SIZE__);
 
 
     /**  Parts of the Power Spectrum  **/
@@ -1132,6 +1474,12 @@ static int _ini_info_btr(void)
 
     _btrInfo -> loopIntgrt = malloc(sizeof(intgrt_t*) * _btrInfo -> loopOrderMax);
 
+    _btrInfo -> loopSymP22 = false;
+
+    _btrInfo -> loopRadial = false;
+    _btrInfo -> loopRadialIntgrt = NULL;
+    _btrInfo -> loopRadialTable = NULL;
+
 
     /**  Parts of the Bispectrum  **/
 
@@ -1187,6 +1535,12 @@ static int _ini_info_dbtr(void)
 
     _dbtrInfo -> loopIntgrt = malloc(sizeof(intgrt_t*) * _dbtrInfo -> loopOrderMax);
 
+    _dbtrInfo -> loopSymP22 = false;
+
+    _dbtrInfo -> loopRadial = false;
+    _dbtrInfo -> loopRadialIntgrt = NULL;
+    _dbtrInfo -> loopRadialTable = NULL;
+
 
     /**  Parts of the Bispectrum  **/
 
@@ -1425,6 +1779,12 @@ static int _ini_info_ttr(void)
 
     _ttrInfo -> loopIntgrt = malloc(sizeof(intgrt_t*) * _ttrInfo -> loopOrderMax);
 
+    _ttrInfo -> loopSymP22 = false;
+
+    _ttrInfo -> loopRadial = false;
+    _ttrInfo -> loopRadialIntgrt = NULL;
+    _ttrInfo -> loopRadialTable = NULL;
+
 
     /**  Parts of the Trispectrum  **/
 
@@ -1473,6 +1833,42 @@ static int _ini_bin(void)
     _dpnlK1LoopBin = NULL;
     _dpnlMu1LoopBin = NULL;
 
+    _loopMuPoly = NULL;
+
+    _loopVegasGrid = NULL;
+    _loopVegasGridNext = NULL;
+
+    for (size_t i = 0; i < __INTGRND_DPNL_SIZE__; i++)
+        _dpnlLoopComp[i] = false;
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static int _ini_table(void)
+{
+    /*
+
+        Initialise the tables of the loop contributions (nothing is tabulated by default)
+
+    */
+
+    /* Power spectrum */
+    _pnlTable = NULL;
+    _pnlTableSize = 0;
+
+    _pnlTableBasis = false;
+
+    _pnlTableKSize = 64;
+    _pnlTableKMin = 1.e-3;
+    _pnlTableKMax = 0.5;
+
+    _pnlTableMuSize = 9;
+
     return 0;
 }
 
@@ -1534,9 +1930,9 @@ static int _ini_interp_pnl(void)
     /* Interpolation functions */
     _pnlInterpIn[0] -> interp = NULL;
 
-    _pnlInterpIn[0] -> interpInit = interpolate_interp_init_splinter;
-    _pnlInterpIn[0] -> interpEval = interpolate_interp_eval_splinter;
-    _pnlInterpIn[0] -> interpFree = interpolate_interp_free_splinter;
+    _pnlInterpIn[0] -> interpInit = interpolate_interp_init_grid;
+    _pnlInterpIn[0] -> interpEval = interpolate_interp_eval_grid;
+    _pnlInterpIn[0] -> interpFree = interpolate_interp_free_grid;
 
     return 0;
 }
@@ -1589,9 +1985,9 @@ static int _ini_interp_dpnl(void)
       {
         _dpnlInterpIn[i] -> interp = NULL;
 
-        _dpnlInterpIn[i] -> interpInit = interpolate_interp_init_splinter;
-        _dpnlInterpIn[i] -> interpEval = interpolate_interp_eval_splinter;
-        _dpnlInterpIn[i] -> interpFree = interpolate_interp_free_splinter;
+        _dpnlInterpIn[i] -> interpInit = interpolate_interp_init_grid;
+        _dpnlInterpIn[i] -> interpEval = interpolate_interp_eval_grid;
+        _dpnlInterpIn[i] -> interpFree = interpolate_interp_free_grid;
       }
 
     return 0;
@@ -1949,6 +2345,7 @@ static int _ini_func_poly(void)
 
 static int _free_labels(void);
 static int _free_info(void);
+static int _free_table(void);
 static int _free_interp(void);
 
 /*  ######################################################################################################  */
@@ -1969,6 +2366,9 @@ int spec_free(void)
     /* Free info */
     _free_info();
 
+    /* Free tables */
+    _free_table();
+
     /* Free interp */
     _free_interp();
 
@@ -2288,6 +2688,25 @@ static int _free_info(void)
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
+static int _free_table(void)
+{
+    /*
+
+        Free the tables of the loop contributions
+
+    */
+
+    /* Power spectrum */
+    spec_table_pnl_free();
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
 /*  ------------------------------------------------------------------------------------------------------  */
 /*  ####################################   Function Declarations   #######################################  */
 
@@ -2479,6 +2898,15 @@ static double _spec_pnl_extrapolate(void *var, void *interp, void *params, size_
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ####################################   Function Declarations   #######################################  */
+
+static int _in_setup_interp(_spec_interp_t *specInterp, dat_t *dat, double (*extrapolate)(void*, void*, void*, size_t*, size_t));
+
+/*  ######################################################################################################  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
 int spec_in_pnl_setup(void)
 {
     /*
@@ -2494,8 +2922,7 @@ int spec_in_pnl_setup(void)
     dat_t *datPnl = dat_input(path, _pnlLabelIn, _true_);
 
     /* Interpolate the data */
-    _pnlInterpInPnl.interp = interpolate_interp_free(_pnlInterpInPnl.interpFree, _pnlInterpInPnl.interp);
-    _pnlInterpInPnl.interp = interpolate_interp_init(_pnlInterpInPnl.interpInit, datPnl, _spec_pnl_extrapolate);
+    _in_setup_interp(&_pnlInterpInPnl, datPnl, _spec_pnl_extrapolate);
 
     /* Free memory */
     free(path);
@@ -2538,14 +2965,8 @@ int spec_in_dpnl_setup(void)
         /* Get the data with current label and additional x dimension depending on multiplicity */
         dat_t *datDPnlSub = _in_dpnl_setup_dat(datDPnl, _dpnlInfo -> partsLabels[i]);
 
-        /* Free any previous interpolation structs */
-        _dpnlInterpIn[i] -> interp = interpolate_interp_free(_dpnlInterpIn[i] -> interpFree, _dpnlInterpIn[i] -> interp);
-
-        /* Interpolate the data if it was found in the file */
-        if (datDPnlSub != NULL)
-          {
-            _dpnlInterpIn[i] -> interp = interpolate_interp_init(_dpnlInterpIn[i] -> interpInit, datDPnlSub, NULL);
-          }
+        /* Interpolate the data if it was found in the file (otherwise only free any previous interpolation structs) */
+        _in_setup_interp(_dpnlInterpIn[i], datDPnlSub, NULL);
 
         datDPnlSub = dat_free(datDPnlSub);
       }
@@ -2723,638 +3144,868 @@ static dat_t *_in_dpnl_setup_dat(dat_t *datDPnl, char *label)
 }
 
 
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static int _in_setup_interp(_spec_interp_t *specInterp, dat_t *dat, double (*extrapolate)(void*, void*, void*, size_t*, size_t))
+{
+    /*
+
+        Free any previous interpolation struct of specInterp and interpolate the data (if not NULL): tables on a regular
+        grid (as written by this code) use interpolate_interp_init_grid, anything else falls back to SPLINTER
+
+    */
+
+    specInterp -> interp = interpolate_interp_free(specInterp -> interpFree, specInterp -> interp);
+
+    if (dat == NULL)
+        return 0;
+
+    /* Regular grid */
+    specInterp -> interpInit = interpolate_interp_init_grid;
+    specInterp -> interpEval = interpolate_interp_eval_grid;
+    specInterp -> interpFree = interpolate_interp_free_grid;
+
+    specInterp -> interp = interpolate_interp_init(specInterp -> interpInit, dat, extrapolate);
+
+    if (specInterp -> interp != NULL)
+        return 0;
+
+    /* Scattered data */
+    specInterp -> interpInit = interpolate_interp_init_splinter;
+    specInterp -> interpEval = interpolate_interp_eval_splinter;
+    specInterp -> interpFree = interpolate_interp_free_splinter;
+
+    specInterp -> interp = interpolate_interp_init(specInterp -> interpInit, dat, extrapolate);
+
+    return 0;
+}
+
+
 
 
 
 /*  ------------------------------------------------------------------------------------------------------  */
 /*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
-/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%     SPECTRA STRUCTS     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%     TABULATED SPECTRA     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
 /*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
 /*  ------------------------------------------------------------------------------------------------------  */
-/*  ---------------------------------------   Derivative Struct   ----------------------------------------  */
+/*  --------------------------------------------   Setters   ---------------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-spec_deriv_t *spec_deriv_new(void)
+int spec_table_pnl_set_k(size_t size, double kMin, double kMax)
 {
     /*
 
-        Create a new derivative struct.
+        Set the k grid (uniform in log(k)) of the power spectrum tables
 
     */
 
-    spec_deriv_t *deriv = malloc(sizeof(spec_deriv_t));
+    /* Need at least 4 points for the cubic interpolation */
+    if (size < __SPEC_TABLE_STENCIL_K__)
+      {
+        printf("The k grid of the power spectrum tables must have at least %d points.\n", __SPEC_TABLE_STENCIL_K__);
+        exit(1);
 
-    /* Some initial values */
-    deriv -> z = 0.;
-    deriv -> k = 0.;
-    deriv -> mu = 0.;
+        return 1;
+      }
 
-    deriv -> log = _false_;
+    if (kMin <= 0. || kMax <= kMin)
+      {
+        printf("The k grid of the power spectrum tables must satisfy 0 < kMin < kMax.\n");
+        exit(1);
 
-    return deriv;
+        return 1;
+      }
+
+    _pnlTableKSize = size;
+    _pnlTableKMin = kMin;
+    _pnlTableKMax = kMax;
+
+    return 0;
 }
 
 
-spec_deriv_t *spec_deriv_free(spec_deriv_t *deriv)
+int spec_table_pnl_set_mu(size_t size)
 {
     /*
 
-        Free deriv
+        Set the size of the mu grid (uniform in mu^2 in [0, 1]) of the power spectrum tables
 
     */
 
-    free(deriv);
+    /* Need at least 5 points for the quartic interpolation */
+    if (size < __SPEC_TABLE_STENCIL_MU__)
+      {
+        printf("The mu grid of the power spectrum tables must have at least %d points.\n", __SPEC_TABLE_STENCIL_MU__);
+        exit(1);
 
-    return NULL;
-}
+        return 1;
+      }
 
+    _pnlTableMuSize = size;
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  ------------------------------------------------------------------------------------------------------  */
+    return 0;
+}
 
 
-int spec_deriv_set_var(spec_deriv_t *deriv, const char *label, double value)
+int spec_table_pnl_set_basis(bool basis)
 {
     /*
 
-        Set the variable of given label for the deriv
-
-        TODO: Maybe check for validity of the value... (ie k in (0, inf), mu and nu in (-1, 1))
+        Tabulate the loop integrals of the individual bias and RSD monomials (see kernels_z2_basis and kernels_z3_basis)
+        instead of P22 and P13 themselves. The tables then only depend on the bootstrap parameters, i.e. they are shared
+        by all redshifts with the same bootstrap parameters and remain valid for any set of bias and RSD parameters.
 
     */
 
-    /* Redshift z */
-    if (!strcmp(label, _idVarZ_))
-      {
-        deriv -> z = value;
+    _pnlTableBasis = basis;
 
-        return 0;
-      }
+    return 0;
+}
 
-    /* Mode k */
-    if (!strcmp(label, _idVarK_))
-      {
-        deriv -> k = value;
 
-        return 0;
-      }
 
-    /* Angle mu */
-    if (!strcmp(label, _idVarMu_))
-      {
-        deriv -> mu = value;
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ----------------------------------------   Setup the Tables   ----------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
 
-        return 0;
-      }
 
-    /* Label not found */
-    if (deriv -> id != NULL)
-        printf("Can only set the variable of the derivative parameter '%s' if its label is '%s', '%s' or '%s'!\n", deriv -> id, _idVarZ_, _idVarK_, _idVarMu_);
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ####################################   Function Declarations   #######################################  */
 
-    else
-        printf("Can only set the variable of a derivative parameter if its label is '%s', '%s' or '%s'!\n", _idVarZ_, _idVarK_, _idVarMu_);
+static _spec_table_t *_spec_table_new(kern_t *kern, bool basis, size_t partsSize, size_t kSize, double kMin, double kMax, size_t muSize);
+static _spec_table_t *_spec_table_free(_spec_table_t *table);
 
-    exit(1);
+static bool _spec_table_btst_equal(fid_btst_t *btst1, fid_btst_t *btst2);
+static bool _spec_table_match(_spec_table_t *table, kern_t *kern);
 
-    return 1;
-}
+static int _spec_pnl_1loop(kern_t *kern, double integrand(double*, size_t, void*), void *params, double *result);
+static int _spec_pnl_1loop_vec(kern_t *kern, int integrandVec(double*, size_t, void*, double*), size_t nComp, void *params, double *result);
+
+/*  ######################################################################################################  */
+/*  ------------------------------------------------------------------------------------------------------  */
 
 
-int spec_deriv_set_z(spec_deriv_t *deriv, double z)
+int spec_table_pnl_setup(void)
 {
     /*
 
-        Set the redshift z for the deriv struct
-
-    */
+        Tabulate the one-loop contributions (P22 and P13) to the non-linear power spectrum for the redshifts in
+        _sampleRedshift_. spec_pnl_p22 and spec_pnl_p13 read from these tables if (z, k) lies on the grid, i.e. the
+        loop integrals are then only computed once per grid point instead of once per evaluation.
 
-    deriv -> z = z;
+        By default there is one table per redshift. If the bias and RSD basis is used (see spec_table_pnl_set_basis)
+        there is one table per distinct set of bootstrap parameters instead.
 
-    return 0;
-}
+        NOTE: The tables are computed with the current loop order and loop 'intgrt_t' struct of the power spectrum,
+              so these must be set beforehand (see spec_info_set_loop_order and spec_info_get_loop_integrate).
 
+    */
 
-int spec_deriv_set_k(spec_deriv_t *deriv, double k)
-{
-    /*
+    /* Free any previous tables */
+    spec_table_pnl_free();
 
-        Set the mode k for the deriv struct
+    /* Nothing to tabulate at tree-level */
+    if (_pnlInfo -> loopOrder == 0)
+      {
+        return 0;
+      }
 
-    */
+    /* Redshift sample */
+    sample_raw_t *sampleRawZ = flss_get_sample_redshift();
 
-    deriv -> k = k;
+    if (sampleRawZ == NULL)
+      {
+        printf("Must set the redshift sample before tabulating the power spectrum.\n");
+        exit(1);
 
-    return 0;
-}
+        return 1;
+      }
 
+    /* Parts of the tables */
+    size_t partsSize = (_pnlTableBasis) ? _pnlTableBasisP22Size + _pnlTableBasisP13Size : _pnlTablePartsSize;
 
-int spec_deriv_set_mu(spec_deriv_t *deriv, double mu)
-{
-    /*
+    /* Allocate the tables (only make them visible once they are filled) */
+    size_t tableSize = 0;
+    _spec_table_t **table = malloc(sizeof(_spec_table_t*) * sampleRawZ -> sampleArg -> size);
 
-        Set the angle mu for the deriv struct
+    kern_t *kern = kernels_new(_pnlInfo -> specOrder, _pnlInfo -> loopOrder);
 
-    */
+    for (size_t n = 0; n < sampleRawZ -> sampleArg -> size; n++)
+      {
+        /* Bootstrap parameters at the current redshift */
+        kernels_set_z(kern, sampleRawZ -> array[n]);
 
-    deriv -> mu = mu;
+        /* Basis tables can be shared by redshifts with the same bootstrap parameters */
+        bool tableExists = false;
 
-    return 0;
-}
+        for (size_t m = 0; _pnlTableBasis && m < tableSize; m++)
+          {
+            if (_spec_table_btst_equal(&table[m] -> btst, kern -> btst))
+              {
+                tableExists = true;
+                break;
+              }
+          }
 
+        if (tableExists)
+          {
+            continue;
+          }
 
-int spec_deriv_set_log(spec_deriv_t *deriv, bool log)
-{
-    /*
+        table[tableSize++] = _spec_table_new(kern, _pnlTableBasis, partsSize, _pnlTableKSize, _pnlTableKMin, _pnlTableKMax, _pnlTableMuSize);
+      }
 
-        Set the flag for calculating the logarithmic derivative for the deriv struct
+    kern = kernels_free(kern);
 
-    */
 
-    deriv -> log = log;
+    /* Tabulate */
 
-    return 0;
-}
+    #pragma omp parallel
 
+      { // Start pragma parallel
 
+        /* Kern struct */
+        kern_t *kernThread = kernels_new(_pnlInfo -> specOrder, _pnlInfo -> loopOrder);
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  -----------------------------------   Spectra Arguments Struct   -------------------------------------  */
-/*  ------------------------------------------------------------------------------------------------------  */
+        /* Parameters of the vector valued integrand of the basis terms (renormalised P13 terms vanish) */
+        intgrnd_basis_vec_t basis;
+        basis.kern = kernThread;
 
+        size_t nComp = 0;
 
-spec_arg_t *spec_arg_new(const char *id)
-{
-    /*
+        for (size_t i = 0; i < __INTGRND_BASIS_SIZE__; i++)
+          {
+            basis.comp[i] = (i < __INTGRND_BASIS_P22_SIZE__) || !_pnlTableBasisP13Renorm[i - __INTGRND_BASIS_P22_SIZE__];
+            nComp += (basis.comp[i]) ? 1 : 0;
+          }
 
-        Create a new spec_arg_t struct
+        double *resultBasis = malloc(sizeof(double) * 3 * nComp);
 
-    */
+        /* Routines without a vector valued form (CQUAD, VEGAS) integrate the basis terms one at a time */
+        bool sweep = integrate_vec_sweep(_pnlInfo -> loopIntgrt[0]);
 
-    spec_arg_t *specArg = malloc(sizeof(spec_arg_t));
+        intgrnd_basis_vec_t basisPart;
+        basisPart.kern = kernThread;
 
-    /* Do not allocate any memory if id is NULL (eg use this if kern should be created by hand) */
-    if (id == NULL)
-      {
-        specArg -> id = NULL;
-        specArg -> kern = NULL;
-        specArg -> deriv = NULL;
+        for (size_t n = 0; n < tableSize; n++)
 
-        specArg -> dz = 0.;
-        specArg -> dk = 0.;
-        specArg -> dmu = 0.;
+          { // Start temporal for
 
-        specArg -> binVolume = 1.;
+            /* Redshift + Fiducials */
+            kernels_set_z(kernThread, table[n] -> z);
 
-        return specArg;
-      }
+            size_t kSize = table[n] -> kSize;
+            size_t muSize = table[n] -> muSize;
 
-    _spec_info_t *info = _spec_info_get_struct(id);
+            double dlogk = (table[n] -> logkMax - table[n] -> logkMin) / (double) (kSize - 1);
 
-    specArg -> id = info -> id;
+            #pragma omp for schedule(dynamic)
 
-    specArg -> kern = kernels_new(info -> specOrder, info -> loopOrder);
-    specArg -> deriv = (spec_info_isderiv(info -> id)) ? spec_deriv_new() : NULL;
+            for (size_t m = 0; m < kSize * muSize; m++)
 
-    specArg -> dz = 0.;
-    specArg -> dk = 0.;
-    specArg -> dmu = 0.;
+              { // Start grid for
 
-    specArg -> binVolume = 1.;
+                /* Grid point */
+                double k = exp(table[n] -> logkMin + (double) (m / muSize) * dlogk);
+                double mu = sqrt((double) (m % muSize) / (double) (muSize - 1));
 
-    return specArg;
-}
+                kernels_qset_k(kernThread, 0, k);
+                kernels_qset_mu(kernThread, 0, mu);
 
+                kernels_qset_k(kernThread, 1, k);
+                kernels_qset_mu(kernThread, 1, -mu);
+                kernels_qset_nu(kernThread, 0, 1, -1.);
 
-spec_arg_t *spec_arg_free(spec_arg_t *specArg)
-{
-    /*
+                double result[3];
 
-        Free specArg
+                /* One-loop contributions */
+                if (!table[n] -> basis)
+                  {
+                    _spec_pnl_1loop(kernThread, integrand_spec_pnl_p22_1loop, kernThread, result);
 
-    */
+                    table[n] -> values[_pnlTableP22][m] = result[0];
+                    table[n] -> errors[_pnlTableP22][m] = result[1];
 
-    /* Check for NULL */
-    if (specArg == NULL)
-        return NULL;
+                    _spec_pnl_1loop(kernThread, integrand_spec_pnl_p13_1loop, kernThread, result);
 
-    /* Free contents */
-    specArg -> kern = kernels_free(specArg -> kern);
-    specArg -> deriv = spec_deriv_free(specArg -> deriv);
+                    table[n] -> values[_pnlTableP13][m] = result[0];
+                    table[n] -> errors[_pnlTableP13][m] = result[1];
 
-    /* Free specArg itself */
-    free(specArg);
+                    continue;
+                  }
 
-    return NULL;
-}
+                /* One-loop contributions of the bias and RSD basis (P22: symmetric pairs (i, j) with i <= j, then P13 / Z1) in
+                   one sweep */
+                if (sweep)
+                    _spec_pnl_1loop_vec(kernThread, integrand_spec_pnl_basis_1loop_vec, nComp, &basis, resultBasis);
 
+                size_t comp = 0;
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  ------------------------------------------------------------------------------------------------------  */
+                for (size_t part = 0; part < __INTGRND_BASIS_SIZE__; part++)
+                  {
+                    if (!basis.comp[part])
+                        continue;
 
+                    if (!sweep)
+                      {
+                        for (size_t i = 0; i < __INTGRND_BASIS_SIZE__; i++)
+                            basisPart.comp[i] = (i == part);
 
-int spec_arg_set_dz(spec_arg_t *specArg, double dz)
-{
-    /*
+                        _spec_pnl_1loop_vec(kernThread, integrand_spec_pnl_basis_1loop_vec, 1, &basisPart, &resultBasis[3*comp]);
+                      }
 
-        Set the redshift bin width dz in specArg
+                    table[n] -> values[part][m] = resultBasis[3*comp];
+                    table[n] -> errors[part][m] = resultBasis[3*comp + 1];
 
-    */
+                    comp++;
+                  }
 
-    specArg -> dz = dz;
+              } // End grid for
 
-    return 0;
-}
+          } // End temporal for
 
+        /* Free memory */
+        free(resultBasis);
 
-int spec_arg_set_dk(spec_arg_t *specArg, double dk)
-{
-    /*
+        kernThread = kernels_free(kernThread);
 
-        Set the mode bin width dk in specArg
+      } // End pragma parallel
 
-    */
 
-    specArg -> dk = dk;
+    /* Store the tables */
+    _pnlTable = table;
+    _pnlTableSize = tableSize;
 
     return 0;
 }
 
 
-int spec_arg_set_dmu(spec_arg_t *specArg, double dmu)
-{
-    /*
-
-        Set the angle bin width dmu in specArg
-
-    */
-
-    specArg -> dmu = dmu;
-
-    return 0;
-}
+/*  ------------------------------------------------------------------------------------------------------  */
 
 
-int spec_arg_set_volume(spec_arg_t *specArg, double binVolume)
+static _spec_table_t *_spec_table_new(kern_t *kern, bool basis, size_t partsSize, size_t kSize, double kMin, double kMax, size_t muSize)
 {
     /*
 
-        Set the bin volume in specArg
+        Create a new (empty) table at the redshift and with the fiducials of kern
 
     */
 
-    specArg -> binVolume = binVolume;
+    _spec_table_t *table = malloc(sizeof(_spec_table_t));
 
-    return 0;
-}
+    table -> z = kern -> z;
+    table -> btst = *kern -> btst;
+    table -> basis = basis;
 
+    table -> bias = *kern -> bias;
+    table -> rsd = *kern -> rsd;
 
-int spec_arg_set_kern(spec_arg_t *specArg, kern_t *kern)
-{
-    /*
+    table -> kSize = kSize;
+    table -> muSize = muSize;
 
-        Set the kern struct for specArg iff specArg -> id is NULL
+    table -> logkMin = log(kMin);
+    table -> logkMax = log(kMax);
 
-    */
+    table -> partsSize = partsSize;
 
-    if (specArg -> id != NULL)
-      {
-        printf("Cannot set the 'kern_t' struct of a 'spec_arg_t' struct if the ID is not NULL.\n");
-        exit(1);
+    table -> values = malloc(sizeof(double*) * partsSize);
+    table -> errors = malloc(sizeof(double*) * partsSize);
 
-        return 1;
+    for (size_t i = 0; i < partsSize; i++)
+      {
+        table -> values[i] = calloc(kSize * muSize, sizeof(double));
+        table -> errors[i] = calloc(kSize * muSize, sizeof(double));
       }
 
-    specArg -> kern = kern;
-
-    return 0;
+    return table;
 }
 
 
-int spec_arg_set_deriv(spec_arg_t *specArg, spec_deriv_t *deriv)
+static _spec_table_t *_spec_table_free(_spec_table_t *table)
 {
     /*
 
-        Set the deriv struct for specArg iff specArg -> id is NULL
+        Free a _spec_table_t struct
 
     */
 
-    if (specArg -> id != NULL)
-      {
-        printf("Cannot set the 'spec_deriv_t' struct of a 'spec_arg_t' struct if the ID is not NULL.\n");
-        exit(1);
+    if (table == NULL)
+        return NULL;
 
-        return 1;
+    for (size_t i = 0; i < table -> partsSize; i++)
+      {
+        free(table -> values[i]);
+        free(table -> errors[i]);
       }
 
-    specArg -> deriv = deriv;
+    free(table -> values);
+    free(table -> errors);
 
-    return 0;
+    free(table);
+
+    return NULL;
 }
 
 
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-spec_deriv_t *spec_arg_get_deriv(spec_arg_t *specArg)
+static bool _spec_table_btst_equal(fid_btst_t *btst1, fid_btst_t *btst2)
 {
     /*
 
-        Get deriv struct from specArg
+        Check if two sets of bootstrap parameters are equal
 
     */
 
-    return specArg -> deriv;
+    return fabs(btst1 -> a2Ga - btst2 -> a2Ga) < __ABSTOL__ && fabs(btst1 -> d2Ga - btst2 -> d2Ga) < __ABSTOL__
+        && fabs(btst1 -> a3GaA - btst2 -> a3GaA) < __ABSTOL__ && fabs(btst1 -> a3GaB - btst2 -> a3GaB) < __ABSTOL__
+        && fabs(btst1 -> d3GaA - btst2 -> d3GaA) < __ABSTOL__ && fabs(btst1 -> d3GaB - btst2 -> d3GaB) < __ABSTOL__
+        && fabs(btst1 -> h - btst2 -> h) < __ABSTOL__;
 }
 
 
-kern_t *spec_arg_get_kern(spec_arg_t *specArg)
+static bool _spec_table_match(_spec_table_t *table, kern_t *kern)
 {
     /*
 
-        Get the kernel struct from specArg
+        Check if a table is valid for kern: tables of the bias and RSD basis only depend on the bootstrap parameters,
+        the other tables on the redshift and all fiducials
 
     */
 
-    return specArg -> kern;
+    if (table -> basis)
+        return _spec_table_btst_equal(&table -> btst, kern -> btst);
+
+    return fabs(table -> z - kern -> z) < __ABSTOL__
+        && !memcmp(&table -> btst, kern -> btst, sizeof(fid_btst_t))
+        && !memcmp(&table -> bias, kern -> bias, sizeof(fid_bias_t))
+        && !memcmp(&table -> rsd, kern -> rsd, sizeof(fid_rsd_t));
 }
 
 
 
 /*  ------------------------------------------------------------------------------------------------------  */
-/*  -------------------------------------   Spectra Output Struct   --------------------------------------  */
+/*  --------------------------------------   Evaluate the Tables   ---------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-spec_out_t *spec_out_new(void)
+static size_t _spec_table_stencil(double x, size_t size, size_t nodes, double *weights)
 {
     /*
 
-        Create a new spec_out_t struct
+        Get the first index and the weights of the Lagrange stencil with the given number of nodes for the grid
+        coordinate x in [0, size - 1]
 
     */
 
-    spec_out_t *out = malloc(sizeof(spec_out_t));
+    /* First index of the stencil (centered around x if possible) */
+    double first = floor(x - (double) (nodes - 1) / 2. + 0.5);
 
-    out -> size = 0;
-    out -> labels = NULL;
+    size_t index = (first < 0.) ? 0 : (size_t) first;
 
-    out -> err = NULL;
-    out -> log = NULL;
+    if (index + nodes > size)
+        index = size - nodes;
 
-    out -> file = NULL;
+    /* Position inside the stencil */
+    double t = x - (double) index;
 
-    out -> binary = _true_;
-    out -> precision = 0;
+    for (size_t i = 0; i < nodes; i++)
+      {
+        weights[i] = 1.;
 
-    return out;
+        for (size_t j = 0; j < nodes; j++)
+          {
+            if (j != i)
+                weights[i] *= (t - (double) j) / ((double) i - (double) j);
+          }
+      }
+
+    return index;
 }
 
 
-spec_out_t *spec_out_free(spec_out_t *out)
+static int _spec_table_point(_spec_table_t *table, kern_t *kern, _spec_table_point_t *point)
 {
     /*
 
-        Free out
+        Get the interpolation stencils of a table for the kern variables (k, mu). Returns 1 if k is not on the grid.
 
     */
 
-    /* Check for NULL */
-    if (out == NULL)
-        return NULL;
+    /* Must lie inside the k grid */
+    double logk = log(kernels_get_k(kern, 0));
 
-    /* Free contents */
-    if (out -> labels != NULL)
+    if (logk < table -> logkMin - __ABSTOL__ || logk > table -> logkMax + __ABSTOL__)
       {
-        for (size_t i = 0; i < out ->size; i++)
-            free(out -> labels[i]);
+        return 1;
       }
 
-    free(out -> labels);
+    double mu = kernels_get_mu(kern, 0);
 
-    free(out -> err);
-    free(out -> log);
+    /* Grid coordinates */
+    double x = (logk - table -> logkMin) / (table -> logkMax - table -> logkMin) * (double) (table -> kSize - 1);
+    double y = fmin(mu*mu, 1.) * (double) (table -> muSize - 1);
 
-    free(out -> file);
+    x = fmin(fmax(x, 0.), (double) (table -> kSize - 1));
 
-    /* Free out itself */
-    free(out);
+    /* Lagrange stencils for the values */
+    point -> indexX = _spec_table_stencil(x, table -> kSize, __SPEC_TABLE_STENCIL_K__, point -> weightsX);
+    point -> indexY = _spec_table_stencil(y, table -> muSize, __SPEC_TABLE_STENCIL_MU__, point -> weightsY);
 
-    return NULL;
-}
+    /* Linear stencils for the errors */
+    point -> indexErrX = (x + 1. < (double) table -> kSize) ? (size_t) x : table -> kSize - 2;
+    point -> indexErrY = (y + 1. < (double) table -> muSize) ? (size_t) y : table -> muSize - 2;
 
+    point -> tX = x - (double) point -> indexErrX;
+    point -> tY = y - (double) point -> indexErrY;
 
-/*  ------------------------------------------------------------------------------------------------------  */
+    return 0;
+}
 
 
-spec_out_t *spec_out_cp(spec_out_t *out)
+static int _spec_table_interp(_spec_table_t *table, size_t part, _spec_table_point_t *point, double *result)
 {
     /*
 
-        Copy out
+        Interpolate part of a table at a given point with cubic interpolation in log(k) and quartic interpolation in mu^2
+        for the value and bilinear interpolation for the error
 
     */
 
-    spec_out_t *outCp = malloc(sizeof(spec_out_t));
-
-    outCp -> size = out -> size;
+    size_t muSize = table -> muSize;
 
-    outCp -> labels = malloc(sizeof(char*) * out -> size);
+    /* Cubic / quartic interpolation of the values */
+    double *values = table -> values[part];
 
-    outCp -> err = malloc(sizeof(bool) * out -> size);
-    outCp -> log = malloc(sizeof(bool) * out -> size);
+    result[0] = 0.;
 
-    for (size_t i = 0; i < out -> size; i++)
+    for (size_t i = 0; i < __SPEC_TABLE_STENCIL_K__; i++)
       {
-        outCp -> labels[i] = misc_scat(1, out -> labels[i]);
-
-        outCp -> err[i] = out -> err[i];
-        outCp -> log[i] = out -> log[i];
+        for (size_t j = 0; j < __SPEC_TABLE_STENCIL_MU__; j++)
+          {
+            result[0] += point -> weightsX[i] * point -> weightsY[j] * values[(point -> indexX + i) * muSize + point -> indexY + j];
+          }
       }
 
-    outCp -> file = misc_scat(1, out -> file);
+    /* Bilinear interpolation of the errors */
+    double *errors = table -> errors[part];
 
-    outCp -> binary = out -> binary;
-    outCp -> precision = out -> precision;
+    size_t index = point -> indexErrX * muSize + point -> indexErrY;
 
-    return outCp;
+    result[1] = (1. - point -> tX) * (1. - point -> tY) * errors[index]
+              + point -> tX * (1. - point -> tY) * errors[index + muSize]
+              + (1. - point -> tX) * point -> tY * errors[index + 1]
+              + point -> tX * point -> tY * errors[index + muSize + 1];
+
+    return 0;
 }
 
 
-/*  ------------------------------------------------------------------------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-int spec_out_add_label(spec_out_t *out, const char *label)
+static int _spec_table_pnl_eval(size_t contribution, kern_t *kern, double *result)
 {
     /*
 
-        Add an output label to out
+        Evaluate the one-loop contribution (_pnlTableP22 or _pnlTableP13) to the power spectrum from the tables
+        (without the smoothing factor). Returns 1 if no table exists for (z, k), 0 otherwise.
 
     */
 
-    /* Label already contained in out -> labels */
-    if (misc_ssearch(out -> labels, out -> size, label, NULL))
+    /* Table at the current redshift and fiducials (or with the current bootstrap parameters) */
+    _spec_table_t *table = NULL;
+
+    for (size_t n = 0; n < _pnlTableSize; n++)
+      {
+        if (_spec_table_match(_pnlTable[n], kern))
+          {
+            table = _pnlTable[n];
+            break;
+          }
+      }
+
+    if (table == NULL)
+      {
+        return 1;
+      }
+
+    /* Interpolation stencils */
+    _spec_table_point_t point;
+
+    if (_spec_table_point(table, kern, &point))
+      {
+        return 1;
+      }
+
+    /* Growth factor */
+    double growth4 = pow(kern -> growth, 4.);
+
+    /* P22 or P13 are tabulated directly */
+    if (!table -> basis)
+      {
+        _spec_table_interp(table, contribution, &point, result);
+
+        result[0] *= growth4;
+        result[1] *= growth4;
+
         return 0;
+      }
 
-    /* Increment the output size and reallocate memory */
-    out -> size += 1;
-    out -> labels = realloc(out -> labels, sizeof(char*) * out -> size);
-    out -> err = realloc(out -> err, sizeof(bool) * out -> size);
-    out -> log = realloc(out -> log, sizeof(bool) * out -> size);
+    /* Sum over the bias and RSD basis */
+    double resultPart[2];
 
-    /* Add the label */
-    out -> labels[out -> size - 1] = misc_scat(1, label);
+    result[0] = 0.;
+    result[1] = 0.;
 
-    /* Set the flags to _false_ */
-    out -> err[out -> size - 1] = _false_;
-    out -> log[out -> size - 1] = _false_;
+    if (contribution == _pnlTableP22)
+      {
+        /* Monomials of Z2 */
+        double z2Coeff[__KERN_Z2_BASIS_SIZE__];
+        kernels_z2_basis_coeff(kern, z2Coeff);
+
+        size_t part = 0;
+
+        for (size_t i = 0; i < __KERN_Z2_BASIS_SIZE__; i++)
+          {
+            for (size_t j = i; j < __KERN_Z2_BASIS_SIZE__; j++)
+              {
+                double coeff = (i == j) ? z2Coeff[i] * z2Coeff[j] : 2. * z2Coeff[i] * z2Coeff[j];
+
+                _spec_table_interp(table, part++, &point, resultPart);
+
+                result[0] += coeff * resultPart[0];
+                result[1] += pow(coeff * resultPart[1], 2.);
+              }
+          }
+
+        result[0] *= growth4;
+        result[1] = sqrt(result[1]) * growth4;
+      }
+
+    else
+      {
+        /* Monomials of Z3 (b2 is renormalised to zero) */
+        double b2 = kern -> bias -> b2;
+        kern -> bias -> b2 = 0.;
+
+        double z3Coeff[__KERN_Z3_BASIS_SIZE__];
+        kernels_z3_basis_coeff(kern, z3Coeff);
+
+        kern -> bias -> b2 = b2;
+
+        for (size_t i = 0; i < __KERN_Z3_BASIS_SIZE__; i++)
+          {
+            _spec_table_interp(table, _pnlTableBasisP22Size + i, &point, resultPart);
+
+            result[0] += z3Coeff[i] * resultPart[0];
+            result[1] += pow(z3Coeff[i] * resultPart[1], 2.);
+          }
+
+        /* Z1(k_) */
+        double z1 = kernels_z1(kern);
+
+        result[0] *= z1 * growth4;
+        result[1] = sqrt(result[1]) * fabs(z1) * growth4;
+      }
 
     return 0;
 }
 
 
-int spec_out_rm_label(spec_out_t *out, const char *label)
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ----------------------------------------   Free the Tables   -----------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int spec_table_pnl_free(void)
 {
     /*
 
-        Remove an output label from out
+        Free the power spectrum tables (the loop integrals are then computed directly again)
 
     */
 
-    bool success;
-
-    /* Get the index */
-    size_t index = misc_ssearch_index(out -> labels, out -> size, label, &success);
-
-    /* Not in the array */
-    if (!success)
+    if (_pnlTable == NULL)
+      {
         return 0;
+      }
 
-    /* Decrease the size of the array */
-    out -> size -= 1;
-
-    /* Push the string to the end of the array */
-    for (size_t i = index; i < out -> size; i++)
+    for (size_t n = 0; n < _pnlTableSize; n++)
       {
-        misc_swap(&(out -> labels)[i], &(out -> labels)[i+1], "s");
-        misc_swap(&(out -> err)[i], &(out -> err)[i+1], "b");
-        misc_swap(&(out -> log)[i], &(out -> log)[i+1], "b");
+        _pnlTable[n] = _spec_table_free(_pnlTable[n]);
       }
 
-    /* Free the last label */
-    free(out -> labels[out -> size]);
+    free(_pnlTable);
 
-    /* Reallocate memory */
-    out -> labels = realloc(out -> labels, sizeof(char*) * out -> size);
-    out -> err = realloc(out -> err, sizeof(bool*) * out -> size);
-    out -> log = realloc(out -> log, sizeof(bool*) * out -> size);
+    _pnlTable = NULL;
+    _pnlTableSize = 0;
 
     return 0;
 }
 
 
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%     SPECTRA STRUCTS     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ---------------------------------------   Derivative Struct   ----------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-int spec_out_set_err(spec_out_t *out, const char *label, bool err)
+spec_deriv_t *spec_deriv_new(void)
 {
     /*
 
-        Set the error flag for the output label in out
+        Create a new derivative struct.
 
     */
 
-    bool success;
+    spec_deriv_t *deriv = malloc(sizeof(spec_deriv_t));
 
-    /* Get the index */
-    size_t index = misc_ssearch_index(out -> labels, out -> size, label, &success);
+    /* Some initial values */
+    deriv -> z = 0.;
+    deriv -> k = 0.;
+    deriv -> mu = 0.;
 
-    /* Not in the array */
-    if (!success)
-      {
-        printf("Cannot set the integration error flag for non-existent label '%s' in a spec_out_t struct!\n", label);
+    deriv -> log = _false_;
 
-        return 0;
-      }
+    return deriv;
+}
 
-    out -> err[index] = err;
 
-    return 0;
+spec_deriv_t *spec_deriv_free(spec_deriv_t *deriv)
+{
+    /*
+
+        Free deriv
+
+    */
+
+    free(deriv);
+
+    return NULL;
 }
 
 
-int spec_out_set_log(spec_out_t *out, const char *label, bool log)
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int spec_deriv_set_var(spec_deriv_t *deriv, const char *label, double value)
 {
     /*
 
-        Set the logarithimic derivative flag for the output label in out
+        Set the variable of given label for the deriv
+
+        TODO: Maybe check for validity of the value... (ie k in (0, inf), mu and nu in (-1, 1))
 
     */
 
-    bool success;
+    /* Redshift z */
+    if (!strcmp(label, _idVarZ_))
+      {
+        deriv -> z = value;
 
-    /* Get the index */
-    size_t index = misc_ssearch_index(out -> labels, out -> size, label, &success);
+        return 0;
+      }
 
-    /* Not in the array */
-    if (!success)
+    /* Mode k */
+    if (!strcmp(label, _idVarK_))
       {
-        printf("Cannot set the logarithmic derivative flag for non-existent label '%s' in a spec_out_t struct!\n", label);
+        deriv -> k = value;
 
         return 0;
       }
 
-    out -> log[index] = log;
+    /* Angle mu */
+    if (!strcmp(label, _idVarMu_))
+      {
+        deriv -> mu = value;
 
-    return 0;
-}
+        return 0;
+      }
 
+    /* Label not found */
+    if (deriv -> id != NULL)
+        printf("Can only set the variable of the derivative parameter '%s' if its label is '%s', '%s' or '%s'!\n", deriv -> id, _idVarZ_, _idVarK_, _idVarMu_);
 
-/*  ------------------------------------------------------------------------------------------------------  */
+    else
+        printf("Can only set the variable of a derivative parameter if its label is '%s', '%s' or '%s'!\n", _idVarZ_, _idVarK_, _idVarMu_);
 
+    exit(1);
 
-int spec_out_set_file(spec_out_t *out, const char *file)
+    return 1;
+}
+
+
+int spec_deriv_set_z(spec_deriv_t *deriv, double z)
 {
     /*
 
-        Set the file name in out (if file is NULL nothing will be output to file)
+        Set the redshift z for the deriv struct
 
     */
 
-    misc_scp(&(out -> file), file);
+    deriv -> z = z;
 
     return 0;
 }
 
 
-int spec_out_set_binary(spec_out_t *out, bool binary)
+int spec_deriv_set_k(spec_deriv_t *deriv, double k)
 {
     /*
 
-        Set the binary flag for out
+        Set the mode k for the deriv struct
 
     */
 
-    out -> binary = binary;
+    deriv -> k = k;
 
     return 0;
 }
 
 
-int spec_out_set_precision(spec_out_t *out, int precision)
+int spec_deriv_set_mu(spec_deriv_t *deriv, double mu)
 {
     /*
 
-        Set the precision in the output file for out -> also set the binary flag to _false_
+        Set the angle mu for the deriv struct
 
     */
 
-    out -> binary = _false_;
-    out -> precision = precision;
+    deriv -> mu = mu;
+
+    return 0;
+}
+
+
+int spec_deriv_set_log(spec_deriv_t *deriv, bool log)
+{
+    /*
+
+        Set the flag for calculating the logarithmic derivative for the deriv struct
+
+    */
+
+    deriv -> log = log;
 
     return 0;
 }
@@ -3362,61 +4013,77 @@ int spec_out_set_precision(spec_out_t *out, int precision)
 
 
 /*  ------------------------------------------------------------------------------------------------------  */
-/*  ----------------------------------------   Spectra Struct   ------------------------------------------  */
+/*  -----------------------------------   Spectra Arguments Struct   -------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-spec_dat_t *spec_dat_new(const char *id)
+spec_arg_t *spec_arg_new(const char *id)
 {
     /*
 
-        New spec_dat_t struct
+        Create a new spec_arg_t struct
 
     */
 
-    spec_dat_t *specDat = malloc(sizeof(spec_dat_t));
+    spec_arg_t *specArg = malloc(sizeof(spec_arg_t));
+
+    /* Do not allocate any memory if id is NULL (eg use this if kern should be created by hand) */
+    if (id == NULL)
+      {
+        specArg -> id = NULL;
+        specArg -> kern = NULL;
+        specArg -> deriv = NULL;
+
+        specArg -> dz = 0.;
+        specArg -> dk = 0.;
+        specArg -> dmu = 0.;
+
+        specArg -> binVolume = 1.;
+
+        specArg -> btrDual = NULL;
+
+        return specArg;
+      }
 
-    /* Info struct */
     _spec_info_t *info = _spec_info_get_struct(id);
 
-    /* Id */
-    specDat -> id = info -> id;
+    specArg -> id = info -> id;
 
-    /* Output */
-    specDat -> out = NULL;
+    specArg -> kern = kernels_new(info -> specOrder, info -> loopOrder);
+    specArg -> deriv = (spec_info_isderiv(info -> id)) ? spec_deriv_new() : NULL;
 
-    /* Print */
-    specDat -> flags = NULL;
+    specArg -> dz = 0.;
+    specArg -> dk = 0.;
+    specArg -> dmu = 0.;
 
-    return specDat;
-}
+    specArg -> binVolume = 1.;
 
+    specArg -> btrDual = NULL;
 
-/*  ------------------------------------------------------------------------------------------------------  */
+    return specArg;
+}
 
 
-spec_dat_t *spec_dat_free(spec_dat_t *specDat)
+spec_arg_t *spec_arg_free(spec_arg_t *specArg)
 {
     /*
 
-        Free a spec_dat_t struct
+        Free specArg
 
     */
 
     /* Check for NULL */
-    if (specDat == NULL)
+    if (specArg == NULL)
         return NULL;
 
     /* Free contents */
+    specArg -> kern = kernels_free(specArg -> kern);
+    specArg -> deriv = spec_deriv_free(specArg -> deriv);
 
-    /* Out */
-    specDat -> out = spec_out_free(specDat -> out);
-
-    /* Flags */
-    specDat -> flags = print_flags_free(specDat -> flags);
+    free(specArg -> btrDual);
 
-    /* Free spec itself */
-    free(specDat);
+    /* Free specArg itself */
+    free(specArg);
 
     return NULL;
 }
@@ -3426,770 +4093,1908 @@ spec_dat_t *spec_dat_free(spec_dat_t *specDat)
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-int spec_dat_set_out(spec_dat_t *specDat, spec_out_t *out)
+int spec_arg_set_dz(spec_arg_t *specArg, double dz)
 {
     /*
 
-        Set the output parameters for spec
+        Set the redshift bin width dz in specArg
 
     */
 
-    specDat -> out = spec_out_free(specDat -> out);
-    specDat -> out = spec_out_cp(out);
+    specArg -> dz = dz;
 
     return 0;
 }
 
 
-/*  ------------------------------------------------------------------------------------------------------  */
-
-
-int spec_dat_set_flags(spec_dat_t *specDat, print_flags_t *flags)
+int spec_arg_set_dk(spec_arg_t *specArg, double dk)
 {
     /*
 
-        Set the print parameters for spec
+        Set the mode bin width dk in specArg
 
     */
 
-    specDat -> flags = print_flags_free(specDat -> flags);
-    specDat -> flags = print_flags_cp(flags);
+    specArg -> dk = dk;
 
     return 0;
 }
 
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  ------------------------------------------------------------------------------------------------------  */
+int spec_arg_set_dmu(spec_arg_t *specArg, double dmu)
+{
+    /*
 
+        Set the angle bin width dmu in specArg
 
-spec_out_t *spec_dat_get_out(spec_dat_t *specDat)
+    */
+
+    specArg -> dmu = dmu;
+
+    return 0;
+}
+
+
+int spec_arg_set_volume(spec_arg_t *specArg, double binVolume)
 {
     /*
 
-        Get the out struct from specDat
+        Set the bin volume in specArg
 
     */
 
-    return specDat -> out;
+    specArg -> binVolume = binVolume;
+
+    return 0;
 }
 
 
-print_flags_t *spec_dat_get_flags(spec_dat_t *specDat)
+int spec_arg_set_kern(spec_arg_t *specArg, kern_t *kern)
 {
     /*
 
-        Get the print struct from specDat
+        Set the kern struct for specArg iff specArg -> id is NULL
 
     */
 
-    return specDat -> flags;
-}
+    if (specArg -> id != NULL)
+      {
+        printf("Cannot set the 'kern_t' struct of a 'spec_arg_t' struct if the ID is not NULL.\n");
+        exit(1);
 
+        return 1;
+      }
 
+    specArg -> kern = kern;
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  ---------------------------------------   Default Settings   -----------------------------------------  */
-/*  ------------------------------------------------------------------------------------------------------  */
+    return 0;
+}
 
 
-spec_dat_t *spec_dat_pnl_default(void)
+int spec_arg_set_deriv(spec_arg_t *specArg, spec_deriv_t *deriv)
 {
     /*
 
-        Default parameters for the non-linear power spectrum function
+        Set the deriv struct for specArg iff specArg -> id is NULL
 
     */
 
-    spec_dat_t *specDat = spec_dat_new(_idSpecPnl_);
-
+    if (specArg -> id != NULL)
+      {
+        printf("Cannot set the 'spec_deriv_t' struct of a 'spec_arg_t' struct if the ID is not NULL.\n");
+        exit(1);
 
-    /* Output */
+        return 1;
+      }
 
-    spec_out_t *out = spec_out_new();
+    specArg -> deriv = deriv;
 
-    /* Labels and errors */
-    for (size_t i = 0; i < _pnlInfo -> partsSize; i++)
-      {
-        spec_out_add_label(out, _pnlInfo -> partsLabels[i]);
-        spec_out_set_err(out, _pnlInfo -> partsLabels[i], *_pnlInfo -> partsHasErr[i]);
-      }
+    return 0;
+}
 
-    /* File */
-    char *outFile = misc_scat(2, _pnlInfo -> id, _outExt);
-    spec_out_set_file(out, outFile);
-    free(outFile);
 
-    /* Precision / Binary */
-    spec_out_set_precision(out, 16);
-    spec_out_set_binary(out, _true_);
+/*  ------------------------------------------------------------------------------------------------------  */
 
-    spec_dat_set_out(specDat, out);
 
-    out = spec_out_free(out);
+spec_deriv_t *spec_arg_get_deriv(spec_arg_t *specArg)
+{
+    /*
 
+        Get deriv struct from specArg
 
-    /* Flags */
+    */
 
-    print_flags_t *flags = print_flags_new();
+    return specArg -> deriv;
+}
 
-    print_flags_set_main(flags, _true_);
-    print_flags_set_sub(flags, _false_);
-    print_flags_set_fid(flags, _false_);
 
-    spec_dat_set_flags(specDat, flags);
+kern_t *spec_arg_get_kern(spec_arg_t *specArg)
+{
+    /*
 
-    flags = print_flags_free(flags);
+        Get the kernel struct from specArg
 
+    */
 
-    return specDat;
+    return specArg -> kern;
 }
 
 
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  -------------------------------------   Spectra Output Struct   --------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-spec_dat_t *spec_dat_dpnl_default(void)
+spec_out_t *spec_out_new(void)
 {
     /*
 
-        Default parameters for the non-linear power spectrum derivatives function
+        Create a new spec_out_t struct
 
     */
 
-    spec_dat_t *specDat = spec_dat_new(_idSpecDPnl_);
+    spec_out_t *out = malloc(sizeof(spec_out_t));
 
+    out -> size = 0;
+    out -> labels = NULL;
 
-    /* Output */
+    out -> err = NULL;
+    out -> log = NULL;
 
-    spec_out_t *out = spec_out_new();
+    out -> file = NULL;
 
-    /* Labels and errors */
-    for (size_t i = 0; i < _dpnlInfo -> partsSize; i++)
-      {
-        spec_out_add_label(out, _dpnlInfo -> partsLabels[i]);
-        spec_out_set_err(out, _dpnlInfo -> partsLabels[i], *_dpnlInfo -> partsHasErr[i]);
-      }
+    out -> binary = _true_;
+    out -> precision = 0;
 
-    /* File */
-    char *outFile = misc_scat(2, _dpnlInfo -> id, _outExt);
-    spec_out_set_file(out, outFile);
-    free(outFile);
+    return out;
+}
 
-    /* Precision / Binary */
-    spec_out_set_precision(out, 16);
-    spec_out_set_binary(out, _true_);
 
-    spec_dat_set_out(specDat, out);
+spec_out_t *spec_out_free(spec_out_t *out)
+{
+    /*
 
-    out = spec_out_free(out);
+        Free out
 
+    */
 
-    /* Flags */
+    /* Check for NULL */
+    if (out == NULL)
+        return NULL;
 
-    print_flags_t *flags = print_flags_new();
+    /* Free contents */
+    if (out -> labels != NULL)
+      {
+        for (size_t i = 0; i < out ->size; i++)
+            free(out -> labels[i]);
+      }
 
-    print_flags_set_main(flags, _true_);
-    print_flags_set_sub(flags, _false_);
-    print_flags_set_fid(flags, _false_);
+    free(out -> labels);
 
-    spec_dat_set_flags(specDat, flags);
+    free(out -> err);
+    free(out -> log);
 
-    flags = print_flags_free(flags);
+    free(out -> file);
 
+    /* Free out itself */
+    free(out);
 
-    return specDat;
+    return NULL;
 }
 
 
-/*  ------------------------------------------------------------------------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-spec_dat_t *spec_dat_btr_default(void)
+spec_out_t *spec_out_cp(spec_out_t *out)
 {
     /*
 
-        Default parameters for the tree-level bispectrum function
+        Copy out
 
     */
 
-    spec_dat_t *specDat = spec_dat_new(_idSpecBtr_);
+    spec_out_t *outCp = malloc(sizeof(spec_out_t));
+
+    outCp -> size = out -> size;
+
+    outCp -> labels = malloc(sizeof(char*) * out -> size);
+
+    outCp -> err = malloc(sizeof(bool) * out -> size);
+    outCp -> log = malloc(sizeof(bool) * out -> size);
+
+    for (size_t i = 0; i < out -> size; i++)
+      {
+        outCp -> labels[i] = misc_scat(1, out -> labels[i]);
+
+        outCp -> err[i] = out -> err[i];
+        outCp -> log[i] = out -> log[i];
+      }
+
+    outCp -> file = misc_scat(1, out -> file);
+
+    outCp -> binary = out -> binary;
+    outCp -> precision = out -> precision;
+
+    return outCp;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int spec_out_add_label(spec_out_t *out, const char *label)
+{
+    /*
+
+        Add an output label to out
+
+    */
+
+    /* Label already contained in out -> labels */
+    if (misc_ssearch(out -> labels, out -> size, label, NULL))
+        return 0;
+
+    /* Increment the output size and reallocate memory */
+    out -> size += 1;
+    out -> labels = realloc(out -> labels, sizeof(char*) * out -> size);
+    out -> err = realloc(out -> err, sizeof(bool) * out -> size);
+    out -> log = realloc(out -> log, sizeof(bool) * out -> size);
+
+    /* Add the label */
+    out -> labels[out -> size - 1] = misc_scat(1, label);
+
+    /* Set the flags to _false_ */
+    out -> err[out -> size - 1] = _false_;
+    out -> log[out -> size - 1] = _false_;
+
+    return 0;
+}
+
+
+int spec_out_rm_label(spec_out_t *out, const char *label)
+{
+    /*
+
+        Remove an output label from out
+
+    */
+
+    bool success;
+
+    /* Get the index */
+    size_t index = misc_ssearch_index(out -> labels, out -> size, label, &success);
+
+    /* Not in the array */
+    if (!success)
+        return 0;
+
+    /* Decrease the size of the array */
+    out -> size -= 1;
+
+    /* Push the string to the end of the array */
+    for (size_t i = index; i < out -> size; i++)
+      {
+        misc_swap(&(out -> labels)[i], &(out -> labels)[i+1], "s");
+        misc_swap(&(out -> err)[i], &(out -> err)[i+1], "b");
+        misc_swap(&(out -> log)[i], &(out -> log)[i+1], "b");
+      }
+
+    /* Free the last label */
+    free(out -> labels[out -> size]);
+
+    /* Reallocate memory */
+    out -> labels = realloc(out -> labels, sizeof(char*) * out -> size);
+    out -> err = realloc(out -> err, sizeof(bool*) * out -> size);
+    out -> log = realloc(out -> log, sizeof(bool*) * out -> size);
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int spec_out_set_err(spec_out_t *out, const char *label, bool err)
+{
+    /*
+
+        Set the error flag for the output label in out
+
+    */
+
+    bool success;
+
+    /* Get the index */
+    size_t index = misc_ssearch_index(out -> labels, out -> size, label, &success);
+
+    /* Not in the array */
+    if (!success)
+      {
+        printf("Cannot set the integration error flag for non-existent label '%s' in a spec_out_t struct!\n", label);
+
+        return 0;
+      }
+
+    out -> err[index] = err;
+
+    return 0;
+}
+
+
+int spec_out_set_log(spec_out_t *out, const char *label, bool log)
+{
+    /*
+
+        Set the logarithimic derivative flag for the output label in out
+
+    */
+
+    bool success;
+
+    /* Get the index */
+    size_t index = misc_ssearch_index(out -> labels, out -> size, label, &success);
+
+    /* Not in the array */
+    if (!success)
+      {
+        printf("Cannot set the logarithmic derivative flag for non-existent label '%s' in a spec_out_t struct!\n", label);
+
+        return 0;
+      }
+
+    out -> log[index] = log;
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int spec_out_set_file(spec_out_t *out, const char *file)
+{
+    /*
+
+        Set the file name in out (if file is NULL nothing will be output to file)
+
+    */
+
+    misc_scp(&(out -> file), file);
+
+    return 0;
+}
+
+
+int spec_out_set_binary(spec_out_t *out, bool binary)
+{
+    /*
+
+        Set the binary flag for out
+
+    */
+
+    out -> binary = binary;
+
+    return 0;
+}
+
+
+int spec_out_set_precision(spec_out_t *out, int precision)
+{
+    /*
+
+        Set the precision in the output file for out -> also set the binary flag to _false_
+
+    */
+
+    out -> binary = _false_;
+    out -> precision = precision;
+
+    return 0;
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ----------------------------------------   Spectra Struct   ------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+spec_dat_t *spec_dat_new(const char *id)
+{
+    /*
+
+        New spec_dat_t struct
+
+    */
+
+    spec_dat_t *specDat = malloc(sizeof(spec_dat_t));
+
+    /* Info struct */
+    _spec_info_t *info = _spec_info_get_struct(id);
+
+    /* Id */
+    specDat -> id = info -> id;
+
+    /* Output */
+    specDat -> out = NULL;
+
+    /* Print */
+    specDat -> flags = NULL;
+
+    return specDat;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+spec_dat_t *spec_dat_free(spec_dat_t *specDat)
+{
+    /*
+
+        Free a spec_dat_t struct
+
+    */
+
+    /* Check for NULL */
+    if (specDat == NULL)
+        return NULL;
+
+    /* Free contents */
+
+    /* Out */
+    specDat -> out = spec_out_free(specDat -> out);
+
+    /* Flags */
+    specDat -> flags = print_flags_free(specDat -> flags);
+
+    /* Free spec itself */
+    free(specDat);
+
+    return NULL;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int spec_dat_set_out(spec_dat_t *specDat, spec_out_t *out)
+{
+    /*
+
+        Set the output parameters for spec
+
+    */
+
+    specDat -> out = spec_out_free(specDat -> out);
+    specDat -> out = spec_out_cp(out);
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+int spec_dat_set_flags(spec_dat_t *specDat, print_flags_t *flags)
+{
+    /*
+
+        Set the print parameters for spec
+
+    */
+
+    specDat -> flags = print_flags_free(specDat -> flags);
+    specDat -> flags = print_flags_cp(flags);
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+spec_out_t *spec_dat_get_out(spec_dat_t *specDat)
+{
+    /*
+
+        Get the out struct from specDat
+
+    */
+
+    return specDat -> out;
+}
+
+
+print_flags_t *spec_dat_get_flags(spec_dat_t *specDat)
+{
+    /*
+
+        Get the print struct from specDat
+
+    */
+
+    return specDat -> flags;
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ---------------------------------------   Default Settings   -----------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+spec_dat_t *spec_dat_pnl_default(void)
+{
+    /*
+
+        Default parameters for the non-linear power spectrum function
+
+    */
+
+    spec_dat_t *specDat = spec_dat_new(_idSpecPnl_);
+
+
+    /* Output */
+
+    spec_out_t *out = spec_out_new();
+
+    /* Labels and errors */
+    for (size_t i = 0; i < _pnlInfo -> partsSize; i++)
+      {
+        spec_out_add_label(out, _pnlInfo -> partsLabels[i]);
+        spec_out_set_err(out, _pnlInfo -> partsLabels[i], *_pnlInfo -> partsHasErr[i]);
+      }
+
+    /* File */
+    char *outFile = misc_scat(2, _pnlInfo -> id, _outExt);
+    spec_out_set_file(out, outFile);
+    free(outFile);
+
+    /* Precision / Binary */
+    spec_out_set_precision(out, 16);
+    spec_out_set_binary(out, _true_);
+
+    spec_dat_set_out(specDat, out);
+
+    out = spec_out_free(out);
+
+
+    /* Flags */
+
+    print_flags_t *flags = print_flags_new();
+
+    print_flags_set_main(flags, _true_);
+    print_flags_set_sub(flags, _false_);
+    print_flags_set_fid(flags, _false_);
+
+    spec_dat_set_flags(specDat, flags);
+
+    flags = print_flags_free(flags);
+
+
+    return specDat;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+spec_dat_t *spec_dat_dpnl_default(void)
+{
+    /*
+
+        Default parameters for the non-linear power spectrum derivatives function
+
+    */
+
+    spec_dat_t *specDat = spec_dat_new(_idSpecDPnl_);
+
+
+    /* Output */
+
+    spec_out_t *out = spec_out_new();
+
+    /* Labels and errors */
+    for (size_t i = 0; i < _dpnlInfo -> partsSize; i++)
+      {
+        spec_out_add_label(out, _dpnlInfo -> partsLabels[i]);
+        spec_out_set_err(out, _dpnlInfo -> partsLabels[i], *_dpnlInfo -> partsHasErr[i]);
+      }
+
+    /* File */
+    char *outFile = misc_scat(2, _dpnlInfo -> id, _outExt);
+    spec_out_set_file(out, outFile);
+    free(outFile);
+
+    /* Precision / Binary */
+    spec_out_set_precision(out, 16);
+    spec_out_set_binary(out, _true_);
+
+    spec_dat_set_out(specDat, out);
+
+    out = spec_out_free(out);
+
+
+    /* Flags */
+
+    print_flags_t *flags = print_flags_new();
+
+    print_flags_set_main(flags, _true_);
+    print_flags_set_sub(flags, _false_);
+    print_flags_set_fid(flags, _false_);
+
+    spec_dat_set_flags(specDat, flags);
+
+    flags = print_flags_free(flags);
+
+
+    return specDat;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+spec_dat_t *spec_dat_btr_default(void)
+{
+    /*
+
+        Default parameters for the tree-level bispectrum function
+
+    */
+
+    spec_dat_t *specDat = spec_dat_new(_idSpecBtr_);
+
+
+    /* Output */
+
+    spec_out_t *out = spec_out_new();
+
+    /* Labels and errors */
+    for (size_t i = 0; i < _btrInfo -> partsSize; i++)
+      {
+        spec_out_add_label(out, _btrInfo -> partsLabels[i]);
+        spec_out_set_err(out, _btrInfo -> partsLabels[i], *_btrInfo -> partsHasErr[i]);
+      }
+
+    /* File */
+    char *outFile = misc_scat(2, _btrInfo -> id, _outExt);
+    spec_out_set_file(out, outFile);
+    free(outFile);
+
+    /* Precision / Binary */
+    spec_out_set_precision(out, 16);
+    spec_out_set_binary(out, _true_);
+
+    spec_dat_set_out(specDat, out);
+
+    out = spec_out_free(out);
+
+
+    /* Flags */
+
+    print_flags_t *flags = print_flags_new();
+
+    print_flags_set_main(flags, _true_);
+    print_flags_set_sub(flags, _false_);
+    print_flags_set_fid(flags, _false_);
+
+    spec_dat_set_flags(specDat, flags);
+
+    flags = print_flags_free(flags);
+
+
+    return specDat;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+spec_dat_t *spec_dat_dbtr_default(void)
+{
+    /*
+
+        Default parameters for the tree-level bispectrum function
+
+    */
+
+    spec_dat_t *specDat = spec_dat_new(_idSpecDBtr_);
+
+
+    /* Output */
+
+    spec_out_t *out = spec_out_new();
+
+    /* Labels and errors */
+    for (size_t i = 0; i < _dbtrInfo -> partsSize; i++)
+      {
+        spec_out_add_label(out, _dbtrInfo -> partsLabels[i]);
+        spec_out_set_err(out, _dbtrInfo -> partsLabels[i], *_dbtrInfo -> partsHasErr[i]);
+      }
+
+    /* File */
+    char *outFile = misc_scat(2, _dbtrInfo -> id, _outExt);
+    spec_out_set_file(out, outFile);
+    free(outFile);
+
+    /* Precision / Binary */
+    spec_out_set_precision(out, 16);
+    spec_out_set_binary(out, _true_);
+
+    spec_dat_set_out(specDat, out);
+
+    out = spec_out_free(out);
+
+
+    /* Flags */
+
+    print_flags_t *flags = print_flags_new();
+
+    print_flags_set_main(flags, _true_);
+    print_flags_set_sub(flags, _false_);
+    print_flags_set_fid(flags, _false_);
+
+    spec_dat_set_flags(specDat, flags);
+
+    flags = print_flags_free(flags);
+
+
+    return specDat;
+}
+
+
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%     CALCULATE SPECTRA     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ---------------------------------------   Setup Data Struct   ----------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ####################################   Function Declarations   #######################################  */
+
+static int _setup_dat_append_y(_spec_info_t *info, spec_dat_t *specDat, dat_t *dat, char *label, bool err, size_t index, int *depth);
+
+/*  ######################################################################################################  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static dat_t *_spec_dat_setup_dat(_spec_info_t *info, spec_dat_t *specDat)
+{
+    /*
+
+        Setup the output dat_t struct
+
+    */
+
+
+    /* Variables of the data */
+
+    sample_shape_t *sampleShape = flss_get_sample_shape(specDat -> id);
+
+    sample_raw_t *sampleRawZ = flss_get_sample_redshift();
+    sample_arg_t *sampleArgZ = sampleRawZ -> sampleArg;
+
+    /* Data dimensions */
+    size_t xDim = 1 + 3 * (sampleShape -> dim - 1) - 1; // 1 for temporal; 3 * (dim - 1) - 1 for spatial (3 * dim for 3 spatial vectors, -3 for delta and -1 for free choice of one variable)
+    size_t yDim = 0;
+    size_t size = sampleArgZ -> size * sampleShape -> size;
+
+    /* Allocate memory */
+    dat_t *dat = dat_new(xDim, yDim, size);
+
+    /* Set the x labels */
+    char *label, buf[5];
+    size_t position = 0;
+
+    label = misc_scat(3, "'", _idVarZ_, "'");
+    dat_set_xlabel(dat, position++, label);
+    free(label);
+
+    for (size_t i = 0; i < sampleShape -> dimLength; i++)
+      {
+        if (sampleShape -> dimLength == 1)
+            label = misc_scat(3, "'", _idVarK_, "'");
+        else
+          {
+            snprintf(buf, 5, "%ld", i + 1);
+            label = misc_scat(4, "'", _idVarK_, buf, "'");
+          }
+
+        dat_set_xlabel(dat, position++, label);
+        free(label);
+      }
+
+    for (size_t i = 0; i < sampleShape -> dimOrientation; i++)
+      {
+        if (sampleShape -> dimOrientation == 1)
+            label = misc_scat(3, "'", _idVarMu_, "'");
+        else
+          {
+            snprintf(buf, 5, "%ld", i + 1);
+            label = misc_scat(4, "'", _idVarMu_, buf, "'");
+          }
+
+        dat_set_xlabel(dat, position++, label);
+        free(label);
+      }
+
+
+    /* Data columns */
+
+    /* Search for the labels and append new columns to the data struct */
+    for (size_t i = 0; i < info -> partsSize; i++)
+      {
+        if (!(*(info -> partsExist[i])))
+            continue;
+
+        bool success;
+        size_t index = misc_ssearch_index(specDat -> out -> labels, specDat -> out -> size, info -> partsLabels[i], &success);
+
+        if (info -> partsDerivLog != NULL)
+          {
+            info -> partsDerivLog[i] = specDat -> out -> log[index];
+          }
+
+        if (info -> partsDerivVals != NULL)
+          {
+            info -> partsDerivVals[i] = dat_free(info -> partsDerivVals[i]);
+          }
+
+        if (success)
+          {
+            int depth = 0;
+
+            _setup_dat_append_y(info, specDat, dat, info -> partsLabels[i], *info -> partsHasErr[i] && specDat -> out -> err[index], i, &depth);
+          }
+      }
+
+    /* Did not find any matching label */
+    if (dat -> yDim == 0)
+      {
+        printf("Labels for the '%s' function were either not provided or did not fit any of the expected labels.\n", info -> id);
+      }
+
+    return dat;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static int _setup_dat_append_y(_spec_info_t *info, spec_dat_t *specDat, dat_t *dat, char *label, bool err, size_t index, int *depth)
+{
+    /*
+
+        Append y columns to dat
+
+    */
+
+    /* No derivatives */
+    if (info -> partsDerivMult == NULL)
+        goto appendCol;
+
+    /* Variables */
+    sample_shape_t *sampleShape = flss_get_sample_shape(specDat -> id);
+
+    sample_raw_t *sampleRawZ = flss_get_sample_redshift();
+    sample_arg_t *sampleArgZ = sampleRawZ -> sampleArg;
+
+    sample_raw_t *sampleRawK = sampleShape -> sampleRawLength;
+    sample_arg_t *sampleArgK = sampleRawK -> sampleArg;
+
+    sample_raw_t *sampleRawMu = sampleShape -> sampleRawOrientation;
+    sample_arg_t *sampleArgMu = sampleRawMu -> sampleArg;
+
+    int currDepth = *depth;
+    *depth += 1;
+
+    /* Redshift z */
+    if (currDepth == 0)
+      {
+        /* Full multiplicity */
+        if (info -> partsDerivMult[index][0] == 1)
+          {
+            /* z sample as dat struct */
+            dat_t *sampleZDat = dat_new(1, 0, sampleArgZ -> size);
+
+            for (size_t i = 0; i < sampleArgZ -> size; i++)
+                dat_set_value(sampleZDat, 0, i, 'x', sampleRawZ -> array[i]);
+
+            /* Derivative values */
+            dat_t *derivVals = dat_cat(2, info -> partsDerivVals[index], sampleZDat);
+            info -> partsDerivVals[index] = dat_free(info -> partsDerivVals[index]);
+            info -> partsDerivVals[index] = dat_cat(1, derivVals);
+            derivVals = dat_free(derivVals);
+            sampleZDat = dat_free(sampleZDat);
+
+            dat_set_xlabel(info -> partsDerivVals[index], info -> partsDerivVals[index] -> xDim - 1, (char*) _idVarZ_);
+
+            for (size_t i = 0; i < sampleArgZ -> size; i++)
+              {
+                /* Get the z value as a string */
+                char *zToString = misc_dtos(sampleRawZ -> array[i], __XSBUFFER__);
+
+                /* Total label */
+                char *totLabel = misc_scat(6, label, " [", _idVarZ_, " = ", zToString, "]");
+
+                /* Append a new column */
+                _setup_dat_append_y(info, specDat, dat, totLabel, err, index, depth);
+                *depth = currDepth + 1;
+
+                /* Free memory */
+                free(zToString);
+                free(totLabel);
+              }
+
+            return 0;
+          }
+
+        /* Partial multiplicity */
+        else if (info -> partsDerivMult[index][0] == -1)
+          {
+            /* Total label */
+            char *totLabel = misc_scat(6, label, " [", _idVarZ_, " = ", _idVarZ_, "']");
+
+            /* Append a new column */
+            _setup_dat_append_y(info, specDat, dat, totLabel, err, index, depth);
+
+            /* Free memory */
+            free(totLabel);
+
+            return 0;
+          }
+
+        /* No multiplicity */
+        else
+          {
+            _setup_dat_append_y(info, specDat, dat, label, err, index, depth);
+
+            return 0;
+          }
+      }
+
+
+    /* Scale k */
+    if (currDepth == 1)
+      {
+        /* Full multiplicity */
+        if (info -> partsDerivMult[index][1] == 1)
+          {
+            /* k sample as dat struct */
+            dat_t *sampleKDat = dat_new(1, 0, sampleArgK -> size);
+
+            for (size_t i = 0; i < sampleArgK -> size; i++)
+                dat_set_value(sampleKDat, 0, i, 'x', sampleRawK -> array[i]);
+
+            /* Derivative values */
+            dat_t *derivVals = dat_cat(2, info -> partsDerivVals[index], sampleKDat);
+            info -> partsDerivVals[index] = dat_free(info -> partsDerivVals[index]);
+            info -> partsDerivVals[index] = dat_cat(1, derivVals);
+            derivVals = dat_free(derivVals);
+            sampleKDat = dat_free(sampleKDat);
+
+            dat_set_xlabel(info -> partsDerivVals[index], info -> partsDerivVals[index] -> xDim - 1, (char*) _idVarK_);
+
+            for (size_t i = 0; i < sampleArgK -> size; i++)
+              {
+                /* Get the k value as a string */
+                char *kToString = misc_dtos(sampleRawK -> array[i], __XSBUFFER__);
+
+                /* Total label */
+                char *totLabel = misc_scat(6, label, " [", _idVarK_, " = ", kToString, "]");
+
+                /* Append a new column */
+                _setup_dat_append_y(info, specDat, dat, totLabel, err, index, depth);
+                *depth = currDepth + 1;
+
+                /* Free memory */
+                free(kToString);
+                free(totLabel);
+              }
+
+            return 0;
+          }
+
+        /* Partial multiplicity */
+        else if (info -> partsDerivMult[index][1] == -1)
+          {
+            /* Total label */
+            char *totLabel = misc_scat(6, label, " [", _idVarK_, " = ", _idVarK_, "']");
+
+            /* Append a new column */
+            _setup_dat_append_y(info, specDat, dat, totLabel, err, index, depth);
+
+            /* Free memory */
+            free(totLabel);
+
+            return 0;
+          }
+
+        /* No multiplicity */
+        else
+          {
+            _setup_dat_append_y(info, specDat, dat, label, err, index, depth);
+
+            return 0;
+          }
+      }
+
+
+    /* Angle mu */
+    if (currDepth == 2)
+      {
+        /* Full multiplicity */
+        if (info -> partsDerivMult[index][2] == 1)
+          {
+            /* mu sample as dat struct */
+            dat_t *sampleMuDat = dat_new(1, 0, sampleArgMu -> size);
+
+            for (size_t i = 0; i < sampleArgMu -> size; i++)
+                dat_set_value(sampleMuDat, 0, i, 'x', sampleRawMu -> array[i]);
+
+            /* Derivative values */
+            dat_t *derivVals = dat_cat(2, info -> partsDerivVals[index], sampleMuDat);
+            info -> partsDerivVals[index] = dat_free(info -> partsDerivVals[index]);
+            info -> partsDerivVals[index] = dat_cat(1, derivVals);
+            derivVals = dat_free(derivVals);
+            sampleMuDat = dat_free(sampleMuDat);
+
+            dat_set_xlabel(info -> partsDerivVals[index], info -> partsDerivVals[index] -> xDim - 1, (char*) _idVarMu_);
+
+            for (size_t i = 0; i < sampleArgMu -> size; i++)
+              {
+                /* Get the mu value as a string */
+                char *muToString = misc_dtos(sampleRawMu -> array[i], __XSBUFFER__);
+
+                /* Total label */
+                char *totLabel = misc_scat(6, label, " [", _idVarMu_, " = ", muToString, "]");
+
+                /* Append a new column */
+                _setup_dat_append_y(info, specDat, dat, totLabel, err, index, depth);
+                *depth = currDepth + 1;
+
+                /* Free memory */
+                free(muToString);
+                free(totLabel);
+              }
+
+            return 0;
+          }
+
+        /* Partial multiplicity */
+        else if (info -> partsDerivMult[index][2] == -1)
+          {
+            /* Total label */
+            char *totLabel = misc_scat(6, label, " [", _idVarMu_, " = ", _idVarMu_, "']");
+
+            /* Append a new column */
+            _setup_dat_append_y(info, specDat, dat, totLabel, err, index, depth);
+
+            /* Free memory */
+            free(totLabel);
+
+            return 0;
+          }
+
+        /* No multiplicity */
+        else
+          {
+            _setup_dat_append_y(info, specDat, dat, label, err, index, depth);
+
+            return 0;
+          }
+      }
+
+    appendCol:
+
+    /* Append another column */
+    dat_append_y(dat, label);
+
+    /* Append another column for errors */
+    if (err)
+      {
+        /* Total label */
+        char *totLabel = misc_scat(3, label, " ", _idIntError_);
+
+        /* Append a new column */
+        dat_append_y(dat, totLabel);
+
+        /* Free memory */
+        free(totLabel);
+      }
+
+    return 0;
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  -------------------------------   Integration Bins for Derivatives   ---------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+// TODO: Improve this...
+
+
+static int _spec_dpnl_setup_bin(void)
+{
+    /*
+
+        Setup the integration bins for the power spectrum derivatives
+
+    */
+
+    int threadsNum = omp_get_max_threads();
+
+    /* Integral bins */
+    _pnl1LoopBin = malloc(sizeof(double*) * (size_t) threadsNum);
+    _dpnlK1LoopBin = malloc(sizeof(double*) * (size_t) threadsNum);
+    _dpnlMu1LoopBin = malloc(sizeof(double*) * (size_t) threadsNum);
+
+    for (size_t i = 0; i < (size_t) threadsNum; i++)
+      {
+        _pnl1LoopBin[i] = NULL;
+        _dpnlK1LoopBin[i] = NULL;
+        _dpnlMu1LoopBin[i] = NULL;
+      }
+
+    return 0;
+}
+
+
+static int _spec_dpnl_reset_bin(int thread)
+{
+    /*
+
+        Reset the integration bin for the power spectrum derivatives for a single thread
+
+    */
+
+    if (_pnl1LoopBin[thread] != NULL) free(_pnl1LoopBin[thread]);
+    _pnl1LoopBin[thread] = NULL;
+
+    if (_dpnlK1LoopBin[thread] != NULL) free(_dpnlK1LoopBin[thread]);
+    _dpnlK1LoopBin[thread] = NULL;
+
+    if (_dpnlMu1LoopBin[thread] != NULL) free(_dpnlMu1LoopBin[thread]);
+    _dpnlMu1LoopBin[thread] = NULL;
+
+    return 0;
+}
+
 
+static int _spec_dpnl_free_bin(void)
+{
+    /*
 
-    /* Output */
+        Free the integration bins for the power spectrum derivatives
 
-    spec_out_t *out = spec_out_new();
+    */
 
-    /* Labels and errors */
-    for (size_t i = 0; i < _btrInfo -> partsSize; i++)
+    int threadsNum = omp_get_max_threads();
+
+    if (_pnl1LoopBin != NULL)
       {
-        spec_out_add_label(out, _btrInfo -> partsLabels[i]);
-        spec_out_set_err(out, _btrInfo -> partsLabels[i], *_btrInfo -> partsHasErr[i]);
+        for (size_t i = 0; i < (size_t) threadsNum; i++)
+          {
+            if (_pnl1LoopBin[i] != NULL) free(_pnl1LoopBin[i]);
+          }
+
+        free(_pnl1LoopBin);
+
+        _pnl1LoopBin = NULL;
       }
 
-    /* File */
-    char *outFile = misc_scat(2, _btrInfo -> id, _outExt);
-    spec_out_set_file(out, outFile);
-    free(outFile);
+    if (_dpnlK1LoopBin != NULL)
+      {
+        for (size_t i = 0; i < (size_t) threadsNum; i++)
+          {
+            if (_dpnlK1LoopBin[i] != NULL) free(_dpnlK1LoopBin[i]);
+          }
 
-    /* Precision / Binary */
-    spec_out_set_precision(out, 16);
-    spec_out_set_binary(out, _true_);
+        free(_dpnlK1LoopBin);
 
-    spec_dat_set_out(specDat, out);
+        _dpnlK1LoopBin = NULL;
+      }
 
-    out = spec_out_free(out);
+    if (_dpnlMu1LoopBin != NULL)
+      {
+        for (size_t i = 0; i < (size_t) threadsNum; i++)
+          {
+            if (_dpnlMu1LoopBin[i] != NULL) free(_dpnlMu1LoopBin[i]);
+          }
 
+        free(_dpnlMu1LoopBin);
 
-    /* Flags */
+        _dpnlMu1LoopBin = NULL;
+      }
 
-    print_flags_t *flags = print_flags_new();
+    return 0;
+}
 
-    print_flags_set_main(flags, _true_);
-    print_flags_set_sub(flags, _false_);
-    print_flags_set_fid(flags, _false_);
 
-    spec_dat_set_flags(specDat, flags);
 
-    flags = print_flags_free(flags);
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ---------------------------------   Loop Integrals as Polynomials   ----------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
 
 
-    return specDat;
-}
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ####################################   Function Declarations   #######################################  */
 
+static size_t _spec_dpnl_loop_comp(double integrand(double*, size_t, void*));
 
+static intgrt_vegas_grid_t *_spec_vegas_grid_get(kern_t *kern, double integrand(double*, size_t, void*));
+
+static int _spec_loop_integrate(kern_t *kern, double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result);
+
+static int _spec_loop_radial(kern_t *kern, double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result);
+
+/*  ######################################################################################################  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-spec_dat_t *spec_dat_dbtr_default(void)
+static int _spec_mu_poly_setup(void)
 {
     /*
 
-        Default parameters for the tree-level bispectrum function
+        Setup the mu^2 polynomials of the loop integrals (one set of slots for every thread)
 
     */
 
-    spec_dat_t *specDat = spec_dat_new(_idSpecDBtr_);
+    int threadsNum = omp_get_max_threads();
 
+    _loopMuPoly = malloc(sizeof(_spec_mu_poly_t*) * (size_t) threadsNum);
 
-    /* Output */
+    for (size_t i = 0; i < (size_t) threadsNum; i++)
+      {
+        _loopMuPoly[i] = malloc(sizeof(_spec_mu_poly_t) * __SPEC_MU_POLY_SLOTS__);
 
-    spec_out_t *out = spec_out_new();
+        for (size_t j = 0; j < __SPEC_MU_POLY_SLOTS__; j++)
+          {
+            _loopMuPoly[i][j].integrand = NULL;
+            _loopMuPoly[i][j].integrandVec = NULL;
+            _loopMuPoly[i][j].computed = false;
+          }
+      }
 
-    /* Labels and errors */
-    for (size_t i = 0; i < _dbtrInfo -> partsSize; i++)
+    return 0;
+}
+
+
+static int _spec_mu_poly_free(void)
+{
+    /*
+
+        Free the mu^2 polynomials of the loop integrals
+
+    */
+
+    if (_loopMuPoly == NULL)
       {
-        spec_out_add_label(out, _dbtrInfo -> partsLabels[i]);
-        spec_out_set_err(out, _dbtrInfo -> partsLabels[i], *_dbtrInfo -> partsHasErr[i]);
+        return 0;
       }
 
-    /* File */
-    char *outFile = misc_scat(2, _dbtrInfo -> id, _outExt);
-    spec_out_set_file(out, outFile);
-    free(outFile);
+    int threadsNum = omp_get_max_threads();
 
-    /* Precision / Binary */
-    spec_out_set_precision(out, 16);
-    spec_out_set_binary(out, _true_);
+    for (size_t i = 0; i < (size_t) threadsNum; i++)
+      {
+        free(_loopMuPoly[i]);
+      }
 
-    spec_dat_set_out(specDat, out);
+    free(_loopMuPoly);
 
-    out = spec_out_free(out);
+    _loopMuPoly = NULL;
 
+    for (size_t i = 0; i < __INTGRND_DPNL_SIZE__; i++)
+        _dpnlLoopComp[i] = false;
 
-    /* Flags */
+    return 0;
+}
 
-    print_flags_t *flags = print_flags_new();
 
-    print_flags_set_main(flags, _true_);
-    print_flags_set_sub(flags, _false_);
-    print_flags_set_fid(flags, _false_);
+/*  ------------------------------------------------------------------------------------------------------  */
 
-    spec_dat_set_flags(specDat, flags);
 
-    flags = print_flags_free(flags);
+static _spec_mu_poly_t *_spec_mu_poly_get(kern_t *kern, double integrand(double*, size_t, void*), int integrandVec(double*, size_t, void*, double*))
+{
+    /*
 
+        Get the slot of the current thread for the (vector valued) integrand. The slot is marked as not computed if
+        (z, k) or the fiducials have changed since the polynomial was computed. Returns NULL if no slot is available.
 
-    return specDat;
-}
+    */
+
+    if (_loopMuPoly == NULL)
+      {
+        return NULL;
+      }
 
+    _spec_mu_poly_t *slots = _loopMuPoly[omp_get_thread_num()];
+
+    for (size_t i = 0; i < __SPEC_MU_POLY_SLOTS__; i++)
+      {
+        bool empty = slots[i].integrand == NULL && slots[i].integrandVec == NULL;
 
+        /* Slot of another integrand */
+        if (!empty && (slots[i].integrand != integrand || slots[i].integrandVec != integrandVec))
+          {
+            continue;
+          }
 
+        _spec_mu_poly_t *muPoly = &slots[i];
 
+        /* Polynomial can be reused */
+        if (!empty && muPoly -> computed
+            && muPoly -> z == kern -> z && muPoly -> k == kernels_qget_k(kern, 0)
+            && !memcmp(&muPoly -> btst, kern -> btst, sizeof(fid_btst_t))
+            && !memcmp(&muPoly -> bias, kern -> bias, sizeof(fid_bias_t))
+            && !memcmp(&muPoly -> rsd, kern -> rsd, sizeof(fid_rsd_t)))
+          {
+            return muPoly;
+          }
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
-/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%     CALCULATE SPECTRA     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
-/*  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  */
-/*  ------------------------------------------------------------------------------------------------------  */
+        /* (Re)claim the slot */
+        muPoly -> integrand = integrand;
+        muPoly -> integrandVec = integrandVec;
+        muPoly -> computed = false;
 
+        muPoly -> z = kern -> z;
+        muPoly -> k = kernels_qget_k(kern, 0);
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  ---------------------------------------   Setup Data Struct   ----------------------------------------  */
-/*  ------------------------------------------------------------------------------------------------------  */
+        muPoly -> btst = *kern -> btst;
+        muPoly -> bias = *kern -> bias;
+        muPoly -> rsd = *kern -> rsd;
 
+        return muPoly;
+      }
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  ####################################   Function Declarations   #######################################  */
+    return NULL;
+}
 
-static int _setup_dat_append_y(_spec_info_t *info, spec_dat_t *specDat, dat_t *dat, char *label, bool err, size_t index, int *depth);
 
-/*  ######################################################################################################  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-static dat_t *_spec_dat_setup_dat(_spec_info_t *info, spec_dat_t *specDat)
+static int _spec_vegas_grid_setup(void)
 {
     /*
 
-        Setup the output dat_t struct
+        Setup the VEGAS grids of the loop integrals (one set of slots for every thread)
 
     */
 
+    int threadsNum = omp_get_max_threads();
 
-    /* Variables of the data */
+    _loopVegasGrid = malloc(sizeof(_spec_vegas_grid_t*) * (size_t) threadsNum);
+    _loopVegasGridNext = malloc(sizeof(size_t) * (size_t) threadsNum);
 
-    sample_shape_t *sampleShape = flss_get_sample_shape(specDat -> id);
+    for (size_t i = 0; i < (size_t) threadsNum; i++)
+      {
+        _loopVegasGrid[i] = malloc(sizeof(_spec_vegas_grid_t) * __SPEC_VEGAS_GRID_SLOTS__);
+        _loopVegasGridNext[i] = 0;
 
-    sample_raw_t *sampleRawZ = flss_get_sample_redshift();
-    sample_arg_t *sampleArgZ = sampleRawZ -> sampleArg;
+        for (size_t j = 0; j < __SPEC_VEGAS_GRID_SLOTS__; j++)
+          {
+            _loopVegasGrid[i][j].integrand = NULL;
+            _loopVegasGrid[i][j].grid = integrate_vegas_grid_new();
+          }
+      }
 
-    /* Data dimensions */
-    size_t xDim = 1 + 3 * (sampleShape -> dim - 1) - 1; // 1 for temporal; 3 * (dim - 1) - 1 for spatial (3 * dim for 3 spatial vectors, -3 for delta and -1 for free choice of one variable)
-    size_t yDim = 0;
-    size_t size = sampleArgZ -> size * sampleShape -> size;
+    return 0;
+}
 
-    /* Allocate memory */
-    dat_t *dat = dat_new(xDim, yDim, size);
 
-    /* Set the x labels */
-    char *label, buf[5];
-    size_t position = 0;
+static int _spec_vegas_grid_free(void)
+{
+    /*
 
-    label = misc_scat(3, "'", _idVarZ_, "'");
-    dat_set_xlabel(dat, position++, label);
-    free(label);
+        Free the VEGAS grids of the loop integrals
 
-    for (size_t i = 0; i < sampleShape -> dimLength; i++)
-      {
-        if (sampleShape -> dimLength == 1)
-            label = misc_scat(3, "'", _idVarK_, "'");
-        else
-          {
-            snprintf(buf, 5, "%ld", i + 1);
-            label = misc_scat(4, "'", _idVarK_, buf, "'");
-          }
+    */
 
-        dat_set_xlabel(dat, position++, label);
-        free(label);
+    if (_loopVegasGrid == NULL)
+      {
+        return 0;
       }
 
-    for (size_t i = 0; i < sampleShape -> dimOrientation; i++)
+    int threadsNum = omp_get_max_threads();
+
+    for (size_t i = 0; i < (size_t) threadsNum; i++)
       {
-        if (sampleShape -> dimOrientation == 1)
-            label = misc_scat(3, "'", _idVarMu_, "'");
-        else
-          {
-            snprintf(buf, 5, "%ld", i + 1);
-            label = misc_scat(4, "'", _idVarMu_, buf, "'");
-          }
+        for (size_t j = 0; j < __SPEC_VEGAS_GRID_SLOTS__; j++)
+            _loopVegasGrid[i][j].grid = integrate_vegas_grid_free(_loopVegasGrid[i][j].grid);
 
-        dat_set_xlabel(dat, position++, label);
-        free(label);
+        free(_loopVegasGrid[i]);
       }
 
+    free(_loopVegasGrid);
+    free(_loopVegasGridNext);
 
-    /* Data columns */
+    _loopVegasGrid = NULL;
+    _loopVegasGridNext = NULL;
 
-    /* Search for the labels and append new columns to the data struct */
-    for (size_t i = 0; i < info -> partsSize; i++)
-      {
-        if (!(*(info -> partsExist[i])))
-            continue;
+    return 0;
+}
 
-        bool success;
-        size_t index = misc_ssearch_index(specDat -> out -> labels, specDat -> out -> size, info -> partsLabels[i], &success);
 
-        if (info -> partsDerivLog != NULL)
-          {
-            info -> partsDerivLog[i] = specDat -> out -> log[index];
-          }
+/*  ------------------------------------------------------------------------------------------------------  */
 
-        if (info -> partsDerivVals != NULL)
-          {
-            info -> partsDerivVals[i] = dat_free(info -> partsDerivVals[i]);
-          }
 
-        if (success)
-          {
-            int depth = 0;
+static intgrt_vegas_grid_t *_spec_vegas_grid_get(kern_t *kern, double integrand(double*, size_t, void*))
+{
+    /*
 
-            _setup_dat_append_y(info, specDat, dat, info -> partsLabels[i], *info -> partsHasErr[i] && specDat -> out -> err[index], i, &depth);
-          }
+        Get the VEGAS grid of the current thread for the integrand in the (log k, mu) cell of the current k and mu. If
+        there is none, the next slot (in turn) is reset and claimed. Returns NULL if the grids were not setup.
+
+    */
+
+    if (_loopVegasGrid == NULL)
+      {
+        return NULL;
       }
 
-    /* Did not find any matching label */
-    if (dat -> yDim == 0)
+    int thread = omp_get_thread_num();
+
+    _spec_vegas_grid_t *slots = _loopVegasGrid[thread];
+
+    /* Cell */
+    long cellK = lround(log(kernels_qget_k(kern, 0)) / __SPEC_VEGAS_GRID_DLOGK__);
+    long cellMu = lround(kernels_qget_mu(kern, 0) / __SPEC_VEGAS_GRID_DMU__);
+
+    for (size_t i = 0; i < __SPEC_VEGAS_GRID_SLOTS__; i++)
       {
-        printf("Labels for the '%s' function were either not provided or did not fit any of the expected labels.\n", info -> id);
+        if (slots[i].integrand == integrand && slots[i].cellK == cellK && slots[i].cellMu == cellMu)
+          {
+            return slots[i].grid;
+          }
       }
 
-    return dat;
+    /* (Re)claim the next slot */
+    _spec_vegas_grid_t *slot = &slots[_loopVegasGridNext[thread]];
+    _loopVegasGridNext[thread] = (_loopVegasGridNext[thread] + 1) % __SPEC_VEGAS_GRID_SLOTS__;
+
+    integrate_vegas_grid_reset(slot -> grid);
+
+    slot -> integrand = integrand;
+    slot -> cellK = cellK;
+    slot -> cellMu = cellMu;
+
+    return slot -> grid;
 }
 
 
-/*  ------------------------------------------------------------------------------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-static int _setup_dat_append_y(_spec_info_t *info, spec_dat_t *specDat, dat_t *dat, char *label, bool err, size_t index, int *depth)
+static int _spec_loop_mu(kern_t *kern, double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result)
 {
     /*
 
-        Append y columns to dat
-
-    */
-
-    /* No derivatives */
-    if (info -> partsDerivMult == NULL)
-        goto appendCol;
+        Integrate a loop contribution to the power spectrum at the current (z, k, mu), where the integrand's parameters
+        are given by kern.
 
-    /* Variables */
-    sample_shape_t *sampleShape = flss_get_sample_shape(specDat -> id);
+        The loop integrals are polynomials in mu^2 (up to mu^8 at one-loop). If the polynomials were setup (see
+        _spec_mu_poly_setup), the integral is only computed at the __SPEC_MU_POLY_SIZE__ nodes in mu^2 for every
+        (z, k) and any mu is then evaluated from these.
 
-    sample_raw_t *sampleRawZ = flss_get_sample_redshift();
-    sample_arg_t *sampleArgZ = sampleRawZ -> sampleArg;
+        If the integrand is a component of integrand_spec_dpnl_1loop_vec which is flagged in _dpnlLoopComp and the routine
+        integrates vector valued integrands in one sweep (see integrate_vec_sweep), all flagged components are integrated
+        in the same sweep and the others are then read from the same slot. Otherwise (e.g. with GSL's VEGAS) every
+        component is integrated with its scalar integrand, as for the non-linear power spectrum.
 
-    sample_raw_t *sampleRawK = sampleShape -> sampleRawLength;
-    sample_arg_t *sampleArgK = sampleRawK -> sampleArg;
+    */
 
-    sample_raw_t *sampleRawMu = sampleShape -> sampleRawOrientation;
-    sample_arg_t *sampleArgMu = sampleRawMu -> sampleArg;
+    /* Component of the vector valued integrand */
+    size_t comp = _spec_dpnl_loop_comp(integrand);
+    bool vec = comp < __INTGRND_DPNL_SIZE__ && _dpnlLoopComp[comp] && !_dpnlInfo -> loopRadial && integrate_vec_sweep(intgrt);
 
-    int currDepth = *depth;
-    *depth += 1;
+    _spec_mu_poly_t *muPoly = (vec) ? _spec_mu_poly_get(kern, NULL, integrand_spec_dpnl_1loop_vec) : _spec_mu_poly_get(kern, integrand, NULL);
 
-    /* Redshift z */
-    if (currDepth == 0)
+    /* Integrate directly */
+    if (muPoly == NULL)
       {
-        /* Full multiplicity */
-        if (info -> partsDerivMult[index][0] == 1)
-          {
-            /* z sample as dat struct */
-            dat_t *sampleZDat = dat_new(1, 0, sampleArgZ -> size);
+        _spec_loop_integrate(kern, integrand, intgrt, result);
 
-            for (size_t i = 0; i < sampleArgZ -> size; i++)
-                dat_set_value(sampleZDat, 0, i, 'x', sampleRawZ -> array[i]);
+        return 0;
+      }
 
-            /* Derivative values */
-            dat_t *derivVals = dat_cat(2, info -> partsDerivVals[index], sampleZDat);
-            info -> partsDerivVals[index] = dat_free(info -> partsDerivVals[index]);
-            info -> partsDerivVals[index] = dat_cat(1, derivVals);
-            derivVals = dat_free(derivVals);
-            sampleZDat = dat_free(sampleZDat);
+    /* Chebyshev-Lobatto nodes in mu^2 */
+    double nodes[__SPEC_MU_POLY_SIZE__];
 
-            dat_set_xlabel(info -> partsDerivVals[index], info -> partsDerivVals[index] -> xDim - 1, (char*) _idVarZ_);
+    for (size_t i = 0; i < __SPEC_MU_POLY_SIZE__; i++)
+        nodes[i] = 0.5 * (1. - cos(M_PI * (double) i / (double) (__SPEC_MU_POLY_SIZE__ - 1)));
 
-            for (size_t i = 0; i < sampleArgZ -> size; i++)
-              {
-                /* Get the z value as a string */
-                char *zToString = misc_dtos(sampleRawZ -> array[i], __XSBUFFER__);
+    /* Integrate at the nodes */
+    if (!muPoly -> computed)
+      {
+        double k = kernels_get_k(kern, 0);
+        double mu = kernels_get_mu(kern, 0);
 
-                /* Total label */
-                char *totLabel = misc_scat(6, label, " [", _idVarZ_, " = ", zToString, "]");
+        /* Parameters of the vector valued integrand */
+        intgrnd_dpnl_t paramsDPnl;
+        paramsDPnl.kern = kern;
 
-                /* Append a new column */
-                _setup_dat_append_y(info, specDat, dat, totLabel, err, index, depth);
-                *depth = currDepth + 1;
+        size_t nComp = 0;
 
-                /* Free memory */
-                free(zToString);
-                free(totLabel);
-              }
+        for (size_t j = 0; j < __INTGRND_DPNL_SIZE__; j++)
+          {
+            paramsDPnl.comp[j] = vec && _dpnlLoopComp[j];
+            nComp += (paramsDPnl.comp[j]) ? 1 : 0;
 
-            return 0;
+            muPoly -> info[j] = 0.;
           }
 
-        /* Partial multiplicity */
-        else if (info -> partsDerivMult[index][0] == -1)
+        for (size_t i = 0; i < __SPEC_MU_POLY_SIZE__; i++)
           {
-            /* Total label */
-            char *totLabel = misc_scat(6, label, " [", _idVarZ_, " = ", _idVarZ_, "']");
-
-            /* Append a new column */
-            _setup_dat_append_y(info, specDat, dat, totLabel, err, index, depth);
+            double muNode = sqrt(nodes[i]);
 
-            /* Free memory */
-            free(totLabel);
+            kernels_qset_mu(kern, 0, muNode);
 
-            return 0;
-          }
+            kernels_qset_k(kern, 1, k);
+            kernels_qset_mu(kern, 1, -muNode);
+            kernels_qset_nu(kern, 0, 1, -1.);
 
-        /* No multiplicity */
-        else
-          {
-            _setup_dat_append_y(info, specDat, dat, label, err, index, depth);
+            double resultNode[3 * __INTGRND_DPNL_SIZE__];
 
-            return 0;
-          }
-      }
+            /* Single integrand */
+            if (!vec)
+              {
+                resultNode[2] = 0.;
+                _spec_loop_integrate(kern, integrand, intgrt, resultNode);
 
+                muPoly -> values[0][i] = resultNode[0];
+                muPoly -> errors[0][i] = resultNode[1];
 
-    /* Scale k */
-    if (currDepth == 1)
-      {
-        /* Full multiplicity */
-        if (info -> partsDerivMult[index][1] == 1)
-          {
-            /* k sample as dat struct */
-            dat_t *sampleKDat = dat_new(1, 0, sampleArgK -> size);
+                muPoly -> info[0] = fmax(muPoly -> info[0], resultNode[2]);
 
-            for (size_t i = 0; i < sampleArgK -> size; i++)
-                dat_set_value(sampleKDat, 0, i, 'x', sampleRawK -> array[i]);
+                continue;
+              }
 
-            /* Derivative values */
-            dat_t *derivVals = dat_cat(2, info -> partsDerivVals[index], sampleKDat);
-            info -> partsDerivVals[index] = dat_free(info -> partsDerivVals[index]);
-            info -> partsDerivVals[index] = dat_cat(1, derivVals);
-            derivVals = dat_free(derivVals);
-            sampleKDat = dat_free(sampleKDat);
+            /* All flagged components in one sweep */
+            integrate_set_params(intgrt, &paramsDPnl);
+            integrate_vec(integrand_spec_dpnl_1loop_vec, nComp, intgrt, resultNode);
+            integrate_set_params(intgrt, kern);
 
-            dat_set_xlabel(info -> partsDerivVals[index], info -> partsDerivVals[index] -> xDim - 1, (char*) _idVarK_);
+            size_t n = 0;
 
-            for (size_t i = 0; i < sampleArgK -> size; i++)
+            for (size_t j = 0; j < __INTGRND_DPNL_SIZE__; j++)
               {
-                /* Get the k value as a string */
-                char *kToString = misc_dtos(sampleRawK -> array[i], __XSBUFFER__);
+                if (!paramsDPnl.comp[j])
+                    continue;
 
-                /* Total label */
-                char *totLabel = misc_scat(6, label, " [", _idVarK_, " = ", kToString, "]");
+                muPoly -> values[j][i] = resultNode[3*n];
+                muPoly -> errors[j][i] = resultNode[3*n + 1];
 
-                /* Append a new column */
-                _setup_dat_append_y(info, specDat, dat, totLabel, err, index, depth);
-                *depth = currDepth + 1;
+                muPoly -> info[j] = fmax(muPoly -> info[j], resultNode[3*n + 2]);
 
-                /* Free memory */
-                free(kToString);
-                free(totLabel);
+                n++;
               }
-
-            return 0;
           }
 
-        /* Partial multiplicity */
-        else if (info -> partsDerivMult[index][1] == -1)
-          {
-            /* Total label */
-            char *totLabel = misc_scat(6, label, " [", _idVarK_, " = ", _idVarK_, "']");
+        /* Reset variables */
+        kernels_qset_mu(kern, 0, mu);
 
-            /* Append a new column */
-            _setup_dat_append_y(info, specDat, dat, totLabel, err, index, depth);
+        kernels_qset_k(kern, 1, k);
+        kernels_qset_mu(kern, 1, -mu);
+        kernels_qset_nu(kern, 0, 1, -1.);
 
-            /* Free memory */
-            free(totLabel);
+        muPoly -> computed = true;
+      }
 
-            return 0;
-          }
+    /* Evaluate the polynomial (Lagrange form) */
+    size_t index = (vec) ? comp : 0;
+    double mu2 = fmin(pow(kernels_get_mu(kern, 0), 2.), 1.);
 
-        /* No multiplicity */
-        else
-          {
-            _setup_dat_append_y(info, specDat, dat, label, err, index, depth);
+    result[0] = 0.;
+    result[1] = 0.;
+    result[2] = muPoly -> info[index];
 
-            return 0;
+    for (size_t i = 0; i < __SPEC_MU_POLY_SIZE__; i++)
+      {
+        double weight = 1.;
+
+        for (size_t j = 0; j < __SPEC_MU_POLY_SIZE__; j++)
+          {
+            if (j != i)
+                weight *= (mu2 - nodes[j]) / (nodes[i] - nodes[j]);
           }
+
+        result[0] += weight * muPoly -> values[index][i];
+        result[1] += pow(weight * muPoly -> errors[index][i], 2.);
       }
 
+    result[1] = sqrt(result[1]);
 
-    /* Angle mu */
-    if (currDepth == 2)
-      {
-        /* Full multiplicity */
-        if (info -> partsDerivMult[index][2] == 1)
-          {
-            /* mu sample as dat struct */
-            dat_t *sampleMuDat = dat_new(1, 0, sampleArgMu -> size);
+    return 0;
+}
 
-            for (size_t i = 0; i < sampleArgMu -> size; i++)
-                dat_set_value(sampleMuDat, 0, i, 'x', sampleRawMu -> array[i]);
 
-            /* Derivative values */
-            dat_t *derivVals = dat_cat(2, info -> partsDerivVals[index], sampleMuDat);
-            info -> partsDerivVals[index] = dat_free(info -> partsDerivVals[index]);
-            info -> partsDerivVals[index] = dat_cat(1, derivVals);
-            derivVals = dat_free(derivVals);
-            sampleMuDat = dat_free(sampleMuDat);
 
-            dat_set_xlabel(info -> partsDerivVals[index], info -> partsDerivVals[index] -> xDim - 1, (char*) _idVarMu_);
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  -------------------------------   Shared Sweep of the Loop Integrals   -------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
 
-            for (size_t i = 0; i < sampleArgMu -> size; i++)
-              {
-                /* Get the mu value as a string */
-                char *muToString = misc_dtos(sampleRawMu -> array[i], __XSBUFFER__);
 
-                /* Total label */
-                char *totLabel = misc_scat(6, label, " [", _idVarMu_, " = ", muToString, "]");
+static int _spec_dpnl_setup_comp(spec_out_t *out)
+{
+    /*
 
-                /* Append a new column */
-                _setup_dat_append_y(info, specDat, dat, totLabel, err, index, depth);
-                *depth = currDepth + 1;
+        Flag the components of integrand_spec_dpnl_1loop_vec needed for the derivatives in out
 
-                /* Free memory */
-                free(muToString);
-                free(totLabel);
-              }
+    */
 
-            return 0;
-          }
+    for (size_t i = 0; i < out -> size; i++)
+      {
+        char *label = out -> labels[i];
 
-        /* Partial multiplicity */
-        else if (info -> partsDerivMult[index][2] == -1)
-          {
-            /* Total label */
-            char *totLabel = misc_scat(6, label, " [", _idVarMu_, " = ", _idVarMu_, "']");
+        /* Bootstrap parameters */
+        if (misc_sin(label, _dpnlLabelA2Ga)) _dpnlLoopComp[__INTGRND_DPNL_A2GA__] = true;
+        if (misc_sin(label, _dpnlLabelD2Ga)) _dpnlLoopComp[__INTGRND_DPNL_D2GA__] = true;
 
-            /* Append a new column */
-            _setup_dat_append_y(info, specDat, dat, totLabel, err, index, depth);
+        if (misc_sin(label, _dpnlLabelA3GaA)) _dpnlLoopComp[__INTGRND_DPNL_A3GAA__] = true;
+        if (misc_sin(label, _dpnlLabelA3GaB)) _dpnlLoopComp[__INTGRND_DPNL_A3GAB__] = true;
+        if (misc_sin(label, _dpnlLabelD3GaA)) _dpnlLoopComp[__INTGRND_DPNL_D3GAA__] = true;
+        if (misc_sin(label, _dpnlLabelD3GaB)) _dpnlLoopComp[__INTGRND_DPNL_D3GAB__] = true;
 
-            /* Free memory */
-            free(totLabel);
+        /* Bias parameters */
+        if (misc_sin(label, _dpnlLabelB1)) _dpnlLoopComp[__INTGRND_DPNL_B1__] = true;
+        if (misc_sin(label, _dpnlLabelB2)) _dpnlLoopComp[__INTGRND_DPNL_B2__] = true;
+        if (misc_sin(label, _dpnlLabelC2Ga)) _dpnlLoopComp[__INTGRND_DPNL_C2GA__] = true;
+        if (misc_sin(label, _dpnlLabelBGam3)) _dpnlLoopComp[__INTGRND_DPNL_BGAM3__] = true;
 
-            return 0;
+        /* RSD parameters (also need Pnl for the growth contribution) */
+        if (misc_sin(label, _dpnlLabelF))
+          {
+            _dpnlLoopComp[__INTGRND_DPNL_PNL__] = true;
+            _dpnlLoopComp[__INTGRND_DPNL_F__] = true;
           }
 
-        /* No multiplicity */
-        else
-          {
-            _setup_dat_append_y(info, specDat, dat, label, err, index, depth);
+        if (misc_sin(label, _dpnlLabelSigv)) _dpnlLoopComp[__INTGRND_DPNL_PNL__] = true;
 
-            return 0;
+        /* AP parameters */
+        if (misc_sin(label, _dpnlLabelD) || misc_sin(label, _dpnlLabelH))
+          {
+            _dpnlLoopComp[__INTGRND_DPNL_PNL__] = true;
+            _dpnlLoopComp[__INTGRND_DPNL_K__] = true;
           }
       }
 
-    appendCol:
+    return 0;
+}
 
-    /* Append another column */
-    dat_append_y(dat, label);
 
-    /* Append another column for errors */
-    if (err)
-      {
-        /* Total label */
-        char *totLabel = misc_scat(3, label, " ", _idIntError_);
+static int _spec_dpnl_free_comp(void)
+{
+    /*
 
-        /* Append a new column */
-        dat_append_y(dat, totLabel);
+        Reset the flagged components of integrand_spec_dpnl_1loop_vec
 
-        /* Free memory */
-        free(totLabel);
-      }
+    */
+
+    for (size_t i = 0; i < __INTGRND_DPNL_SIZE__; i++)
+        _dpnlLoopComp[i] = false;
 
     return 0;
 }
 
 
-
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  -------------------------------   Integration Bins for Derivatives   ---------------------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
-// TODO: Improve this...
+static size_t _spec_dpnl_loop_comp(double integrand(double*, size_t, void*))
+{
+    /*
 
+        Get the component of integrand_spec_dpnl_1loop_vec corresponding to the integrand (__INTGRND_DPNL_SIZE__ if
+        there is none)
 
-static int _spec_dpnl_setup_bin(void)
+    */
+
+    if (integrand == integrand_spec_pnl_1loop) return __INTGRND_DPNL_PNL__;
+
+    if (integrand == integrand_spec_dpnl_a2ga_1loop) return __INTGRND_DPNL_A2GA__;
+    if (integrand == integrand_spec_dpnl_d2ga_1loop) return __INTGRND_DPNL_D2GA__;
+
+    if (integrand == integrand_spec_dpnl_a3gaa_1loop) return __INTGRND_DPNL_A3GAA__;
+    if (integrand == integrand_spec_dpnl_a3gab_1loop) return __INTGRND_DPNL_A3GAB__;
+    if (integrand == integrand_spec_dpnl_d3gaa_1loop) return __INTGRND_DPNL_D3GAA__;
+    if (integrand == integrand_spec_dpnl_d3gab_1loop) return __INTGRND_DPNL_D3GAB__;
+
+    if (integrand == integrand_spec_dpnl_b1_1loop) return __INTGRND_DPNL_B1__;
+    if (integrand == integrand_spec_dpnl_b2_1loop) return __INTGRND_DPNL_B2__;
+    if (integrand == integrand_spec_dpnl_c2ga_1loop) return __INTGRND_DPNL_C2GA__;
+    if (integrand == integrand_spec_dpnl_bgam3_1loop) return __INTGRND_DPNL_BGAM3__;
+
+    if (integrand == integrand_spec_dpnl_f_1loop) return __INTGRND_DPNL_F__;
+
+    if (integrand == integrand_spec_dpnl_k_1loop) return __INTGRND_DPNL_K__;
+
+    return __INTGRND_DPNL_SIZE__;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static int _spec_loop_integrate(kern_t *kern, double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result)
 {
     /*
 
-        Setup the integration bins for the power spectrum derivatives
+        Integrate a loop integrand, where P22 and P13 are handed over to the integration routine together with their
+        batched versions (see integrate_batch).
+
+        If the integrand's parameters are given by kern, VEGAS starts from the grid that was last adapted to the same
+        integrand at a nearby (k, mu) (see _spec_vegas_grid_get).
+
+        If the P13 contributions are integrated radially, the integrand is handed over to _spec_loop_radial instead.
+        P22 of the power spectrum is replaced by its IR-safe version if loopSymP22 is set.
 
     */
 
-    int threadsNum = omp_get_max_threads();
+    if (_spec_loop_radial(kern, integrand, intgrt, result) == 0)
+        return 0;
 
-    /* Integral bins */
-    _pnl1LoopBin = malloc(sizeof(double*) * (size_t) threadsNum);
-    _dpnlK1LoopBin = malloc(sizeof(double*) * (size_t) threadsNum);
-    _dpnlMu1LoopBin = malloc(sizeof(double*) * (size_t) threadsNum);
+    if (integrand == integrand_spec_pnl_p22_1loop && _pnlInfo -> loopSymP22)
+        integrand = integrand_spec_pnl_p22_sym_1loop;
 
-    for (size_t i = 0; i < (size_t) threadsNum; i++)
-      {
-        _pnl1LoopBin[i] = NULL;
-        _dpnlK1LoopBin[i] = NULL;
-        _dpnlMu1LoopBin[i] = NULL;
-      }
+    if (intgrt -> params == kern)
+        integrate_set_vegas_grid(intgrt, _spec_vegas_grid_get(kern, integrand));
+
+    if (integrand == integrand_spec_pnl_p22_1loop)
+        integrate_batch(integrand, integrand_spec_pnl_p22_1loop_batch, intgrt, result);
+
+    else if (integrand == integrand_spec_pnl_p22_sym_1loop)
+        integrate_batch(integrand, integrand_spec_pnl_p22_sym_1loop_batch, intgrt, result);
+
+    else if (integrand == integrand_spec_pnl_p13_1loop)
+        integrate_batch(integrand, integrand_spec_pnl_p13_1loop_batch, intgrt, result);
+
+    else
+        integrate(integrand, intgrt, result);
+
+    integrate_set_vegas_grid(intgrt, NULL);
 
     return 0;
 }
 
 
-static int _spec_dpnl_reset_bin(int thread)
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+typedef struct
 {
     /*
 
-        Reset the integration bin for the power spectrum derivatives for a single thread
+        Split of a loop integrand into its P22 (NULL if there is none) and P13 parts
 
     */
 
-    if (_pnl1LoopBin[thread] != NULL) free(_pnl1LoopBin[thread]);
-    _pnl1LoopBin[thread] = NULL;
+    double (*integrand)(double*, size_t, void*);
 
-    if (_dpnlK1LoopBin[thread] != NULL) free(_dpnlK1LoopBin[thread]);
-    _dpnlK1LoopBin[thread] = NULL;
+    double (*integrandP22)(double*, size_t, void*);
+    double (*integrandP13)(double*, size_t, void*);
+
+    /* Integrand of the power spectrum derivatives (_dpnlInfo) rather than the power spectrum (_pnlInfo) */
+    bool deriv;
+
+} _spec_loop_split_t;
+
+
+static const _spec_loop_split_t _loopSplit[] =
+{
+    {integrand_spec_pnl_p13_1loop, NULL, integrand_spec_pnl_p13_1loop, false},
+    {integrand_spec_pnl_p13_basis_1loop, NULL, integrand_spec_pnl_p13_basis_1loop, false},
+
+    {integrand_spec_pnl_1loop, integrand_spec_pnl_p22_1loop, integrand_spec_pnl_p13_1loop, true},
+
+    {integrand_spec_dpnl_a2ga_1loop, integrand_spec_dpnl_dp22_a2ga_1loop, integrand_spec_dpnl_dp13_a2ga_1loop, true},
+    {integrand_spec_dpnl_d2ga_1loop, integrand_spec_dpnl_dp22_d2ga_1loop, integrand_spec_dpnl_dp13_d2ga_1loop, true},
+    {integrand_spec_dpnl_h_1loop, integrand_spec_dpnl_dp22_h_1loop, integrand_spec_dpnl_dp13_h_1loop, true},
+
+    {integrand_spec_dpnl_a3gaa_1loop, integrand_spec_dpnl_dp22_a3gaa_1loop, integrand_spec_dpnl_dp13_a3gaa_1loop, true},
+    {integrand_spec_dpnl_a3gab_1loop, integrand_spec_dpnl_dp22_a3gab_1loop, integrand_spec_dpnl_dp13_a3gab_1loop, true},
+    {integrand_spec_dpnl_d3gaa_1loop, integrand_spec_dpnl_dp22_d3gaa_1loop, integrand_spec_dpnl_dp13_d3gaa_1loop, true},
+    {integrand_spec_dpnl_d3gab_1loop, integrand_spec_dpnl_dp22_d3gab_1loop, integrand_spec_dpnl_dp13_d3gab_1loop, true},
+
+    {integrand_spec_dpnl_b1_1loop, integrand_spec_dpnl_dp22_b1_1loop, integrand_spec_dpnl_dp13_b1_1loop, true},
+    {integrand_spec_dpnl_b2_1loop, integrand_spec_dpnl_dp22_b2_1loop, integrand_spec_dpnl_dp13_b2_1loop, true},
+    {integrand_spec_dpnl_c2ga_1loop, integrand_spec_dpnl_dp22_c2ga_1loop, integrand_spec_dpnl_dp13_c2ga_1loop, true},
+    {integrand_spec_dpnl_bgam3_1loop, integrand_spec_dpnl_dp22_bgam3_1loop, integrand_spec_dpnl_dp13_bgam3_1loop, true},
 
-    if (_dpnlMu1LoopBin[thread] != NULL) free(_dpnlMu1LoopBin[thread]);
-    _dpnlMu1LoopBin[thread] = NULL;
+    {integrand_spec_dpnl_f_1loop, integrand_spec_dpnl_dp22_f_1loop, integrand_spec_dpnl_dp13_f_1loop, true},
 
-    return 0;
-}
+    {integrand_spec_dpnl_k_1loop, integrand_spec_dpnl_dp22_k_1loop, integrand_spec_dpnl_dp13_k_1loop, true},
+    {integrand_spec_dpnl_mu_1loop, integrand_spec_dpnl_dp22_mu_1loop, integrand_spec_dpnl_dp13_mu_1loop, true}
+};
 
 
-static int _spec_dpnl_free_bin(void)
+static int _spec_loop_radial(kern_t *kern, double integrand(double*, size_t, void*), intgrt_t *intgrt, double *result)
 {
     /*
 
-        Free the integration bins for the power spectrum derivatives
+        Integrate a loop integrand whose P13 part is reduced to a 1d integral in q: the angles are integrated with an
+        inner rule (see integrand_spec_p13_radial_1loop, with the Gauss-Legendre table of the info) and the remaining integral over q is done with the info's
+        loopRadialIntgrt (CQUAD by default) over the same q-range as intgrt. The P22 part is still integrated with
+        intgrt.
+
+        Returns 1 (without touching result) if the integrand has no P13 part or its spectrum is not integrated
+        radially (see spec_info_set_loop_radial).
 
     */
 
-    int threadsNum = omp_get_max_threads();
+    /* Split of the integrand */
+    const _spec_loop_split_t *split = NULL;
 
-    if (_pnl1LoopBin != NULL)
+    for (size_t i = 0; i < sizeof(_loopSplit) / sizeof(_loopSplit[0]); i++)
       {
-        for (size_t i = 0; i < (size_t) threadsNum; i++)
+        if (integrand == _loopSplit[i].integrand)
           {
-            if (_pnl1LoopBin[i] != NULL) free(_pnl1LoopBin[i]);
+            split = &_loopSplit[i];
+            break;
           }
+      }
 
-        free(_pnl1LoopBin);
+    if (split == NULL)
+        return 1;
 
-        _pnl1LoopBin = NULL;
-      }
+    _spec_info_t *info = (split -> deriv) ? _dpnlInfo : _pnlInfo;
 
-    if (_dpnlK1LoopBin != NULL)
-      {
-        for (size_t i = 0; i < (size_t) threadsNum; i++)
-          {
-            if (_dpnlK1LoopBin[i] != NULL) free(_dpnlK1LoopBin[i]);
-          }
+    if (!info -> loopRadial)
+        return 1;
 
-        free(_dpnlK1LoopBin);
 
-        _dpnlK1LoopBin = NULL;
-      }
+    /* P22 part */
+    double resultP22[3] = {0., 0., 0.};
 
-    if (_dpnlMu1LoopBin != NULL)
-      {
-        for (size_t i = 0; i < (size_t) threadsNum; i++)
-          {
-            if (_dpnlMu1LoopBin[i] != NULL) free(_dpnlMu1LoopBin[i]);
-          }
+    if (split -> integrandP22 != NULL)
+        _spec_loop_integrate(kern, split -> integrandP22, intgrt, resultP22);
 
-        free(_dpnlMu1LoopBin);
 
-        _dpnlMu1LoopBin = NULL;
-      }
+    /* P13 part */
+    double resultP13[3] = {0., 0., 0.};
+
+    intgrt_t *intgrtRadial = integrate_cp(info -> loopRadialIntgrt);
+
+    integrate_set_bounds_lower(intgrtRadial, intgrt -> lowerBounds);
+    integrate_set_bounds_upper(intgrtRadial, intgrt -> upperBounds);
+
+    intgrnd_radial_t paramsRadial;
+    paramsRadial.integrand = split -> integrandP13;
+    paramsRadial.params = intgrt -> params;
+    paramsRadial.table = info -> loopRadialTable;
+
+    integrate_set_params(intgrtRadial, &paramsRadial);
+
+    integrate(integrand_spec_p13_radial_1loop, intgrtRadial, resultP13);
+
+    intgrtRadial = integrate_free(intgrtRadial);
+
+
+    /* Combine the parts */
+    result[0] = resultP22[0] + resultP13[0];
+    result[1] = sqrt(resultP22[1]*resultP22[1] + resultP13[1]*resultP13[1]);
+    result[2] = resultP22[2];
 
     return 0;
 }
@@ -4259,6 +6064,23 @@ dat_t *spec_dat_poly(spec_dat_t *specDat)
     if (!strcmp(specDat -> id, _idSpecDPnl_))
       {
         _spec_dpnl_setup_bin();
+        _spec_dpnl_setup_comp(specDat -> out);
+      }
+
+    /* Loop integrals of the power spectrum (and its derivatives) are computed once per (z, k) as polynomials in mu^2
+       (only if there are at least as many mu as nodes of the polynomials) */
+    int chunkSize = 1;
+
+    if (!strcmp(specDat -> id, _idSpecPnl_) || !strcmp(specDat -> id, _idSpecDPnl_))
+      {
+        if (sampleArgMu -> size >= __SPEC_MU_POLY_SIZE__)
+            _spec_mu_poly_setup();
+
+        _spec_vegas_grid_setup();
+
+        /* Same k (shapes are sorted by length) should be calculated by the same thread */
+        if (sampleShape -> dimLength == 1 && sampleShape -> size % sampleArgK -> size == 0)
+            chunkSize = (int) (sampleShape -> size / sampleArgK -> size);
       }
 
 
@@ -4310,7 +6132,7 @@ dat_t *spec_dat_poly(spec_dat_t *specDat)
 
             /* Calculate the spectra for the current redshift */
 
-            #pragma omp for schedule(dynamic)
+            #pragma omp for schedule(dynamic, chunkSize)
 
             for (size_t m = 0; m < sampleShape -> size; m++)
 
@@ -4547,8 +6369,12 @@ dat_t *spec_dat_poly(spec_dat_t *specDat)
     if (!strcmp(specDat -> id, _idSpecDPnl_))
       {
         _spec_dpnl_free_bin();
+        _spec_dpnl_free_comp();
       }
 
+    _spec_mu_poly_free();
+    _spec_vegas_grid_free();
+
     return dat;
 }
 
@@ -4596,6 +6422,94 @@ int spec_pnl_tree(spec_arg_t *specArg, double *result)
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
+static int _spec_pnl_1loop(kern_t *kern, double integrand(double*, size_t, void*), void *params, double *result)
+{
+    /*
+
+        Integrate a one-loop contribution to the power spectrum (without the growth and smoothing factors)
+
+    */
+
+    /* Variables */
+    double k = kernels_get_k(kern, 0);
+    double mu = kernels_get_mu(kern, 0);
+
+
+    /* Integrate */
+
+    /* One-loop */
+    double result1Loop[3] = {0., 0., 0.};
+    intgrt_t *intgrt1Loop = integrate_cp(_pnlInfo -> loopIntgrt[0]);
+    integrate_set_params(intgrt1Loop, params);
+
+    if (params == kern)
+        _spec_loop_mu(kern, integrand, intgrt1Loop, result1Loop);
+
+    else
+        _spec_loop_integrate(kern, integrand, intgrt1Loop, result1Loop);
+
+    intgrt1Loop = integrate_free(intgrt1Loop);
+
+    /* Get the result */
+    double factor1Loop = 2. / pow(2. * M_PI, 3.);
+
+    result[0] = result1Loop[0] * factor1Loop;
+    result[1] = result1Loop[1] * factor1Loop;
+
+    /* Reset variables */
+    kernels_qset_k(kern, 1, k);
+    kernels_qset_mu(kern, 1, -mu);
+    kernels_qset_nu(kern, 0, 1, -1.);
+
+    return 0;
+}
+
+
+static int _spec_pnl_1loop_vec(kern_t *kern, int integrandVec(double*, size_t, void*, double*), size_t nComp, void *params, double *result)
+{
+    /*
+
+        Integrate the nComp components of a vector valued one-loop integrand in one sweep (see _spec_pnl_1loop), the
+        results of the i'th component are stored in result[3*i] and result[3*i + 1]
+
+    */
+
+    /* Variables */
+    double k = kernels_get_k(kern, 0);
+    double mu = kernels_get_mu(kern, 0);
+
+
+    /* Integrate */
+
+    /* One-loop */
+    intgrt_t *intgrt1Loop = integrate_cp(_pnlInfo -> loopIntgrt[0]);
+    integrate_set_params(intgrt1Loop, params);
+
+    integrate_vec(integrandVec, nComp, intgrt1Loop, result);
+
+    intgrt1Loop = integrate_free(intgrt1Loop);
+
+    /* Get the result */
+    double factor1Loop = 2. / pow(2. * M_PI, 3.);
+
+    for (size_t i = 0; i < nComp; i++)
+      {
+        result[3*i] *= factor1Loop;
+        result[3*i + 1] *= factor1Loop;
+      }
+
+    /* Reset variables */
+    kernels_qset_k(kern, 1, k);
+    kernels_qset_mu(kern, 1, -mu);
+    kernels_qset_nu(kern, 0, 1, -1.);
+
+    return 0;
+}
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
 int spec_pnl_p22(spec_arg_t *specArg, double *result)
 {
     /*
@@ -4617,38 +6531,28 @@ int spec_pnl_p22(spec_arg_t *specArg, double *result)
     /* Kern struct */
     kern_t *kern = specArg -> kern;
 
-    /* Variables */
-    double k = kernels_get_k(kern, 0);
-    double mu = kernels_get_mu(kern, 0);
-
     /* Smoothing */
     double smooth = kernels_smooth(kern);
 
 
-    /* Integrate */
-
-    /* One-loop */
+    /* One-loop (from the table if possible) */
     double result1Loop[3] = {0., 0., 0.};
-    intgrt_t *intgrt1Loop = integrate_cp(_pnlInfo -> loopIntgrt[0]);
-    integrate_set_params(intgrt1Loop, kern);
 
-    integrate(integrand_spec_pnl_p22_1loop, intgrt1Loop, result1Loop);
+    if (_spec_table_pnl_eval(_pnlTableP22, kern, result1Loop))
+      {
+        _spec_pnl_1loop(kern, integrand_spec_pnl_p22_1loop, kern, result1Loop);
 
-    intgrt1Loop = integrate_free(intgrt1Loop);
+        result1Loop[0] *= pow(kern -> growth, 4.);
+        result1Loop[1] *= pow(kern -> growth, 4.);
+      }
 
     /* Get the result */
-    double factor1Loop = 2. / pow(2. * M_PI, 3.) * pow(kern -> growth, 4.) * smooth;
-    result1Loop[0] *= factor1Loop;
-    result1Loop[1] *= factor1Loop;
+    result1Loop[0] *= smooth;
+    result1Loop[1] *= smooth;
 
     result[0] += result1Loop[0];
     result[1] = sqrt(result[1]*result[1] + result1Loop[1]*result1Loop[1]);
 
-    /* Reset variables */
-    kernels_qset_k(kern, 1, k);
-    kernels_qset_mu(kern, 1, -mu);
-    kernels_qset_nu(kern, 0, 1, -1.);
-
     return 0;
 }
 
@@ -4674,38 +6578,28 @@ int spec_pnl_p13(spec_arg_t *specArg, double *result)
     /* Kern struct */
     kern_t *kern = specArg -> kern;
 
-    /* Variables */
-    double k = kernels_get_k(kern, 0);
-    double mu = kernels_get_mu(kern, 0);
-
     /* Smoothing */
     double smooth = kernels_smooth(kern);
 
 
-    /* Integrate */
-
-    /* One-loop */
+    /* One-loop (from the table if possible) */
     double result1Loop[3] = {0., 0., 0.};
-    intgrt_t *intgrt1Loop = integrate_cp(_pnlInfo -> loopIntgrt[0]);
-    integrate_set_params(intgrt1Loop, kern);
 
-    integrate(integrand_spec_pnl_p13_1loop, intgrt1Loop, result1Loop);
+    if (_spec_table_pnl_eval(_pnlTableP13, kern, result1Loop))
+      {
+        _spec_pnl_1loop(kern, integrand_spec_pnl_p13_1loop, kern, result1Loop);
 
-    intgrt1Loop = integrate_free(intgrt1Loop);
+        result1Loop[0] *= pow(kern -> growth, 4.);
+        result1Loop[1] *= pow(kern -> growth, 4.);
+      }
 
     /* Get the result */
-    double factor1Loop = 2. / pow(2. * M_PI, 3.) * pow(kern -> growth, 4.) * smooth;
-    result1Loop[0] *= factor1Loop;
-    result1Loop[1] *= factor1Loop;
+    result1Loop[0] *= smooth;
+    result1Loop[1] *= smooth;
 
     result[0] += result1Loop[0];
     result[1] = sqrt(result[1]*result[1] + result1Loop[1]*result1Loop[1]);
 
-    /* Reset variables */
-    kernels_qset_k(kern, 1, k);
-    kernels_qset_mu(kern, 1, -mu);
-    kernels_qset_nu(kern, 0, 1, -1.);
-
     return 0;
 }
 
@@ -5020,7 +6914,7 @@ int spec_dpnl_a2ga(spec_arg_t *specArg, double *result)
         intgrt_t *intgrt1Loop = integrate_cp(_dpnlInfo -> loopIntgrt[0]);
         integrate_set_params(intgrt1Loop, kern);
 
-        integrate(integrand_spec_dpnl_a2ga_1loop, intgrt1Loop, result1Loop);
+        _spec_loop_mu(kern, integrand_spec_dpnl_a2ga_1loop, intgrt1Loop, result1Loop);
 
         intgrt1Loop = integrate_free(intgrt1Loop);
 
@@ -5112,7 +7006,7 @@ int spec_dpnl_d2ga(spec_arg_t *specArg, double *result)
         intgrt_t *intgrt1Loop = integrate_cp(_dpnlInfo -> loopIntgrt[0]);
         integrate_set_params(intgrt1Loop, kern);
 
-        integrate(integrand_spec_dpnl_d2ga_1loop, intgrt1Loop, result1Loop);
+        _spec_loop_mu(kern, integrand_spec_dpnl_d2ga_1loop, intgrt1Loop, result1Loop);
 
         intgrt1Loop = integrate_free(intgrt1Loop);
 
@@ -5204,7 +7098,7 @@ int spec_dpnl_a3gaa(spec_arg_t *specArg, double *result)
         intgrt_t *intgrt1Loop = integrate_cp(_dpnlInfo -> loopIntgrt[0]);
         integrate_set_params(intgrt1Loop, kern);
 
-        integrate(integrand_spec_dpnl_a3gaa_1loop, intgrt1Loop, result1Loop);
+        _spec_loop_mu(kern, integrand_spec_dpnl_a3gaa_1loop, intgrt1Loop, result1Loop);
 
         intgrt1Loop = integrate_free(intgrt1Loop);
 
@@ -5296,7 +7190,7 @@ int spec_dpnl_a3gab(spec_arg_t *specArg, double *result)
         intgrt_t *intgrt1Loop = integrate_cp(_dpnlInfo -> loopIntgrt[0]);
         integrate_set_params(intgrt1Loop, kern);
 
-        integrate(integrand_spec_dpnl_a3gab_1loop, intgrt1Loop, result1Loop);
+        _spec_loop_mu(kern, integrand_spec_dpnl_a3gab_1loop, intgrt1Loop, result1Loop);
 
         intgrt1Loop = integrate_free(intgrt1Loop);
 
@@ -5388,7 +7282,7 @@ int spec_dpnl_d3gaa(spec_arg_t *specArg, double *result)
         intgrt_t *intgrt1Loop = integrate_cp(_dpnlInfo -> loopIntgrt[0]);
         integrate_set_params(intgrt1Loop, kern);
 
-        integrate(integrand_spec_dpnl_d3gaa_1loop, intgrt1Loop, result1Loop);
+        _spec_loop_mu(kern, integrand_spec_dpnl_d3gaa_1loop, intgrt1Loop, result1Loop);
 
         intgrt1Loop = integrate_free(intgrt1Loop);
 
@@ -5480,7 +7374,7 @@ int spec_dpnl_d3gab(spec_arg_t *specArg, double *result)
         intgrt_t *intgrt1Loop = integrate_cp(_dpnlInfo -> loopIntgrt[0]);
         integrate_set_params(intgrt1Loop, kern);
 
-        integrate(integrand_spec_dpnl_d3gab_1loop, intgrt1Loop, result1Loop);
+        _spec_loop_mu(kern, integrand_spec_dpnl_d3gab_1loop, intgrt1Loop, result1Loop);
 
         intgrt1Loop = integrate_free(intgrt1Loop);
 
@@ -5577,7 +7471,7 @@ int spec_dpnl_b1(spec_arg_t *specArg, double *result)
         intgrt_t *intgrt1Loop = integrate_cp(_dpnlInfo -> loopIntgrt[0]);
         integrate_set_params(intgrt1Loop, kern);
 
-        integrate(integrand_spec_dpnl_b1_1loop, intgrt1Loop, result1Loop);
+        _spec_loop_mu(kern, integrand_spec_dpnl_b1_1loop, intgrt1Loop, result1Loop);
 
         intgrt1Loop = integrate_free(intgrt1Loop);
 
@@ -5669,7 +7563,7 @@ int spec_dpnl_b2(spec_arg_t *specArg, double *result)
         intgrt_t *intgrt1Loop = integrate_cp(_dpnlInfo -> loopIntgrt[0]);
         integrate_set_params(intgrt1Loop, kern);
 
-        integrate(integrand_spec_dpnl_b2_1loop, intgrt1Loop, result1Loop);
+        _spec_loop_mu(kern, integrand_spec_dpnl_b2_1loop, intgrt1Loop, result1Loop);
 
         intgrt1Loop = integrate_free(intgrt1Loop);
 
@@ -5761,7 +7655,7 @@ int spec_dpnl_c2ga(spec_arg_t *specArg, double *result)
         intgrt_t *intgrt1Loop = integrate_cp(_dpnlInfo -> loopIntgrt[0]);
         integrate_set_params(intgrt1Loop, kern);
 
-        integrate(integrand_spec_dpnl_c2ga_1loop, intgrt1Loop, result1Loop);
+        _spec_loop_mu(kern, integrand_spec_dpnl_c2ga_1loop, intgrt1Loop, result1Loop);
 
         intgrt1Loop = integrate_free(intgrt1Loop);
 
@@ -5853,7 +7747,7 @@ int spec_dpnl_bgam3(spec_arg_t *specArg, double *result)
         intgrt_t *intgrt1Loop = integrate_cp(_dpnlInfo -> loopIntgrt[0]);
         integrate_set_params(intgrt1Loop, kern);
 
-        integrate(integrand_spec_dpnl_bgam3_1loop, intgrt1Loop, result1Loop);
+        _spec_loop_mu(kern, integrand_spec_dpnl_bgam3_1loop, intgrt1Loop, result1Loop);
 
         intgrt1Loop = integrate_free(intgrt1Loop);
 
@@ -5986,7 +7880,7 @@ int spec_dpnl_f(spec_arg_t *specArg, double *result)
                   {
                     _pnl1LoopBin[thread] = malloc(sizeof(double) * 3);
 
-                    integrate(integrand_spec_pnl_1loop, intgrt1Loop, _pnl1LoopBin[thread]);
+                    _spec_loop_mu(kern, integrand_spec_pnl_1loop, intgrt1Loop, _pnl1LoopBin[thread]);
                   }
 
                 result1Loop[0] = _pnl1LoopBin[thread][0];
@@ -5996,7 +7890,7 @@ int spec_dpnl_f(spec_arg_t *specArg, double *result)
             /* Must integrate without bin */
             else
               {
-                integrate(integrand_spec_pnl_1loop, intgrt1Loop, result1Loop);
+                _spec_loop_mu(kern, integrand_spec_pnl_1loop, intgrt1Loop, result1Loop);
               }
 
             intgrt1Loop = integrate_free(intgrt1Loop);
@@ -6043,7 +7937,7 @@ int spec_dpnl_f(spec_arg_t *specArg, double *result)
             intgrt_t *intgrt1Loop = integrate_cp(_dpnlInfo -> loopIntgrt[0]);
             integrate_set_params(intgrt1Loop, kern);
 
-            integrate(integrand_spec_dpnl_f_1loop, intgrt1Loop, result1Loop);
+            _spec_loop_mu(kern, integrand_spec_dpnl_f_1loop, intgrt1Loop, result1Loop);
 
             intgrt1Loop = integrate_free(intgrt1Loop);
 
@@ -6154,7 +8048,7 @@ int spec_dpnl_sigv(spec_arg_t *specArg, double *result)
               {
                 _pnl1LoopBin[thread] = malloc(sizeof(double) * 3);
 
-                integrate(integrand_spec_pnl_1loop, intgrt1Loop, _pnl1LoopBin[thread]);
+                _spec_loop_mu(kern, integrand_spec_pnl_1loop, intgrt1Loop, _pnl1LoopBin[thread]);
               }
 
             result1Loop[0] = _pnl1LoopBin[thread][0];
@@ -6164,7 +8058,7 @@ int spec_dpnl_sigv(spec_arg_t *specArg, double *result)
         /* Must integrate without bin */
         else
           {
-            integrate(integrand_spec_pnl_1loop, intgrt1Loop, result1Loop);
+            _spec_loop_mu(kern, integrand_spec_pnl_1loop, intgrt1Loop, result1Loop);
           }
 
         intgrt1Loop = integrate_free(intgrt1Loop);
@@ -6290,7 +8184,7 @@ int spec_dpnl_d(spec_arg_t *specArg, double *result)
                   {
                     _pnl1LoopBin[thread] = malloc(sizeof(double) * 3);
 
-                    integrate(integrand_spec_pnl_1loop, intgrt1Loop, _pnl1LoopBin[thread]);
+                    _spec_loop_mu(kern, integrand_spec_pnl_1loop, intgrt1Loop, _pnl1LoopBin[thread]);
                   }
 
                 result1Loop[0] = _pnl1LoopBin[thread][0];
@@ -6300,7 +8194,7 @@ int spec_dpnl_d(spec_arg_t *specArg, double *result)
             /* Must integrate without bin */
             else
               {
-                integrate(integrand_spec_pnl_1loop, intgrt1Loop, result1Loop);
+                _spec_loop_mu(kern, integrand_spec_pnl_1loop, intgrt1Loop, result1Loop);
               }
 
             intgrt1Loop = integrate_free(intgrt1Loop);
@@ -6359,7 +8253,7 @@ int spec_dpnl_d(spec_arg_t *specArg, double *result)
                   {
                     _dpnlK1LoopBin[thread] = malloc(sizeof(double) * 3);
 
-                    integrate(integrand_spec_dpnl_k_1loop, intgrt1Loop, _dpnlK1LoopBin[thread]);
+                    _spec_loop_mu(kern, integrand_spec_dpnl_k_1loop, intgrt1Loop, _dpnlK1LoopBin[thread]);
                   }
 
                 result1LoopK[0] = _dpnlK1LoopBin[thread][0];
@@ -6369,7 +8263,7 @@ int spec_dpnl_d(spec_arg_t *specArg, double *result)
             /* Must integrate without bin */
             else
               {
-                integrate(integrand_spec_dpnl_k_1loop, intgrt1Loop, result1LoopK);
+                _spec_loop_mu(kern, integrand_spec_dpnl_k_1loop, intgrt1Loop, result1LoopK);
               }
 
             /* Can only use the bin if it was setup beforehand */
@@ -6506,7 +8400,7 @@ int spec_dpnl_h(spec_arg_t *specArg, double *result)
                   {
                     _pnl1LoopBin[thread] = malloc(sizeof(double) * 3);
 
-                    integrate(integrand_spec_pnl_1loop, intgrt1Loop, _pnl1LoopBin[thread]);
+                    _spec_loop_mu(kern, integrand_spec_pnl_1loop, intgrt1Loop, _pnl1LoopBin[thread]);
                   }
 
                 result1Loop[0] = _pnl1LoopBin[thread][0];
@@ -6516,7 +8410,7 @@ int spec_dpnl_h(spec_arg_t *specArg, double *result)
             /* Must integrate without bin */
             else
               {
-                integrate(integrand_spec_pnl_1loop, intgrt1Loop, result1Loop);
+                _spec_loop_mu(kern, integrand_spec_pnl_1loop, intgrt1Loop, result1Loop);
               }
 
             intgrt1Loop = integrate_free(intgrt1Loop);
@@ -6574,7 +8468,7 @@ int spec_dpnl_h(spec_arg_t *specArg, double *result)
                   {
                     _dpnlK1LoopBin[thread] = malloc(sizeof(double) * 3);
 
-                    integrate(integrand_spec_dpnl_k_1loop, intgrt1Loop, _dpnlK1LoopBin[thread]);
+                    _spec_loop_mu(kern, integrand_spec_dpnl_k_1loop, intgrt1Loop, _dpnlK1LoopBin[thread]);
                   }
 
                 result1LoopK[0] = _dpnlK1LoopBin[thread][0];
@@ -6584,7 +8478,7 @@ int spec_dpnl_h(spec_arg_t *specArg, double *result)
             /* Must integrate without bin */
             else
               {
-                integrate(integrand_spec_dpnl_k_1loop, intgrt1Loop, result1LoopK);
+                _spec_loop_mu(kern, integrand_spec_dpnl_k_1loop, intgrt1Loop, result1LoopK);
               }
 
             if (fabs(mu) < 1.) // Must have |mu| < 1
@@ -8887,40 +10781,203 @@ int (*spec_btr(const char *label))(spec_arg_t*, double*)
         return spec_btr_full;
       }
 
-    /* Label not found */
-    return _spec_zero;
-}
+    /* Label not found */
+    return _spec_zero;
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  -------------------------------   (Indirect) Tree-Level Bispectrum   ---------------------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static double _spec_btr(void *var, void *params)
+{
+    /*
+
+        Calculate the tree-level bispectrum (plus shot noise)
+
+        Note: This indirect function is used as the initial function for 'double _specBtr_(void*, void*)'.
+              The direct function 'int spec_btr(spec_arg_t*, double*)' is of different shape (but here they calculate the same thing in the same way)!
+
+    */
+
+    (void) params;
+
+    double result[3];
+    spec_btr_full(var, result);
+
+    return result[0];
+}
+
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  --------------------   (Direct) Tree-Level Bispectrum (Analytical) Derivatives   ---------------------  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+typedef struct
+{
+    /*
+
+        Tree-level bispectrum kernels Z1 Z1 Z2 P P (summed over the permutations, without 2 D^4 and the smoothing) and
+        their derivatives w.r.t. all kernel parameters at the configuration and fiducials they were computed for
+
+    */
+
+    bool computed;
+
+    /* Configuration: (z, k1, k2, k3, mu1, mu2, mu3, nu12, nu13, nu23) and the linear power spectra */
+    double var[10];
+    double pk[3];
+
+    /* Fiducials */
+    fid_btst_t btst;
+    fid_bias_t bias;
+    fid_rsd_t rsd;
+
+    kern_dual_t btr;
+
+} _spec_btr_dual_t;
+
+
+/*  ------------------------------------------------------------------------------------------------------  */
+/*  ####################################   Function Declarations   #######################################  */
+
+static const kern_dual_t *_spec_dbtr_tree_dual(spec_arg_t *specArg);
+
+/*  ######################################################################################################  */
+/*  ------------------------------------------------------------------------------------------------------  */
+
+
+static const kern_dual_t *_spec_dbtr_tree_dual(spec_arg_t *specArg)
+{
+    /*
+
+        Tree-level bispectrum kernels (see _spec_btr_dual_t) and their derivatives w.r.t. all kernel parameters at the
+        current configuration of specArg -> kern, computed in one pass with the dual kernels (kernels_z1_dual and
+        kernels_z2_dual). The result is kept in specArg, so the derivatives w.r.t. the other parameters at the same
+        configuration (e.g. the columns of spec_dat_poly) are read from there.
+
+    */
+
+    /* Kern struct */
+    kern_t *kern = specArg -> kern;
+
+    /* Variables */
+    double k1 = kernels_qget_k(kern, 0);
+    double k2 = kernels_qget_k(kern, 1);
+    double k3 = kernels_qget_k(kern, 2);
+
+    double mu1 = kernels_qget_mu(kern, 0);
+    double mu2 = kernels_qget_mu(kern, 1);
+    double mu3 = kernels_qget_mu(kern, 2);
+
+    double nu12 = kernels_qget_nu(kern, 0, 1);
+    double nu13 = kernels_qget_nu(kern, 0, 2);
+    double nu23 = kernels_qget_nu(kern, 1, 2);
+
+    double var[10] = {kern -> z, k1, k2, k3, mu1, mu2, mu3, nu12, nu13, nu23};
+
+    /* Linear power spectra */
+    double pk[3] = {_fidPk_(&k1, _fidParamsPk_), _fidPk_(&k2, _fidParamsPk_), _fidPk_(&k3, _fidParamsPk_)};
+
+    /* Result of the last call */
+    if (specArg -> btrDual == NULL)
+      {
+        specArg -> btrDual = malloc(sizeof(_spec_btr_dual_t));
+        ((_spec_btr_dual_t*) specArg -> btrDual) -> computed = false;
+      }
+
+    _spec_btr_dual_t *btrDual = (_spec_btr_dual_t*) specArg -> btrDual;
+
+    if (btrDual -> computed
+        && !memcmp(btrDual -> var, var, sizeof(var)) && !memcmp(btrDual -> pk, pk, sizeof(pk))
+        && !memcmp(&btrDual -> btst, kern -> btst, sizeof(fid_btst_t))
+        && !memcmp(&btrDual -> bias, kern -> bias, sizeof(fid_bias_t))
+        && !memcmp(&btrDual -> rsd, kern -> rsd, sizeof(fid_rsd_t)))
+      {
+        return &btrDual -> btr;
+      }
+
+
+    /* Kernels */
+
+    kern_dual_t z1Dual[3];
+    kern_dual_t z2Dual[3];
+
+    /* Z1(k1_), Z1(k2_), Z1(k3_) */
+    double mu[3] = {mu1, mu2, mu3};
+
+    for (size_t i = 0; i < 3; i++)
+      {
+        kernels_qset_mu(kern, 0, mu[i]);
+        kernels_z1_dual(kern, &z1Dual[i]);
+      }
+
+    /* Z2(k1_, k2_), Z2(k1_, k3_), Z2(k2_, k3_) */
+    size_t a[3] = {0, 0, 1};
+    size_t b[3] = {1, 2, 2};
+
+    double k[3] = {k1, k2, k3};
+    double nu[3] = {nu12, nu13, nu23};
+
+    for (size_t p = 0; p < 3; p++)
+      {
+        kernels_qset_k(kern, 0, k[a[p]]);
+        kernels_qset_k(kern, 1, k[b[p]]);
+        kernels_qset_mu(kern, 0, mu[a[p]]);
+        kernels_qset_mu(kern, 1, mu[b[p]]);
+        kernels_qset_nu(kern, 0, 1, nu[p]);
+
+        if (k[a[p]] != 0. && k[b[p]] != 0.)
+            kernels_z2_dual(kern, &z2Dual[p]);
+
+        else
+            memset(&z2Dual[p], 0, sizeof(kern_dual_t));
+      }
 
+    /* Reset the variables */
+    kernels_qset_k(kern, 0, k1);
+    kernels_qset_k(kern, 1, k2);
+    kernels_qset_mu(kern, 0, mu1);
+    kernels_qset_mu(kern, 1, mu2);
+    kernels_qset_nu(kern, 0, 1, nu12);
 
 
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  -------------------------------   (Indirect) Tree-Level Bispectrum   ---------------------------------  */
-/*  ------------------------------------------------------------------------------------------------------  */
+    /* Sum over the permutations (product rule for the derivatives) */
+    kern_dual_t *btr = &btrDual -> btr;
+    memset(btr, 0, sizeof(kern_dual_t));
 
+    for (size_t p = 0; p < 3; p++)
+      {
+        double pkab = pk[a[p]] * pk[b[p]];
 
-static double _spec_btr(void *var, void *params)
-{
-    /*
+        kern_dual_t *za = &z1Dual[a[p]];
+        kern_dual_t *zb = &z1Dual[b[p]];
 
-        Calculate the tree-level bispectrum (plus shot noise)
+        btr -> val += za -> val * zb -> val * z2Dual[p].val * pkab;
 
-        Note: This indirect function is used as the initial function for 'double _specBtr_(void*, void*)'.
-              The direct function 'int spec_btr(spec_arg_t*, double*)' is of different shape (but here they calculate the same thing in the same way)!
+        for (size_t i = 0; i < __KERN_DUAL_SIZE__; i++)
+            btr -> d[i] += (za -> d[i] * zb -> val * z2Dual[p].val + za -> val * zb -> d[i] * z2Dual[p].val + za -> val * zb -> val * z2Dual[p].d[i]) * pkab;
+      }
 
-    */
+    /* Store the configuration */
+    btrDual -> computed = true;
 
-    (void) params;
+    memcpy(btrDual -> var, var, sizeof(var));
+    memcpy(btrDual -> pk, pk, sizeof(pk));
 
-    double result[3];
-    spec_btr_full(var, result);
+    btrDual -> btst = *kern -> btst;
+    btrDual -> bias = *kern -> bias;
+    btrDual -> rsd = *kern -> rsd;
 
-    return result[0];
+    return btr;
 }
 
 
-
-/*  ------------------------------------------------------------------------------------------------------  */
-/*  --------------------   (Direct) Tree-Level Bispectrum (Analytical) Derivatives   ---------------------  */
 /*  ------------------------------------------------------------------------------------------------------  */
 
 
@@ -8964,62 +11021,14 @@ int spec_dbtr_a2ga(spec_arg_t *specArg, double *result)
     double mu3 = kernels_qget_mu(kern, 2);
 
     double nu12 = kernels_qget_nu(kern, 0, 1);
-    double nu13 = kernels_qget_nu(kern, 0, 2);
-    double nu23 = kernels_qget_nu(kern, 1, 2);
-
-    /* Linear power spectra */
-    double pk1 = _fidPk_(&k1, _fidParamsPk_);
-    double pk2 = _fidPk_(&k2, _fidParamsPk_);
-    double pk3 = _fidPk_(&k3, _fidParamsPk_);
-
-
-    /* Kernels */
-
-    /* Z1(k1_) */
-    kernels_qset_mu(kern, 0, mu1);
-    double z1Kernel1 = kernels_z1(kern);
-
-    /* Z1(k2_) */
-    kernels_qset_mu(kern, 0, mu2);
-    double z1Kernel2 = kernels_z1(kern);
-
-    /* Z1(k3_) */
-    kernels_qset_mu(kern, 0, mu3);
-    double z1Kernel3 = kernels_z1(kern);
-
-    /* Z2(k1_, k2_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k2);
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu2);
-    kernels_qset_nu(kern, 0, 1, nu12);
-
-    double dz2Kernel1 = (k1 != 0. && k2 != 0.) ? kernels_dz2_a2ga(kern) : 0.;
-
-    /* Z2(k1_, k3_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_nu(kern, 0, 1, nu13);
-
-    double dz2Kernel2 = (k1 != 0. && k3 != 0.) ? kernels_dz2_a2ga(kern) : 0.;
-
-    /* Z2(k2_, k3_) */
-    kernels_qset_k(kern, 0, k2);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu2);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_nu(kern, 0, 1, nu23);
 
-    double dz2Kernel3 = (k2 != 0. && k3 != 0.) ? kernels_dz2_a2ga(kern) : 0.;
+    /* Tree-level kernels and their derivatives w.r.t. all kernel parameters (in one pass, see _spec_dbtr_tree_dual) */
+    const kern_dual_t *btrDual = _spec_dbtr_tree_dual(specArg);
 
 
     /* Result */
 
-    result[0] = 2. * pow(kern -> growth, 4.) * smooth * (z1Kernel1 * z1Kernel2 * dz2Kernel1 * pk1 * pk2
-                                                       + z1Kernel1 * z1Kernel3 * dz2Kernel2 * pk1 * pk3
-                                                       + z1Kernel2 * z1Kernel3 * dz2Kernel3 * pk2 * pk3);
+    result[0] = 2. * pow(kern -> growth, 4.) * smooth * btrDual -> d[__KERN_DUAL_A2GA__];
 
     result[1] = 0.;
 
@@ -9121,62 +11130,14 @@ int spec_dbtr_d2ga(spec_arg_t *specArg, double *result)
     double mu3 = kernels_qget_mu(kern, 2);
 
     double nu12 = kernels_qget_nu(kern, 0, 1);
-    double nu13 = kernels_qget_nu(kern, 0, 2);
-    double nu23 = kernels_qget_nu(kern, 1, 2);
-
-    /* Linear power spectra */
-    double pk1 = _fidPk_(&k1, _fidParamsPk_);
-    double pk2 = _fidPk_(&k2, _fidParamsPk_);
-    double pk3 = _fidPk_(&k3, _fidParamsPk_);
-
-
-    /* Kernels */
-
-    /* Z1(k1_) */
-    kernels_qset_mu(kern, 0, mu1);
-    double z1Kernel1 = kernels_z1(kern);
-
-    /* Z1(k2_) */
-    kernels_qset_mu(kern, 0, mu2);
-    double z1Kernel2 = kernels_z1(kern);
-
-    /* Z1(k3_) */
-    kernels_qset_mu(kern, 0, mu3);
-    double z1Kernel3 = kernels_z1(kern);
-
-    /* Z2(k1_, k2_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k2);
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu2);
-    kernels_qset_nu(kern, 0, 1, nu12);
-
-    double dz2Kernel1 = (k1 != 0. && k2 != 0.) ? kernels_dz2_d2ga(kern) : 0.;
-
-    /* Z2(k1_, k3_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_nu(kern, 0, 1, nu13);
 
-    double dz2Kernel2 = (k1 != 0. && k3 != 0.) ? kernels_dz2_d2ga(kern) : 0.;
-
-    /* Z2(k2_, k3_) */
-    kernels_qset_k(kern, 0, k2);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu2);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_nu(kern, 0, 1, nu23);
-
-    double dz2Kernel3 = (k2 != 0. && k3 != 0.) ? kernels_dz2_d2ga(kern) : 0.;
+    /* Tree-level kernels and their derivatives w.r.t. all kernel parameters (in one pass, see _spec_dbtr_tree_dual) */
+    const kern_dual_t *btrDual = _spec_dbtr_tree_dual(specArg);
 
 
     /* Result */
 
-    result[0] = 2. * pow(kern -> growth, 4.) * smooth * (z1Kernel1 * z1Kernel2 * dz2Kernel1 * pk1 * pk2
-                                                       + z1Kernel1 * z1Kernel3 * dz2Kernel2 * pk1 * pk3
-                                                       + z1Kernel2 * z1Kernel3 * dz2Kernel3 * pk2 * pk3);
+    result[0] = 2. * pow(kern -> growth, 4.) * smooth * btrDual -> d[__KERN_DUAL_D2GA__];
 
     result[1] = 0.;
 
@@ -9597,68 +11558,14 @@ int spec_dbtr_b1(spec_arg_t *specArg, double *result)
     double mu3 = kernels_qget_mu(kern, 2);
 
     double nu12 = kernels_qget_nu(kern, 0, 1);
-    double nu13 = kernels_qget_nu(kern, 0, 2);
-    double nu23 = kernels_qget_nu(kern, 1, 2);
-
-    /* Linear power spectra */
-    double pk1 = _fidPk_(&k1, _fidParamsPk_);
-    double pk2 = _fidPk_(&k2, _fidParamsPk_);
-    double pk3 = _fidPk_(&k3, _fidParamsPk_);
-
 
-    /* Kernels */
-
-    /* Z1(k1_) */
-    kernels_qset_mu(kern, 0, mu1);
-    double z1Kernel1 = kernels_z1(kern);
-    double dz1Kernel1 = kernels_dz1_b1(kern);
-
-    /* Z1(k2_) */
-    kernels_qset_mu(kern, 0, mu2);
-    double z1Kernel2 = kernels_z1(kern);
-    double dz1Kernel2 = kernels_dz1_b1(kern);
-
-    /* Z1(k3_) */
-    kernels_qset_mu(kern, 0, mu3);
-    double z1Kernel3 = kernels_z1(kern);
-    double dz1Kernel3 = kernels_dz1_b1(kern);
-
-    /* Z2(k1_, k2_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k2);
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu2);
-    kernels_qset_nu(kern, 0, 1, nu12);
-
-    double z2Kernel1 = (k1 != 0. && k2 != 0.) ? kernels_z2(kern) : 0.;
-    double dz2Kernel1 = (k1 != 0. && k2 != 0.) ? kernels_dz2_b1(kern) : 0.;
-
-    /* Z2(k1_, k3_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_nu(kern, 0, 1, nu13);
-
-    double z2Kernel2 = (k1 != 0. && k3 != 0.) ? kernels_z2(kern) : 0.;
-    double dz2Kernel2 = (k1 != 0. && k3 != 0.) ? kernels_dz2_b1(kern) : 0.;
-
-    /* Z2(k2_, k3_) */
-    kernels_qset_k(kern, 0, k2);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu2);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_nu(kern, 0, 1, nu23);
-
-    double z2Kernel3 = (k2 != 0. && k3 != 0.) ? kernels_z2(kern) : 0.;
-    double dz2Kernel3 = (k2 != 0. && k3 != 0.) ? kernels_dz2_b1(kern) : 0.;
+    /* Tree-level kernels and their derivatives w.r.t. all kernel parameters (in one pass, see _spec_dbtr_tree_dual) */
+    const kern_dual_t *btrDual = _spec_dbtr_tree_dual(specArg);
 
 
     /* Result */
 
-    result[0] = 2. * pow(kern -> growth, 4.) * smooth * ((dz1Kernel1 * z1Kernel2 * z2Kernel1 + z1Kernel1 * dz1Kernel2 * z2Kernel1 + z1Kernel1 * z1Kernel2 * dz2Kernel1) * pk1 * pk2
-                                                       + (dz1Kernel1 * z1Kernel3 * z2Kernel2 + z1Kernel1 * dz1Kernel3 * z2Kernel2 + z1Kernel1 * z1Kernel3 * dz2Kernel2) * pk1 * pk3
-                                                       + (dz1Kernel2 * z1Kernel3 * z2Kernel3 + z1Kernel2 * dz1Kernel3 * z2Kernel3 + z1Kernel2 * z1Kernel3 * dz2Kernel3) * pk2 * pk3);
+    result[0] = 2. * pow(kern -> growth, 4.) * smooth * btrDual -> d[__KERN_DUAL_B1__];
 
     result[1] = 0.;
 
@@ -9760,62 +11667,14 @@ int spec_dbtr_b2(spec_arg_t *specArg, double *result)
     double mu3 = kernels_qget_mu(kern, 2);
 
     double nu12 = kernels_qget_nu(kern, 0, 1);
-    double nu13 = kernels_qget_nu(kern, 0, 2);
-    double nu23 = kernels_qget_nu(kern, 1, 2);
-
-    /* Linear power spectra */
-    double pk1 = _fidPk_(&k1, _fidParamsPk_);
-    double pk2 = _fidPk_(&k2, _fidParamsPk_);
-    double pk3 = _fidPk_(&k3, _fidParamsPk_);
-
-
-    /* Kernels */
-
-    /* Z1(k1_) */
-    kernels_qset_mu(kern, 0, mu1);
-    double z1Kernel1 = kernels_z1(kern);
-
-    /* Z1(k2_) */
-    kernels_qset_mu(kern, 0, mu2);
-    double z1Kernel2 = kernels_z1(kern);
-
-    /* Z1(k3_) */
-    kernels_qset_mu(kern, 0, mu3);
-    double z1Kernel3 = kernels_z1(kern);
-
-    /* Z2(k1_, k2_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k2);
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu2);
-    kernels_qset_nu(kern, 0, 1, nu12);
-
-    double dz2Kernel1 = (k1 != 0. && k2 != 0.) ? kernels_dz2_b2(kern) : 0.;
-
-    /* Z2(k1_, k3_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_nu(kern, 0, 1, nu13);
-
-    double dz2Kernel2 = (k1 != 0. && k3 != 0.) ? kernels_dz2_b2(kern) : 0.;
-
-    /* Z2(k2_, k3_) */
-    kernels_qset_k(kern, 0, k2);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu2);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_nu(kern, 0, 1, nu23);
 
-    double dz2Kernel3 = (k2 != 0. && k3 != 0.) ? kernels_dz2_b2(kern) : 0.;
+    /* Tree-level kernels and their derivatives w.r.t. all kernel parameters (in one pass, see _spec_dbtr_tree_dual) */
+    const kern_dual_t *btrDual = _spec_dbtr_tree_dual(specArg);
 
 
     /* Result */
 
-    result[0] = 2. * pow(kern -> growth, 4.) * smooth * (z1Kernel1 * z1Kernel2 * dz2Kernel1 * pk1 * pk2
-                                                       + z1Kernel1 * z1Kernel3 * dz2Kernel2 * pk1 * pk3
-                                                       + z1Kernel2 * z1Kernel3 * dz2Kernel3 * pk2 * pk3);
+    result[0] = 2. * pow(kern -> growth, 4.) * smooth * btrDual -> d[__KERN_DUAL_B2__];
 
     result[1] = 0.;
 
@@ -9904,75 +11763,27 @@ int spec_dbtr_c2ga(spec_arg_t *specArg, double *result)
     size_t specOrder = kern -> specOrder;
     kern -> specOrder = 3;
 
-    /* Smoothing */
-    double smooth = kernels_smooth(kern);
-
-    /* Variables */
-    double k1 = kernels_qget_k(kern, 0);
-    double k2 = kernels_qget_k(kern, 1);
-    double k3 = kernels_qget_k(kern, 2);
-
-    double mu1 = kernels_qget_mu(kern, 0);
-    double mu2 = kernels_qget_mu(kern, 1);
-    double mu3 = kernels_qget_mu(kern, 2);
-
-    double nu12 = kernels_qget_nu(kern, 0, 1);
-    double nu13 = kernels_qget_nu(kern, 0, 2);
-    double nu23 = kernels_qget_nu(kern, 1, 2);
-
-    /* Linear power spectra */
-    double pk1 = _fidPk_(&k1, _fidParamsPk_);
-    double pk2 = _fidPk_(&k2, _fidParamsPk_);
-    double pk3 = _fidPk_(&k3, _fidParamsPk_);
-
-
-    /* Kernels */
-
-    /* Z1(k1_) */
-    kernels_qset_mu(kern, 0, mu1);
-    double z1Kernel1 = kernels_z1(kern);
-
-    /* Z1(k2_) */
-    kernels_qset_mu(kern, 0, mu2);
-    double z1Kernel2 = kernels_z1(kern);
-
-    /* Z1(k3_) */
-    kernels_qset_mu(kern, 0, mu3);
-    double z1Kernel3 = kernels_z1(kern);
-
-    /* Z2(k1_, k2_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k2);
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu2);
-    kernels_qset_nu(kern, 0, 1, nu12);
-
-    double dz2Kernel1 = (k1 != 0. && k2 != 0.) ? kernels_dz2_c2ga(kern) : 0.;
+    /* Smoothing */
+    double smooth = kernels_smooth(kern);
 
-    /* Z2(k1_, k3_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_nu(kern, 0, 1, nu13);
+    /* Variables */
+    double k1 = kernels_qget_k(kern, 0);
+    double k2 = kernels_qget_k(kern, 1);
+    double k3 = kernels_qget_k(kern, 2);
 
-    double dz2Kernel2 = (k1 != 0. && k3 != 0.) ? kernels_dz2_c2ga(kern) : 0.;
+    double mu1 = kernels_qget_mu(kern, 0);
+    double mu2 = kernels_qget_mu(kern, 1);
+    double mu3 = kernels_qget_mu(kern, 2);
 
-    /* Z2(k2_, k3_) */
-    kernels_qset_k(kern, 0, k2);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu2);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_nu(kern, 0, 1, nu23);
+    double nu12 = kernels_qget_nu(kern, 0, 1);
 
-    double dz2Kernel3 = (k2 != 0. && k3 != 0.) ? kernels_dz2_c2ga(kern) : 0.;
+    /* Tree-level kernels and their derivatives w.r.t. all kernel parameters (in one pass, see _spec_dbtr_tree_dual) */
+    const kern_dual_t *btrDual = _spec_dbtr_tree_dual(specArg);
 
 
     /* Result */
 
-    result[0] = 2. * pow(kern -> growth, 4.) * smooth * (z1Kernel1 * z1Kernel2 * dz2Kernel1 * pk1 * pk2
-                                                       + z1Kernel1 * z1Kernel3 * dz2Kernel2 * pk1 * pk3
-                                                       + z1Kernel2 * z1Kernel3 * dz2Kernel3 * pk2 * pk3);
+    result[0] = 2. * pow(kern -> growth, 4.) * smooth * btrDual -> d[__KERN_DUAL_C2GA__];
 
     result[1] = 0.;
 
@@ -10172,61 +11983,9 @@ int spec_dbtr_f(spec_arg_t *specArg, double *result)
     double mu3 = kernels_qget_mu(kern, 2);
 
     double nu12 = kernels_qget_nu(kern, 0, 1);
-    double nu13 = kernels_qget_nu(kern, 0, 2);
-    double nu23 = kernels_qget_nu(kern, 1, 2);
-
-    /* Linear power spectra */
-    double pk1 = _fidPk_(&k1, _fidParamsPk_);
-    double pk2 = _fidPk_(&k2, _fidParamsPk_);
-    double pk3 = _fidPk_(&k3, _fidParamsPk_);
-
-
-    /* Kernels */
-
-    /* Z1(k1_) */
-    kernels_qset_mu(kern, 0, mu1);
-    double z1Kernel1 = kernels_z1(kern);
-    double dz1Kernel1 = kernels_dz1_f(kern);
-
-    /* Z1(k2_) */
-    kernels_qset_mu(kern, 0, mu2);
-    double z1Kernel2 = kernels_z1(kern);
-    double dz1Kernel2 = kernels_dz1_f(kern);
-
-    /* Z1(k3_) */
-    kernels_qset_mu(kern, 0, mu3);
-    double z1Kernel3 = kernels_z1(kern);
-    double dz1Kernel3 = kernels_dz1_f(kern);
-
-    /* Z2(k1_, k2_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k2);
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu2);
-    kernels_qset_nu(kern, 0, 1, nu12);
-
-    double z2Kernel1 = (k1 != 0. && k2 != 0.) ? kernels_z2(kern) : 0.;
-    double dz2Kernel1 = (k1 != 0. && k2 != 0.) ? kernels_dz2_f(kern) : 0.;
-
-    /* Z2(k1_, k3_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_nu(kern, 0, 1, nu13);
-
-    double z2Kernel2 = (k1 != 0. && k3 != 0.) ? kernels_z2(kern) : 0.;
-    double dz2Kernel2 = (k1 != 0. && k3 != 0.) ? kernels_dz2_f(kern) : 0.;
-
-    /* Z2(k2_, k3_) */
-    kernels_qset_k(kern, 0, k2);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu2);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_nu(kern, 0, 1, nu23);
 
-    double z2Kernel3 = (k2 != 0. && k3 != 0.) ? kernels_z2(kern) : 0.;
-    double dz2Kernel3 = (k2 != 0. && k3 != 0.) ? kernels_dz2_f(kern) : 0.;
+    /* Tree-level kernels and their derivatives w.r.t. all kernel parameters (in one pass, see _spec_dbtr_tree_dual) */
+    const kern_dual_t *btrDual = _spec_dbtr_tree_dual(specArg);
 
 
     /* Result */
@@ -10236,16 +11995,12 @@ int spec_dbtr_f(spec_arg_t *specArg, double *result)
 
     if (kern -> z == specArg -> deriv -> z)
       {
-        result[0] += 2. * pow(kern -> growth, 4.) * smooth * ((dz1Kernel1 * z1Kernel2 * z2Kernel1 + z1Kernel1 * dz1Kernel2 * z2Kernel1 + z1Kernel1 * z1Kernel2 * dz2Kernel1) * pk1 * pk2
-                                                            + (dz1Kernel1 * z1Kernel3 * z2Kernel2 + z1Kernel1 * dz1Kernel3 * z2Kernel2 + z1Kernel1 * z1Kernel3 * dz2Kernel2) * pk1 * pk3
-                                                            + (dz1Kernel2 * z1Kernel3 * z2Kernel3 + z1Kernel2 * dz1Kernel3 * z2Kernel3 + z1Kernel2 * z1Kernel3 * dz2Kernel3) * pk2 * pk3);
+        result[0] += 2. * pow(kern -> growth, 4.) * smooth * btrDual -> d[__KERN_DUAL_F__];
       }
 
     if (kern -> z <= specArg -> deriv -> z)
       {
-        result[0] += 8. * pow(kern -> growth, 4.) * dGrowth * smooth * (z1Kernel1 * z1Kernel2 * z2Kernel1 * pk1 * pk2
-                                                                       + z1Kernel1 * z1Kernel3 * z2Kernel2 * pk1 * pk3
-                                                                       + z1Kernel2 * z1Kernel3 * z2Kernel3 * pk2 * pk3);
+        result[0] += 8. * pow(kern -> growth, 4.) * dGrowth * smooth * btrDual -> val;
       }
 
     /* Logarithmic derivative */
@@ -10346,62 +12101,14 @@ int spec_dbtr_sigv(spec_arg_t *specArg, double *result)
     double mu3 = kernels_qget_mu(kern, 2);
 
     double nu12 = kernels_qget_nu(kern, 0, 1);
-    double nu13 = kernels_qget_nu(kern, 0, 2);
-    double nu23 = kernels_qget_nu(kern, 1, 2);
-
-    /* Linear power spectra */
-    double pk1 = _fidPk_(&k1, _fidParamsPk_);
-    double pk2 = _fidPk_(&k2, _fidParamsPk_);
-    double pk3 = _fidPk_(&k3, _fidParamsPk_);
-
-
-    /* Kernels */
-
-    /* Z1(k1_) */
-    kernels_qset_mu(kern, 0, mu1);
-    double z1Kernel1 = kernels_z1(kern);
-
-    /* Z1(k2_) */
-    kernels_qset_mu(kern, 0, mu2);
-    double z1Kernel2 = kernels_z1(kern);
-
-    /* Z1(k3_) */
-    kernels_qset_mu(kern, 0, mu3);
-    double z1Kernel3 = kernels_z1(kern);
-
-    /* Z2(k1_, k2_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k2);
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu2);
-    kernels_qset_nu(kern, 0, 1, nu12);
-
-    double z2Kernel1 = (k1 != 0. && k2 != 0.) ? kernels_z2(kern) : 0.;
-
-    /* Z2(k1_, k3_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_nu(kern, 0, 1, nu13);
-
-    double z2Kernel2 = (k1 != 0. && k3 != 0.) ? kernels_z2(kern) : 0.;
-
-    /* Z2(k2_, k3_) */
-    kernels_qset_k(kern, 0, k2);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu2);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_nu(kern, 0, 1, nu23);
 
-    double z2Kernel3 = (k2 != 0. && k3 != 0.) ? kernels_z2(kern) : 0.;
+    /* Tree-level kernels (see _spec_dbtr_tree_dual) */
+    const kern_dual_t *btrDual = _spec_dbtr_tree_dual(specArg);
 
 
     /* Result */
 
-    result[0] = 2. * pow(kern -> growth, 4.) * dsmooth * (z1Kernel1 * z1Kernel2 * z2Kernel1 * pk1 * pk2
-                                                        + z1Kernel1 * z1Kernel3 * z2Kernel2 * pk1 * pk3
-                                                        + z1Kernel2 * z1Kernel3 * z2Kernel3 * pk2 * pk3);
+    result[0] = 2. * pow(kern -> growth, 4.) * dsmooth * btrDual -> val;
 
     result[1] = 0.;
 
@@ -12336,234 +14043,98 @@ int spec_ttr_tree(spec_arg_t *specArg, double *result)
 
     /**  Kernels  **/
 
-    /* Z1 */
-
-    /* Z1(k1_) */
-    kernels_qset_mu(kern, 0, mu1);
-    double z1Kernel1 = kernels_z1(kern);
-
-    /* Z1(k2_) */
-    kernels_qset_mu(kern, 0, mu2);
-    double z1Kernel2 = kernels_z1(kern);
-
-    /* Z1(k3_) */
-    kernels_qset_mu(kern, 0, mu3);
-    double z1Kernel3 = kernels_z1(kern);
-
-    /* Z1(k4_) */
-    kernels_qset_mu(kern, 0, mu4);
-    double z1Kernel4 = kernels_z1(kern);
-
-
-    /* Z2 */
-
-    /* Z2(k12_, -k2_) */
-    kernels_qset_k(kern, 0, k12);
-    kernels_qset_k(kern, 1, k2);
-    kernels_qset_mu(kern, 0, mu12);
-    kernels_qset_mu(kern, 1, -mu2);
-    kernels_qset_nu(kern, 0, 1, -nu12_2);
-
-    double z2Kernel12_2 = (k12 != 0. && k2 != 0.) ? kernels_z2(kern) : 0.;
-
-    /* Z2(k12_, -k1_) */
-    kernels_qset_k(kern, 0, k12);
-    kernels_qset_k(kern, 1, k1);
-    kernels_qset_mu(kern, 0, mu12);
-    kernels_qset_mu(kern, 1, -mu1);
-    kernels_qset_nu(kern, 0, 1, -nu12_1);
-
-    double z2Kernel12_1 = (k12 != 0. && k1 != 0.) ? kernels_z2(kern) : 0.;
-
-    /* Z2(k13_, -k3_) */
-    kernels_qset_k(kern, 0, k13);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu13);
-    kernels_qset_mu(kern, 1, -mu3);
-    kernels_qset_nu(kern, 0, 1, -nu13_3);
-
-    double z2Kernel13_3 = (k13 != 0. && k3 != 0.) ? kernels_z2(kern) : 0.;
-
-    /* Z2(k13_, -k1_) */
-    kernels_qset_k(kern, 0, k13);
-    kernels_qset_k(kern, 1, k1);
-    kernels_qset_mu(kern, 0, mu13);
-    kernels_qset_mu(kern, 1, -mu1);
-    kernels_qset_nu(kern, 0, 1, -nu13_1);
-
-    double z2Kernel13_1 = (k13 != 0. && k1 != 0.) ? kernels_z2(kern) : 0.;
-
-    /* Z2(k14_, -k4_) */
-    kernels_qset_k(kern, 0, k14);
-    kernels_qset_k(kern, 1, k4);
-    kernels_qset_mu(kern, 0, mu14);
-    kernels_qset_mu(kern, 1, -mu4);
-    kernels_qset_nu(kern, 0, 1, -nu14_4);
-
-    double z2Kernel14_4 = (k14 != 0. && k4 != 0.) ? kernels_z2(kern) : 0.;
-
-    /* Z2(k14_, -k1_) */
-    kernels_qset_k(kern, 0, k14);
-    kernels_qset_k(kern, 1, k1);
-    kernels_qset_mu(kern, 0, mu14);
-    kernels_qset_mu(kern, 1, -mu1);
-    kernels_qset_nu(kern, 0, 1, -nu14_1);
-
-    double z2Kernel14_1 = (k14 != 0. && k1 != 0.) ? kernels_z2(kern) : 0.;
-
-    /* Z2(k23_, -k3_) = Z2(k14_, k3_) */
-    kernels_qset_k(kern, 0, k14);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu14);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_nu(kern, 0, 1, -nu23_3);
-
-    double z2Kernel23_3 = (k14 != 0. && k3 != 0.) ? kernels_z2(kern) : 0.;
-
-    /* Z2(k23_, -k2_) = Z2(k14_, k2_) */
-    kernels_qset_k(kern, 0, k14);
-    kernels_qset_k(kern, 1, k2);
-    kernels_qset_mu(kern, 0, mu14);
-    kernels_qset_mu(kern, 1, mu2);
-    kernels_qset_nu(kern, 0, 1, -nu23_2);
-
-    double z2Kernel23_2 = (k14 != 0. && k2 != 0.) ? kernels_z2(kern) : 0.;
-
-    /* Z2(k24_, -k4_) = Z2(k13_, k4_) */
-    kernels_qset_k(kern, 0, k13);
-    kernels_qset_k(kern, 1, k4);
-    kernels_qset_mu(kern, 0, mu13);
-    kernels_qset_mu(kern, 1, mu4);
-    kernels_qset_nu(kern, 0, 1, -nu24_4);
-
-    double z2Kernel24_4 = (k13 != 0. && k4 != 0.) ? kernels_z2(kern) : 0.;
-
-    /* Z2(k24_, -k2_) = Z2(k13_, k2_) */
-    kernels_qset_k(kern, 0, k13);
-    kernels_qset_k(kern, 1, k2);
-    kernels_qset_mu(kern, 0, mu13);
-    kernels_qset_mu(kern, 1, mu2);
-    kernels_qset_nu(kern, 0, 1, -nu24_2);
-
-    double z2Kernel24_2 = (k13 != 0. && k2 != 0.) ? kernels_z2(kern) : 0.;
-
-    /* Z2(k34_, -k4_) = Z2(k12_, k4_) */
-    kernels_qset_k(kern, 0, k12);
-    kernels_qset_k(kern, 1, k4);
-    kernels_qset_mu(kern, 0, mu12);
-    kernels_qset_mu(kern, 1, mu4);
-    kernels_qset_nu(kern, 0, 1, -nu34_4);
-
-    double z2Kernel34_4 = (k12 != 0. && k4 != 0.) ? kernels_z2(kern) : 0.;
-
-    /* Z2(k34_, -k3_) = Z2(k12_, k3_) */
-    kernels_qset_k(kern, 0, k12);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_mu(kern, 0, mu12);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_nu(kern, 0, 1, -nu34_3);
-
-    double z2Kernel34_3 = (k12 != 0. && k2 != 0.) ? kernels_z2(kern) : 0.;
-
+    /*
 
-    /* Z3 */
+        Every kernel of the T2211 and T3111 permutations is evaluated exactly once from the pair sums above (using
+        k23_ = -k14_, k24_ = -k13_ and k34_ = -k12_), and all of them are evaluated in three batches (see kernels_z1_batch,
+        kernels_z2_batch and kernels_z3_batch) instead of one kernels_z... call (and one set of working kern_t structs)
+        per permutation.
 
-    /* Z3(k1_, k2_, k3_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k2);
-    kernels_qset_k(kern, 2, k3);
+    */
 
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu2);
-    kernels_qset_mu(kern, 2, mu3);
+    /* Z1(ki_) */
+    double muZ1[4] = {mu1, mu2, mu3, mu4};
+    double z1Kernel[4];
 
-    kernels_qset_nu(kern, 0, 1, nu12);
-    kernels_qset_nu(kern, 0, 2, nu13);
-    kernels_qset_nu(kern, 1, 2, nu23);
+    kernels_z1_batch(kern, 4, muZ1, z1Kernel);
 
-    double z3Kernel123 = (k1 != 0. && k2 != 0. && k3 != 0.) ? kernels_z3(kern) : 0.;
+    /* Z2(kij_, -kj_) in the order 12_2, 12_1, 13_3, 13_1, 14_4, 14_1, 23_3, 23_2, 24_4, 24_2, 34_4, 34_3 */
+    double kZ2a[12] = {k12, k12, k13, k13, k14, k14, k14, k14, k13, k13, k12, k12};
+    double kZ2b[12] = {k2, k1, k3, k1, k4, k1, k3, k2, k4, k2, k4, k3};
 
-    /* Z3(k1_, k2_, k4_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k2);
-    kernels_qset_k(kern, 2, k4);
+    double muZ2a[12] = {mu12, mu12, mu13, mu13, mu14, mu14, mu14, mu14, mu13, mu13, mu12, mu12};
+    double muZ2b[12] = {-mu2, -mu1, -mu3, -mu1, -mu4, -mu1, mu3, mu2, mu4, mu2, mu4, mu3};
 
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu2);
-    kernels_qset_mu(kern, 2, mu4);
+    double nuZ2[12] = {-nu12_2, -nu12_1, -nu13_3, -nu13_1, -nu14_4, -nu14_1, -nu23_3, -nu23_2, -nu24_4, -nu24_2, -nu34_4, -nu34_3};
 
-    kernels_qset_nu(kern, 0, 1, nu12);
-    kernels_qset_nu(kern, 0, 2, nu14);
-    kernels_qset_nu(kern, 1, 2, nu24);
+    double z2Kernel[12];
 
-    double z3Kernel124 = (k1 != 0. && k2 != 0. && k4 != 0.) ? kernels_z3(kern) : 0.;
+    kernels_z2_batch(kern, 12, kZ2a, kZ2b, nuZ2, muZ2a, muZ2b, z2Kernel);
 
-    /* Z3(k1_, k3_, k4_) */
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_k(kern, 2, k4);
+    for (size_t i = 0; i < 12; i++)
+        z2Kernel[i] = (kZ2a[i] != 0. && kZ2b[i] != 0.) ? z2Kernel[i] : 0.;
 
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_mu(kern, 2, mu4);
+    double z2Kernel12_2 = z2Kernel[0];
+    double z2Kernel12_1 = z2Kernel[1];
+    double z2Kernel13_3 = z2Kernel[2];
+    double z2Kernel13_1 = z2Kernel[3];
+    double z2Kernel14_4 = z2Kernel[4];
+    double z2Kernel14_1 = z2Kernel[5];
+    double z2Kernel23_3 = z2Kernel[6];
+    double z2Kernel23_2 = z2Kernel[7];
+    double z2Kernel24_4 = z2Kernel[8];
+    double z2Kernel24_2 = z2Kernel[9];
+    double z2Kernel34_4 = z2Kernel[10];
+    double z2Kernel34_3 = z2Kernel[11];
 
-    kernels_qset_nu(kern, 0, 1, nu13);
-    kernels_qset_nu(kern, 0, 2, nu14);
-    kernels_qset_nu(kern, 1, 2, nu34);
+    /* Z3(ki_, kj_, kl_) in the order 123, 124, 134, 234 */
+    double kZ3a[4] = {k1, k1, k1, k2};
+    double kZ3b[4] = {k2, k2, k3, k3};
+    double kZ3c[4] = {k3, k4, k4, k4};
 
-    double z3Kernel134 = (k1 != 0. && k3 != 0. && k4 != 0.) ? kernels_z3(kern) : 0.;
+    double nuZ3ab[4] = {nu12, nu12, nu13, nu23};
+    double nuZ3ac[4] = {nu13, nu14, nu14, nu24};
+    double nuZ3bc[4] = {nu23, nu24, nu34, nu34};
 
-    /* Z3(k2_, k3_, k4_) */
-    kernels_qset_k(kern, 0, k2);
-    kernels_qset_k(kern, 1, k3);
-    kernels_qset_k(kern, 2, k4);
+    double muZ3a[4] = {mu1, mu1, mu1, mu2};
+    double muZ3b[4] = {mu2, mu2, mu3, mu3};
+    double muZ3c[4] = {mu3, mu4, mu4, mu4};
 
-    kernels_qset_mu(kern, 0, mu2);
-    kernels_qset_mu(kern, 1, mu3);
-    kernels_qset_mu(kern, 2, mu4);
+    double z3Kernel[4];
 
-    kernels_qset_nu(kern, 0, 1, nu23);
-    kernels_qset_nu(kern, 0, 2, nu24);
-    kernels_qset_nu(kern, 1, 2, nu34);
+    kernels_z3_batch(kern, 4, kZ3a, kZ3b, kZ3c, nuZ3ab, nuZ3ac, nuZ3bc, muZ3a, muZ3b, muZ3c, z3Kernel);
 
-    double z3Kernel234 = (k2 != 0. && k3 != 0. && k4 != 0.) ? kernels_z3(kern) : 0.;
+    for (size_t i = 0; i < 4; i++)
+        z3Kernel[i] = (kZ3a[i] != 0. && kZ3b[i] != 0. && kZ3c[i] != 0.) ? z3Kernel[i] : 0.;
 
 
     /**  Result  **/
 
+    /* Z1(ki_) P(ki) */
+    double lin1 = z1Kernel[0] * pk1;
+    double lin2 = z1Kernel[1] * pk2;
+    double lin3 = z1Kernel[2] * pk3;
+    double lin4 = z1Kernel[3] * pk4;
+
     /* T2211 */
-    double tri2211 = 4. * (z2Kernel13_3 * z2Kernel24_4 * pk13 + z2Kernel14_4 * z2Kernel23_3 * pk14) * z1Kernel3 * z1Kernel4 *  pk3 * pk4
-                   + 4. * (z2Kernel12_2 * z2Kernel34_4 * pk12 + z2Kernel14_4 * z2Kernel23_2 * pk14) * z1Kernel2 * z1Kernel4 *  pk2 * pk4
-                   + 4. * (z2Kernel13_3 * z2Kernel24_2 * pk13 + z2Kernel12_2 * z2Kernel34_3 * pk12) * z1Kernel2 * z1Kernel3 *  pk2 * pk3
-                   + 4. * (z2Kernel13_1 * z2Kernel24_4 * pk13 + z2Kernel34_4 * z2Kernel12_1 * pk12) * z1Kernel1 * z1Kernel4 *  pk1 * pk4
-                   + 4. * (z2Kernel34_3 * z2Kernel12_1 * pk12 + z2Kernel14_1 * z2Kernel23_3 * pk14) * z1Kernel1 * z1Kernel3 *  pk1 * pk3
-                   + 4. * (z2Kernel13_1 * z2Kernel24_2 * pk13 + z2Kernel14_1 * z2Kernel23_2 * pk14) * z1Kernel1 * z1Kernel2 *  pk1 * pk2;
+    double tri2211 = 4. * (z2Kernel13_3 * z2Kernel24_4 * pk13 + z2Kernel14_4 * z2Kernel23_3 * pk14) * lin3 * lin4
+                   + 4. * (z2Kernel12_2 * z2Kernel34_4 * pk12 + z2Kernel14_4 * z2Kernel23_2 * pk14) * lin2 * lin4
+                   + 4. * (z2Kernel13_3 * z2Kernel24_2 * pk13 + z2Kernel12_2 * z2Kernel34_3 * pk12) * lin2 * lin3
+                   + 4. * (z2Kernel13_1 * z2Kernel24_4 * pk13 + z2Kernel34_4 * z2Kernel12_1 * pk12) * lin1 * lin4
+                   + 4. * (z2Kernel34_3 * z2Kernel12_1 * pk12 + z2Kernel14_1 * z2Kernel23_3 * pk14) * lin1 * lin3
+                   + 4. * (z2Kernel13_1 * z2Kernel24_2 * pk13 + z2Kernel14_1 * z2Kernel23_2 * pk14) * lin1 * lin2;
 
     /* T3111 */
-    double tri3111 = 6. * z3Kernel123 * z1Kernel1 * z1Kernel2 * z1Kernel3 * pk1 * pk2 * pk3
-                   + 6. * z3Kernel124 * z1Kernel1 * z1Kernel2 * z1Kernel4 * pk1 * pk2 * pk4
-                   + 6. * z3Kernel134 * z1Kernel1 * z1Kernel3 * z1Kernel4 * pk1 * pk3 * pk4
-                   + 6. * z3Kernel234 * z1Kernel2 * z1Kernel3 * z1Kernel4 * pk2 * pk3 * pk4;
+    double tri3111 = 6. * (z3Kernel[0] * lin1 * lin2 * lin3 + z3Kernel[1] * lin1 * lin2 * lin4
+                           + z3Kernel[2] * lin1 * lin3 * lin4 + z3Kernel[3] * lin2 * lin3 * lin4);
 
     /* Combine the results */
     result[0] = pow(kern -> growth, 6.) * smooth * (tri2211 + tri3111);
     result[1] = 0.;
 
-    /* Reset the variables */
+    /* Reset the spectrum order */
     kern -> specOrder = specOrder;
 
-    kernels_qset_k(kern, 0, k1);
-    kernels_qset_k(kern, 1, k2);
-    kernels_qset_k(kern, 2, k3);
-
-    kernels_qset_mu(kern, 0, mu1);
-    kernels_qset_mu(kern, 1, mu2);
-    kernels_qset_mu(kern, 2, mu3);
-
-    kernels_qset_nu(kern, 0, 1, nu12);
-    kernels_qset_nu(kern, 0, 2, nu13);
-    kernels_qset_nu(kern, 1, 2, nu23);
-
     return 0;
 }
 